@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+
+#include <future>
+
+using namespace mbgl;
+
+namespace {
+
+struct Counter {
+    Counter(ActorRef<Counter>) {}
+
+    void receive(int) { ++count; }
+    void flush(std::promise<int>* promise) { promise->set_value(count); }
+
+    int count = 0;
+};
+
+struct Pong {
+    Pong(ActorRef<Pong>) {}
+
+    void ping(std::promise<void>* reply) { reply->set_value(); }
+};
+
+} // namespace
+
+// Messages per second that one thread can send to an actor running on the background scheduler.
+static void Actor_Throughput(benchmark::State& state) {
+    Actor<Counter> counter(Scheduler::GetBackground());
+    const auto messages = static_cast<int>(state.range(0));
+
+    while (state.KeepRunning()) {
+        for (int i = 0; i < messages; ++i) {
+            counter.self().invoke(&Counter::receive, i);
+        }
+        std::promise<int> flushed;
+        counter.self().invoke(&Counter::flush, &flushed);
+        benchmark::DoNotOptimize(flushed.get_future().get());
+    }
+    state.SetItemsProcessed(state.iterations() * messages);
+}
+
+// Time from sending a message to an idle actor on the background scheduler until the sender is woken up
+// by its reply.
+static void Actor_Latency(benchmark::State& state) {
+    Actor<Pong> pong(Scheduler::GetBackground());
+
+    while (state.KeepRunning()) {
+        std::promise<void> reply;
+        pong.self().invoke(&Pong::ping, &reply);
+        reply.get_future().wait();
+    }
+}
+
+BENCHMARK(Actor_Throughput)->Arg(1)->Arg(100)->Arg(10000);
+BENCHMARK(Actor_Latency);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <chrono>
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+// Runs the tasks on the calling thread, as cluster tiles used to be generated.
+class InlineScheduler final : public Scheduler {
+public:
+    void schedule(std::function<void()> fn) override { fn(); }
+    mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
+
+private:
+    mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
+};
+
+std::shared_ptr<style::GeoJSONData> makeClusteredData(std::shared_ptr<Scheduler> scheduler) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> lon(-180.0, 180.0);
+    std::uniform_real_distribution<double> lat(-80.0, 80.0);
+
+    mapbox::feature::feature_collection<double> features;
+    for (std::size_t i = 0; i < 100000; ++i) {
+        const mapbox::geometry::point<double> point(lon(generator), lat(generator));
+        features.push_back(mapbox::feature::feature<double>{point, {}, {}});
+    }
+
+    Mutable<style::GeoJSONOptions> options = makeMutable<style::GeoJSONOptions>();
+    options->cluster = true;
+    return style::GeoJSONData::create(features, std::move(options), std::move(scheduler));
+}
+
+// Measures how long the calling (map) thread is blocked while requesting all tiles of a zoom level
+// from a clustered source. The time until every tile is delivered is reported as a counter.
+void requestClusterTiles(benchmark::State& state, std::shared_ptr<Scheduler> scheduler) {
+    util::RunLoop loop;
+    auto data = makeClusteredData(std::move(scheduler));
+    const auto z = static_cast<uint8_t>(state.range(0));
+    const uint32_t tiles = 1u << z;
+
+    double totalSeconds = 0;
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<AsyncRequest>> requests;
+        std::size_t pending = tiles * tiles;
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t x = 0; x < tiles; ++x) {
+            for (uint32_t y = 0; y < tiles; ++y) {
+                requests.push_back(data->getTile({z, x, y}, [&](style::GeoJSONData::TileFeatures features) {
+                    benchmark::DoNotOptimize(features);
+                    if (--pending == 0) loop.stop();
+                }));
+            }
+        }
+        const auto stall = std::chrono::steady_clock::now() - start;
+        loop.run();
+        const auto total = std::chrono::steady_clock::now() - start;
+
+        state.SetIterationTime(std::chrono::duration<double>(stall).count());
+        totalSeconds += std::chrono::duration<double>(total).count();
+    }
+
+    state.counters["total_ms"] = benchmark::Counter(totalSeconds * 1000.0, benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+static void API_GeoJSONClusterTiles_CallerThread(benchmark::State& state) {
+    requestClusterTiles(state, std::make_shared<InlineScheduler>());
+}
+
+static void API_GeoJSONClusterTiles_Worker(benchmark::State& state) {
+    requestClusterTiles(state, nullptr);
+}
+
+BENCHMARK(API_GeoJSONClusterTiles_CallerThread)->Arg(2)->Arg(4)->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(API_GeoJSONClusterTiles_Worker)->Arg(2)->Arg(4)->UseManualTime()->Unit(benchmark::kMillisecond);
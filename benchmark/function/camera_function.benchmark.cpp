@@ -54,6 +54,36 @@ static void Evaluate_CameraFunction(benchmark::State& state) {
     state.SetLabel(std::to_string(stopCount).c_str());
 }
 
+static std::string createExpressionJSON(size_t stopCount) {
+    std::string expression = R"(["interpolate", ["exponential", 2], ["zoom"])";
+    for (size_t i = 0; i < stopCount; i++) {
+        std::string value = std::to_string(24.0f / stopCount * i);
+        expression += ", " + value + R"(, ["*", )" + value + ", 2]";
+    }
+    return expression + "]";
+}
+
+// Stop outputs are constant subexpressions, which are folded to literals when the expression is parsed.
+static void Evaluate_CameraExpression(benchmark::State& state) {
+    size_t stopCount = state.range(0);
+    auto doc = createExpressionJSON(stopCount);
+    conversion::Error error;
+    std::optional<PropertyValue<float>> expression = conversion::convertJSON<PropertyValue<float>>(
+        doc, error, false, false);
+    if (!expression) {
+        state.SkipWithError(error.message.c_str());
+    }
+
+    while (state.KeepRunning()) {
+        float z = 24.0f * static_cast<float>(rand() % 100) / 100;
+        expression->asExpression().evaluate(z);
+    }
+
+    state.SetLabel(std::to_string(stopCount).c_str());
+}
+
 BENCHMARK(Parse_CameraFunction)->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
 
 BENCHMARK(Evaluate_CameraFunction)->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
+
+BENCHMARK(Evaluate_CameraExpression)->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
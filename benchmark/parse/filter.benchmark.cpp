@@ -4,6 +4,7 @@
 #include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/tile/geojson_tile_data.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
 
@@ -30,5 +31,61 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+static void Parse_EvaluateFilter_NumberEquals(benchmark::State& state) {
+    const style::Filter filter = parse(R"FILTER(["==", ["get", "rank"], 3])FILTER");
+    const StubGeometryTileFeature feature = {{}, FeatureType::Unknown, {}, {{"rank", int64_t(3)}}};
+    const style::expression::EvaluationContext context(&feature);
+
+    while (state.KeepRunning()) {
+        filter(context);
+    }
+}
+
+static void Parse_EvaluateFilter_In(benchmark::State& state) {
+    const style::Filter filter = parse(
+        R"FILTER(["in", ["get", "class"], ["literal", ["motorway", "trunk", "primary", "tertiary"]]])FILTER");
+    const StubGeometryTileFeature feature = {{}, FeatureType::Unknown, {}, {{"class", std::string("tertiary")}}};
+    const style::expression::EvaluationContext context(&feature);
+
+    while (state.KeepRunning()) {
+        filter(context);
+    }
+}
+
+static void Parse_EvaluateFilter_Match(benchmark::State& state) {
+    const style::Filter filter = parse(
+        R"FILTER(["match", ["get", "class"], "motorway", true, ["primary", "tertiary"], true, false])FILTER");
+    const StubGeometryTileFeature feature = {{}, FeatureType::Unknown, {}, {{"class", std::string("tertiary")}}};
+    const style::expression::EvaluationContext context(&feature);
+
+    while (state.KeepRunning()) {
+        filter(context);
+    }
+}
+
+static void Parse_SelectFilter(benchmark::State& state) {
+    const style::Filter filter = parse(R"FILTER(["all",
+        ["in", ["get", "class"], ["literal", ["primary", "tertiary"]]],
+        ["==", ["get", "oneway"], 1]
+    ])FILTER");
+    mapbox::feature::feature_collection<int16_t> features;
+    const char* classes[] = {"motorway", "primary", "service", "tertiary"};
+    for (std::size_t i = 0; i < 1024; ++i) {
+        features.push_back({mapbox::geometry::point<int16_t>{0, 0},
+                            PropertyMap{{"class", std::string(classes[i % 4])},
+                                        {"oneway", static_cast<int64_t>(i % 3 == 0)}}});
+    }
+    const GeoJSONTileLayer layer(std::make_shared<const mapbox::feature::feature_collection<int16_t>>(features));
+    const style::expression::EvaluationContext context(0.0f, nullptr);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(filter.select(context, layer));
+    }
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateFilter_NumberEquals);
+BENCHMARK(Parse_EvaluateFilter_In);
+BENCHMARK(Parse_EvaluateFilter_Match);
+BENCHMARK(Parse_SelectFilter);
@@ -28,3 +28,33 @@ static void Parse_VectorTile(benchmark::State& state) {
 }
 
 BENCHMARK(Parse_VectorTile);
+
+// Reads every source layer as many times as it would be read by a style with several
+// style layers per source layer, evaluating a property lookup per feature as filters do.
+static void Parse_VectorTileSharedLayers(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const auto styleLayersPerSourceLayer = static_cast<std::size_t>(state.range(0));
+
+    while (state.KeepRunning()) {
+        std::size_t length = 0;
+        VectorTileData tile(data);
+        for (const auto& name : tile.layerNames()) {
+            for (std::size_t n = 0; n < styleLayersPerSourceLayer; ++n) {
+                if (auto layer = tile.getLayer(name)) {
+                    const std::size_t count = layer->featureCount();
+                    for (std::size_t i = 0; i < count; i++) {
+                        if (auto feature = layer->getFeature(i)) {
+                            if (feature->getValue("class")) {
+                                length += feature->getGeometries().size();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        (void)length;
+    }
+}
+
+BENCHMARK(Parse_VectorTileSharedLayers)->Arg(1)->Arg(4)->Arg(16);
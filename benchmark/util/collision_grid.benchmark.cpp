@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/collision_grid.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Candidate label boxes of a dense placement on a 1024x768 viewport, with the default padding of 100 pixels.
+std::vector<CollisionGrid::BBox> labelBoxes() {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> x(0.0f, 1224.0f);
+    std::uniform_real_distribution<float> y(0.0f, 968.0f);
+    std::uniform_real_distribution<float> width(20.0f, 120.0f);
+    std::vector<CollisionGrid::BBox> boxes;
+    for (std::size_t i = 0; i < 4000; ++i) {
+        const mapbox::geometry::point<float> min{x(generator), y(generator)};
+        boxes.push_back({min, {min.x + width(generator), min.y + 16.0f}});
+    }
+    return boxes;
+}
+
+} // namespace
+
+static void CollisionGrid_GridIndexPlacement(benchmark::State& state) {
+    const auto boxes = labelBoxes();
+    const IndexedSubfeature feature(0, "poi", "poi", 0);
+
+    while (state.KeepRunning()) {
+        GridIndex<IndexedSubfeature> grid(1224, 968, 25);
+        for (const auto& box : boxes) {
+            if (!grid.hitTest(box)) {
+                grid.insert(IndexedSubfeature(feature, 0, 0), box);
+            }
+        }
+        benchmark::DoNotOptimize(grid.size());
+    }
+}
+
+static void CollisionGrid_Placement(benchmark::State& state) {
+    const auto boxes = labelBoxes();
+    const IndexedSubfeature feature(0, "poi", "poi", 0);
+
+    while (state.KeepRunning()) {
+        CollisionGrid grid(1224, 968, 25);
+        for (const auto& box : boxes) {
+            if (!grid.hitTest(box)) {
+                grid.insert(grid.addFeature(feature, 0, 0), box);
+            }
+        }
+        benchmark::DoNotOptimize(grid.size());
+    }
+}
+
+BENCHMARK(CollisionGrid_GridIndexPlacement);
+BENCHMARK(CollisionGrid_Placement);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+const std::string& tile() {
+    static const std::string data = util::read_file("test/fixtures/map/issue12432/0-0-0.mvt");
+    return data;
+}
+
+void decompress(benchmark::State& state, int windowBits) {
+    const std::string compressed = util::compress(tile(), windowBits);
+
+    while (state.KeepRunning()) {
+        std::string data = util::decompress(compressed, windowBits);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * tile().size()));
+}
+
+} // namespace
+
+static void Compression_DecompressGzip(benchmark::State& state) {
+    decompress(state, util::CompressionFormat::GZIP);
+}
+
+static void Compression_DecompressZlib(benchmark::State& state) {
+    decompress(state, util::CompressionFormat::ZLIB);
+}
+
+static void Compression_Compress(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        std::string data = util::compress(tile());
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * tile().size()));
+}
+
+BENCHMARK(Compression_DecompressGzip);
+BENCHMARK(Compression_DecompressZlib);
+BENCHMARK(Compression_Compress);
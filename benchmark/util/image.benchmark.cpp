@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <string>
+
+using namespace mbgl;
+
+namespace {
+
+void decode(benchmark::State& state, const std::string& path) {
+    const std::string data = util::read_file(path);
+
+    while (state.KeepRunning()) {
+        PremultipliedImage image = decodeImage(data);
+        benchmark::DoNotOptimize(image.data.get());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+} // namespace
+
+static void Image_DecodePNG(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.png");
+}
+
+static void Image_DecodePNGAlpha(benchmark::State& state) {
+    decode(state, "test/fixtures/image/profile_alpha.png");
+}
+
+static void Image_DecodeJPEG(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.jpeg");
+}
+
+static void Image_DecodeWebP(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.webp");
+}
+
+static void Image_Premultiply(benchmark::State& state) {
+    UnassociatedImage image({1024, 1024});
+    for (std::size_t i = 0; i < image.bytes(); ++i) {
+        image.data[i] = static_cast<uint8_t>(i * 31);
+    }
+
+    while (state.KeepRunning()) {
+        // Pixels with zero alpha stay at zero after the first pass, which doesn't change the work done.
+        util::premultiply(image.data.get(), image.bytes() / 4);
+        benchmark::DoNotOptimize(image.data.get());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * image.bytes()));
+}
+
+BENCHMARK(Image_DecodePNG);
+BENCHMARK(Image_DecodePNGAlpha);
+BENCHMARK(Image_DecodeJPEG);
+BENCHMARK(Image_DecodeWebP);
+BENCHMARK(Image_Premultiply);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection_batch.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+// Anchors spread over a tile, projected with the matrix of a pitched view.
+PointBatch tileAnchors() {
+    PointBatch points;
+    for (int y = 0; y < util::EXTENT; y += 128) {
+        for (int x = 0; x < util::EXTENT; x += 128) {
+            points.push_back({static_cast<float>(x), static_cast<float>(y)});
+        }
+    }
+    return points;
+}
+
+mat4 pitchedMatrix() {
+    mat4 m;
+    matrix::perspective(m, 0.6435, 4.0 / 3.0, 1, 4000);
+    matrix::translate(m, m, 0, 0, -1000);
+    matrix::rotate_x(m, m, 1.0);
+    matrix::scale(m, m, util::tileSize_D / util::EXTENT, util::tileSize_D / util::EXTENT, 1);
+    return m;
+}
+
+} // namespace
+
+static void ProjectionBatch_TransformMat4(benchmark::State& state) {
+    const PointBatch points = tileAnchors();
+    const mat4 matrix = pitchedMatrix();
+    ProjectedPointBatch projected;
+    projected.x.resize(points.size());
+    projected.y.resize(points.size());
+    projected.w.resize(points.size());
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            vec4 p = {{points.x[i], points.y[i], 0, 1}};
+            matrix::transformMat4(p, p, matrix);
+            projected.x[i] = static_cast<float>(p[0] / p[3]);
+            projected.y[i] = static_cast<float>(p[1] / p[3]);
+            projected.w[i] = static_cast<float>(p[3]);
+        }
+        benchmark::DoNotOptimize(projected.x.data());
+    }
+}
+
+static void ProjectionBatch_ProjectPoints(benchmark::State& state) {
+    const PointBatch points = tileAnchors();
+    const mat4 matrix = pitchedMatrix();
+    ProjectedPointBatch projected;
+
+    while (state.KeepRunning()) {
+        util::projectPoints(points, matrix, projected);
+        benchmark::DoNotOptimize(projected.x.data());
+    }
+}
+
+BENCHMARK(ProjectionBatch_TransformMat4);
+BENCHMARK(ProjectionBatch_ProjectPoints);
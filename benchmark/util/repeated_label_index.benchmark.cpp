@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/layout/repeated_label_index.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Anchors of an overzoomed tile with contour lines: 400 wavy lines sharing 8 elevation labels, with
+// candidate anchors every 25 units, checked against a repeat distance of 125 units.
+std::vector<std::pair<std::u16string, Point<float>>> contourAnchors() {
+    std::vector<std::pair<std::u16string, Point<float>>> anchors;
+    const float extent = util::EXTENT;
+    for (int line = 0; line < 400; ++line) {
+        const std::u16string text = std::u16string(u"elevation ") + char16_t(u'0' + line % 8);
+        const float y = extent * line / 400;
+        for (float x = 0; x < extent; x += 25.0f) {
+            anchors.emplace_back(text, Point<float>{x, y + 10.0f * ((static_cast<int>(x) / 100) % 2)});
+        }
+    }
+    return anchors;
+}
+
+} // namespace
+
+static void RepeatedLabelIndex_Contours(benchmark::State& state) {
+    const auto anchors = contourAnchors();
+
+    while (state.KeepRunning()) {
+        RepeatedLabelIndex index;
+        std::size_t added = 0;
+        for (const auto& anchor : anchors) {
+            added += !index.isTooClose(anchor.first, 125.0f, anchor.second);
+        }
+        benchmark::DoNotOptimize(added);
+    }
+}
+
+BENCHMARK(RepeatedLabelIndex_Contours);
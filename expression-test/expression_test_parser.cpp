@@ -19,6 +19,7 @@
 #include <args.hxx>
 
 #include <regex>
+#include <unordered_set>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -271,7 +272,7 @@ bool parseInputs(const JSValue& inputsValue, TestData& data) {
         }
 
         // Parse availableImages
-        std::set<std::string> availableImages;
+        std::unordered_set<std::string> availableImages;
         if (evaluationContext.HasMember("availableImages")) {
             assert(evaluationContext["availableImages"].IsArray());
             for (const auto& image : evaluationContext["availableImages"].GetArray()) {
@@ -301,7 +302,7 @@ bool parseInputs(const JSValue& inputsValue, TestData& data) {
         data.inputs.emplace_back(std::move(zoom),
                                  std::move(heatmapDensity),
                                  std::move(canonical),
-                                 std::move(availableImages),
+                                 AvailableImages(std::move(availableImages)),
                                  std::move(feature));
     }
     return true;
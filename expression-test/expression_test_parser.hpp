@@ -16,7 +16,7 @@ struct Input {
     Input(std::optional<float> zoom_,
           std::optional<double> heatmapDensity_,
           std::optional<CanonicalTileID> canonical_,
-          std::set<std::string> availableImages_,
+          AvailableImages availableImages_,
           Feature feature_)
         : zoom(std::move(zoom_)),
           heatmapDensity(std::move(heatmapDensity_)),
@@ -26,7 +26,7 @@ struct Input {
     std::optional<float> zoom;
     std::optional<double> heatmapDensity;
     std::optional<CanonicalTileID> canonical;
-    std::set<std::string> availableImages;
+    AvailableImages availableImages;
     Feature feature;
 };
 
@@ -64,6 +64,9 @@ public:
 
     ActorRef<std::decay_t<Object>> self() { return parent.self(); }
 
+    /// Sets the scheduler priority lane used for this actor's messages.
+    void setPriority(TaskPriority priority) { parent.mailbox->setPriority(priority); }
+
 private:
     std::shared_ptr<Scheduler> retainer;
     AspiringActor<Object> parent;
@@ -1,15 +1,18 @@
 #pragma once
 
+#include <mbgl/actor/scheduler.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 #include <mapbox/std/weak.hpp>
 
 namespace mbgl {
 
-class Scheduler;
 class Message;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
@@ -21,6 +24,7 @@ public:
     Mailbox();
 
     Mailbox(Scheduler&);
+    ~Mailbox();
 
     /// Attach the given scheduler to this mailbox and begin processing messages
     /// sent to it. The mailbox must be a "holding" mailbox, as created by the
@@ -30,22 +34,57 @@ public:
 
     bool isOpen() const;
 
+    /// Sets the priority lane used when scheduling this mailbox's messages.
+    /// Takes effect the next time the mailbox is scheduled.
+    void setPriority(TaskPriority);
+
+    /// Queues a message. Safe to call from any thread; only locks when a receive() has to be scheduled,
+    /// or to wake a close() waiting for it.
     void push(std::unique_ptr<Message>);
+
+    /// Processes up to `maxBatchSize` queued messages, then yields the thread to other tasks by
+    /// rescheduling itself if more messages are pending.
     void receive();
 
+    static constexpr std::size_t maxBatchSize = 16;
+
     static void maybeReceive(const std::weak_ptr<Mailbox>&);
     static std::function<void()> makeClosure(std::weak_ptr<Mailbox>);
 
 private:
+    // Schedules a receive() unless one is scheduled already.
+    void scheduleReceive();
+    // Ends a push(), waking close() if it waits for the last one.
+    void endPush();
+
+    // Intrusive multi-producer, single-consumer queue (D. Vyukov). Producers only exchange `head`;
+    // the receiving thread owns `tail`. `stub` keeps the list non-empty.
+    void enqueue(Message*);
+    std::unique_ptr<Message> dequeue();
+
     mapbox::base::WeakPtr<Scheduler> weakScheduler;
 
+    // Held while messages are processed, and by open() and close(). It is recursive to allow a mailbox
+    // (and thus the actor) to close itself.
     std::recursive_mutex receivingMutex;
-    std::mutex pushingMutex;
+    // Guards reading `weakScheduler` for scheduling against open() setting it.
+    std::mutex schedulingMutex;
 
-    bool closed{false};
+    std::atomic<bool> closed{false};
+    std::atomic<TaskPriority> priority{TaskPriority::Normal};
+
+    // Number of push() calls in progress; close() waits on `pushed` for it to drop to zero.
+    std::atomic<std::size_t> pushing{0};
+    std::mutex pushingMutex;
+    std::condition_variable pushed;
+    // Messages pushed and not yet dequeued.
+    std::atomic<std::size_t> pending{0};
+    // Whether a receive() task is scheduled or running, so that there is never more than one.
+    std::atomic<bool> scheduled{false};
 
-    std::mutex queueMutex;
-    std::queue<std::unique_ptr<Message>> queue;
+    std::unique_ptr<Message> stub;
+    std::atomic<Message*> head;
+    Message* tail;
 };
 
 } // namespace mbgl
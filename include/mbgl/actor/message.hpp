@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <future>
 #include <utility>
 
@@ -12,6 +13,11 @@ class Message {
 public:
     virtual ~Message() = default;
     virtual void operator()() = 0;
+
+private:
+    friend class Mailbox;
+    // Link to the next message in a mailbox queue, so that queueing doesn't allocate.
+    std::atomic<Message*> next{nullptr};
 };
 
 template <class Object, class MemberFn, class ArgsTuple>
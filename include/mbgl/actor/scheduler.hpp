@@ -4,6 +4,8 @@
 
 #include <mapbox/std/weak.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -11,6 +13,17 @@ namespace mbgl {
 
 class Mailbox;
 
+/// Scheduling lane for a task. Schedulers that support priorities run
+/// all pending `High` tasks before `Normal` ones, and `Normal` before `Low`.
+/// Schedulers that don't treat every task as `Normal`.
+enum class TaskPriority : uint8_t {
+    High,
+    Normal,
+    Low
+};
+
+constexpr std::size_t TaskPriorityCount = 3;
+
 /**
     A `Scheduler` is responsible for coordinating the processing of messages by
     one or more actors via their mailboxes. It's an abstract interface. Currently,
@@ -24,7 +37,8 @@ class Mailbox;
         concurrency within a mailbox
 
       Subject to these constraints, processing can happen on whatever thread in the
-      pool is available.
+      pool is available. The pool size is chosen at runtime, see `ThreadPool`, and
+      each thread keeps its own task queue, stealing from the others when idle.
 
     * `Scheduler::GetCurrent()` is typically used to create a mailbox and `ActorRef`
       for an object that lives on the main thread and is not itself wrapped an
@@ -39,6 +53,9 @@ public:
 
     /// Enqueues a function for execution.
     virtual void schedule(std::function<void()>) = 0;
+    /// Enqueues a function for execution in the given priority lane.
+    /// The default implementation ignores the priority.
+    virtual void scheduleWithPriority(TaskPriority, std::function<void()> fn) { schedule(std::move(fn)); }
     /// Makes a weak pointer to this Scheduler.
     virtual mapbox::base::WeakPtr<Scheduler> makeWeakPtr() = 0;
 
@@ -15,6 +15,44 @@ DECLARE_MAPBOX_SETTING(EXPERIMENTAL_THREAD_PRIORITY_FILE, thread_priority_file);
 DECLARE_MAPBOX_SETTING(EXPERIMENTAL_THREAD_PRIORITY_NETWORK, thread_priority_network);
 DECLARE_MAPBOX_SETTING(EXPERIMENTAL_THREAD_PRIORITY_DATABASE, thread_priority_database);
 
+// The value for EXPERIMENTAL_THREAD_POOL_SIZE must be a positive integer. When missing,
+// the background thread pool is sized from std::thread::hardware_concurrency(), with at least four threads.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_THREAD_POOL_SIZE, thread_pool_size);
+
+// The values for EXPERIMENTAL_TILE_CACHE_* keys must be unsigned integers, in bytes.
+// EXPERIMENTAL_TILE_CACHE_MAX_BYTES bounds the tile cache of every source that doesn't set its own
+// budget with Source::setTileCacheMaxBytes(). EXPERIMENTAL_TILE_CACHE_TOTAL_MAX_BYTES bounds all tile
+// caches together; it is read once, when the first tile cache is created.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_TILE_CACHE_MAX_BYTES, tile_cache_max_bytes);
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_TILE_CACHE_TOTAL_MAX_BYTES, tile_cache_total_max_bytes);
+
+// The value for EXPERIMENTAL_CAMERA_PREFETCH_TILES must be an unsigned integer, the number of tiles
+// of every source requested at low priority along the path of a camera animation. Zero disables
+// prefetching; 32 tiles when missing.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_CAMERA_PREFETCH_TILES, camera_prefetch_tiles);
+
+// The value for EXPERIMENTAL_PARALLEL_TILE_PARSING must be a bool. When true, the layer
+// groups of a geometry tile are built concurrently on the background scheduler.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_PARALLEL_TILE_PARSING, parallel_tile_parsing);
+
+// The value for EXPERIMENTAL_PLACEMENT_TIME_BUDGET is a number of milliseconds. When set, symbol
+// placement in continuous mode is spread over several frames, spending at most this long per frame.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_PLACEMENT_TIME_BUDGET, placement_time_budget);
+
+// The value for EXPERIMENTAL_MBTILES_READER_COUNT must be a positive integer, the number of threads
+// reading tiles from .mbtiles archives. EXPERIMENTAL_MBTILES_MMAP_SIZE is the number of bytes of each
+// archive SQLite may map into memory; memory-mapped I/O is disabled when missing or zero.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_MBTILES_READER_COUNT, mbtiles_reader_count);
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_MBTILES_MMAP_SIZE, mbtiles_mmap_size);
+
+// The value for EXPERIMENTAL_SHAPING_CACHE_SIZE must be an unsigned integer, the number of text shapings
+// kept for reuse by the symbol layouts of all tiles. Zero disables the cache; 4096 when missing.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_SHAPING_CACHE_SIZE, shaping_cache_size);
+
+// The value for EXPERIMENTAL_PROGRAM_CACHE_DIR must be a string, the path of an existing writable directory.
+// When set, linked shader programs are saved there and loaded back by later runs on the same driver.
+DECLARE_MAPBOX_SETTING(EXPERIMENTAL_PROGRAM_CACHE_DIR, program_cache_dir);
+
 /// Settings class provides non-persistent, in-process key-value storage.
 class Settings final {
 public:
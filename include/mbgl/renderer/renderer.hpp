@@ -2,6 +2,7 @@
 
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geojson.hpp>
 
@@ -12,6 +13,7 @@
 
 namespace mbgl {
 
+class AsyncRequest;
 class RendererObserver;
 class RenderedQueryOptions;
 class SourceQueryOptions;
@@ -70,6 +72,15 @@ public:
         const std::string& extension,
         const std::string& extensionField,
         const std::optional<std::map<std::string, Value>>& args = std::nullopt) const;
+    /// Asynchronous feature extension query, that does not block the calling thread while a clustered
+    /// source is queried. The callback is invoked on the calling thread, unless the returned request is
+    /// destroyed before. The request is nullptr when the query was answered synchronously.
+    std::unique_ptr<AsyncRequest> queryFeatureExtensions(const std::string& sourceID,
+                                                         const Feature& feature,
+                                                         const std::string& extension,
+                                                         const std::string& extensionField,
+                                                         const std::optional<std::map<std::string, Value>>& args,
+                                                         std::function<void(FeatureExtensionValue)> callback) const;
 
     void setFeatureState(const std::string& sourceID,
                          const std::optional<std::string>& sourceLayerID,
@@ -107,6 +118,14 @@ public:
      */
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
 
+    /**
+     * @brief In Continuous map mode, returns the wall-clock time between the start and the commit
+     * of the latest committed symbol placement.
+     *
+     * With a placement time budget set, this spans all the frames the placement was spread over.
+     */
+    Duration getPlacementLatency() const;
+
     // Memory
     void reduceMemoryUse();
     void clearData();
@@ -98,7 +98,7 @@ public:
     std::optional<Timestamp> priorModified = std::nullopt;
     std::optional<Timestamp> priorExpires = std::nullopt;
     std::optional<std::string> priorEtag = std::nullopt;
-    std::shared_ptr<const std::string> priorData;
+    SharedBuffer priorData;
     Duration minimumUpdateInterval{Duration::zero()};
     StoragePolicy storagePolicy{StoragePolicy::Permanent};
 };
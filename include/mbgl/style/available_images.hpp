@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace mbgl {
+
+/**
+ * @brief Immutable set of the IDs of the images of a style, used by `image` expressions to tell whether
+ * an image is available.
+ *
+ * The image manager takes a snapshot whenever its images change, which the tile workers share by
+ * reference instead of copying.
+ */
+class AvailableImages {
+public:
+    AvailableImages() = default;
+    explicit AvailableImages(std::unordered_set<std::string> ids_)
+        : ids(std::move(ids_)) {}
+    AvailableImages(std::initializer_list<std::string> ids_)
+        : ids(ids_) {}
+
+    bool contains(const std::string& id) const { return ids.find(id) != ids.end(); }
+
+    std::size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+private:
+    std::unordered_set<std::string> ids;
+};
+
+} // namespace mbgl
@@ -37,6 +37,9 @@ public:
     static ParseResult parse(const mbgl::style::conversion::Convertible& value, ParsingContext& ctx);
 
     EvaluationResult evaluate(const EvaluationContext& params) const override;
+    void select(const EvaluationContext& params,
+                const GeometryTileLayer& layer,
+                std::vector<std::size_t>& selection) const override;
     void eachChild(const std::function<void(const Expression&)>& visit) const override;
     bool operator==(const Expression& e) const override;
     std::vector<std::optional<Value>> possibleOutputs() const override;
@@ -6,6 +6,8 @@
 #include <mbgl/style/conversion.hpp>
 
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace mbgl {
 namespace style {
@@ -22,15 +24,24 @@ public:
     void eachChild(const std::function<void(const Expression&)>& visit) const override;
     bool operator==(const Expression&) const override;
     EvaluationResult evaluate(const EvaluationContext&) const override;
+    void select(const EvaluationContext&,
+                const GeometryTileLayer&,
+                std::vector<std::size_t>& selection) const override;
     std::vector<std::optional<Value>> possibleOutputs() const override;
     std::string getOperator() const override;
 
 private:
+    bool compareProperty(const GeometryTileFeature&) const;
+
     std::string op;
     CompareFunctionType compare;
     std::unique_ptr<Expression> lhs;
     std::unique_ptr<Expression> rhs;
     bool needsRuntimeTypeCheck;
+    // Set when comparing ["get", key] with a literal for (in)equality, so that the feature property is
+    // compared with the literal without evaluating either side.
+    std::optional<std::string> propertyKey;
+    std::optional<Value> propertyOperand;
 };
 
 class CollatorComparison : public Expression {
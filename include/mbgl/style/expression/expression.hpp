@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/available_images.hpp>
 #include <mbgl/style/expression/parsing_context.hpp>
 #include <mbgl/style/expression/type.hpp>
 #include <mbgl/style/expression/value.hpp>
@@ -15,6 +16,7 @@
 namespace mbgl {
 
 class GeometryTileFeature;
+class GeometryTileLayer;
 
 namespace style {
 namespace expression {
@@ -58,7 +60,7 @@ public:
         return *this;
     };
 
-    EvaluationContext& withAvailableImages(const std::set<std::string>* availableImages_) noexcept {
+    EvaluationContext& withAvailableImages(const AvailableImages* availableImages_) noexcept {
         availableImages = availableImages_;
         return *this;
     };
@@ -75,7 +77,7 @@ public:
     // Contains formatted section object, std::unordered_map<std::string, Value>.
     const Value* formattedSection = nullptr;
     const FeatureState* featureState = nullptr;
-    const std::set<std::string>* availableImages = nullptr;
+    const AvailableImages* availableImages = nullptr;
     const mbgl::CanonicalTileID* canonical = nullptr;
 };
 
@@ -204,14 +206,23 @@ public:
     EvaluationResult evaluate(std::optional<float> zoom,
                               const Feature& feature,
                               std::optional<double> colorRampParameter,
-                              const std::set<std::string>& availableImages) const;
+                              const AvailableImages& availableImages) const;
     EvaluationResult evaluate(std::optional<float> zoom,
                               const Feature& feature,
                               std::optional<double> colorRampParameter,
-                              const std::set<std::string>& availableImages,
+                              const AvailableImages& availableImages,
                               const CanonicalTileID& canonical) const;
     EvaluationResult evaluate(std::optional<mbgl::Value> accumulated, const Feature& feature) const;
 
+    /**
+     * Evaluates a boolean expression for the features of `layer` at the sorted indices in `selection`,
+     * removing the indices of the features it doesn't evaluate to true for. The features are read one at a
+     * time and evaluated with a copy of `params`, unless the expression can test their properties directly.
+     */
+    virtual void select(const EvaluationContext& params,
+                        const GeometryTileLayer& layer,
+                        std::vector<std::size_t>& selection) const;
+
     /**
      * Statically analyze the expression, attempting to enumerate possible outputs. Returns
      * an array of values plus the sentinel null optional value, used to indicate that the
@@ -3,6 +3,9 @@
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/expression/expression.hpp>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace mbgl {
 namespace style {
@@ -15,6 +18,9 @@ public:
     static ParseResult parse(const mbgl::style::conversion::Convertible& value, ParsingContext& ctx);
 
     EvaluationResult evaluate(const EvaluationContext& params) const override;
+    void select(const EvaluationContext& params,
+                const GeometryTileLayer& layer,
+                std::vector<std::size_t>& selection) const override;
     void eachChild(const std::function<void(const Expression&)>&) const override;
 
     bool operator==(const Expression& e) const override;
@@ -24,8 +30,19 @@ public:
     std::string getOperator() const override;
 
 private:
+    // Returns whether the array contains the feature property, or std::nullopt if the property isn't a scalar.
+    std::optional<bool> searchProperty(const GeometryTileFeature&) const;
+
     std::unique_ptr<Expression> needle;
     std::unique_ptr<Expression> haystack;
+
+    // Set when searching a literal array for ["get", key], so that the feature property is looked up in
+    // sorted copies of the array elements without evaluating either child.
+    std::optional<std::string> propertyKey;
+    std::vector<double> numbers;
+    std::vector<std::string> strings;
+    bool containsTrue = false;
+    bool containsFalse = false;
 };
 
 } // namespace expression
@@ -5,6 +5,8 @@
 #include <mbgl/style/conversion.hpp>
 
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace mbgl {
 namespace style {
@@ -18,11 +20,7 @@ public:
     Match(const type::Type& type_,
           std::unique_ptr<Expression> input_,
           Branches branches_,
-          std::unique_ptr<Expression> otherwise_)
-        : Expression(Kind::Match, type_),
-          input(std::move(input_)),
-          branches(std::move(branches_)),
-          otherwise(std::move(otherwise_)) {}
+          std::unique_ptr<Expression> otherwise_);
 
     EvaluationResult evaluate(const EvaluationContext& params) const override;
 
@@ -39,6 +37,8 @@ private:
     std::unique_ptr<Expression> input;
     Branches branches;
     std::unique_ptr<Expression> otherwise;
+    // Set when the input is ["get", key], so that the feature property is matched without evaluating it.
+    std::optional<std::string> propertyKey;
 };
 
 ParseResult parseMatch(const mbgl::style::conversion::Convertible& value, ParsingContext& ctx);
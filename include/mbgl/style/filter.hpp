@@ -31,6 +31,12 @@ public:
 
     bool operator()(const expression::EvaluationContext& context) const;
 
+    // Returns the indices of the features of `layer` that pass the filter, in ascending order, evaluated
+    // with the zoom and tile of `context`. Equivalent to calling operator() for each feature, but only
+    // reads the properties the filter tests, so rejected features are never decoded any further.
+    std::vector<std::size_t> select(const expression::EvaluationContext& context,
+                                    const GeometryTileLayer& layer) const;
+
     operator bool() const { return expression || legacyFilter; }
 
     friend bool operator==(const Filter& lhs, const Filter& rhs) {
@@ -7,9 +7,13 @@
 #include <mbgl/style/expression/find_zoom_curve.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <functional>
 #include <optional>
 
 namespace mbgl {
+
+class GeometryTileLayer;
+
 namespace style {
 
 class PropertyExpressionBase {
@@ -31,11 +35,20 @@ public:
     bool useIntegerZoom = false;
 
 protected:
+    // Evaluates the expression for the features of `layer` at the indices in `selection`, in order, with the
+    // zoom and tile of `context`, passing each result to `consume`. An expression that only reads a feature
+    // property, such as ["get", key] or ["number", ["get", key]], looks the property up directly.
+    void evaluateFeatures(const expression::EvaluationContext& context,
+                          const GeometryTileLayer& layer,
+                          const std::vector<std::size_t>& selection,
+                          const std::function<void(const expression::EvaluationResult&)>& consume) const;
+
     std::shared_ptr<const expression::Expression> expression;
     variant<std::nullptr_t, const expression::Interpolate*, const expression::Step*> zoomCurve;
     bool isZoomConstant_;
     bool isFeatureConstant_;
     bool isRuntimeConstant_;
+    std::optional<std::string> propertyKey;
 };
 
 template <class T>
@@ -56,6 +69,22 @@ public:
         return defaultValue ? *defaultValue : finalDefaultValue;
     }
 
+    // Evaluates the expression for the features of `layer` at the indices in `selection`, with the zoom
+    // and tile of `context`, and returns the values in the same order.
+    std::vector<T> evaluate(const expression::EvaluationContext& context,
+                            const GeometryTileLayer& layer,
+                            const std::vector<std::size_t>& selection,
+                            T finalDefaultValue = T()) const {
+        std::vector<T> values;
+        values.reserve(selection.size());
+        evaluateFeatures(context, layer, selection, [&](const expression::EvaluationResult& result) {
+            std::optional<T> typed;
+            if (result) typed = expression::fromExpressionValue<T>(*result);
+            values.push_back(typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue);
+        });
+        return values;
+    }
+
     T evaluate(float zoom) const {
         assert(!isZoomConstant());
         assert(isFeatureConstant());
@@ -69,7 +98,7 @@ public:
     }
 
     T evaluate(const GeometryTileFeature& feature,
-               const std::set<std::string>& availableImages,
+               const AvailableImages& availableImages,
                T finalDefaultValue) const {
         return evaluate(expression::EvaluationContext(&feature).withAvailableImages(&availableImages),
                         finalDefaultValue);
@@ -80,7 +109,7 @@ public:
     }
 
     T evaluate(const GeometryTileFeature& feature,
-               const std::set<std::string>& availableImages,
+               const AvailableImages& availableImages,
                const CanonicalTileID& canonical,
                T finalDefaultValue) const {
         return evaluate(expression::EvaluationContext(&feature)
@@ -95,7 +124,7 @@ public:
 
     T evaluate(float zoom,
                const GeometryTileFeature& feature,
-               const std::set<std::string>& availableImages,
+               const AvailableImages& availableImages,
                T finalDefaultValue) const {
         return evaluate(expression::EvaluationContext(zoom, &feature).withAvailableImages(&availableImages),
                         finalDefaultValue);
@@ -103,7 +132,7 @@ public:
 
     T evaluate(float zoom,
                const GeometryTileFeature& feature,
-               const std::set<std::string>& availableImages,
+               const AvailableImages& availableImages,
                const CanonicalTileID& canonical,
                T finalDefaultValue) const {
         return evaluate(expression::EvaluationContext(zoom, &feature)
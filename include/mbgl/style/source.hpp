@@ -105,6 +105,13 @@ public:
     // parent tile may be used.
     void setMaxOverscaleFactorForParentTiles(std::optional<uint8_t> overscaleFactor) noexcept;
     std::optional<uint8_t> getMaxOverscaleFactorForParentTiles() const noexcept;
+
+    // Sets the maximum estimated memory, in bytes, of the tiles this source keeps cached
+    // after they are no longer rendered. Zero means unbounded.
+    //
+    // By default, the `EXPERIMENTAL_TILE_CACHE_MAX_BYTES` platform setting is used.
+    void setTileCacheMaxBytes(std::optional<std::size_t> maxBytes) noexcept;
+    std::optional<std::size_t> getTileCacheMaxBytes() const noexcept;
     void dumpDebugLogs() const;
 
     virtual bool supportsLayerType(const mbgl::style::LayerTypeInfo*) const = 0;
@@ -8,7 +8,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -36,6 +38,20 @@ struct GeoJSONOptions {
 
     static Immutable<GeoJSONOptions> defaultOptions();
 };
+
+/// Changes to the features of a GeoJSON source, see GeoJSONSource::updateGeoJSON().
+/// Features are identified by their id.
+struct GeoJSONDiff {
+    /// Removes all the features before applying the other changes.
+    bool removeAll = false;
+    /// Ids of the features to remove.
+    std::vector<FeatureIdentifier> remove;
+    /// Features to add, replacing the features with the same id.
+    std::vector<GeoJSONFeature> add;
+};
+
+class GeoJSONFeatureStore;
+
 class GeoJSONData {
 public:
     using TileFeatures = mapbox::feature::feature_collection<int16_t>;
@@ -43,16 +59,59 @@ public:
     static std::shared_ptr<GeoJSONData> create(const GeoJSON&,
                                                const Immutable<GeoJSONOptions>& = GeoJSONOptions::defaultOptions(),
                                                std::shared_ptr<Scheduler> scheduler = nullptr);
+    // Takes the features over, so that they can be updated by id without being copied, see applyDiff().
+    static std::shared_ptr<GeoJSONData> create(GeoJSON&&,
+                                               const Immutable<GeoJSONOptions>& = GeoJSONOptions::defaultOptions(),
+                                               std::shared_ptr<Scheduler> scheduler = nullptr);
 
     virtual ~GeoJSONData() = default;
-    virtual void getTile(const CanonicalTileID&, const std::function<void(TileFeatures)>&) = 0;
+    // Generates the features of the given tile, possibly on another thread, and passes them to the
+    // callback on the calling thread. Destroying the returned request cancels the generation, and
+    // the callback is not invoked afterwards.
+    virtual std::unique_ptr<AsyncRequest> getTile(const CanonicalTileID&,
+                                                  const std::function<void(TileFeatures)>&) = 0;
 
     // SuperclusterData
     virtual Features getChildren(std::uint32_t) = 0;
     virtual Features getLeaves(std::uint32_t, std::uint32_t limit, std::uint32_t offset) = 0;
     virtual std::uint8_t getClusterExpansionZoom(std::uint32_t) = 0;
 
+    // Asynchronous variants of the cluster queries above, that do not block the calling thread. The
+    // callback is invoked on the calling thread, unless the returned request is destroyed before, and
+    // receives an empty result for unknown cluster ids. The default implementations answer synchronously
+    // and return nullptr.
+    virtual std::unique_ptr<AsyncRequest> requestChildren(std::uint32_t, std::function<void(Features)>);
+    virtual std::unique_ptr<AsyncRequest> requestLeaves(std::uint32_t,
+                                                        std::uint32_t limit,
+                                                        std::uint32_t offset,
+                                                        std::function<void(Features)>);
+    virtual std::unique_ptr<AsyncRequest> requestClusterExpansionZoom(std::uint32_t,
+                                                                      std::function<void(std::uint8_t)>);
+
+    // Applies the diff to the features, on the scheduler, and passes the updated data to the callback
+    // on the calling thread. The updated data is nullptr if the features cannot be updated by id, i.e.
+    // unless they all have an id and, for unclustered data, were moved into create(). The default
+    // implementation never updates the features.
+    virtual void applyDiff(GeoJSONDiff, std::function<void(std::shared_ptr<GeoJSONData>)>);
+    // Returns the bounds of the features changed since the given data, in world coordinates normalized
+    // to [0, 1], or std::nullopt if they are unknown, e.g. when this data is not an update of `other`.
+    std::optional<std::vector<mapbox::geometry::box<double>>> getChangedBoundsSince(const GeoJSONData& other) const;
+
     virtual std::shared_ptr<Scheduler> getScheduler() { return nullptr; }
+
+protected:
+    GeoJSONData() = default;
+    // Data whose features can be updated by id keeps them in a store shared by all its versions.
+    GeoJSONData(std::shared_ptr<GeoJSONFeatureStore>, std::uint64_t version);
+
+    const std::shared_ptr<GeoJSONFeatureStore> featureStore;
+    const std::uint64_t featureVersion = 0;
+
+private:
+    static std::shared_ptr<GeoJSONData> create(const GeoJSON&,
+                                               std::shared_ptr<const GeoJSON> owned,
+                                               const Immutable<GeoJSONOptions>&,
+                                               std::shared_ptr<Scheduler>);
 };
 
 class GeoJSONSource final : public Source {
@@ -62,7 +121,15 @@ public:
 
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
+    /// Takes the features over, so that they can later be updated with updateGeoJSON().
+    void setGeoJSON(GeoJSON&&);
     void setGeoJSONData(std::shared_ptr<GeoJSONData>);
+    /// Adds, replaces and removes features by id without re-indexing the others, so that only the
+    /// tiles touched by the changed features are reloaded. The features of the source must all have
+    /// an id and, unless the source is clustered, have been loaded from the URL or moved into
+    /// setGeoJSON(). Otherwise, or if the source has no data yet, the diff is ignored and an error
+    /// is logged.
+    void updateGeoJSON(const GeoJSONDiff&);
 
     std::optional<std::string> getURL() const;
     const GeoJSONOptions& getOptions() const;
@@ -83,6 +150,8 @@ private:
     std::optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
     std::shared_ptr<Scheduler> threadPool;
+    // Incremented whenever the data is replaced, so that pending diffs to the previous data are dropped.
+    std::uint64_t dataGeneration = 0;
     mapbox::base::WeakPtrFactory<Source> weakFactory{this};
 };
 
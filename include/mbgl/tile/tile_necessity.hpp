@@ -1,15 +1,20 @@
 #pragma once
 
+#include <cstdint>
+
 namespace mbgl {
 
-// Tiles can have two states: optional or required.
+// Tiles can have three states: optional, prefetch or required.
 // - optional means that only low-cost actions should be taken to obtain the data
 //   (e.g. load from cache, but accept stale data)
+// - prefetch means that the data is likely to be needed soon, e.g. at the destination of a
+//   camera animation, and should be obtained like required data, but at low priority
 // - required means that every effort should be taken to obtain the data (e.g. load
 //   from internet and keep the data fresh if it expires)
-enum class TileNecessity : bool {
-    Optional = false,
-    Required = true,
+enum class TileNecessity : uint8_t {
+    Optional,
+    Prefetch,
+    Required,
 };
 
 } // namespace mbgl
@@ -2,11 +2,17 @@
 
 #include <mbgl/util/image.hpp>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace mbgl {
 namespace util {
 
 PremultipliedImage premultiply(UnassociatedImage&&);
 UnassociatedImage unpremultiply(PremultipliedImage&&);
 
+// Premultiplies `pixels` RGBA pixels in place, e.g. a row of an image while it is being decoded.
+void premultiply(uint8_t* data, std::size_t pixels);
+
 } // namespace util
 } // namespace mbgl
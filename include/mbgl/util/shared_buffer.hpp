@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace mbgl {
+
+// Immutable, reference-counted view of a contiguous range of bytes. The memory is kept alive by an
+// opaque owner, which may be a std::string, a memory-mapped file region or a decompression arena, so
+// that payloads can be handed from file sources to tile parsers without copying.
+//
+// For compatibility with code that expects a std::shared_ptr<const std::string>, the buffer can be
+// dereferenced as a string. Buffers that are not backed by a std::string materialize a copy on first
+// access, which is then shared by all copies of the buffer.
+class SharedBuffer {
+public:
+    SharedBuffer() = default;
+    SharedBuffer(std::nullptr_t) {}
+    SharedBuffer(std::shared_ptr<const std::string>);
+
+    // Accepts anything that converts to a std::shared_ptr<const std::string>, e.g. std::make_shared<std::string>().
+    template <typename T, typename = std::enable_if_t<std::is_convertible_v<T, std::shared_ptr<const std::string>>>>
+    SharedBuffer(T&& string_)
+        : SharedBuffer(std::shared_ptr<const std::string>(std::forward<T>(string_))) {}
+
+    // Wraps `size` bytes at `data`, which must remain valid and unchanged for as long as `owner` is alive.
+    SharedBuffer(const char* data, std::size_t size, std::shared_ptr<const void> owner);
+
+    const char* data() const { return begin; }
+    std::size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    std::string_view view() const { return {begin, length}; }
+
+    // Returns a buffer that shares ownership with this one and covers `count` bytes starting at `offset`.
+    // The range is clamped to the bounds of this buffer.
+    SharedBuffer slice(std::size_t offset, std::size_t count = std::string::npos) const;
+
+    // Returns the contents as a string, without copying if the buffer wraps a whole std::string.
+    std::shared_ptr<const std::string> string() const;
+
+    const std::string& operator*() const { return *string(); }
+    const std::string* operator->() const { return string().get(); }
+    const std::string* get() const { return owner ? string().get() : nullptr; }
+
+    // A default-constructed buffer holds no data, which is distinct from holding zero bytes.
+    explicit operator bool() const { return static_cast<bool>(owner); }
+
+    friend bool operator==(const SharedBuffer& lhs, const SharedBuffer& rhs) {
+        return lhs.owner == rhs.owner && lhs.begin == rhs.begin && lhs.length == rhs.length;
+    }
+    friend bool operator!=(const SharedBuffer& lhs, const SharedBuffer& rhs) { return !(lhs == rhs); }
+    friend bool operator==(const SharedBuffer& lhs, std::nullptr_t) { return !lhs; }
+    friend bool operator!=(const SharedBuffer& lhs, std::nullptr_t) { return static_cast<bool>(lhs); }
+
+private:
+    struct Materialized;
+
+    std::shared_ptr<const void> owner;
+    const char* begin = nullptr;
+    std::size_t length = 0;
+
+    // Set when the buffer covers an entire std::string; otherwise a copy is made on demand.
+    std::shared_ptr<const std::string> whole;
+    std::shared_ptr<Materialized> materialized;
+};
+
+} // namespace mbgl
@@ -122,9 +122,16 @@ FeatureExtensionValue AndroidRendererFrontend::queryFeatureExtensions(
     const std::string& extension,
     const std::string& extensionField,
     const std::optional<std::map<std::string, mbgl::Value>>& args) const {
-    return mapRenderer.actor()
-        .ask(&Renderer::queryFeatureExtensions, sourceID, feature, extension, extensionField, args)
-        .get();
+    // Select the right overloaded method
+    FeatureExtensionValue (Renderer::*fn)(const std::string&,
+                                          const Feature&,
+                                          const std::string&,
+                                          const std::string&,
+                                          const std::optional<std::map<std::string, mbgl::Value>>&)
+        const = &Renderer::queryFeatureExtensions;
+
+    // Waits for the result from the orchestration thread and returns
+    return mapRenderer.actor().ask(fn, sourceID, feature, extension, extensionField, args).get();
 }
 
 } // namespace android
@@ -2,12 +2,20 @@
 
 #include <mbgl/util/string.hpp>
 
+#include <cstddef>
+
 namespace mbgl {
 
 template <typename>
 class ActorRef;
 class FileSourceRequest;
 
-void requestLocalFile(const std::string&, const ActorRef<FileSourceRequest>&);
+// Tiles at least this large are memory-mapped by requestLocalFile(); smaller tiles and other
+// resources are read, since mapping them costs more than copying.
+constexpr std::size_t MIN_MAPPED_TILE_SIZE = 64 * 1024;
+
+// Responds with the contents of the file. Pass isTile for tile requests, which may then be mapped
+// with util::mapFile() and carry its restrictions.
+void requestLocalFile(const std::string&, const ActorRef<FileSourceRequest>&, bool isTile = false);
 
 } // namespace mbgl
@@ -13,6 +13,7 @@
 #include <memory>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -35,6 +36,19 @@ struct IOException;
 struct MapboxTileLimitExceededException : util::Exception {
     MapboxTileLimitExceededException()
         : util::Exception("Mapbox tile limit exceeded") {}
+
+    // When thrown by OfflineDatabase::putRegionResources(), the stored size of each resource of the
+    // batch that was stored before the limit was reached.
+    std::vector<uint64_t> storedSizes;
+};
+
+// Progress of a region download through the tiles of one tileset: the tiles enumerated before the
+// one at `index` within zoom level `z` are done, and `completedTileCount` of them are stored.
+struct OfflineRegionTileCursor {
+    uint8_t z = 0;
+    uint64_t index = 0;
+    uint64_t completedTileCount = 0;
+    uint64_t completedTileSize = 0;
 };
 
 class OfflineDatabase {
@@ -78,18 +92,29 @@ public:
     std::optional<std::pair<Response, uint64_t>> getRegionResource(const Resource&);
     std::optional<int64_t> hasRegionResource(const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
-    void putRegionResources(int64_t regionID, const std::list<std::tuple<Resource, Response>>&, OfflineRegionStatus&);
+    // Returns the stored size of each resource, or the error that kept them from being stored. When the
+    // Mapbox tile limit is reached part way through, the resources before it are still stored and the
+    // thrown MapboxTileLimitExceededException carries their sizes.
+    expected<std::vector<uint64_t>, std::exception_ptr> putRegionResources(
+        int64_t regionID, const std::list<std::tuple<Resource, Response>>&, OfflineRegionStatus&);
 
     expected<OfflineRegionDefinition, std::exception_ptr> getRegionDefinition(int64_t regionID);
     expected<OfflineRegionStatus, std::exception_ptr> getRegionCompletedStatus(int64_t regionID);
 
+    // The tile cursors of a region download, by tile URL template, let an interrupted download resume
+    // without enumerating the tiles it already stored. They are removed when the region is invalidated.
+    std::optional<OfflineRegionTileCursor> getRegionTileCursor(int64_t regionID, const std::string& urlTemplate);
+    void putRegionTileCursor(int64_t regionID, const std::string& urlTemplate, const OfflineRegionTileCursor&);
+    void deleteRegionTileCursors(int64_t regionID);
+
     std::exception_ptr setMaximumAmbientCacheSize(uint64_t);
     void setOfflineMapboxTileCountLimit(uint64_t);
     uint64_t getOfflineMapboxTileCountLimit();
     bool offlineMapboxTileCountLimitExceeded();
     uint64_t getOfflineMapboxTileCount();
     bool exceedsOfflineMapboxTileCountLimit(const Resource&);
-    void markUsedResources(int64_t regionID, const std::list<Resource>&);
+    // Returns whether the resources were marked.
+    bool markUsedResources(int64_t regionID, const std::list<Resource>&);
     std::exception_ptr pack();
     void runPackDatabaseAutomatically(bool autopack_) { autopack = autopack_; }
 
@@ -110,6 +135,8 @@ private:
     void migrateToVersion5();
     void migrateToVersion3();
     void migrateToVersion6();
+    void createTileCursorTable();
+    bool hasTileCursorTable();
     void cleanup();
     bool disabled();
     void vacuum();
@@ -184,6 +211,9 @@ private:
 
     bool autopack = true;
     bool readOnly = false;
+    // The tile cursor table is created on first use, so that the schema version stays the one
+    // sideloaded databases are checked against.
+    bool tileCursorTableCreated = false;
 };
 
 } // namespace mbgl
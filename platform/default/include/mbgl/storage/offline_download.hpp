@@ -8,6 +8,8 @@
 #include <unordered_set>
 #include <memory>
 #include <deque>
+#include <optional>
+#include <vector>
 
 namespace mbgl {
 
@@ -47,7 +49,9 @@ private:
      * While the request is in progress, it is recorded in `requests`. If the download
      * is deactivated, all in progress requests are cancelled.
      */
-    void ensureResource(Resource&&, std::function<void(Response)> = {});
+    void ensureResource(Resource&&,
+                        std::function<void(Response)> = {},
+                        std::function<void(std::optional<uint64_t>)> onDone = {});
 
     void onMapboxTileCountLimitExceeded();
 
@@ -64,9 +68,21 @@ private:
     std::list<Resource> resourcesToBeMarkedAsUsed;
     std::list<std::tuple<Resource, Response>> buffer;
 
+    // Tiles are enumerated lazily, as request slots free up, by one cursor per tileset.
+    struct TileCursor;
+    std::vector<std::unique_ptr<TileCursor>> tileCursors;
+
+    // Called once the resources found in the database are marked as used by the region, and with
+    // the stored size of each resource of `buffer` once it is written.
+    std::list<std::function<void()>> markedCallbacks;
+    std::list<std::function<void(uint64_t)>> bufferCallbacks;
+
     void queueResource(Resource&&);
     void queueTiles(style::SourceType, uint16_t tileSize, const Tileset&);
+    void ensureTile(TileCursor&);
+    bool hasRemainingResources() const;
     void markPendingUsedResources();
+    void saveTileCursors();
 };
 
 } // namespace mbgl
@@ -26,7 +26,7 @@ public:
           resourceOptions(resourceOptions_.clone()),
           clientOptions(clientOptions_.clone()) {}
 
-    void request(const std::string& url, const ActorRef<FileSourceRequest>& req) {
+    void request(const std::string& url, bool isTile, const ActorRef<FileSourceRequest>& req) {
         if (!acceptsURL(url)) {
             Response response;
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other, "Invalid asset URL");
@@ -37,7 +37,7 @@ public:
         // Cut off the protocol and prefix with path.
         const auto path = root + "/" +
                           mbgl::util::percentDecode(url.substr(std::char_traits<char>::length(util::ASSET_PROTOCOL)));
-        requestLocalFile(path, req);
+        requestLocalFile(path, req, isTile);
     }
 
     void setResourceOptions(ResourceOptions options) {
@@ -80,7 +80,7 @@ AssetFileSource::~AssetFileSource() = default;
 std::unique_ptr<AsyncRequest> AssetFileSource::request(const Resource& resource, Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
-    impl->actor().invoke(&Impl::request, resource.url, req->actor());
+    impl->actor().invoke(&Impl::request, resource.url, resource.kind == Resource::Kind::Tile, req->actor());
 
     return req;
 }
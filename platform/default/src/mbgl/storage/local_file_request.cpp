@@ -11,7 +11,7 @@
 
 namespace mbgl {
 
-void requestLocalFile(const std::string& path, const ActorRef<FileSourceRequest>& req) {
+void requestLocalFile(const std::string& path, const ActorRef<FileSourceRequest>& req, bool isTile) {
     Response response;
     struct stat buf;
     int result = stat(path.c_str(), &buf);
@@ -20,6 +20,15 @@ void requestLocalFile(const std::string& path, const ActorRef<FileSourceRequest>
         response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
     } else if (result == -1 && errno == ENOENT) {
         response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
+    } else if (isTile && result == 0 && static_cast<std::size_t>(buf.st_size) >= MIN_MAPPED_TILE_SIZE) {
+        // Tiles on disk are assumed not to change while in use; a truncated mapping raises SIGBUS.
+        auto data = util::mapFile(path);
+        if (!data) {
+            response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other,
+                                                               std::string("Cannot read file ") + path);
+        } else {
+            response.data = std::move(*data);
+        }
     } else {
         auto data = util::readFile(path);
         if (!data) {
@@ -1,5 +1,8 @@
-#include <sstream>
+#include <algorithm>
+#include <deque>
 #include <map>
+#include <sstream>
+#include <thread>
 
 #include <mbgl/platform/settings.hpp>
 #include <mbgl/storage/mbtiles_file_source.hpp>
@@ -14,6 +17,7 @@
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/compression.hpp>
+#include <mbgl/math/clamp.hpp>
 
 #include <mbgl/storage/sqlite3.hpp>
 
@@ -39,10 +43,74 @@ std::string url_to_path(const std::string &url) {
 namespace mbgl {
 using namespace rapidjson;
 
+namespace {
+
+struct TileRequest {
+    TileRequest(const Resource &resource_, ActorRef<FileSourceRequest> req_)
+        : resource(resource_),
+          path(url_to_path(resource.url)),
+          req(std::move(req_)) {
+        path = path.substr(0, path.find('?'));
+    }
+
+    Resource resource;
+    std::string path;
+    ActorRef<FileSourceRequest> req;
+};
+
+// A read-only connection to an archive, with the tile statement prepared once for all requests.
+struct Connection {
+    Connection(const std::string &path, uint64_t mmapSize)
+        : db(mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)),
+          tileStatement(db,
+                        "SELECT tile_data FROM tiles "
+                        "WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3") {
+        if (mmapSize > 0) {
+            db.exec("PRAGMA mmap_size = " + std::to_string(mmapSize));
+        }
+    }
+
+    mapbox::sqlite::Database db;
+    mapbox::sqlite::Statement tileStatement;
+};
+
+std::size_t readerCountSetting() {
+    auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_MBTILES_READER_COUNT);
+    if (auto *count = value.getUint()) {
+        if (*count > 0) return static_cast<std::size_t>(*count);
+    } else if (auto *signedCount = value.getInt()) {
+        if (*signedCount > 0) return static_cast<std::size_t>(*signedCount);
+    }
+    return util::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, 4);
+}
+
+uint64_t mmapSizeSetting() {
+    auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_MBTILES_MMAP_SIZE);
+    if (auto *size = value.getUint()) {
+        return *size;
+    } else if (auto *signedSize = value.getInt()) {
+        return *signedSize > 0 ? static_cast<uint64_t>(*signedSize) : 0;
+    }
+    return 0;
+}
+
+} // namespace
+
+struct MBTilesFileSource::TileQueue {
+    std::mutex mutex;
+    std::deque<TileRequest> requests;
+};
+
 class MBTilesFileSource::Impl {
 public:
-    explicit Impl(const ActorRef<Impl> &, const ResourceOptions &resourceOptions_, const ClientOptions &clientOptions_)
-        : resourceOptions(resourceOptions_.clone()),
+    explicit Impl(const ActorRef<Impl> &,
+                  const ResourceOptions &resourceOptions_,
+                  const ClientOptions &clientOptions_,
+                  std::shared_ptr<TileQueue> tileQueue_,
+                  uint64_t mmapSize_)
+        : tileQueue(std::move(tileQueue_)),
+          mmapSize(mmapSize_),
+          resourceOptions(resourceOptions_.clone()),
           clientOptions(clientOptions_.clone()) {}
 
     std::vector<double> &split(const std::string &s, char delim, std::vector<double> &elems) {
@@ -69,8 +137,6 @@ public:
         return std::string(buffer.GetString(), buffer.GetSize());
     }
 
-    std::string db_path(const std::string &path) { return path.substr(0, path.find('?')); }
-
     bool is_compressed(const std::string &v) { return (((uint8_t)v[0]) == 0x1f) && (((uint8_t)v[1]) == 0x8b); }
 
     // Generate a tilejson resource from .mbtiles file
@@ -181,30 +247,88 @@ public:
         req.invoke(&FileSourceRequest::setResponse, response);
     }
 
-    // Load data for specific tile
-    void request_tile(const Resource &resource, ActorRef<FileSourceRequest> req) {
-        std::string base_path = url_to_path(resource.url);
-        std::string path = db_path(base_path);
-        auto &db = get_db(path);
+    // Load data for the queued tiles. Every request schedules a call, but a call serves up to
+    // maxBatchSize requests, so that most calls find the queue empty during a burst of requests.
+    void request_tiles() {
+        std::vector<TileRequest> batch;
+        {
+            std::lock_guard<std::mutex> lock(tileQueue->mutex);
+            const auto count = std::min(tileQueue->requests.size(), maxBatchSize);
+            batch.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(tileQueue->requests.front()));
+                tileQueue->requests.pop_front();
+            }
+        }
 
-        int iy = resource.tileData->y;
-        int iz = resource.tileData->z;
+        std::stable_sort(batch.begin(), batch.end(), [](const TileRequest &a, const TileRequest &b) {
+            return a.path < b.path;
+        });
+        for (auto begin = batch.begin(); begin != batch.end();) {
+            auto end = std::find_if(begin, batch.end(), [&](const TileRequest &r) { return r.path != begin->path; });
+            read_tiles(begin->path, begin, end);
+            begin = end;
+        }
+    }
 
-        auto x = std::to_string(resource.tileData->x);
-        auto y = std::to_string((int)(pow(2, iz) - 1) - iy);
-        auto z = std::to_string(iz);
+    // Looks up several tiles of the same archive at once, within a single read transaction.
+    void read_tiles(const std::string &path,
+                    std::vector<TileRequest>::iterator begin,
+                    std::vector<TileRequest>::iterator end) {
+        std::vector<Response> responses(static_cast<std::size_t>(end - begin));
+        std::size_t read = 0;
+        bool reopen = false;
+        const auto fail = [](Response &response, const char *message) {
+            response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other, message);
+        };
+        try {
+            auto &connection = get_connection(path);
+            mapbox::sqlite::Transaction transaction(connection.db);
+            // A tile that fails to load, e.g. because it is corrupt, does not fail the others.
+            for (; read < responses.size(); ++read) {
+                try {
+                    responses[read] = read_tile(connection, begin[static_cast<std::ptrdiff_t>(read)].resource);
+                } catch (const mapbox::sqlite::Exception &ex) {
+                    reopen = true;
+                    fail(responses[read], ex.what());
+                } catch (const std::exception &ex) {
+                    fail(responses[read], ex.what());
+                }
+            }
+            transaction.commit();
+        } catch (const std::exception &ex) {
+            // The archive could not be opened: the tiles not read yet fail.
+            reopen = reopen || dynamic_cast<const mapbox::sqlite::Exception *>(&ex);
+            for (; read < responses.size(); ++read) {
+                fail(responses[read], ex.what());
+            }
+        }
+        if (reopen) {
+            // Reopen the archive for the next requests, in case it was replaced.
+            close_db(path);
+        }
+
+        for (auto it = begin; it != end; ++it) {
+            it->req.invoke(&FileSourceRequest::setResponse, responses[static_cast<std::size_t>(it - begin)]);
+        }
+    }
 
-        std::string sql = "SELECT tile_data FROM tiles where zoom_level = " + z + " AND tile_column = " + x +
-                          " AND tile_row = " + y;
-        mapbox::sqlite::Statement stmt(db, sql.c_str());
+    // Load data for specific tile
+    Response read_tile(Connection &connection, const Resource &resource) {
+        const auto &tile = *resource.tileData;
+        mapbox::sqlite::Query query{connection.tileStatement};
+        query.bind(1, static_cast<int64_t>(tile.z));
+        query.bind(2, static_cast<int64_t>(tile.x));
+        // Tile rows follow the TMS scheme, with y pointing north.
+        query.bind(3, (int64_t(1) << tile.z) - 1 - tile.y);
 
         Response response;
         response.noContent = true;
 
-        for (mapbox::sqlite::Query q(stmt); q.run();) {
-            std::optional<std::string> data = q.get<std::optional<std::string>>(0);
+        if (query.run()) {
+            std::optional<std::string> data = query.get<std::optional<std::string>>(0);
             if (data) {
-                response.data = std::make_shared<std::string>(*data);
+                response.data = std::make_shared<std::string>(std::move(*data));
                 response.noContent = false;
                 response.expires = Timestamp::max();
                 response.etag = resource.url;
@@ -214,7 +338,7 @@ public:
                 }
             }
         }
-        req.invoke(&FileSourceRequest::setResponse, response);
+        return response;
     }
 
     void setResourceOptions(ResourceOptions options) {
@@ -238,27 +362,27 @@ public:
     }
 
 private:
-    std::map<std::string, mapbox::sqlite::Database> db_cache;
+    // The tiles served in one transaction at most, so that other readers get a share of a burst.
+    static constexpr std::size_t maxBatchSize = 32;
 
-    void close_db(const std::string &path) {
-        auto ptr = db_cache.find(path);
-        if (ptr != db_cache.end()) {
-            db_cache.erase(path);
-        }
-    }
+    std::shared_ptr<TileQueue> tileQueue;
+    const uint64_t mmapSize;
+
+    // Connections are not shared between readers, so that they never wait on each other.
+    std::map<std::string, std::unique_ptr<Connection>> db_cache;
+
+    void close_db(const std::string &path) { db_cache.erase(path); }
 
     void close_all() { db_cache.clear(); }
 
     // Multiple databases open simultaneoulsy, to effectively support multiple .mbtiles maps
-    mapbox::sqlite::Database &get_db(const std::string &path) {
+    Connection &get_connection(const std::string &path) {
         auto ptr = db_cache.find(path);
         if (ptr != db_cache.end()) {
-            return ptr->second;
-        };
+            return *ptr->second;
+        }
 
-        auto ptr2 = db_cache.insert(std::pair<std::string, mapbox::sqlite::Database>(
-            path, mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)));
-        return ptr2.first->second;
+        return *db_cache.emplace(path, std::make_unique<Connection>(path, mmapSize)).first->second;
     }
 
     mutable std::mutex resourceOptionsMutex;
@@ -268,18 +392,32 @@ private:
 };
 
 MBTilesFileSource::MBTilesFileSource(const ResourceOptions &resourceOptions, const ClientOptions &clientOptions)
-    : thread(std::make_unique<util::Thread<Impl>>(
-          util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_FILE),
-          "MBTilesFileSource",
-          resourceOptions.clone(),
-          clientOptions.clone())) {}
+    : tileQueue(std::make_shared<TileQueue>()) {
+    const std::size_t count = readerCountSetting();
+    const uint64_t mmap = mmapSizeSetting();
+    readers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        readers.push_back(std::make_unique<util::Thread<Impl>>(
+            util::makeThreadPrioritySetter(platform::EXPERIMENTAL_THREAD_PRIORITY_FILE),
+            "MBTilesFileSource",
+            resourceOptions.clone(),
+            clientOptions.clone(),
+            tileQueue,
+            mmap));
+    }
+}
 
 std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource &resource, FileSource::Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
     // assume if there is a tile request, that the mbtiles file has been validated
     if (resource.kind == Resource::Tile) {
-        thread->actor().invoke(&Impl::request_tile, resource, req->actor());
+        {
+            std::lock_guard<std::mutex> lock(tileQueue->mutex);
+            tileQueue->requests.emplace_back(resource, req->actor());
+        }
+        // Any reader may serve the request, the calls are only spread to wake them all up.
+        readers[nextReader++ % readers.size()]->actor().invoke(&Impl::request_tiles);
         return req;
     }
 
@@ -306,7 +444,7 @@ std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource &resourc
     }
 
     // return TileJSON
-    thread->actor().invoke(&Impl::request_tilejson, resource, req->actor());
+    readers.front()->actor().invoke(&Impl::request_tilejson, resource, req->actor());
     return req;
 }
 
@@ -317,19 +455,23 @@ bool MBTilesFileSource::canRequest(const Resource &resource) const {
 MBTilesFileSource::~MBTilesFileSource() = default;
 
 void MBTilesFileSource::setResourceOptions(ResourceOptions options) {
-    thread->actor().invoke(&Impl::setResourceOptions, options.clone());
+    for (auto &reader : readers) {
+        reader->actor().invoke(&Impl::setResourceOptions, options.clone());
+    }
 }
 
 ResourceOptions MBTilesFileSource::getResourceOptions() {
-    return thread->actor().ask(&Impl::getResourceOptions).get();
+    return readers.front()->actor().ask(&Impl::getResourceOptions).get();
 }
 
 void MBTilesFileSource::setClientOptions(ClientOptions options) {
-    thread->actor().invoke(&Impl::setClientOptions, options.clone());
+    for (auto &reader : readers) {
+        reader->actor().invoke(&Impl::setClientOptions, options.clone());
+    }
 }
 
 ClientOptions MBTilesFileSource::getClientOptions() {
-    return thread->actor().ask(&Impl::getClientOptions).get();
+    return readers.front()->actor().ask(&Impl::getClientOptions).get();
 }
 
 } // namespace mbgl
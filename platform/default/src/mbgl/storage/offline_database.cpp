@@ -88,6 +88,7 @@ void OfflineDatabase::cleanup() {
     try {
         statements.clear();
         db.reset();
+        tileCursorTableCreated = false;
     } catch (...) {
         handleError("close database");
     }
@@ -152,6 +153,7 @@ void OfflineDatabase::removeExisting() {
 
     statements.clear();
     db.reset();
+    tileCursorTableCreated = false;
 
     util::deleteFile(path);
 }
@@ -211,6 +213,33 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+void OfflineDatabase::createTileCursorTable() {
+    assert(db);
+    checkFlags();
+
+    if (tileCursorTableCreated) return;
+    db->exec(
+        "CREATE TABLE IF NOT EXISTS region_tile_cursors ("
+        "  region_id INTEGER NOT NULL REFERENCES regions(id) ON DELETE CASCADE,"
+        "  url_template TEXT NOT NULL,"
+        "  z INTEGER NOT NULL,"
+        "  tile_index INTEGER NOT NULL,"
+        "  completed_tile_count INTEGER NOT NULL,"
+        "  completed_tile_size INTEGER NOT NULL,"
+        "  UNIQUE (region_id, url_template)"
+        ")");
+    tileCursorTableCreated = true;
+}
+
+// Unlike createTileCursorTable(), this doesn't write to the database, so that it works in read-only mode.
+bool OfflineDatabase::hasTileCursorTable() {
+    if (tileCursorTableCreated) return true;
+    mapbox::sqlite::Query query{
+        getStatement("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'region_tile_cursors'")};
+    tileCursorTableCreated = query.run();
+    return tileCursorTableCreated;
+}
+
 void OfflineDatabase::vacuum() {
     assert(db);
     checkFlags();
@@ -392,8 +421,8 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const
         response.data = std::make_shared<std::string>(util::decompress(*data));
         size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -566,8 +595,8 @@ std::optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Reso
         response.data = std::make_shared<std::string>(util::decompress(*data));
         size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        response.data = std::make_shared<std::string>(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -798,6 +827,12 @@ std::exception_ptr OfflineDatabase::invalidateRegion(int64_t regionID) try {
 
         resourceQuery.bind(1, regionID);
         resourceQuery.run();
+
+        // The next download of the region revalidates all of its tiles.
+        createTileCursorTable();
+        mapbox::sqlite::Query cursorQuery{getStatement("DELETE FROM region_tile_cursors WHERE region_id = ?")};
+        cursorQuery.bind(1, regionID);
+        cursorQuery.run();
     }
 
     assert(db);
@@ -1002,9 +1037,8 @@ uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& re
     return 0;
 }
 
-void OfflineDatabase::putRegionResources(int64_t regionID,
-                                         const std::list<std::tuple<Resource, Response>>& resources,
-                                         OfflineRegionStatus& status) try {
+expected<std::vector<uint64_t>, std::exception_ptr> OfflineDatabase::putRegionResources(
+    int64_t regionID, const std::list<std::tuple<Resource, Response>>& resources, OfflineRegionStatus& status) try {
     checkFlags();
 
     if (!db) {
@@ -1018,6 +1052,8 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
     uint64_t completedResourceSize = 0;
     uint64_t completedTileCount = 0;
     uint64_t completedTileSize = 0;
+    std::vector<uint64_t> sizes;
+    sizes.reserve(resources.size());
 
     for (const auto& elem : resources) {
         const auto& resource = std::get<0>(elem);
@@ -1025,15 +1061,17 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
 
         try {
             uint64_t resourceSize = putRegionResourceInternal(regionID, resource, response);
+            sizes.push_back(resourceSize);
             completedResourceCount++;
             completedResourceSize += resourceSize;
             if (resource.kind == Resource::Kind::Tile) {
                 completedTileCount += 1;
                 completedTileSize += resourceSize;
             }
-        } catch (const MapboxTileLimitExceededException&) {
+        } catch (MapboxTileLimitExceededException& ex) {
             // Commit the rest of the batch and rethrow
             transaction.commit();
+            ex.storedSizes = std::move(sizes);
             throw;
         }
     }
@@ -1045,8 +1083,10 @@ void OfflineDatabase::putRegionResources(int64_t regionID,
     status.completedResourceSize += completedResourceSize;
     status.completedTileCount += completedTileCount;
     status.completedTileSize += completedTileSize;
+    return sizes;
 } catch (...) {
     handleError("write region resources");
+    return unexpected<std::exception_ptr>(std::current_exception());
 }
 
 uint64_t OfflineDatabase::putRegionResourceInternal(int64_t regionID,
@@ -1178,6 +1218,77 @@ expected<OfflineRegionStatus, std::exception_ptr> OfflineDatabase::getRegionComp
     return unexpected<std::exception_ptr>(std::current_exception());
 }
 
+std::optional<OfflineRegionTileCursor> OfflineDatabase::getRegionTileCursor(int64_t regionID,
+                                                                          const std::string& urlTemplate) try {
+    if (!db) {
+        initialize();
+    }
+    if (!hasTileCursorTable()) {
+        return std::nullopt;
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "SELECT z, tile_index, completed_tile_count, completed_tile_size "
+        "FROM region_tile_cursors "
+        "WHERE region_id = ?1 "
+        "  AND url_template = ?2 ") };
+    // clang-format on
+    query.bind(1, regionID);
+    query.bind(2, urlTemplate);
+    if (!query.run()) {
+        return std::nullopt;
+    }
+
+    OfflineRegionTileCursor cursor;
+    cursor.z = static_cast<uint8_t>(query.get<int64_t>(0));
+    cursor.index = static_cast<uint64_t>(query.get<int64_t>(1));
+    cursor.completedTileCount = static_cast<uint64_t>(query.get<int64_t>(2));
+    cursor.completedTileSize = static_cast<uint64_t>(query.get<int64_t>(3));
+    return cursor;
+} catch (...) {
+    handleError("read region tile cursor");
+    return std::nullopt;
+}
+
+void OfflineDatabase::putRegionTileCursor(int64_t regionID,
+                                          const std::string& urlTemplate,
+                                          const OfflineRegionTileCursor& cursor) try {
+    if (!db) {
+        initialize();
+    }
+    createTileCursorTable();
+
+    // clang-format off
+    mapbox::sqlite::Query query{ getStatement(
+        "REPLACE INTO region_tile_cursors "
+        "       (region_id, url_template, z,  tile_index, completed_tile_count, completed_tile_size) "
+        "VALUES (?1,        ?2,           ?3, ?4,         ?5,                   ?6) ") };
+    // clang-format on
+    query.bind(1, regionID);
+    query.bind(2, urlTemplate);
+    query.bind(3, static_cast<int64_t>(cursor.z));
+    query.bind(4, static_cast<int64_t>(cursor.index));
+    query.bind(5, static_cast<int64_t>(cursor.completedTileCount));
+    query.bind(6, static_cast<int64_t>(cursor.completedTileSize));
+    query.run();
+} catch (...) {
+    handleError("write region tile cursor");
+}
+
+void OfflineDatabase::deleteRegionTileCursors(int64_t regionID) try {
+    if (!db) {
+        initialize();
+    }
+    createTileCursorTable();
+
+    mapbox::sqlite::Query query{getStatement("DELETE FROM region_tile_cursors WHERE region_id = ?")};
+    query.bind(1, regionID);
+    query.run();
+} catch (...) {
+    handleError("delete region tile cursors");
+}
+
 std::pair<int64_t, int64_t> OfflineDatabase::getCompletedResourceCountAndSize(int64_t regionID) {
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
@@ -1420,7 +1531,7 @@ bool OfflineDatabase::exceedsOfflineMapboxTileCountLimit(const Resource& resourc
            offlineMapboxTileCountLimitExceeded();
 }
 
-void OfflineDatabase::markUsedResources(int64_t regionID, const std::list<Resource>& resources) try {
+bool OfflineDatabase::markUsedResources(int64_t regionID, const std::list<Resource>& resources) try {
     if (!db) {
         initialize();
     }
@@ -1429,8 +1540,10 @@ void OfflineDatabase::markUsedResources(int64_t regionID, const std::list<Resour
         markUsed(regionID, resource);
     }
     transaction.commit();
+    return true;
 } catch (...) {
     handleError("mark resources as used");
+    return false;
 }
 
 std::exception_ptr OfflineDatabase::pack() try {
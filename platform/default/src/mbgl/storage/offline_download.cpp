@@ -16,9 +16,12 @@
 #include <mbgl/util/i18n.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tileset.hpp>
 
+#include <algorithm>
+#include <map>
 #include <set>
 
 namespace {
@@ -49,46 +52,129 @@ Range<uint8_t> coveringZoomRange(const RegionDefinition& definition,
     return {static_cast<uint8_t>(minZ), static_cast<uint8_t>(maxZ)};
 }
 
-template <class Geometry, class Fn>
-void tileCover(const Geometry& geometry, uint8_t z, Fn&& fn) {
-    util::TileCover cover(geometry, z);
-    while (cover.hasNext()) {
-        fn(cover.next()->canonical);
-    }
+Range<uint8_t> coveringZoomRange(const OfflineRegionDefinition& definition,
+                                 style::SourceType type,
+                                 uint16_t tileSize,
+                                 const Range<uint8_t>& zoomRange) {
+    return definition.match([&](auto& reg) { return coveringZoomRange(reg, type, tileSize, zoomRange); });
 }
 
-template <class Fn>
-void tileCover(const OfflineRegionDefinition& definition,
-               style::SourceType type,
-               uint16_t tileSize,
-               const Range<uint8_t>& zoomRange,
-               Fn&& fn) {
-    const Range<uint8_t> clampedZoomRange = definition.match(
-        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, zoomRange); });
+std::unique_ptr<util::TileCover> tileCover(const OfflineRegionDefinition& definition, uint8_t z) {
+    return definition.match(
+        [&](const OfflineTilePyramidRegionDefinition& reg) { return std::make_unique<util::TileCover>(reg.bounds, z); },
+        [&](const OfflineGeometryRegionDefinition& reg) { return std::make_unique<util::TileCover>(reg.geometry, z); });
+}
 
-    for (uint8_t z = clampedZoomRange.min; z <= clampedZoomRange.max; z++) {
-        definition.match([&](const OfflineTilePyramidRegionDefinition& reg) { tileCover(reg.bounds, z, fn); },
-                         [&](const OfflineGeometryRegionDefinition& reg) { tileCover(reg.geometry, z, fn); });
-    }
+uint64_t tileCount(const OfflineRegionDefinition& definition, uint8_t z) {
+    return definition.match(
+        [&](const OfflineTilePyramidRegionDefinition& reg) { return util::tileCount(reg.bounds, z); },
+        [&](const OfflineGeometryRegionDefinition& reg) { return util::tileCount(reg.geometry, z); });
 }
 
 uint64_t tileCount(const OfflineRegionDefinition& definition,
                    style::SourceType type,
                    uint16_t tileSize,
                    const Range<uint8_t>& zoomRange) {
-    const Range<uint8_t> clampedZoomRange = definition.match(
-        [&](auto& reg) { return coveringZoomRange(reg, type, tileSize, zoomRange); });
+    const Range<uint8_t> clampedZoomRange = coveringZoomRange(definition, type, tileSize, zoomRange);
 
     uint64_t result{};
     for (uint8_t z = clampedZoomRange.min; z <= clampedZoomRange.max; z++) {
-        result += definition.match(
-            [&](const OfflineTilePyramidRegionDefinition& reg) { return util::tileCount(reg.bounds, z); },
-            [&](const OfflineGeometryRegionDefinition& reg) { return util::tileCount(reg.geometry, z); });
+        result += tileCount(definition, z);
     }
 
     return result;
 }
 
+// OfflineDownload::TileCursor
+
+struct OfflineDownload::TileCursor {
+    // Tiles are identified by their zoom level and their index in the tile cover of that zoom level.
+    using Position = std::pair<uint8_t, uint64_t>;
+
+    TileCursor(const OfflineRegionDefinition& definition_, Tileset tileset_, Range<uint8_t> zoomRange_)
+        : definition(definition_),
+          tileset(std::move(tileset_)),
+          zoomRange(zoomRange_),
+          next(zoomRange.min, 0) {
+        progress.z = zoomRange.min;
+    }
+
+    // Starts after the tiles done in a previous download.
+    void resume(const OfflineRegionTileCursor& saved) {
+        assert(!cover && pending.empty());
+        progress = saved;
+        next = {saved.z, saved.index};
+    }
+
+    // Moves `upcoming` to the tile at `next`, or resets it when all tiles were taken.
+    void advance() {
+        upcoming.reset();
+        while (next.first <= zoomRange.max) {
+            if (!cover) {
+                cover = tileCover(definition, next.first);
+                // When resuming within a zoom level, skip the tiles done without creating their resources.
+                for (uint64_t i = 0; i < next.second && cover->hasNext(); ++i) {
+                    cover->next();
+                }
+            }
+            if (cover->hasNext()) {
+                upcoming = cover->next()->canonical;
+                return;
+            }
+            cover.reset();
+            next = {static_cast<uint8_t>(next.first + 1), 0};
+        }
+    }
+
+    std::pair<Position, CanonicalTileID> take() {
+        assert(upcoming);
+        std::pair<Position, CanonicalTileID> result{next, *upcoming};
+        pending.emplace(next, PendingTile());
+        ++next.second;
+        advance();
+        return result;
+    }
+
+    // Records a tile as done, stored with the given size or skipped, and moves the progress over the
+    // tiles done in order.
+    void done(const Position& position, std::optional<uint64_t> size) {
+        auto it = pending.find(position);
+        assert(it != pending.end());
+        it->second = {true, size};
+
+        while (!pending.empty() && pending.begin()->second.done) {
+            if (const auto& storedSize = pending.begin()->second.size) {
+                progress.completedTileCount++;
+                progress.completedTileSize += *storedSize;
+            }
+            pending.erase(pending.begin());
+            dirty = true;
+        }
+
+        const Position first = pending.empty() ? next : pending.begin()->first;
+        progress.z = first.first;
+        progress.index = first.second;
+    }
+
+    struct PendingTile {
+        bool done = false;
+        std::optional<uint64_t> size;
+    };
+
+    const OfflineRegionDefinition& definition;
+    const Tileset tileset;
+    const Range<uint8_t> zoomRange;
+
+    Position next;
+    std::unique_ptr<util::TileCover> cover;
+    std::optional<CanonicalTileID> upcoming;
+
+    // The tiles taken and not done in order yet. Tiles retried after an error hold back the progress.
+    std::map<Position, PendingTile> pending;
+    OfflineRegionTileCursor progress;
+    bool dirty = false;
+};
+
 // OfflineDownload
 
 OfflineDownload::OfflineDownload(int64_t id_,
@@ -376,11 +462,13 @@ void OfflineDownload::activateDownload() {
    the first few errors is fruitless anyway.
 */
 void OfflineDownload::continueDownload() {
-    if (resourcesRemaining.empty()) {
+    if (!hasRemainingResources()) {
         // Flush pending buffers.
         if (!flushResourcesBuffer()) return;
         if (status.complete()) {
             markPendingUsedResources();
+            // Activating the download again checks all of its resources.
+            offlineDatabase.deleteRegionTileCursors(id);
             setState(OfflineRegionDownloadState::Inactive);
             return;
         }
@@ -394,9 +482,18 @@ void OfflineDownload::continueDownload() {
         maxConcurrentRequests = static_cast<uint32_t>(*maxRequests);
     }
 
-    while (!resourcesRemaining.empty() && requests.size() < maxConcurrentRequests) {
-        ensureResource(std::move(resourcesRemaining.front()));
-        resourcesRemaining.pop_front();
+    while (requests.size() < maxConcurrentRequests) {
+        if (!resourcesRemaining.empty()) {
+            ensureResource(std::move(resourcesRemaining.front()));
+            resourcesRemaining.pop_front();
+            continue;
+        }
+
+        auto cursor = std::find_if(tileCursors.begin(), tileCursors.end(), [](const auto& tileCursor) {
+            return tileCursor->upcoming.has_value();
+        });
+        if (cursor == tileCursors.end()) break;
+        ensureTile(**cursor);
     }
 }
 
@@ -405,19 +502,50 @@ void OfflineDownload::deactivateDownload() {
     resourcesRemaining.clear();
     requests.clear();
     buffer.clear();
+    bufferCallbacks.clear();
+    markedCallbacks.clear();
+    tileCursors.clear();
 }
 
 bool OfflineDownload::flushResourcesBuffer() {
     if (buffer.empty()) return true;
+    std::vector<uint64_t> sizes;
+    bool tileLimitExceeded = false;
     try {
-        offlineDatabase.putRegionResources(id, buffer, status);
-        buffer.clear();
-        observer->statusChanged(status);
-        return true;
-    } catch (const MapboxTileLimitExceededException&) {
+        auto stored = offlineDatabase.putRegionResources(id, buffer, status);
+        if (!stored) {
+            // None of the batch was stored; the tile cursors were not moved past it, so the next
+            // activation downloads it again.
+            observer->responseError(Response::Error(Response::Error::Reason::Other,
+                                                    "Can't store region resources: " + util::toString(stored.error())));
+            setState(OfflineRegionDownloadState::Inactive);
+            return false;
+        }
+        sizes = std::move(*stored);
+    } catch (MapboxTileLimitExceededException& ex) {
+        sizes = std::move(ex.storedSizes);
+        tileLimitExceeded = true;
+    }
+
+    // Resources are stored in order, so the sizes belong to the first resources of the batch. Only
+    // those are done; the others weren't stored and keep their tile cursor from moving past them.
+    auto callback = bufferCallbacks.begin();
+    for (const uint64_t size : sizes) {
+        if (*callback) (*callback)(size);
+        ++callback;
+    }
+    if (!sizes.empty()) {
+        saveTileCursors();
+    }
+    buffer.clear();
+    bufferCallbacks.clear();
+
+    if (tileLimitExceeded) {
         onMapboxTileCountLimitExceeded();
         return false;
     }
+    observer->statusChanged(status);
+    return true;
 }
 
 void OfflineDownload::queueResource(Resource&& resource) {
@@ -431,30 +559,85 @@ void OfflineDownload::queueResource(Resource&& resource) {
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
-    tileCover(definition, type, tileSize, tileset.zoomRange, [&](const auto& tile) {
-        status.requiredResourceCount++;
-        status.requiredTileCount++;
+    const Range<uint8_t> zoomRange = coveringZoomRange(definition, type, tileSize, tileset.zoomRange);
+    const uint64_t tiles = tileCount(definition, type, tileSize, tileset.zoomRange);
+    status.requiredResourceCount += tiles;
+    status.requiredTileCount += tiles;
+
+    auto cursor = std::make_unique<TileCursor>(definition, tileset, zoomRange);
+
+    // Resume after the tiles done by a previous download, counting the ones stored as completed. The
+    // others got an error 404 and are not required anymore, as when they were skipped.
+    std::optional<OfflineRegionTileCursor> saved = offlineDatabase.getRegionTileCursor(id, tileset.tiles[0]);
+    if (saved && saved->z >= zoomRange.min && saved->z <= zoomRange.max + 1) {
+        uint64_t done = saved->index;
+        for (uint8_t z = zoomRange.min; z < saved->z; ++z) {
+            done += tileCount(definition, z);
+        }
+        if (done <= tiles && saved->completedTileCount <= done) {
+            cursor->resume(*saved);
+            status.completedResourceCount += saved->completedTileCount;
+            status.completedResourceSize += saved->completedTileSize;
+            status.completedTileCount += saved->completedTileCount;
+            status.completedTileSize += saved->completedTileSize;
+            status.requiredResourceCount -= done - saved->completedTileCount;
+        }
+    }
+
+    cursor->advance();
+    tileCursors.push_back(std::move(cursor));
+}
 
-        auto tileResource = Resource::tile(tileset.tiles[0],
-                                           definition.match([](auto& def) { return def.pixelRatio; }),
-                                           tile.x,
-                                           tile.y,
-                                           tile.z,
-                                           tileset.scheme);
+void OfflineDownload::ensureTile(TileCursor& cursor) {
+    const auto taken = cursor.take();
+    const TileCursor::Position position = taken.first;
+    const CanonicalTileID& tile = taken.second;
 
-        tileResource.setPriority(Resource::Priority::Low);
-        tileResource.setUsage(Resource::Usage::Offline);
+    auto tileResource = Resource::tile(cursor.tileset.tiles[0],
+                                       definition.match([](auto& def) { return def.pixelRatio; }),
+                                       tile.x,
+                                       tile.y,
+                                       tile.z,
+                                       cursor.tileset.scheme);
 
-        resourcesRemaining.push_back(std::move(tileResource));
+    tileResource.setPriority(Resource::Priority::Low);
+    tileResource.setUsage(Resource::Usage::Offline);
+
+    TileCursor* tileCursor = &cursor;
+    ensureResource(std::move(tileResource), {}, [tileCursor, position](std::optional<uint64_t> size) {
+        tileCursor->done(position, size);
     });
 }
 
+bool OfflineDownload::hasRemainingResources() const {
+    if (!resourcesRemaining.empty()) return true;
+    return std::any_of(
+        tileCursors.begin(), tileCursors.end(), [](const auto& cursor) { return cursor->upcoming.has_value(); });
+}
+
 void OfflineDownload::markPendingUsedResources() {
-    offlineDatabase.markUsedResources(id, resourcesToBeMarkedAsUsed);
+    if (offlineDatabase.markUsedResources(id, resourcesToBeMarkedAsUsed)) {
+        for (const auto& callback : markedCallbacks) {
+            callback();
+        }
+        saveTileCursors();
+    }
     resourcesToBeMarkedAsUsed.clear();
+    markedCallbacks.clear();
 }
 
-void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Response)> callback) {
+void OfflineDownload::saveTileCursors() {
+    for (const auto& cursor : tileCursors) {
+        if (cursor->dirty) {
+            offlineDatabase.putRegionTileCursor(id, cursor->tileset.tiles[0], cursor->progress);
+            cursor->dirty = false;
+        }
+    }
+}
+
+void OfflineDownload::ensureResource(Resource&& resource,
+                                     std::function<void(Response)> callback,
+                                     std::function<void(std::optional<uint64_t>)> onDone) {
     assert(resource.priority == Resource::Priority::Low);
     assert(resource.usage == Resource::Usage::Offline);
 
@@ -474,7 +657,13 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
                 }
             }
 
-            if (result) resourcesToBeMarkedAsUsed.emplace_back(resource);
+            if (result) {
+                resourcesToBeMarkedAsUsed.emplace_back(resource);
+                if (onDone) {
+                    const auto size = static_cast<uint64_t>(*result);
+                    markedCallbacks.emplace_back([onDone, size] { onDone(size); });
+                }
+            }
             return result;
         };
 
@@ -507,6 +696,7 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
                     requests.erase(fileRequestsIt);
                     assert(status.requiredResourceCount > 0);
                     status.requiredResourceCount--;
+                    if (onDone) onDone(std::nullopt);
                     continueDownload();
                 }
                 return;
@@ -520,11 +710,12 @@ void OfflineDownload::ensureResource(Resource&& resource, std::function<void(Res
 
             // Queue up for batched insertion
             buffer.emplace_back(resource, onlineResponse);
+            bufferCallbacks.emplace_back(onDone);
 
             // Flush buffer periodically.
-            // Have to keep `resourcesRemaining.empty()` as the following condition would fail otherwise.
+            // Have to keep `hasRemainingResources()` as the following condition would fail otherwise.
             // TODO: Simplify the tile count limit check code path!
-            if ((buffer.size() == kResourcesBatchSize || resourcesRemaining.empty()) && !flushResourcesBuffer()) return;
+            if ((buffer.size() == kResourcesBatchSize || !hasRemainingResources()) && !flushResourcesBuffer()) return;
 
             if (offlineDatabase.exceedsOfflineMapboxTileCountLimit(resource)) {
                 onMapboxTileCountLimitExceeded();
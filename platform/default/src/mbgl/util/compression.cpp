@@ -6,8 +6,15 @@
 #include <zlib.h>
 #endif
 
+#ifdef MBGL_USE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+#include <algorithm>
+#include <climits>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 #include <stdexcept>
 
 #if defined(__GNUC__)
@@ -37,74 +44,190 @@ namespace util {
 // cause a link error.
 #undef compress
 
-std::string compress(const std::string &raw, int windowBits) {
-    z_stream deflate_stream;
-    memset(&deflate_stream, 0, sizeof(deflate_stream));
+namespace {
 
-    // TODO: reuse z_streams
-    if (deflateInit2(&deflate_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
-        throw std::runtime_error("failed to initialize deflate");
+// Setting up a z_stream allocates its window and state (about 256 KB for deflate), which dominates the
+// cost of decompressing a tile. Each thread keeps one stream of each kind and resets it between calls.
+class InflateStream {
+public:
+    InflateStream() { std::memset(&stream, 0, sizeof(stream)); }
+    ~InflateStream() {
+        if (initialized) {
+            inflateEnd(&stream);
+        }
     }
 
+    z_stream &reset(int windowBits) {
+        if (!initialized) {
+            if (inflateInit2(&stream, windowBits) != Z_OK) {
+                throw std::runtime_error("failed to initialize inflate");
+            }
+            initialized = true;
+        } else if (inflateReset2(&stream, windowBits) != Z_OK) {
+            throw std::runtime_error("failed to reset inflate");
+        }
+        return stream;
+    }
+
+private:
+    z_stream stream;
+    bool initialized = false;
+};
+
+class DeflateStream {
+public:
+    DeflateStream() { std::memset(&stream, 0, sizeof(stream)); }
+    ~DeflateStream() {
+        if (initialized) {
+            deflateEnd(&stream);
+        }
+    }
+
+    z_stream &reset(int windowBits_) {
+        if (initialized && windowBits != windowBits_) {
+            deflateEnd(&stream);
+            initialized = false;
+        }
+        if (!initialized) {
+            if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits_, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                throw std::runtime_error("failed to initialize deflate");
+            }
+            windowBits = windowBits_;
+            initialized = true;
+        } else if (deflateReset(&stream) != Z_OK) {
+            throw std::runtime_error("failed to reset deflate");
+        }
+        return stream;
+    }
+
+private:
+    z_stream stream;
+    int windowBits = 0;
+    bool initialized = false;
+};
+
+bool isGzip(const std::string &raw) {
+    return raw.size() >= 18 && static_cast<uint8_t>(raw[0]) == 0x1f && static_cast<uint8_t>(raw[1]) == 0x8b;
+}
+
+// The initial output buffer never exceeds this; larger outputs grow geometrically while inflating.
+constexpr std::size_t maxInitialSize = 4 * 1024 * 1024;
+
+// Returns the initial size of the output buffer. The gzip trailer records the uncompressed size modulo
+// 2^32; it is only a hint, since it can't be trusted for concatenated, corrupt or hostile streams. It is
+// clamped to a typical tile compression ratio, so that a forged trailer can't make us allocate and zero
+// a large buffer before inflating anything.
+std::size_t estimateDecompressedSize(const std::string &raw) {
+    if (isGzip(raw)) {
+        const auto *trailer = reinterpret_cast<const uint8_t*>(raw.data() + raw.size() - 4);
+        const uint32_t size = uint32_t(trailer[0]) | uint32_t(trailer[1]) << 8 | uint32_t(trailer[2]) << 16 |
+                              uint32_t(trailer[3]) << 24;
+        return std::max<std::size_t>(1, std::min<std::size_t>({size, raw.size() * 8, maxInitialSize}));
+    }
+    return std::max<std::size_t>(1024, std::min(raw.size() * 4, maxInitialSize));
+}
+
+#ifdef MBGL_USE_LIBDEFLATE
+// One-shot decoding with libdeflate, which is considerably faster than zlib's streaming inflate.
+std::string decompressWithLibdeflate(const std::string &raw, int windowBits) {
+    thread_local std::unique_ptr<libdeflate_decompressor, decltype(&libdeflate_free_decompressor)> decompressor(
+        libdeflate_alloc_decompressor(), libdeflate_free_decompressor);
+    if (!decompressor) {
+        throw std::runtime_error("failed to initialize libdeflate");
+    }
+
+    // Mirrors the meaning of zlib's windowBits; libdeflate supports all window sizes.
+    const bool headerless = windowBits < 0;
+    const bool gzip = windowBits > 15 && (windowBits <= 31 || isGzip(raw));
+
+    std::string result(estimateDecompressedSize(raw), '\0');
+    while (true) {
+        std::size_t in = 0;
+        std::size_t out = 0;
+        libdeflate_result code;
+        if (headerless) {
+            code = libdeflate_deflate_decompress_ex(
+                decompressor.get(), raw.data(), raw.size(), result.data(), result.size(), &in, &out);
+        } else if (gzip) {
+            code = libdeflate_gzip_decompress_ex(
+                decompressor.get(), raw.data(), raw.size(), result.data(), result.size(), &in, &out);
+        } else {
+            code = libdeflate_zlib_decompress_ex(
+                decompressor.get(), raw.data(), raw.size(), result.data(), result.size(), &in, &out);
+        }
+
+        if (code == LIBDEFLATE_SUCCESS) {
+            result.resize(out);
+            return result;
+        } else if (code != LIBDEFLATE_INSUFFICIENT_SPACE) {
+            throw std::runtime_error("decompression error");
+        }
+        result.resize(result.size() * 2);
+    }
+}
+#endif
+
+} // namespace
+
+std::string compress(const std::string &raw, int windowBits) {
+    thread_local DeflateStream deflater;
+    z_stream &deflate_stream = deflater.reset(windowBits);
+
     deflate_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
     deflate_stream.avail_in = uInt(raw.size());
 
-    std::string result;
-    char out[16384];
+    // deflateBound() is an upper bound for a single Z_FINISH call, so this normally runs once.
+    std::string result(deflateBound(&deflate_stream, uLong(raw.size())), '\0');
 
     int code;
     do {
-        deflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        deflate_stream.avail_out = sizeof(out);
-        code = deflate(&deflate_stream, Z_FINISH);
-        if (result.size() < deflate_stream.total_out) {
-            // append the block to the output string
-            result.append(out, deflate_stream.total_out - result.size());
+        if (deflate_stream.total_out == result.size()) {
+            result.resize(result.size() * 2);
         }
+        deflate_stream.next_out = reinterpret_cast<Bytef *>(result.data() + deflate_stream.total_out);
+        deflate_stream.avail_out = uInt(std::min<std::size_t>(result.size() - deflate_stream.total_out, UINT_MAX));
+        code = deflate(&deflate_stream, Z_FINISH);
     } while (code == Z_OK);
 
-    deflateEnd(&deflate_stream);
-
     if (code != Z_STREAM_END) {
-        throw std::runtime_error(deflate_stream.msg);
+        throw std::runtime_error(deflate_stream.msg ? deflate_stream.msg : "compression error");
     }
 
+    result.resize(deflate_stream.total_out);
     return result;
 }
 
 std::string decompress(const std::string &raw, int windowBits) {
-    z_stream inflate_stream;
-    memset(&inflate_stream, 0, sizeof(inflate_stream));
-
-    // TODO: reuse z_streams
-    if (inflateInit2(&inflate_stream, windowBits) != Z_OK) {
-        throw std::runtime_error("failed to initialize inflate");
-    }
+#ifdef MBGL_USE_LIBDEFLATE
+    return decompressWithLibdeflate(raw, windowBits);
+#else
+    thread_local InflateStream inflater;
+    z_stream &inflate_stream = inflater.reset(windowBits);
 
     inflate_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(raw.data()));
     inflate_stream.avail_in = uInt(raw.size());
 
-    std::string result;
-    char out[15384];
+    // Inflate straight into the result, growing it geometrically when the estimate was too small.
+    std::string result(estimateDecompressedSize(raw), '\0');
 
     int code;
     do {
-        inflate_stream.next_out = reinterpret_cast<Bytef *>(out);
-        inflate_stream.avail_out = sizeof(out);
-        code = inflate(&inflate_stream, 0);
-        // result.append(out, sizeof(out) - inflate_stream.avail_out);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
+        if (inflate_stream.total_out == result.size()) {
+            result.resize(result.size() * 2);
         }
+        inflate_stream.next_out = reinterpret_cast<Bytef *>(result.data() + inflate_stream.total_out);
+        inflate_stream.avail_out = uInt(std::min<std::size_t>(result.size() - inflate_stream.total_out, UINT_MAX));
+        code = inflate(&inflate_stream, Z_NO_FLUSH);
     } while (code == Z_OK);
 
-    inflateEnd(&inflate_stream);
-
     if (code != Z_STREAM_END) {
         throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
     }
 
+    result.resize(inflate_stream.total_out);
     return result;
+#endif
 }
+
 } // namespace util
 } // namespace mbgl
@@ -94,7 +94,9 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
     int color_type = 0;
     png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
 
-    UnassociatedImage image({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
+    // Opaque images are premultiplied already.
+    const bool hasAlpha = (color_type & PNG_COLOR_MASK_ALPHA) || png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+    PremultipliedImage image({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
 
     if (color_type == PNG_COLOR_TYPE_PALETTE) png_set_expand(png_ptr);
 
@@ -108,7 +110,8 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
 
     png_set_add_alpha(png_ptr, 0xff, PNG_FILLER_AFTER);
 
-    if (png_get_interlace_type(png_ptr, info_ptr) == PNG_INTERLACE_ADAM7) {
+    const bool interlaced = png_get_interlace_type(png_ptr, info_ptr) == PNG_INTERLACE_ADAM7;
+    if (interlaced) {
         png_set_interlace_handling(png_ptr); // FIXME: libpng bug?
         // according to docs png_read_image
         // "..automatically handles interlacing,
@@ -117,15 +120,24 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
 
     png_read_update_info(png_ptr, info_ptr);
 
-    // we can read whole image at once
-    // alloc row pointers
-    const std::unique_ptr<png_bytep[]> rows(new png_bytep[height]);
-    for (unsigned row = 0; row < height; ++row) rows[row] = image.data.get() + row * width * 4;
-    png_read_image(png_ptr, rows.get());
+    if (interlaced) {
+        // Interlaced images are only complete after the last pass, so they are read at once
+        const std::unique_ptr<png_bytep[]> rows(new png_bytep[height]);
+        for (unsigned row = 0; row < height; ++row) rows[row] = image.data.get() + row * width * 4;
+        png_read_image(png_ptr, rows.get());
+        if (hasAlpha) util::premultiply(image.data.get(), image.bytes() / 4);
+    } else {
+        // Premultiply each row while it is still in the cache
+        for (unsigned row = 0; row < height; ++row) {
+            png_bytep rowData = image.data.get() + row * width * 4;
+            png_read_row(png_ptr, rowData, nullptr);
+            if (hasAlpha) util::premultiply(rowData, width);
+        }
+    }
 
     png_read_end(png_ptr, nullptr);
 
-    return util::premultiply(std::move(image));
+    return image;
 }
 
 } // namespace mbgl
@@ -8,19 +8,24 @@
 namespace mbgl {
 
 PremultipliedImage decodeWEBP(const uint8_t* data, size_t size) {
-    int32_t width, height;
-    if (!WebPGetInfo(data, size, &width, &height)) {
+    WebPBitstreamFeatures features;
+    if (WebPGetFeatures(data, size, &features) != VP8_STATUS_OK) {
         Log::Warning(Event::Image, "Failed to decode WebP image header!");
         return {};
     }
 
-    auto img = UnassociatedImage({static_cast<uint32_t>(width), static_cast<uint32_t>(height)});
+    auto img = PremultipliedImage({static_cast<uint32_t>(features.width), static_cast<uint32_t>(features.height)});
     if (!WebPDecodeRGBAInto(data, size, img.data.get(), img.bytes(), static_cast<int32_t>(img.stride()))) {
         Log::Warning(Event::Image, "Failed to decode WebP image contents!");
         return {};
     }
 
-    return util::premultiply(std::move(img));
+    // Opaque images are premultiplied already.
+    if (features.has_alpha) {
+        util::premultiply(img.data.get(), img.bytes() / 4);
+    }
+
+    return img;
 }
 
 } // namespace mbgl
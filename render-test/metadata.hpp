@@ -96,6 +96,17 @@ struct FpsProbe {
     float tolerance = 0.0f;
 };
 
+// Frame times in milliseconds: the first frame rendered by the probe, the sum of all frames until the map is
+// fully rendered, and the first frame after the camera moves. Also records the latency of the symbol placement
+// committed once the map is fully rendered, which spans several frames with a placement time budget.
+struct FrameTimeProbe {
+    float firstFrame = 0.0f;
+    float loaded = 0.0f;
+    float firstInteraction = 0.0f;
+    float placementLatency = 0.0f;
+    float tolerance = 0.0f;
+};
+
 struct NetworkProbe {
     NetworkProbe() = default;
     NetworkProbe(size_t requests_, size_t transferred_)
@@ -132,11 +143,15 @@ struct GfxProbe {
 
 class TestMetrics {
 public:
-    bool isEmpty() const { return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && gfx.empty(); }
+    bool isEmpty() const {
+        return fileSize.empty() && memory.empty() && network.empty() && fps.empty() && frameTime.empty() &&
+               gfx.empty();
+    }
     std::map<std::string, FileSizeProbe> fileSize;
     std::map<std::string, MemoryProbe> memory;
     std::map<std::string, NetworkProbe> network;
     std::map<std::string, FpsProbe> fps;
+    std::map<std::string, FrameTimeProbe> frameTime;
     std::map<std::string, GfxProbe> gfx;
 };
 
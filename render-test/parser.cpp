@@ -260,6 +260,24 @@ std::string serializeMetrics(const TestMetrics& metrics) {
         // End fps section
     }
 
+    if (!metrics.frameTime.empty()) {
+        // Start frame time section
+        writer.Key("frameTime");
+        writer.StartArray();
+        for (const auto& frameTimeProbe : metrics.frameTime) {
+            assert(!frameTimeProbe.first.empty());
+            writer.StartArray();
+            writer.String(frameTimeProbe.first.c_str());
+            writer.Double(frameTimeProbe.second.firstFrame);
+            writer.Double(frameTimeProbe.second.loaded);
+            writer.Double(frameTimeProbe.second.firstInteraction);
+            writer.Double(frameTimeProbe.second.placementLatency);
+            writer.EndArray();
+        }
+        writer.EndArray();
+        // End frame time section
+    }
+
     if (!metrics.gfx.empty()) {
         // Start gfx section
         writer.Key("gfx");
@@ -411,6 +429,29 @@ TestMetrics readExpectedMetrics(const mbgl::filesystem::path& path) {
         }
     }
 
+    if (document.HasMember("frameTime")) {
+        const mbgl::JSValue& frameTimeValue = document["frameTime"];
+        assert(frameTimeValue.IsArray());
+        for (auto& probeValue : frameTimeValue.GetArray()) {
+            assert(probeValue.IsArray());
+            assert(probeValue.Size() >= 6u);
+            assert(probeValue[0].IsString());
+            assert(probeValue[1].IsNumber()); // First frame
+            assert(probeValue[2].IsNumber()); // Loaded
+            assert(probeValue[3].IsNumber()); // First interaction
+            assert(probeValue[4].IsNumber()); // Placement latency
+            assert(probeValue[5].IsNumber()); // Tolerance
+            const std::string mark{probeValue[0].GetString(), probeValue[0].GetStringLength()};
+            assert(!mark.empty());
+            result.frameTime.insert({std::move(mark),
+                                     {probeValue[1].GetFloat(),
+                                      probeValue[2].GetFloat(),
+                                      probeValue[3].GetFloat(),
+                                      probeValue[4].GetFloat(),
+                                      probeValue[5].GetFloat()}});
+        }
+    }
+
     if (document.HasMember("gfx")) {
         const mbgl::JSValue& gfxValue = document["gfx"];
         assert(gfxValue.IsArray());
@@ -638,6 +679,7 @@ const std::string setFeatureStateOp("setFeatureState");
 const std::string getFeatureStateOp("getFeatureState");
 const std::string removeFeatureStateOp("removeFeatureState");
 const std::string panGestureOp("panGesture");
+const std::string frameTimeProbeOp("probeFrameTime");
 const std::string gfxProbeOp("probeGFX");
 const std::string gfxProbeStartOp("probeGFXStart");
 const std::string gfxProbeEndOp("probeGFXEnd");
@@ -1259,6 +1301,46 @@ TestOperations parseTestOperations(TestMetadata& metadata) {
                 ctx.getMetadata().metrics.fps.insert({mark, {averageFps, minOnePcFps, 0.0f}});
                 return true;
             });
+        } else if (operationArray[0].GetString() == frameTimeProbeOp) {
+            // probeFrameTime
+            assert(operationArray.Size() >= 2u);
+            assert(operationArray[1].IsString());
+
+            if (metadata.mapMode != mbgl::MapMode::Continuous) {
+                metadata.errorMessage = "Map mode must be Continous for " + frameTimeProbeOp + " operation";
+                return {};
+            }
+
+            std::string mark = std::string(operationArray[1].GetString(), operationArray[1].GetStringLength());
+            result.emplace_back([mark](TestContext& ctx) {
+                auto& map = ctx.getMap();
+                auto& observer = ctx.getObserver();
+                auto& frontend = ctx.getFrontend();
+                FrameTimeProbe probe;
+
+                observer.reset();
+                frontend.renderOnce(map);
+                probe.firstFrame = static_cast<float>(frontend.getFrameTime() * 1000.0);
+                probe.loaded = probe.firstFrame;
+                while (!observer.finishRenderingMap) {
+                    frontend.renderOnce(map);
+                    probe.loaded += static_cast<float>(frontend.getFrameTime() * 1000.0);
+                }
+
+                if (observer.mapLoadFailure) return false;
+                probe.placementLatency = static_cast<float>(
+                    std::chrono::duration<double, std::milli>(frontend.getRenderer()->getPlacementLatency()).count());
+
+                // Panning by a quarter of the viewport brings features into view that may need shader variants
+                // nothing on screen has used so far.
+                const mbgl::Size size = frontend.getSize();
+                map.moveBy({size.width / 4.0, size.height / 4.0});
+                frontend.renderOnce(map);
+                probe.firstInteraction = static_cast<float>(frontend.getFrameTime() * 1000.0);
+
+                ctx.getMetadata().metrics.frameTime.insert({mark, probe});
+                return true;
+            });
         } else if (operationArray[0].GetString() == gfxProbeStartOp) {
             // probeGFXStart
             result.emplace_back([](TestContext& ctx) {
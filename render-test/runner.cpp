@@ -456,6 +456,32 @@ void TestRunner::checkProbingResults(TestMetadata& resultMetadata) {
             metadata.errorMessage += metadata.errorMessage.empty() ? ss.str() : "\n" + ss.str();
         }
     };
+    // Check frame time metrics
+    auto checkFrameTime = [](TestMetadata& metadata) {
+        if (metadata.metrics.frameTime.empty()) return;
+        for (const auto& expected : metadata.expectedMetrics.frameTime) {
+            auto actual = metadata.metrics.frameTime.find(expected.first);
+            if (actual == metadata.metrics.frameTime.end()) {
+                metadata.errorMessage = "Failed to find frame time probe: " + expected.first;
+                metadata.metricsErrored++;
+                return;
+            }
+            std::stringstream ss;
+            const auto check = [&](const char* name, float expectedValue, float actualValue) {
+                if (!std::get<bool>(checkValue(expectedValue, actualValue, expected.second.tolerance))) {
+                    ss << name << " at probe \"" << expected.first << "\" is " << actualValue
+                       << "ms, expected to be " << expectedValue << "ms with tolerance of "
+                       << expected.second.tolerance;
+                    metadata.metricsFailed++;
+                }
+            };
+            check("First frame time", expected.second.firstFrame, actual->second.firstFrame);
+            check("Loaded frame time", expected.second.loaded, actual->second.loaded);
+            check("First interaction frame time", expected.second.firstInteraction, actual->second.firstInteraction);
+            check("Placement latency", expected.second.placementLatency, actual->second.placementLatency);
+            metadata.errorMessage += metadata.errorMessage.empty() ? ss.str() : "\n" + ss.str();
+        }
+    };
     // Check gfx metrics
     auto checkGfx = [](TestMetadata& metadata) {
         if (metadata.metrics.gfx.empty()) return;
@@ -532,6 +558,7 @@ void TestRunner::checkProbingResults(TestMetadata& resultMetadata) {
     checkMemory(resultMetadata);
     checkNetwork(resultMetadata);
     checkFps(resultMetadata);
+    checkFrameTime(resultMetadata);
     checkGfx(resultMetadata);
 
     if (resultMetadata.ignoredTest) {
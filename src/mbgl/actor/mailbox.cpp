@@ -6,89 +6,172 @@
 
 namespace mbgl {
 
-Mailbox::Mailbox() = default;
+namespace {
+
+class StubMessage final : public Message {
+public:
+    void operator()() override { assert(false); }
+};
+
+} // namespace
+
+Mailbox::Mailbox()
+    : stub(std::make_unique<StubMessage>()),
+      head(stub.get()),
+      tail(stub.get()) {}
 
 Mailbox::Mailbox(Scheduler& scheduler_)
-    : weakScheduler(scheduler_.makeWeakPtr()) {}
+    : Mailbox() {
+    weakScheduler = scheduler_.makeWeakPtr();
+}
+
+Mailbox::~Mailbox() {
+    // No other thread can push at this point, so the queue is consistent.
+    while (dequeue()) {
+    }
+}
 
 void Mailbox::open(Scheduler& scheduler_) {
     assert(!weakScheduler);
 
-    // As with close(), block until neither receive() nor push() are in progress, and acquire the two
-    // mutexes in the same order.
+    // As with close(), block until receive() is not in progress.
     std::lock_guard<std::recursive_mutex> receivingLock(receivingMutex);
-    std::lock_guard<std::mutex> pushingLock(pushingMutex);
 
-    weakScheduler = scheduler_.makeWeakPtr();
+    {
+        std::lock_guard<std::mutex> schedulingLock(schedulingMutex);
+        weakScheduler = scheduler_.makeWeakPtr();
+    }
 
     if (closed) {
         return;
     }
 
-    if (!queue.empty()) {
-        auto guard = weakScheduler.lock();
-        if (weakScheduler) weakScheduler->schedule(makeClosure(shared_from_this()));
+    if (pending > 0) {
+        scheduleReceive();
     }
 }
 
 void Mailbox::close() {
-    // Block until neither receive() nor push() are in progress. Two mutexes are used because receive()
-    // must not block send(). Of the two, the receiving mutex must be acquired first, because that is
-    // the order that an actor will obtain them when it self-sends a message, and consistent lock
-    // acquisition order prevents deadlocks.
-    // The receiving mutex is recursive to allow a mailbox (and thus the actor) to close itself.
+    // Block until neither receive() nor push() are in progress. receive() holds the receiving mutex for
+    // as long as it processes messages. push() doesn't lock, so wait for the pushes that started before
+    // `closed` was set; later ones see it and return immediately.
     std::lock_guard<std::recursive_mutex> receivingLock(receivingMutex);
-    std::lock_guard<std::mutex> pushingLock(pushingMutex);
 
     closed = true;
+    std::unique_lock<std::mutex> pushingLock(pushingMutex);
+    pushed.wait(pushingLock, [this] { return pushing == 0; });
 }
 
 bool Mailbox::isOpen() const {
     return bool(weakScheduler);
 }
 
-void Mailbox::push(std::unique_ptr<Message> message) {
-    std::lock_guard<std::mutex> pushingLock(pushingMutex);
+void Mailbox::setPriority(TaskPriority priority_) {
+    priority = priority_;
+}
 
+void Mailbox::push(std::unique_ptr<Message> message) {
+    // Both `pushing` and `closed` are sequentially consistent, so that either close() waits for this
+    // push, or this push sees that the mailbox is closed.
+    ++pushing;
     if (closed) {
+        endPush();
         return;
     }
 
-    std::lock_guard<std::mutex> queueLock(queueMutex);
-    bool wasEmpty = queue.empty();
-    queue.push(std::move(message));
-    auto guard = weakScheduler.lock();
-    if (wasEmpty && weakScheduler) {
-        weakScheduler->schedule(makeClosure(shared_from_this()));
+    ++pending;
+    enqueue(message.release());
+    scheduleReceive();
+
+    endPush();
+}
+
+void Mailbox::endPush() {
+    // The last push sees `closed` if close() may be waiting, as `closed` is set before close() reads
+    // `pushing`. Notifying under the lock keeps the wakeup from falling between that read and the wait.
+    if (--pushing == 0 && closed) {
+        std::lock_guard<std::mutex> pushingLock(pushingMutex);
+        pushed.notify_all();
     }
 }
 
 void Mailbox::receive() {
     std::lock_guard<std::recursive_mutex> receivingLock(receivingMutex);
 
-    auto guard = weakScheduler.lock();
-    assert(weakScheduler);
+    {
+        auto guard = weakScheduler.lock();
+        assert(weakScheduler);
+
+        for (std::size_t i = 0; i < maxBatchSize && !closed; ++i) {
+            std::unique_ptr<Message> message = dequeue();
+            if (!message) {
+                // Either empty, or a push() has not linked its message yet and will be picked up below.
+                break;
+            }
+            --pending;
+            (*message)();
+        }
+    }
 
     if (closed) {
         return;
     }
 
-    std::unique_ptr<Message> message;
-    bool wasEmpty;
+    // Allow push() to schedule again before checking for messages that it may have missed.
+    scheduled = false;
+    if (pending > 0) {
+        scheduleReceive();
+    }
+}
 
-    {
-        std::lock_guard<std::mutex> queueLock(queueMutex);
-        assert(!queue.empty());
-        message = std::move(queue.front());
-        queue.pop();
-        wasEmpty = queue.empty();
+void Mailbox::scheduleReceive() {
+    if (scheduled.exchange(true)) {
+        return;
     }
 
-    (*message)();
+    std::lock_guard<std::mutex> schedulingLock(schedulingMutex);
+    auto guard = weakScheduler.lock();
+    if (weakScheduler) {
+        weakScheduler->scheduleWithPriority(priority, makeClosure(shared_from_this()));
+    } else {
+        // A holding mailbox; open() schedules the queued messages.
+        scheduled = false;
+    }
+}
+
+void Mailbox::enqueue(Message* message) {
+    message->next.store(nullptr, std::memory_order_relaxed);
+    Message* previous = head.exchange(message, std::memory_order_acq_rel);
+    previous->next.store(message, std::memory_order_release);
+}
 
-    if (!wasEmpty) {
-        weakScheduler->schedule(makeClosure(shared_from_this()));
+std::unique_ptr<Message> Mailbox::dequeue() {
+    Message* first = tail;
+    Message* next = first->next.load(std::memory_order_acquire);
+    if (first == stub.get()) {
+        if (!next) {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        tail = next;
+        return std::unique_ptr<Message>(first);
+    }
+    if (first != head.load(std::memory_order_acquire)) {
+        // A producer has swapped `head` but not linked its message yet.
+        return nullptr;
+    }
+    // `first` is the last message; put the stub behind it so that it can be unlinked.
+    enqueue(stub.get());
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return std::unique_ptr<Message>(first);
     }
+    return nullptr;
 }
 
 // static
@@ -14,6 +14,8 @@
 
 #include <boost/iterator/function_output_iterator.hpp>
 
+#include <algorithm>
+
 // Note: LayerManager::annotationsEnabled is defined
 // at compile time, so that linker (with LTO on) is able
 // to optimize out the unreachable code.
@@ -36,6 +38,24 @@ const std::string AnnotationManager::SourceID = "com.mapbox.annotations";
 const std::string AnnotationManager::PointLayerID = "com.mapbox.annotations.points";
 const std::string AnnotationManager::ShapeLayerID = "com.mapbox.annotations.shape.";
 
+namespace {
+
+// Past this many changed areas, further changes are merged into the last one.
+const std::size_t maxDirtyBounds = 64;
+
+std::string shapeLayerID(AnnotationID key) {
+    return AnnotationManager::ShapeLayerID + util::toString(key);
+}
+
+// GeoJSONVT copies shapes crossing the antimeridian into the neighbouring worlds; shifting bounds by whole worlds
+// finds those copies.
+ShapeAnnotationBounds shiftWorlds(const ShapeAnnotationBounds& bounds, double worlds) {
+    return {{bounds.min_corner().get<0>() + worlds, bounds.min_corner().get<1>()},
+            {bounds.max_corner().get<0>() + worlds, bounds.max_corner().get<1>()}};
+}
+
+} // namespace
+
 AnnotationManager::AnnotationManager(Style& style_)
     : style(style_){};
 
@@ -78,18 +98,35 @@ void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& anno
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
     symbolAnnotations.emplace(id, impl);
+    markDirty(projectShapeAnnotationBounds(annotation.geometry, annotation.geometry));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation) {
-    ShapeAnnotationImpl& impl =
-        *shapeAnnotations.emplace(id, std::make_unique<LineAnnotationImpl>(id, annotation)).first->second;
-    impl.updateStyle(*style.get().impl);
+    addShape(std::make_unique<LineAnnotationImpl>(id, annotation));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation) {
-    ShapeAnnotationImpl& impl =
-        *shapeAnnotations.emplace(id, std::make_unique<FillAnnotationImpl>(id, annotation)).first->second;
-    impl.updateStyle(*style.get().impl);
+    addShape(std::make_unique<FillAnnotationImpl>(id, annotation));
+}
+
+void AnnotationManager::addShape(std::unique_ptr<ShapeAnnotationImpl> shape) {
+    ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(shape->id, std::move(shape)).first->second;
+    insertShapeBounds(impl);
+
+    // A new shape has the highest AnnotationID, so it is drawn above all others: in the topmost layer if the styles
+    // match, otherwise in a new layer above it.
+    if (!shapeLayers.empty()) {
+        auto top = std::prev(shapeLayers.end());
+        if (shapeAnnotations.at(*top->second.begin())->hasSameStyle(impl)) {
+            top->second.insert(impl.id);
+            impl.layerID = shapeLayerID(top->first);
+            return;
+        }
+    }
+
+    shapeLayers.emplace(impl.id, std::set<AnnotationID>{impl.id});
+    impl.layerID = shapeLayerID(impl.id);
+    impl.updateStyle(*style.get().impl, PointLayerID);
 }
 
 void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation) {
@@ -110,37 +147,121 @@ void AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& a
 }
 
 void AnnotationManager::update(const AnnotationID& id, const LineAnnotation& annotation) {
-    auto it = shapeAnnotations.find(id);
+    updateShape(std::make_unique<LineAnnotationImpl>(id, annotation));
+}
+
+void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& annotation) {
+    updateShape(std::make_unique<FillAnnotationImpl>(id, annotation));
+}
+
+void AnnotationManager::updateShape(std::unique_ptr<ShapeAnnotationImpl> shape) {
+    auto it = shapeAnnotations.find(shape->id);
     if (it == shapeAnnotations.end()) {
         assert(false); // Attempt to update a non-existent shape annotation
         return;
     }
 
-    shapeAnnotations.erase(it);
-    add(id, annotation);
+    removeShapeBounds(*it->second);
+    const bool restyled = !it->second->hasSameStyle(*shape);
+    shape->layerID = it->second->layerID;
+    it->second = std::move(shape);
+    insertShapeBounds(*it->second);
+
+    if (restyled) {
+        restyleShape(*it->second);
+    }
     dirty = true;
 }
 
-void AnnotationManager::update(const AnnotationID& id, const FillAnnotation& annotation) {
-    auto it = shapeAnnotations.find(id);
-    if (it == shapeAnnotations.end()) {
-        assert(false); // Attempt to update a non-existent shape annotation
-        return;
+// Moves a shape whose style changed out of the layer it shares with other shapes. The shapes below it keep the
+// layer, and those above it move to a new layer with the old style, so that the drawing order stays the same.
+void AnnotationManager::restyleShape(ShapeAnnotationImpl& shape) {
+    Style::Impl& styleImpl = *style.get().impl;
+    auto layer = std::prev(shapeLayers.upper_bound(shape.id));
+    auto next = std::next(layer);
+    std::string beforeLayerID = next == shapeLayers.end() ? PointLayerID : shapeLayerID(next->first);
+
+    std::set<AnnotationID>& below = layer->second;
+    std::set<AnnotationID> above(below.upper_bound(shape.id), below.end());
+    below.erase(below.lower_bound(shape.id), below.end());
+
+    if (!above.empty()) {
+        const AnnotationID key = *above.begin();
+        for (const AnnotationID& id : above) {
+            ShapeAnnotationImpl& moved = *shapeAnnotations.at(id);
+            moved.layerID = shapeLayerID(key);
+            if (auto bounds = moved.bounds()) {
+                markDirty(*bounds);
+            }
+        }
+        shapeAnnotations.at(key)->updateStyle(styleImpl, beforeLayerID);
+        shapeLayers.emplace(key, std::move(above));
+        beforeLayerID = shapeLayerID(key);
     }
 
-    shapeAnnotations.erase(it);
-    add(id, annotation);
+    if (below.empty()) {
+        // The shape is the lowest one left in its layer. Recreate the layer, as the shape may have turned from a line
+        // into a fill or back.
+        below.insert(shape.id);
+        (void)styleImpl.removeLayer(shape.layerID);
+    } else {
+        shapeLayers.emplace(shape.id, std::set<AnnotationID>{shape.id});
+        shape.layerID = shapeLayerID(shape.id);
+    }
+    shape.updateStyle(styleImpl, beforeLayerID);
+}
+
+void AnnotationManager::insertShapeBounds(ShapeAnnotationImpl& shape) {
+    if (auto bounds = shape.bounds()) {
+        shapeTree.insert({*bounds, &shape});
+        markDirty(*bounds);
+    }
+}
+
+void AnnotationManager::removeShapeBounds(ShapeAnnotationImpl& shape) {
+    if (auto bounds = shape.bounds()) {
+        shapeTree.remove({*bounds, &shape});
+        markDirty(*bounds);
+    }
+}
+
+void AnnotationManager::markDirty(const ShapeAnnotationBounds& bounds) {
     dirty = true;
+    if (dirtyBounds.size() < maxDirtyBounds) {
+        dirtyBounds.push_back(bounds);
+    } else {
+        boost::geometry::expand(dirtyBounds.back(), bounds);
+    }
+}
+
+bool AnnotationManager::isDirty(const CanonicalTileID& tileID) const {
+    const ShapeAnnotationBounds tileBounds = ShapeAnnotationImpl::tileBounds(tileID);
+    for (const auto& bounds : dirtyBounds) {
+        for (double worlds : {-1.0, 0.0, 1.0}) {
+            if (boost::geometry::intersects(tileBounds, shiftWorlds(bounds, worlds))) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 void AnnotationManager::remove(const AnnotationID& id) {
     CHECK_ANNOTATIONS_ENABLED_AND_RETURN_NOARG();
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
+        const Point<double>& geometry = symbolAnnotations.at(id)->annotation.geometry;
+        markDirty(projectShapeAnnotationBounds(geometry, geometry));
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
         auto it = shapeAnnotations.find(id);
-        (void)*style.get().impl->removeLayer(it->second->layerID);
+        removeShapeBounds(*it->second);
+        auto layer = std::prev(shapeLayers.upper_bound(id));
+        layer->second.erase(id);
+        if (layer->second.empty()) {
+            (void)*style.get().impl->removeLayer(it->second->layerID);
+            shapeLayers.erase(layer);
+        }
         shapeAnnotations.erase(it);
     } else {
         assert(false); // Should never happen
@@ -166,8 +287,17 @@ std::unique_ptr<AnnotationTileData> AnnotationManager::getTileData(const Canonic
         boost::geometry::index::intersects(tileBounds),
         boost::make_function_output_iterator([&](const auto& val) { val->updateLayer(tileID, *pointLayer); }));
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateTileData(tileID, *tileData);
+    std::vector<ShapeAnnotationImpl*> shapes;
+    const ShapeAnnotationBounds shapeTileBounds = ShapeAnnotationImpl::tileBounds(tileID);
+    for (double worlds : {-1.0, 0.0, 1.0}) {
+        shapeTree.query(boost::geometry::index::intersects(shiftWorlds(shapeTileBounds, worlds)),
+                        boost::make_function_output_iterator([&](const auto& val) { shapes.push_back(val.second); }));
+    }
+    // Shapes sharing a layer are drawn in the order their features are added, which must be by AnnotationID.
+    std::sort(shapes.begin(), shapes.end(), [](const auto* a, const auto* b) { return a->id < b->id; });
+    shapes.erase(std::unique(shapes.begin(), shapes.end()), shapes.end());
+    for (auto* shape : shapes) {
+        shape->updateTileData(tileID, *tileData);
     }
 
     return tileData;
@@ -193,8 +323,8 @@ void AnnotationManager::updateStyle() {
 
     std::lock_guard<std::mutex> lock(mutex);
 
-    for (const auto& shape : shapeAnnotations) {
-        shape.second->updateStyle(*style.get().impl);
+    for (const auto& layer : shapeLayers) {
+        shapeAnnotations.at(*layer.second.begin())->updateStyle(*style.get().impl, PointLayerID);
     }
 
     for (const auto& image : images) {
@@ -213,9 +343,12 @@ void AnnotationManager::updateData() {
     std::lock_guard<std::mutex> lock(mutex);
     if (dirty) {
         for (auto& tile : tiles) {
-            tile->setData(getTileData(tile->id.canonical));
+            if (isDirty(tile->id.canonical)) {
+                tile->setData(getTileData(tile->id.canonical));
+            }
         }
         dirty = false;
+        dirtyBounds.clear();
     }
 }
 
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/annotation/shape_annotation_impl.hpp>
 #include <mbgl/annotation/symbol_annotation_impl.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/util/noncopyable.hpp>
 
+#include <map>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -19,7 +22,6 @@ class LatLngBounds;
 class AnnotationTile;
 class AnnotationTileData;
 class SymbolAnnotationImpl;
-class ShapeAnnotationImpl;
 
 namespace style {
 class Style;
@@ -63,6 +65,15 @@ private:
 
     void remove(const AnnotationID&);
 
+    void addShape(std::unique_ptr<ShapeAnnotationImpl>);
+    void updateShape(std::unique_ptr<ShapeAnnotationImpl>);
+    void restyleShape(ShapeAnnotationImpl&);
+
+    void insertShapeBounds(ShapeAnnotationImpl&);
+    void removeShapeBounds(ShapeAnnotationImpl&);
+    void markDirty(const ShapeAnnotationBounds&);
+    bool isDirty(const CanonicalTileID&) const;
+
     void updateStyle();
 
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
@@ -71,7 +82,9 @@ private:
 
     std::mutex mutex;
 
+    // Set when any annotation changed. Only tiles touching one of dirtyBounds are rebuilt by updateData().
     bool dirty = false;
+    std::vector<ShapeAnnotationBounds> dirtyBounds;
 
     AnnotationID nextID = 0;
 
@@ -81,11 +94,18 @@ private:
     // below newer annotations. <https://github.com/mapbox/mapbox-gl-native/issues/5691>
     using SymbolAnnotationMap = std::map<AnnotationID, std::shared_ptr<SymbolAnnotationImpl>>;
     using ShapeAnnotationMap = std::map<AnnotationID, std::unique_ptr<ShapeAnnotationImpl>>;
+    using ShapeAnnotationTree = boost::geometry::index::rtree<std::pair<ShapeAnnotationBounds, ShapeAnnotationImpl*>,
+                                                              boost::geometry::index::rstar<16, 4>>;
+    // Consecutive shapes with the same style share a style layer. Each entry holds the shapes of one layer, keyed by
+    // the lowest AnnotationID the layer was created for, so that the layers keep the order of their shapes.
+    using ShapeLayerMap = std::map<AnnotationID, std::set<AnnotationID>>;
     using ImageMap = std::unordered_map<std::string, style::Image>;
 
     SymbolAnnotationTree symbolTree;
     SymbolAnnotationMap symbolAnnotations;
     ShapeAnnotationMap shapeAnnotations;
+    ShapeAnnotationTree shapeTree;
+    ShapeLayerMap shapeLayers;
     ImageMap images;
 
     std::unordered_set<AnnotationTile*> tiles;
@@ -14,13 +14,13 @@ FillAnnotationImpl::FillAnnotationImpl(AnnotationID id_, FillAnnotation annotati
                  annotation_.color,
                  annotation_.outlineColor) {}
 
-void FillAnnotationImpl::updateStyle(Style::Impl& style) const {
+void FillAnnotationImpl::updateStyle(Style::Impl& style, const std::string& beforeLayerID) const {
     Layer* layer = style.getLayer(layerID);
 
     if (!layer) {
         auto newLayer = std::make_unique<FillLayer>(layerID, AnnotationManager::SourceID);
         newLayer->setSourceLayer(layerID);
-        layer = style.addLayer(std::move(newLayer), AnnotationManager::PointLayerID);
+        layer = style.addLayer(std::move(newLayer), beforeLayerID);
     }
 
     auto* fillLayer = static_cast<FillLayer*>(layer);
@@ -33,4 +33,13 @@ const ShapeAnnotationGeometry& FillAnnotationImpl::geometry() const {
     return annotation.geometry;
 }
 
+bool FillAnnotationImpl::hasSameStyle(const ShapeAnnotationImpl& other) const {
+    return other.hasStyle(annotation);
+}
+
+bool FillAnnotationImpl::hasStyle(const FillAnnotation& other) const {
+    return other.opacity == annotation.opacity && other.color == annotation.color &&
+           other.outlineColor == annotation.outlineColor;
+}
+
 } // namespace mbgl
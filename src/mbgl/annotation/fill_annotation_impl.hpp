@@ -9,9 +9,13 @@ class FillAnnotationImpl : public ShapeAnnotationImpl {
 public:
     FillAnnotationImpl(AnnotationID, FillAnnotation);
 
-    void updateStyle(style::Style::Impl&) const final;
+    void updateStyle(style::Style::Impl&, const std::string& beforeLayerID) const final;
     const ShapeAnnotationGeometry& geometry() const final;
 
+    bool hasSameStyle(const ShapeAnnotationImpl&) const final;
+    using ShapeAnnotationImpl::hasStyle;
+    bool hasStyle(const FillAnnotation&) const final;
+
 private:
     const FillAnnotation annotation;
 };
@@ -14,14 +14,14 @@ LineAnnotationImpl::LineAnnotationImpl(AnnotationID id_, LineAnnotation annotati
                  annotation_.width,
                  annotation_.color) {}
 
-void LineAnnotationImpl::updateStyle(Style::Impl& style) const {
+void LineAnnotationImpl::updateStyle(Style::Impl& style, const std::string& beforeLayerID) const {
     Layer* layer = style.getLayer(layerID);
 
     if (!layer) {
         auto newLayer = std::make_unique<LineLayer>(layerID, AnnotationManager::SourceID);
         newLayer->setSourceLayer(layerID);
         newLayer->setLineJoin(LineJoinType::Round);
-        layer = style.addLayer(std::move(newLayer), AnnotationManager::PointLayerID);
+        layer = style.addLayer(std::move(newLayer), beforeLayerID);
     }
 
     auto* lineLayer = static_cast<LineLayer*>(layer);
@@ -34,4 +34,12 @@ const ShapeAnnotationGeometry& LineAnnotationImpl::geometry() const {
     return annotation.geometry;
 }
 
+bool LineAnnotationImpl::hasSameStyle(const ShapeAnnotationImpl& other) const {
+    return other.hasStyle(annotation);
+}
+
+bool LineAnnotationImpl::hasStyle(const LineAnnotation& other) const {
+    return other.opacity == annotation.opacity && other.width == annotation.width && other.color == annotation.color;
+}
+
 } // namespace mbgl
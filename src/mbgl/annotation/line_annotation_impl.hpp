@@ -9,9 +9,13 @@ class LineAnnotationImpl : public ShapeAnnotationImpl {
 public:
     LineAnnotationImpl(AnnotationID, LineAnnotation);
 
-    void updateStyle(style::Style::Impl&) const final;
+    void updateStyle(style::Style::Impl&, const std::string& beforeLayerID) const final;
     const ShapeAnnotationGeometry& geometry() const final;
 
+    bool hasSameStyle(const ShapeAnnotationImpl&) const final;
+    using ShapeAnnotationImpl::hasStyle;
+    bool hasStyle(const LineAnnotation&) const final;
+
 private:
     const LineAnnotation annotation;
 };
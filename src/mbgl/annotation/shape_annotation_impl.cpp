@@ -8,10 +8,37 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+// Buffer around each tile, in tile extent units.
+const uint16_t tileBuffer = 255;
+
+// The projection GeoJSONVT applies to its input coordinates.
+double projectX(double longitude) {
+    return longitude / 360.0 + 0.5;
+}
+
+double projectY(double latitude) {
+    const double sine = std::sin(latitude * M_PI / 180.0);
+    const double y = 0.5 - 0.25 * std::log((1 + sine) / (1 - sine)) / M_PI;
+    return util::clamp(y, 0.0, 1.0);
+}
+
+} // namespace
+
+ShapeAnnotationBounds projectShapeAnnotationBounds(const Point<double>& southwest, const Point<double>& northeast) {
+    // Projected y grows towards the south.
+    return {{projectX(southwest.x), projectY(northeast.y)}, {projectX(northeast.x), projectY(southwest.y)}};
+}
+
 ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_)
     : id(id_),
       layerID(AnnotationManager::ShapeLayerID + util::toString(id)) {}
@@ -27,7 +54,7 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
         // The annotation source is currently hard coded to maxzoom 16, so we're topping out at z16
         // here as well.
         options.maxZoom = 16;
-        options.buffer = 255u;
+        options.buffer = tileBuffer;
         options.extent = util::EXTENT;
         options.tolerance = baseTolerance;
         shapeTiler = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(features, options);
@@ -55,4 +82,30 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
     }
 }
 
+std::optional<ShapeAnnotationBounds> ShapeAnnotationImpl::bounds() const {
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = std::numeric_limits<double>::infinity();
+    double maxX = -std::numeric_limits<double>::infinity();
+    double maxY = -std::numeric_limits<double>::infinity();
+    ShapeAnnotationGeometry::visit(geometry(), [&](const auto& geom) {
+        mapbox::geometry::for_each_point(geom, [&](const Point<double>& point) {
+            minX = std::min(minX, point.x);
+            minY = std::min(minY, point.y);
+            maxX = std::max(maxX, point.x);
+            maxY = std::max(maxY, point.y);
+        });
+    });
+    if (minX > maxX || !std::isfinite(minY) || !std::isfinite(maxY)) {
+        return std::nullopt;
+    }
+    return projectShapeAnnotationBounds({minX, minY}, {maxX, maxY});
+}
+
+ShapeAnnotationBounds ShapeAnnotationImpl::tileBounds(const CanonicalTileID& tileID) {
+    const double tiles = std::pow(2.0, tileID.z);
+    const double buffer = static_cast<double>(tileBuffer) / util::EXTENT;
+    return {{(tileID.x - buffer) / tiles, (tileID.y - buffer) / tiles},
+            {(tileID.x + 1 + buffer) / tiles, (tileID.y + 1 + buffer) / tiles}};
+}
+
 } // namespace mbgl
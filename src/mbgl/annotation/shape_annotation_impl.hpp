@@ -7,6 +7,10 @@
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/style/style.hpp>
 
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point.hpp>
+
+#include <optional>
 #include <string>
 #include <memory>
 
@@ -15,18 +19,38 @@ namespace mbgl {
 class AnnotationTileData;
 class CanonicalTileID;
 
+// A box in the projected coordinates GeoJSONVT tiles shapes in, where the world spans [0, 1] on both axes.
+using ShapeAnnotationBounds =
+    boost::geometry::model::box<boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>>;
+
+// Projects the box between two longitude, latitude points.
+ShapeAnnotationBounds projectShapeAnnotationBounds(const Point<double> &southwest, const Point<double> &northeast);
+
 class ShapeAnnotationImpl {
 public:
     ShapeAnnotationImpl(AnnotationID);
     virtual ~ShapeAnnotationImpl() = default;
 
-    virtual void updateStyle(style::Style::Impl &) const = 0;
+    // Adds or updates the style layer named layerID, placing a new layer below beforeLayerID.
+    virtual void updateStyle(style::Style::Impl &, const std::string &beforeLayerID) const = 0;
     virtual const ShapeAnnotationGeometry &geometry() const = 0;
 
+    // Whether both shapes can be drawn by the same style layer.
+    virtual bool hasSameStyle(const ShapeAnnotationImpl &) const = 0;
+    virtual bool hasStyle(const LineAnnotation &) const { return false; }
+    virtual bool hasStyle(const FillAnnotation &) const { return false; }
+
     void updateTileData(const CanonicalTileID &, AnnotationTileData &);
 
+    // The area covered by the shape, or nothing if it has no coordinates.
+    std::optional<ShapeAnnotationBounds> bounds() const;
+
+    // The area a tile takes shape geometry from, including the buffer GeoJSONVT keeps around it.
+    static ShapeAnnotationBounds tileBounds(const CanonicalTileID &);
+
     const AnnotationID id;
-    const std::string layerID;
+    // The style layer and source layer the shape is drawn with. Shapes with the same style may share one.
+    std::string layerID;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
 };
 
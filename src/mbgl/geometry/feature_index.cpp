@@ -53,6 +53,13 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
     }
 }
 
+std::size_t FeatureIndex::getMemoryUsage() const {
+    // Each grid element is stored once, plus a cell reference for every cell it covers. The tile data
+    // holds the decoded layers, which are shared with the layout and kept as long as the index.
+    return grid.size() * (sizeof(std::pair<IndexedSubfeature, GridIndex<IndexedSubfeature>::BBox>) + sizeof(size_t)) +
+           (tileData ? tileData->getMemoryUsage() : 0);
+}
+
 void FeatureIndex::query(std::unordered_map<std::string, std::vector<Feature>>& result,
                          const GeometryCoordinates& queryGeometry,
                          const TransformState& transformState,
@@ -100,6 +100,9 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketLeaderID, const std::vector<std::string>& layerIDs);
 
+    // Returns an estimate of the memory held by the index in bytes.
+    std::size_t getMemoryUsage() const;
+
     std::unordered_map<std::string, std::vector<Feature>> lookupSymbolFeatures(
         const std::vector<IndexedSubfeature>& symbolFeatures,
         const RenderedQueryOptions& options,
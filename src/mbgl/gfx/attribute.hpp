@@ -313,6 +313,13 @@ public:
     AttributeBindings(Args&&... args)
         : Base(std::forward<Args>(args)...) {}
 
+    // Marks every attribute as bound, without referring to a vertex buffer. Such bindings can't be drawn with,
+    // but select the same program variant as the bindings of an actual vertex buffer.
+    static AttributeBindings placeholder() {
+        const std::optional<AttributeBinding> binding = AttributeBinding{};
+        return {ExpandToType<As, std::optional<AttributeBinding>>(binding)...};
+    }
+
     AttributeBindings offset(const std::size_t vertexOffset) const {
         return {offsetAttributeBinding(Base::template get<As>(), vertexOffset)...};
     }
@@ -19,12 +19,15 @@ class OffscreenTexture;
 
 class Context {
 protected:
-    Context(uint32_t maximumVertexBindingCount_)
-        : maximumVertexBindingCount(maximumVertexBindingCount_) {}
+    Context(uint32_t maximumVertexBindingCount_, uint32_t maximumTextureSize_)
+        : maximumVertexBindingCount(maximumVertexBindingCount_),
+          maximumTextureSize(maximumTextureSize_) {}
 
 public:
     static constexpr const uint32_t minimumRequiredVertexBindingCount = 8;
     const uint32_t maximumVertexBindingCount;
+    // Largest width and height of a texture.
+    const uint32_t maximumTextureSize;
     bool supportsHalfFloatTextures = false;
 
 public:
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <cassert>
+#include <cstdint>
 
 namespace mbgl {
 namespace gfx {
@@ -20,6 +21,8 @@ public:
         : elements(elements_),
           resource(std::move(resource_)) {}
 
+    std::size_t bytes() const { return elements * sizeof(uint16_t); }
+
     std::size_t elements;
 
     template <typename T = IndexBufferResource>
@@ -38,6 +38,10 @@ public:
     using UniformList = typename Name::UniformList;
     using TextureList = typename Name::TextureList;
 
+    // Builds the variant of the program that draw() would use for these bindings, so that it is ready before
+    // the first draw. Only the presence of each binding matters, so they don't need to refer to vertex buffers.
+    virtual void prewarm(Context&, const AttributeBindings<AttributeList>&) = 0;
+
     virtual void draw(Context&,
                       RenderPass&,
                       const DrawMode&,
@@ -36,7 +36,18 @@ public:
     template <class Vertex>
     void updateVertexBuffer(VertexBuffer<Vertex>& buffer, VertexVector<Vertex>&& v) {
         assert(v.elements() == buffer.elements);
-        updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes());
+        updateVertexBufferResource(buffer.getResource(), v.data(), v.bytes(), 0);
+    }
+
+    // Updates `count` vertices of the buffer, starting at `first`, from the same range of `v`.
+    template <class Vertex>
+    void updateVertexBuffer(VertexBuffer<Vertex>& buffer,
+                            const VertexVector<Vertex>& v,
+                            std::size_t first,
+                            std::size_t count) {
+        assert(v.elements() == buffer.elements && first + count <= buffer.elements);
+        updateVertexBufferResource(
+            buffer.getResource(), v.data() + first, count * sizeof(Vertex), first * sizeof(Vertex));
     }
 
     template <class DrawMode>
@@ -55,7 +66,10 @@ protected:
     virtual std::unique_ptr<VertexBufferResource> createVertexBufferResource(const void* data,
                                                                              std::size_t size,
                                                                              BufferUsageType) = 0;
-    virtual void updateVertexBufferResource(VertexBufferResource&, const void* data, std::size_t size) = 0;
+    virtual void updateVertexBufferResource(VertexBufferResource&,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) = 0;
 
     virtual std::unique_ptr<IndexBufferResource> createIndexBufferResource(const void* data,
                                                                            std::size_t size,
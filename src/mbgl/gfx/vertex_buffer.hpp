@@ -16,13 +16,15 @@ public:
 
 // This class has a template argument that we use to specify the vertex type. It is not used by
 // the implementation, but serves type checking purposes during build time.
-template <class>
+template <class V>
 class VertexBuffer {
 public:
     VertexBuffer(const std::size_t elements_, std::unique_ptr<VertexBufferResource>&& resource_)
         : elements(elements_),
           resource(std::move(resource_)) {}
 
+    std::size_t bytes() const { return elements * sizeof(V); }
+
     std::size_t elements;
 
     template <typename T = VertexBufferResource>
@@ -8,11 +8,13 @@
 #include <mbgl/gl/offscreen_texture.hpp>
 #include <mbgl/gl/command_encoder.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
+#include <mbgl/gl/program_binary_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <iterator>
 
@@ -31,6 +33,7 @@ static_assert(std::is_same_v<TextureID, GLuint>, "OpenGL type mismatch");
 static_assert(std::is_same_v<VertexArrayID, GLuint>, "OpenGL type mismatch");
 static_assert(std::is_same_v<FramebufferID, GLuint>, "OpenGL type mismatch");
 static_assert(std::is_same_v<RenderbufferID, GLuint>, "OpenGL type mismatch");
+static_assert(std::is_same_v<BinaryProgramFormat, GLenum>, "OpenGL type mismatch");
 
 static_assert(underlying_type(UniformDataType::Float) == GL_FLOAT, "OpenGL type mismatch");
 static_assert(underlying_type(UniformDataType::FloatVec2) == GL_FLOAT_VEC2, "OpenGL type mismatch");
@@ -51,11 +54,17 @@ static_assert(underlying_type(UniformDataType::Sampler2D) == GL_SAMPLER_2D, "Ope
 static_assert(underlying_type(UniformDataType::SamplerCube) == GL_SAMPLER_CUBE, "OpenGL type mismatch");
 
 Context::Context(RendererBackend& backend_)
-    : gfx::Context([] {
-          GLint value;
-          MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &value));
-          return value;
-      }()),
+    : gfx::Context(
+          [] {
+              GLint value;
+              MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &value));
+              return value;
+          }(),
+          [] {
+              GLint value;
+              MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &value));
+              return value;
+          }()),
       backend(backend_),
       stats() {}
 
@@ -103,6 +112,27 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
             vertexArray = std::make_unique<extension::VertexArray>(fn);
         }
 
+        // Some drivers expose the extension but support no binary formats at all.
+        if (strstr(extensions, "_get_program_binary") != nullptr) {
+            GLint binaryFormats = 0;
+            MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats));
+            if (binaryFormats > 0) {
+                std::vector<GLint> formats(static_cast<std::size_t>(binaryFormats));
+                MBGL_CHECK_ERROR(glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data()));
+                for (const GLint format : formats) {
+                    programBinaryFormats.push_back(static_cast<BinaryProgramFormat>(format));
+                }
+                programBinary = std::make_unique<extension::ProgramBinary>(fn);
+            }
+        }
+
+        for (const GLenum stringName : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+            if (const auto* value = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(stringName)))) {
+                driverInfo += value;
+            }
+            driverInfo += '\n';
+        }
+
 #if MBGL_USE_GLES2
         constexpr const char* halfFloatExtensionName = "OES_texture_half_float";
         constexpr const char* halfFloatColorBufferExtensionName = "EXT_color_buffer_half_float";
@@ -163,9 +193,18 @@ UniqueShader Context::createShader(ShaderType type, const std::initializer_list<
     throw std::runtime_error("shader failed to compile");
 }
 
-UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName) {
+UniqueProgram Context::createProgram(ShaderID vertexShader,
+                                     ShaderID fragmentShader,
+                                     const char* location0AttribName,
+                                     bool retrievable) {
     UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
 
+    // Without the hint, desktop drivers may not keep the binary that getBinaryProgram() returns. OpenGL ES
+    // has no such hint: binaries are always retrievable there.
+    if (retrievable && programBinary && programBinary->programParameteri) {
+        MBGL_CHECK_ERROR(programBinary->programParameteri(result, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     MBGL_CHECK_ERROR(glAttachShader(result, vertexShader));
     MBGL_CHECK_ERROR(glAttachShader(result, fragmentShader));
 
@@ -180,6 +219,53 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     return result;
 }
 
+std::optional<UniqueProgram> Context::createProgram(BinaryProgramFormat binaryFormat,
+                                                    const std::string& binaryProgram) {
+    assert(supportsProgramBinaries());
+    // Loading a binary of a format the driver does not support is an error, rather than a failed link.
+    if (std::find(programBinaryFormats.begin(), programBinaryFormats.end(), binaryFormat) ==
+        programBinaryFormats.end()) {
+        return std::nullopt;
+    }
+
+    UniqueProgram result{MBGL_CHECK_ERROR(glCreateProgram()), {this}};
+    MBGL_CHECK_ERROR(programBinary->programBinary(
+        result, binaryFormat, binaryProgram.data(), static_cast<GLsizei>(binaryProgram.size())));
+
+    GLint status = GL_FALSE;
+    MBGL_CHECK_ERROR(glGetProgramiv(result, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        return std::nullopt;
+    }
+    return {std::move(result)};
+}
+
+std::optional<std::pair<BinaryProgramFormat, std::string>> Context::getBinaryProgram(ProgramID program_) const {
+    if (!supportsProgramBinaries()) {
+        return std::nullopt;
+    }
+
+    GLint binaryLength = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+    if (binaryLength <= 0) {
+        return std::nullopt;
+    }
+
+    std::string binary(static_cast<std::size_t>(binaryLength), '\0');
+    GLenum binaryFormat = 0;
+    GLsizei length = 0;
+    MBGL_CHECK_ERROR(programBinary->getProgramBinary(program_, binaryLength, &length, &binaryFormat, binary.data()));
+    if (length <= 0) {
+        return std::nullopt;
+    }
+    binary.resize(static_cast<std::size_t>(length));
+    return {{binaryFormat, std::move(binary)}};
+}
+
+bool Context::supportsProgramBinaries() const {
+    return programBinary && programBinary->getProgramBinary && programBinary->programBinary;
+}
+
 void Context::linkProgram(ProgramID program_) {
     MBGL_CHECK_ERROR(glLinkProgram(program_));
     verifyProgramLinkage(program_);
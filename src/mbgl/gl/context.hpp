@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <array>
 #include <string>
@@ -31,6 +32,7 @@ class RendererBackend;
 namespace extension {
 class VertexArray;
 class Debugging;
+class ProgramBinary;
 } // namespace extension
 
 class Context final : public gfx::Context {
@@ -50,7 +52,17 @@ public:
     void enableDebugging();
 
     UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources);
-    UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
+    // The binary of a retrievable program can be saved with getBinaryProgram().
+    UniqueProgram createProgram(ShaderID vertexShader,
+                                ShaderID fragmentShader,
+                                const char* location0AttribName,
+                                bool retrievable = false);
+    // Returns an empty value if the driver rejects the binary, e.g. because it was updated since the binary was saved.
+    std::optional<UniqueProgram> createProgram(BinaryProgramFormat binaryFormat, const std::string& binaryProgram);
+    std::optional<std::pair<BinaryProgramFormat, std::string>> getBinaryProgram(ProgramID) const;
+    bool supportsProgramBinaries() const;
+    // Vendor, renderer and version strings of the driver, which identify the programs it can load back.
+    const std::string& getDriverInfo() const { return driverInfo; }
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
     UniqueTexture createUniqueTexture();
@@ -121,6 +133,9 @@ private:
     gfx::RenderingStats stats;
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
+    std::unique_ptr<extension::ProgramBinary> programBinary;
+    std::vector<BinaryProgramFormat> programBinaryFormats;
+    std::string driverInfo;
 
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
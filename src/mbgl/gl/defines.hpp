@@ -100,6 +100,7 @@
 #define GL_LINE_WIDTH 0x0B21
 #define GL_LINK_STATUS 0x8B82
 #define GL_LUMINANCE 0x1909
+#define GL_MAX_TEXTURE_SIZE 0x0D33
 #define GL_MAX_VERTEX_ATTRIBS 0x8869
 #define GL_NEAREST 0x2600
 #define GL_NEAREST_MIPMAP_NEAREST 0x2700
@@ -107,6 +108,7 @@
 #define GL_NEVER 0x0200
 #define GL_NO_ERROR 0
 #define GL_NOTEQUAL 0x0205
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
 #define GL_ONE 1
 #define GL_ONE_MINUS_CONSTANT_ALPHA 0x8004
 #define GL_ONE_MINUS_CONSTANT_COLOR 0x8002
@@ -117,6 +119,9 @@
 #define GL_OUT_OF_MEMORY 0x0505
 #define GL_PACK_ALIGNMENT 0x0D05
 #define GL_POINTS 0x0000
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
 #define GL_RENDERBUFFER 0x8D41
 #define GL_RENDERBUFFER_BINDING 0x8CA7
 #define GL_RENDERER 0x1F01
@@ -161,6 +166,8 @@
 #define GL_UNSIGNED_BYTE 0x1401
 #define GL_UNSIGNED_INT 0x1405
 #define GL_UNSIGNED_SHORT 0x1403
+#define GL_VENDOR 0x1F00
+#define GL_VERSION 0x1F02
 #define GL_VERTEX_SHADER 0x8B31
 #define GL_VIEWPORT 0x0BA2
 #define GL_ZERO 0
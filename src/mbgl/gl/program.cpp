@@ -0,0 +1,53 @@
+#include <mbgl/gl/program.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace mbgl {
+namespace gl {
+
+// Cached programs are stored as the binary format, followed by the binary as returned by the driver.
+
+std::optional<UniqueProgram> loadCachedProgram(Context& context, const std::string& path) {
+    const auto data = util::readFile(path);
+    if (!data || data->size() <= sizeof(BinaryProgramFormat)) {
+        return std::nullopt;
+    }
+
+    BinaryProgramFormat binaryFormat;
+    std::memcpy(&binaryFormat, data->data(), sizeof(binaryFormat));
+    try {
+        return context.createProgram(binaryFormat, data->substr(sizeof(binaryFormat)));
+    } catch (const std::runtime_error& e) {
+        Log::Warning(Event::OpenGL, std::string("Discarding cached program: ") + e.what());
+        return std::nullopt;
+    }
+}
+
+void cacheProgram(Context& context, ProgramID program, const std::string& path) {
+    try {
+        auto binary = context.getBinaryProgram(program);
+        if (!binary) {
+            return;
+        }
+
+        std::string data(sizeof(BinaryProgramFormat), '\0');
+        std::memcpy(data.data(), &binary->first, sizeof(binary->first));
+        data += binary->second;
+
+        // Other processes may be loading the same program, so they must never see a partially written file.
+        const std::string temporaryPath = path + ".tmp";
+        util::write_file(temporaryPath, data);
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            util::deleteFile(temporaryPath);
+        }
+    } catch (const std::exception& e) {
+        Log::Warning(Event::OpenGL, std::string("Failed to cache program: ") + e.what());
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -18,11 +18,18 @@
 #include <mbgl/programs/program_parameters.hpp>
 #include <mbgl/shaders/shader_manifest.hpp>
 
+#include <optional>
 #include <string>
 
 namespace mbgl {
 namespace gl {
 
+// Loads a program saved by cacheProgram(). Returns an empty value if there is none, or if the driver rejects it.
+std::optional<UniqueProgram> loadCachedProgram(Context&, const std::string& path);
+
+// Saves the binary of a linked program. Failures are logged, since the program can always be compiled again.
+void cacheProgram(Context&, ProgramID, const std::string& path);
+
 template <class Name>
 class Program final : public gfx::Program<Name> {
 public:
@@ -37,12 +44,8 @@ public:
 
     class Instance {
     public:
-        Instance(Context& context,
-                 const std::initializer_list<const char*>& vertexSource,
-                 const std::initializer_list<const char*>& fragmentSource)
-            : program(context.createProgram(context.createShader(ShaderType::Vertex, vertexSource),
-                                            context.createShader(ShaderType::Fragment, fragmentSource),
-                                            attributeLocations.getFirstAttribName())) {
+        Instance(UniqueProgram&& program_)
+            : program(std::move(program_)) {
             attributeLocations.queryLocations(program);
             uniformStates.queryLocations(program);
             // Texture units are specified via uniforms as well, so we need query their locations
@@ -52,20 +55,45 @@ public:
         static std::unique_ptr<Instance> createInstance(gl::Context& context,
                                                         const ProgramParameters& programParameters,
                                                         const std::string& additionalDefines) {
+            const std::string& defines = programParameters.getDefines();
+            const std::string& vertexSource = programParameters.vertexSource(gfx::Backend::Type::OpenGL);
+            const std::string& fragmentSource = programParameters.fragmentSource(gfx::Backend::Type::OpenGL);
+            const char* vertexPrelude =
+                shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex;
+            const char* fragmentPrelude =
+                shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::fragment;
+
+            std::optional<std::string> cachePath;
+            if (context.supportsProgramBinaries()) {
+                cachePath = programParameters.cachePath(Name::Name,
+                                                        {context.getDriverInfo(),
+                                                         defines,
+                                                         additionalDefines,
+                                                         vertexPrelude,
+                                                         vertexSource,
+                                                         fragmentPrelude,
+                                                         fragmentSource});
+            }
+            if (cachePath) {
+                if (auto program = loadCachedProgram(context, *cachePath)) {
+                    return std::make_unique<Instance>(std::move(*program));
+                }
+            }
+
             // Compile the shader
-            std::initializer_list<const char*> vertexSource = {
-                programParameters.getDefines().c_str(),
-                additionalDefines.c_str(),
-                shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::vertex,
-                programParameters.vertexSource(gfx::Backend::Type::OpenGL).c_str()};
-
-            std::initializer_list<const char*> fragmentSource = {
-                programParameters.getDefines().c_str(),
-                additionalDefines.c_str(),
-                shaders::ShaderSource<shaders::BuiltIn::Prelude, gfx::Backend::Type::OpenGL>::fragment,
-                programParameters.fragmentSource(gfx::Backend::Type::OpenGL).c_str()};
-
-            return std::make_unique<Instance>(context, vertexSource, fragmentSource);
+            auto instance = std::make_unique<Instance>(context.createProgram(
+                context.createShader(ShaderType::Vertex,
+                                     {defines.c_str(), additionalDefines.c_str(), vertexPrelude, vertexSource.c_str()}),
+                context.createShader(
+                    ShaderType::Fragment,
+                    {defines.c_str(), additionalDefines.c_str(), fragmentPrelude, fragmentSource.c_str()}),
+                gl::AttributeLocations<AttributeList>::getFirstAttribName(),
+                cachePath.has_value()));
+
+            if (cachePath) {
+                cacheProgram(context, instance->program, *cachePath);
+            }
+            return instance;
         }
 
         UniqueProgram program;
@@ -74,6 +102,11 @@ public:
         gl::TextureStates<TextureList> textureStates;
     };
 
+    void prewarm(gfx::Context& genericContext,
+                 const gfx::AttributeBindings<AttributeList>& attributeBindings) override {
+        getInstance(static_cast<gl::Context&>(genericContext), attributeBindings);
+    }
+
     void draw(gfx::Context& genericContext,
               gfx::RenderPass&,
               const gfx::DrawMode& drawMode,
@@ -95,6 +128,26 @@ public:
         context.setColorMode(colorMode);
         context.setCullFaceMode(cullFaceMode);
 
+        Instance* instance = getInstance(context, attributeBindings);
+        if (!instance) {
+            return;
+        }
+
+        context.program = instance->program;
+
+        instance->uniformStates.bind(uniformValues);
+
+        instance->textureStates.bind(context, textureBindings);
+
+        auto& vertexArray = drawScope.getResource<gl::DrawScopeResource>().vertexArray;
+        vertexArray.bind(context, indexBuffer, instance->attributeLocations.toBindingArray(attributeBindings));
+
+        context.draw(drawMode, indexOffset, indexLength);
+    }
+
+private:
+    // Returns the variant of the program for the given set of bound attributes, creating it on first use.
+    Instance* getInstance(gl::Context& context, const gfx::AttributeBindings<AttributeList>& attributeBindings) {
         const uint32_t key = gl::AttributeKey<AttributeList>::compute(attributeBindings);
         auto it = instances.find(key);
         if (it == instances.end()) {
@@ -107,24 +160,12 @@ public:
                          .first;
             } catch (const std::runtime_error& e) {
                 Log::Error(Event::OpenGL, e.what());
-                return;
+                return nullptr;
             }
         }
-
-        auto& instance = *it->second;
-        context.program = instance.program;
-
-        instance.uniformStates.bind(uniformValues);
-
-        instance.textureStates.bind(context, textureBindings);
-
-        auto& vertexArray = drawScope.getResource<gl::DrawScopeResource>().vertexArray;
-        vertexArray.bind(context, indexBuffer, instance.attributeLocations.toBindingArray(attributeBindings));
-
-        context.draw(drawMode, indexOffset, indexLength);
+        return it->second.get();
     }
 
-private:
     std::map<uint32_t, std::unique_ptr<Instance>> instances;
 };
 
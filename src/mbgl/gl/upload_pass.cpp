@@ -30,9 +30,12 @@ std::unique_ptr<gfx::VertexBufferResource> UploadPass::createVertexBufferResourc
     return std::make_unique<gl::VertexBufferResource>(std::move(result), static_cast<int>(size));
 }
 
-void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource, const void* data, std::size_t size) {
+void UploadPass::updateVertexBufferResource(gfx::VertexBufferResource& resource,
+                                            const void* data,
+                                            std::size_t size,
+                                            std::size_t offset) {
     commandEncoder.context.vertexBuffer = static_cast<gl::VertexBufferResource&>(resource).buffer;
-    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
 }
 
 std::unique_ptr<gfx::IndexBufferResource> UploadPass::createIndexBufferResource(const void* data,
@@ -26,7 +26,10 @@ public:
     std::unique_ptr<gfx::VertexBufferResource> createVertexBufferResource(const void* data,
                                                                           std::size_t size,
                                                                           gfx::BufferUsageType) override;
-    void updateVertexBufferResource(gfx::VertexBufferResource&, const void* data, std::size_t size) override;
+    void updateVertexBufferResource(gfx::VertexBufferResource&,
+                                    const void* data,
+                                    std::size_t size,
+                                    std::size_t offset) override;
     std::unique_ptr<gfx::IndexBufferResource> createIndexBufferResource(const void* data,
                                                                         std::size_t size,
                                                                         gfx::BufferUsageType) override;
@@ -6,6 +6,8 @@
 #include <mbgl/renderer/render_layer.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 class CircleLayout final : public Layout {
@@ -29,13 +31,11 @@ public:
             layerPropertiesMap.emplace(layerId, layerProperties);
         }
 
-        const size_t featureCount = sourceLayer->featureCount();
-        for (size_t i = 0; i < featureCount; ++i) {
+        const std::vector<std::size_t> selection = leaderLayerProperties->layerImpl().filter.select(
+            style::expression::EvaluationContext(zoom, nullptr).withCanonicalTileID(&parameters.tileID.canonical),
+            *sourceLayer);
+        for (const std::size_t i : selection) {
             auto feature = sourceLayer->getFeature(i);
-            if (!leaderLayerProperties->layerImpl().filter(style::expression::EvaluationContext(zoom, feature.get())
-                                                               .withCanonicalTileID(&parameters.tileID.canonical))) {
-                continue;
-            }
 
             if (!sortFeaturesByKey) {
                 features.push_back({i, std::move(feature), style::CircleSortKey::defaultValue()});
@@ -59,6 +59,14 @@ public:
                       const bool,
                       const CanonicalTileID& canonical) override {
         auto bucket = std::make_shared<CircleBucket>(layerPropertiesMap, mode, zoom);
+        std::vector<std::size_t> featureIndices;
+        featureIndices.reserve(features.size());
+        for (const auto& circleFeature : features) {
+            featureIndices.push_back(circleFeature.i);
+        }
+        // Features may be ordered by sort key.
+        std::sort(featureIndices.begin(), featureIndices.end());
+        bucket->prepareFeatures(*sourceLayer, featureIndices, canonical);
 
         for (auto& circleFeature : features) {
             const auto i = circleFeature.i;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/renderer/image_atlas.hpp>
+#include <mbgl/style/available_images.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <memory>
@@ -36,7 +37,7 @@ public:
     const BucketParameters& bucketParameters;
     GlyphDependencies& glyphDependencies;
     ImageDependencies& imageDependencies;
-    std::set<std::string>& availableImages;
+    const AvailableImages& availableImages;
 };
 
 } // namespace mbgl
@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <list>
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/layout/layout.hpp>
@@ -110,13 +111,12 @@ public:
             layerPropertiesMap.emplace(layerId, layerProperties);
         }
 
-        const size_t featureCount = sourceLayer->featureCount();
-        for (size_t i = 0; i < featureCount; ++i) {
+        const std::vector<std::size_t> selection = leaderLayerProperties->layerImpl().filter.select(
+            style::expression::EvaluationContext(this->zoom, nullptr).withCanonicalTileID(&parameters.tileID.canonical),
+            *sourceLayer);
+
+        for (const std::size_t i : selection) {
             auto feature = sourceLayer->getFeature(i);
-            if (!leaderLayerProperties->layerImpl().filter(
-                    style::expression::EvaluationContext(this->zoom, feature.get())
-                        .withCanonicalTileID(&parameters.tileID.canonical)))
-                continue;
 
             PatternLayerMap patternDependencyMap;
             if (hasPattern) {
@@ -174,6 +174,15 @@ public:
                       const bool /*showCollisionBoxes*/,
                       const CanonicalTileID& canonical) override {
         auto bucket = std::make_shared<BucketType>(layout, layerPropertiesMap, zoom, overscaling);
+        std::vector<std::size_t> featureIndices;
+        featureIndices.reserve(features.size());
+        for (const auto& patternFeature : features) {
+            featureIndices.push_back(patternFeature.i);
+        }
+        // Features may be ordered by sort key.
+        std::sort(featureIndices.begin(), featureIndices.end());
+        bucket->prepareFeatures(*sourceLayer, featureIndices, canonical);
+
         for (auto& patternFeature : features) {
             const auto i = patternFeature.i;
             std::unique_ptr<GeometryTileFeature> feature = std::move(patternFeature.feature);
@@ -0,0 +1,47 @@
+#include <mbgl/layout/repeated_label_index.hpp>
+#include <mbgl/util/math.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace mbgl {
+
+int32_t RepeatedLabelIndex::Grid::cellCoordinate(float value) const {
+    return static_cast<int32_t>(std::floor(value / cellSize));
+}
+
+uint64_t RepeatedLabelIndex::Grid::cellKey(int32_t x, int32_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+bool RepeatedLabelIndex::isTooClose(const std::u16string& text, float repeatDistance, const Point<float>& anchor) {
+    auto it = grids.find(text);
+    if (it == grids.end()) {
+        // The repeat distance is constant within a layer, so cells of that size keep the lookup to the
+        // 3x3 cells around the anchor.
+        it = grids.emplace(text, Grid(std::max(repeatDistance, 1.0f))).first;
+    } else if (repeatDistance > 0) {
+        const Grid& grid = it->second;
+        const int32_t minX = grid.cellCoordinate(anchor.x - repeatDistance);
+        const int32_t maxX = grid.cellCoordinate(anchor.x + repeatDistance);
+        const int32_t minY = grid.cellCoordinate(anchor.y - repeatDistance);
+        const int32_t maxY = grid.cellCoordinate(anchor.y + repeatDistance);
+        for (int32_t x = minX; x <= maxX; ++x) {
+            for (int32_t y = minY; y <= maxY; ++y) {
+                const auto cell = grid.cells.find(Grid::cellKey(x, y));
+                if (cell == grid.cells.end()) continue;
+                for (const auto& other : cell->second) {
+                    if (util::dist<float>(anchor, other) < repeatDistance) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    Grid& grid = it->second;
+    grid.cells[Grid::cellKey(grid.cellCoordinate(anchor.x), grid.cellCoordinate(anchor.y))].push_back(anchor);
+    return false;
+}
+
+} // namespace mbgl
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mbgl/util/geometry.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/**
+ * @brief Anchors of the labels of a symbol layout, grouped by text and bucketed into square cells.
+ *
+ * Used to enforce the repeat distance of labels along lines: only the anchors in the cells around a
+ * new anchor are compared, instead of every anchor with the same text in the tile.
+ */
+class RepeatedLabelIndex {
+public:
+    // Returns true if an anchor of `text` closer than `repeatDistance` to `anchor` was added before.
+    // Otherwise adds `anchor` and returns false.
+    bool isTooClose(const std::u16string& text, float repeatDistance, const Point<float>& anchor);
+
+    void clear() { grids.clear(); }
+
+private:
+    struct Grid {
+        explicit Grid(float cellSize_)
+            : cellSize(cellSize_) {}
+
+        int32_t cellCoordinate(float value) const;
+        static uint64_t cellKey(int32_t x, int32_t y);
+
+        const float cellSize;
+        std::unordered_map<uint64_t, std::vector<Point<float>>> cells;
+    };
+
+    std::unordered_map<std::u16string, Grid> grids;
+};
+
+} // namespace mbgl
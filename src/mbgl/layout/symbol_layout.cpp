@@ -6,6 +6,7 @@
 #include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/text/get_anchors.hpp>
 #include <mbgl/text/shaping.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/util/utf.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
@@ -129,14 +130,12 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
     }
 
     // Determine glyph dependencies
-    const size_t featureCount = sourceLayer->featureCount();
-    for (size_t i = 0; i < featureCount; ++i) {
-        auto feature = sourceLayer->getFeature(i);
-        if (!leader.filter(expression::EvaluationContext(this->zoom, feature.get())
-                               .withCanonicalTileID(&parameters.tileID.canonical)))
-            continue;
+    const std::vector<std::size_t> selection = leader.filter.select(
+        expression::EvaluationContext(this->zoom, nullptr).withCanonicalTileID(&parameters.tileID.canonical),
+        *sourceLayer);
 
-        SymbolFeature ft(std::move(feature));
+    for (const std::size_t i : selection) {
+        SymbolFeature ft(sourceLayer->getFeature(i));
 
         ft.index = i;
 
@@ -373,10 +372,29 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
                                     WritingModeType writingMode,
                                     SymbolAnchorType textAnchor,
                                     TextJustifyType textJustify) {
+                const float maxWidth = isPointPlacement
+                                           ? layout->evaluate<TextMaxWidth>(zoom, feature, canonicalID) * util::ONE_EM
+                                           : 0.0f;
+                // Labels repeat across tiles, so shapings of texts without images are looked up first.
+                const auto key = ShapingCache::makeKey(formattedText,
+                                                       glyphMap,
+                                                       maxWidth,
+                                                       lineHeight,
+                                                       textAnchor,
+                                                       textJustify,
+                                                       spacing,
+                                                       textOffset,
+                                                       writingMode,
+                                                       allowVerticalPlacement);
+                if (key) {
+                    if (auto cached = ShapingCache::getInstance().get(*key, glyphPositions)) {
+                        return std::move(*cached);
+                    }
+                }
+
                 Shaping result = getShaping(
                     /* string */ formattedText,
-                    /* maxWidth: ems */
-                    isPointPlacement ? layout->evaluate<TextMaxWidth>(zoom, feature, canonicalID) * util::ONE_EM : 0.0f,
+                    /* maxWidth: ems */ maxWidth,
                     /* ems */ lineHeight,
                     textAnchor,
                     textJustify,
@@ -391,6 +409,9 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
                     layoutTextSizeAtBucketZoomLevel,
                     allowVerticalPlacement);
 
+                if (key) {
+                    ShapingCache::getInstance().put(*key, result);
+                }
                 return result;
             };
 
@@ -516,7 +537,7 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
         feature.geometry.clear();
     }
 
-    compareText.clear();
+    repeatedLabels.clear();
 }
 
 void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
@@ -666,7 +687,7 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
             auto sharedData = createSymbolInstanceSharedData(std::move(line));
             for (auto& anchor : anchors) {
                 if (!feature.formattedText ||
-                    !anchorIsTooClose(feature.formattedText->rawText(), textRepeatDistance, anchor)) {
+                    !repeatedLabels.isTooClose(feature.formattedText->rawText(), textRepeatDistance, anchor.point)) {
                     addSymbolInstance(anchor, sharedData);
                 }
             }
@@ -730,21 +751,6 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
     }
 }
 
-bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repeatDistance, const Anchor& anchor) {
-    if (compareText.find(text) == compareText.end()) {
-        compareText.emplace(text, Anchors());
-    } else {
-        const auto& otherAnchors = compareText.find(text)->second;
-        for (const Anchor& otherAnchor : otherAnchors) {
-            if (util::dist<float>(anchor.point, otherAnchor.point) < repeatDistance) {
-                return true;
-            }
-        }
-    }
-    compareText[text].push_back(anchor);
-    return false;
-}
-
 // Analog of `addToLineVertexArray` in JS. This version doesn't need to build up a line array like the
 // JS version does, but it uses the same logic to calculate tile distances.
 std::vector<float> SymbolLayout::calculateTileDistances(const GeometryCoordinates& line, const Anchor& anchor) {
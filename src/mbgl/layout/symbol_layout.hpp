@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/layout/layout.hpp>
+#include <mbgl/layout/repeated_label_index.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/layout/symbol_feature.hpp>
@@ -75,8 +76,7 @@ private:
                     float layoutIconSize,
                     SymbolContent iconType);
 
-    bool anchorIsTooClose(const std::u16string& text, float repeatDistance, const Anchor&);
-    std::map<std::u16string, std::vector<Anchor>> compareText;
+    RepeatedLabelIndex repeatedLabels;
 
     void addToDebugBuffers(SymbolBucket&);
 
@@ -4,6 +4,7 @@
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/projection_batch.hpp>
 
 namespace mbgl {
 
@@ -117,9 +118,9 @@ float evaluateSizeForFeature(const ZoomEvaluatedSize& zoomEvaluatedSize, const P
     }
 }
 
-bool isVisible(const vec4& anchorPos, const std::array<double, 2>& clippingBuffer) {
-    const double x = anchorPos[0] / anchorPos[3];
-    const double y = anchorPos[1] / anchorPos[3];
+bool isVisible(const Point<float>& anchorPos, const std::array<float, 2>& clippingBuffer) {
+    const float x = anchorPos.x;
+    const float y = anchorPos.y;
     const bool inPaddedViewport = (x >= -clippingBuffer[0] && x <= clippingBuffer[0] && y >= -clippingBuffer[1] &&
                                    y <= clippingBuffer[1]);
     return inPaddedViewport;
@@ -430,11 +431,14 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
                          bool keepUpright,
                          const RenderTile& tile,
                          const SymbolSizeBinder& sizeBinder,
-                         const TransformState& state) {
+                         const TransformState& state,
+                         PointBatch& anchors,
+                         ProjectedPointBatch& viewportAnchors,
+                         ProjectedPointBatch& labelPlaneAnchors) {
     const ZoomEvaluatedSize partiallyEvaluatedSize = sizeBinder.evaluateForZoom(static_cast<float>(state.getZoom()));
 
-    const std::array<double, 2> clippingBuffer = {
-        {256.0 / state.getSize().width * 2.0 + 1.0, 256.0 / state.getSize().height * 2.0 + 1.0}};
+    const std::array<float, 2> clippingBuffer = {{static_cast<float>(256.0 / state.getSize().width * 2.0 + 1.0),
+                                                  static_cast<float>(256.0 / state.getSize().height * 2.0 + 1.0)}};
 
     const float pixelsToTileUnits = tile.id.pixelsToTileUnits(1.0f, static_cast<float>(state.getZoom()));
 
@@ -444,9 +448,19 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
 
     dynamicVertexArray.clear();
 
+    // Project all anchors up front, to the viewport for culling and perspective scaling, and to the label plane.
+    anchors.clear();
+    anchors.reserve(placedSymbols.size());
+    for (const auto& placedSymbol : placedSymbols) {
+        anchors.push_back(placedSymbol.anchorPoint);
+    }
+    util::projectPoints(anchors, posMatrix, viewportAnchors);
+    util::projectPoints(anchors, labelPlaneMatrix, labelPlaneAnchors);
+
     bool useVertical = false;
 
-    for (auto& placedSymbol : placedSymbols) {
+    for (std::size_t i = 0; i < placedSymbols.size(); ++i) {
+        const PlacedSymbol& placedSymbol = placedSymbols[i];
         // Don't do calculations for vertical glyphs unless the previous symbol was horizontal
         // and we determined that vertical glyphs were necessary.
         // Also don't do calculations for symbols that are collided and fully faded out
@@ -458,22 +472,19 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
         // counterpart
         useVertical = false;
 
-        vec4 anchorPos = {{placedSymbol.anchorPoint.x, placedSymbol.anchorPoint.y, 0, 1}};
-        matrix::transformMat4(anchorPos, anchorPos, posMatrix);
-
         // Don't bother calculating the correct point for invisible labels.
-        if (!isVisible(anchorPos, clippingBuffer)) {
+        if (!isVisible(viewportAnchors.point(i), clippingBuffer)) {
             hideGlyphs(placedSymbol.glyphOffsets.size(), dynamicVertexArray);
             continue;
         }
 
-        const auto cameraToAnchorDistance = static_cast<float>(anchorPos[3]);
+        const float cameraToAnchorDistance = viewportAnchors.w[i];
         const float perspectiveRatio = 0.5f + 0.5f * (cameraToAnchorDistance / state.getCameraToCenterDistance());
 
         const float fontSize = evaluateSizeForFeature(partiallyEvaluatedSize, placedSymbol);
         const float pitchScaledFontSize = pitchWithMap ? fontSize * perspectiveRatio : fontSize / perspectiveRatio;
 
-        const Point<float> anchorPoint = project(placedSymbol.anchorPoint, labelPlaneMatrix).first;
+        const Point<float> anchorPoint = labelPlaneAnchors.point(i);
 
         PlacementResult placeUnflipped = placeGlyphsAlongLine(placedSymbol,
                                                               pitchScaledFontSize,
@@ -10,6 +10,8 @@ class TransformState;
 class RenderTile;
 class SymbolSizeBinder;
 class PlacedSymbol;
+class PointBatch;
+class ProjectedPointBatch;
 namespace style {
 class SymbolPropertyValues;
 } // end namespace style
@@ -56,7 +58,10 @@ void reprojectLineLabels(gfx::VertexVector<gfx::Vertex<SymbolDynamicLayoutAttrib
                          bool keepUpright,
                          const RenderTile&,
                          const SymbolSizeBinder& sizeBinder,
-                         const TransformState&);
+                         const TransformState&,
+                         PointBatch& anchors,
+                         ProjectedPointBatch& viewportAnchors,
+                         ProjectedPointBatch& labelPlaneAnchors);
 
 std::optional<std::pair<PlacedGlyph, PlacedGlyph>> placeFirstAndLastGlyph(float fontScale,
                                                                           float lineOffsetX,
@@ -64,6 +64,7 @@ void Map::Impl::onUpdate() {
                                annotationManager.makeWeakPtr(),
                                fileSource,
                                prefetchZoomDelta,
+                               transform.getCameraTrajectory(),
                                bool(stillImageRequest),
                                crossSourceCollisions};
 
@@ -17,6 +17,9 @@
 
 namespace mbgl {
 
+// Number of states sampled along the path of an animation, including its destination.
+static constexpr std::size_t cameraTrajectorySamples = 8;
+
 /** Converts the given angle (in radians) to be numerically close to the anchor angle, allowing it to be interpolated
  * properly without sudden jumps. */
 static double _normalizeAngle(double angle, double anchorAngle) {
@@ -535,7 +538,24 @@ void Transform::startTransition(const CameraOptions& camera,
         }
     };
 
+    if (isAnimated) {
+        // Sample the path by applying the frame function to the start state. Each frame sets the
+        // animated properties from scratch, so the samples match the states of the animation.
+        const TransformState startState = state;
+        auto trajectory = std::make_shared<std::vector<TransformState>>();
+        trajectory->reserve(cameraTrajectorySamples);
+        for (std::size_t i = 0; i < cameraTrajectorySamples; ++i) {
+            // The destination comes first, as it is where the camera stays.
+            frame(i == 0 ? 1.0 : static_cast<double>(i) / cameraTrajectorySamples);
+            if (anchor) state.moveLatLng(anchorLatLng, *anchor);
+            trajectory->push_back(state);
+            state = startState;
+        }
+        cameraTrajectory = std::move(trajectory);
+    }
+
     transitionFinishFn = [isAnimated, animation, this] {
+        cameraTrajectory.reset();
         state.setProperties(
             TransformStateProperties().withPanningInProgress(false).withScalingInProgress(false).withRotatingInProgress(
                 false));
@@ -606,6 +626,7 @@ void Transform::cancelTransitions() {
     if (transitionFinishFn) {
         transitionFinishFn();
     }
+    cameraTrajectory.reset();
 
     transitionFrameFn = nullptr;
     transitionFinishFn = nullptr;
@@ -12,7 +12,9 @@
 #include <cstdint>
 #include <cmath>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace mbgl {
 
@@ -100,6 +102,10 @@ public:
     TimePoint getTransitionStart() const { return transitionStart; }
     Duration getTransitionDuration() const { return transitionDuration; }
     void cancelTransitions();
+    /** Returns the states the camera passes through during the current animation, starting with its
+        destination and followed by evenly spaced samples of the path, or null if no animation is
+        running. Used to load the tiles of the destination before the camera arrives. */
+    std::shared_ptr<const std::vector<TransformState>> getCameraTrajectory() const { return cameraTrajectory; }
 
     // Gesture
     void setGestureInProgress(bool);
@@ -132,6 +138,7 @@ private:
 
     TimePoint transitionStart;
     Duration transitionDuration;
+    std::shared_ptr<const std::vector<TransformState>> cameraTrajectory;
     std::function<bool(const TimePoint)> transitionFrameFn;
     std::function<void()> transitionFinishFn;
 };
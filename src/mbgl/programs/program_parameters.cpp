@@ -1,11 +1,12 @@
 #include <mbgl/programs/program_parameters.hpp>
 #include <mbgl/util/string.hpp>
+#include <cstdio>
 #include <string_view>
 #include <stdexcept>
 
 namespace mbgl {
 
-ProgramParameters::ProgramParameters(const float pixelRatio, const bool overdraw)
+ProgramParameters::ProgramParameters(const float pixelRatio, const bool overdraw, std::optional<std::string> cacheDir_)
     : defines([&] {
           std::string result;
           result.reserve(32);
@@ -16,7 +17,8 @@ ProgramParameters::ProgramParameters(const float pixelRatio, const bool overdraw
               result += "#define OVERDRAW_INSPECTOR\n";
           }
           return result;
-      }()) {}
+      }()),
+      cacheDir(std::move(cacheDir_)) {}
 
 ProgramParameters ProgramParameters::withShaderSource(const ProgramSource& source) const noexcept {
     assert(gfx::Backend::Type::TYPE_MAX != source.backend);
@@ -62,4 +64,29 @@ const std::string& ProgramParameters::fragmentSource(gfx::Backend::Type backend)
     }
 }
 
+std::optional<std::string> ProgramParameters::cachePath(std::string_view name,
+                                                        std::initializer_list<std::string_view> key) const {
+    if (!cacheDir) {
+        return std::nullopt;
+    }
+
+    // FNV-1a, which unlike std::hash gives the same result in every build, so that the cache survives upgrades
+    // of the standard library. A terminator is mixed in after each part to keep them from running together.
+    uint64_t hash = 0xcbf29ce484222325;
+    const auto mix = [&](const unsigned char c) {
+        hash ^= c;
+        hash *= 0x100000001b3;
+    };
+    for (const std::string_view part : key) {
+        for (const char c : part) {
+            mix(static_cast<unsigned char>(c));
+        }
+        mix(0);
+    }
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return *cacheDir + "/" + std::string(name) + "." + hex + ".bin";
+}
+
 } // namespace mbgl
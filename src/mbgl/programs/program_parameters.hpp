@@ -4,7 +4,11 @@
 
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace mbgl {
 
@@ -30,7 +34,7 @@ public:
         }
     };
 
-    ProgramParameters(float pixelRatio, bool overdraw);
+    ProgramParameters(float pixelRatio, bool overdraw, std::optional<std::string> cacheDir = std::nullopt);
 
     /// @brief Provide custom shader code which overrides any default source present
     /// @param source ProgramSource
@@ -57,8 +61,15 @@ public:
     /// @return Shader source string
     const std::string& fragmentSource(gfx::Backend::Type backend) const;
 
+    /// @brief Get the path under which a linked program is cached
+    /// @param name Program name
+    /// @param key Everything the linked program depends on, such as its sources and the driver version
+    /// @return File path, or an empty value if program caching is disabled
+    std::optional<std::string> cachePath(std::string_view name, std::initializer_list<std::string_view> key) const;
+
 private:
     std::string defines;
+    std::optional<std::string> cacheDir;
 
     std::array<ProgramSource, static_cast<size_t>(gfx::Backend::Type::TYPE_MAX)> defaultSources;
     std::array<ProgramSource, static_cast<size_t>(gfx::Backend::Type::TYPE_MAX)> userSources;
@@ -298,6 +298,16 @@ public:
             .concat(paintPropertyBinders.attributeBindings(currentProperties));
     }
 
+    void prewarm(gfx::Context& context, const typename PaintProperties::PossiblyEvaluated& currentProperties) {
+        if (!program) {
+            return;
+        }
+
+        program->prewarm(context,
+                         gfx::AttributeBindings<LayoutAndSizeAttributeList>::placeholder().concat(
+                             Binders::placeholderAttributeBindings(currentProperties)));
+    }
+
     static uint32_t activeBindingCount(const AttributeBindings& allAttributeBindings) {
         return allAttributeBindings.activeCount();
     }
@@ -39,6 +39,12 @@ public:
                             std::size_t,
                             const CanonicalTileID&){};
 
+    // Called before adding the features of `layer` at the sorted indices in `selection`, so that data-driven
+    // paint properties are evaluated for all of them at once rather than in addFeature().
+    virtual void prepareFeatures(const GeometryTileLayer&,
+                                 const std::vector<std::size_t>& /* selection */,
+                                 const CanonicalTileID&) {}
+
     virtual void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) {}
 
     // As long as this bucket has a Prepare render pass, this function is getting called. Typically,
@@ -51,6 +57,10 @@ public:
 
     bool needsUpload() const { return hasData() && !uploaded; }
 
+    // Returns an estimate of the memory held by this bucket in bytes, counting both
+    // the CPU-side vectors and the uploaded GPU buffers.
+    virtual std::size_t getMemoryUsage() const { return 0; }
+
     // The following methods are implemented by buckets that require cross-tile indexing and placement.
 
     // Returns a pair, the first element of which is a bucket cross-tile id
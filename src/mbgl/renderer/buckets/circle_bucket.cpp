@@ -24,7 +24,7 @@ CircleBucket::CircleBucket(const std::map<std::string, Immutable<LayerProperties
 CircleBucket::~CircleBucket() = default;
 
 void CircleBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
         indexBuffer = uploadPass.createIndexBuffer(std::move(triangles));
     }
@@ -40,6 +40,11 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t CircleBucket::getMemoryUsage() const {
+    return vertices.bytes() + triangles.bytes() + (vertexBuffer ? vertexBuffer->bytes() : 0) +
+           (indexBuffer ? indexBuffer->bytes() : 0);
+}
+
 template <class Property>
 static float get(const CirclePaintProperties::PossiblyEvaluated& evaluated,
                  const std::string& id,
@@ -60,6 +65,14 @@ float CircleBucket::getQueryRadius(const RenderLayer& layer) const {
     return radius + stroke + util::length(translate[0], translate[1]);
 }
 
+void CircleBucket::prepareFeatures(const GeometryTileLayer& layer,
+                                   const std::vector<std::size_t>& selection,
+                                   const CanonicalTileID& canonical) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepareVertexVectors(layer, selection, canonical);
+    }
+}
+
 void CircleBucket::update(const FeatureStates& states,
                           const GeometryTileLayer& layer,
                           const std::string& layerID,
@@ -131,7 +131,8 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
 }
 
 void FillBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    // Feature-state changes only update the paint attributes, the layout buffers are uploaded once.
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
         lineIndexBuffer = uploadPass.createIndexBuffer(std::move(lines));
         triangleIndexBuffer = triangles.empty() ? std::optional<gfx::IndexBuffer>{}
@@ -149,12 +150,25 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+std::size_t FillBucket::getMemoryUsage() const {
+    return vertices.bytes() + lines.bytes() + triangles.bytes() + (vertexBuffer ? vertexBuffer->bytes() : 0) +
+           (lineIndexBuffer ? lineIndexBuffer->bytes() : 0) + (triangleIndexBuffer ? triangleIndexBuffer->bytes() : 0);
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     const auto& evaluated = getEvaluated<FillLayerProperties>(layer.evaluatedProperties);
     const std::array<float, 2>& translate = evaluated.get<FillTranslate>();
     return util::length(translate[0], translate[1]);
 }
 
+void FillBucket::prepareFeatures(const GeometryTileLayer& layer,
+                                 const std::vector<std::size_t>& selection,
+                                 const CanonicalTileID& canonical) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepareVertexVectors(layer, selection, canonical);
+    }
+}
+
 void FillBucket::update(const FeatureStates& states,
                         const GeometryTileLayer& layer,
                         const std::string& layerID,
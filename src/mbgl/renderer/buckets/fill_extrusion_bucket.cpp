@@ -168,7 +168,7 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
 }
 
 void FillExtrusionBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
         indexBuffer = uploadPass.createIndexBuffer(std::move(triangles));
     }
@@ -184,12 +184,25 @@ bool FillExtrusionBucket::hasData() const {
     return !triangleSegments.empty();
 }
 
+std::size_t FillExtrusionBucket::getMemoryUsage() const {
+    return vertices.bytes() + triangles.bytes() + (vertexBuffer ? vertexBuffer->bytes() : 0) +
+           (indexBuffer ? indexBuffer->bytes() : 0);
+}
+
 float FillExtrusionBucket::getQueryRadius(const RenderLayer& layer) const {
     const auto& evaluated = getEvaluated<FillExtrusionLayerProperties>(layer.evaluatedProperties);
     const std::array<float, 2>& translate = evaluated.get<FillExtrusionTranslate>();
     return util::length(translate[0], translate[1]);
 }
 
+void FillExtrusionBucket::prepareFeatures(const GeometryTileLayer& layer,
+                                          const std::vector<std::size_t>& selection,
+                                          const CanonicalTileID& canonical) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepareVertexVectors(layer, selection, canonical);
+    }
+}
+
 void FillExtrusionBucket::update(const FeatureStates& states,
                                  const GeometryTileLayer& layer,
                                  const std::string& layerID,
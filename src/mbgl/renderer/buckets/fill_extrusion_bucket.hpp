@@ -32,11 +32,13 @@ public:
                     const CanonicalTileID&) override;
 
     bool hasData() const override;
+    std::size_t getMemoryUsage() const override;
 
     void upload(gfx::UploadPass&) override;
 
     float getQueryRadius(const RenderLayer&) const override;
 
+    void prepareFeatures(const GeometryTileLayer&, const std::vector<std::size_t>&, const CanonicalTileID&) override;
     void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) override;
 
     gfx::VertexVector<FillExtrusionLayoutVertex> vertices;
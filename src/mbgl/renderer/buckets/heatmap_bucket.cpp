@@ -38,6 +38,11 @@ bool HeatmapBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t HeatmapBucket::getMemoryUsage() const {
+    return vertices.bytes() + triangles.bytes() + (vertexBuffer ? vertexBuffer->bytes() : 0) +
+           (indexBuffer ? indexBuffer->bytes() : 0);
+}
+
 void HeatmapBucket::addFeature(const GeometryTileFeature& feature,
                                const GeometryCollection& geometry,
                                const ImagePositions&,
@@ -95,6 +100,14 @@ void HeatmapBucket::addFeature(const GeometryTileFeature& feature,
     }
 }
 
+void HeatmapBucket::prepareFeatures(const GeometryTileLayer& layer,
+                                    const std::vector<std::size_t>& selection,
+                                    const CanonicalTileID& canonical) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepareVertexVectors(layer, selection, canonical);
+    }
+}
+
 float HeatmapBucket::getQueryRadius(const RenderLayer& layer) const {
     (void)layer;
     return 0;
@@ -24,7 +24,9 @@ public:
                     const PatternLayerMap&,
                     std::size_t,
                     const CanonicalTileID&) override;
+    void prepareFeatures(const GeometryTileLayer&, const std::vector<std::size_t>&, const CanonicalTileID&) override;
     bool hasData() const override;
+    std::size_t getMemoryUsage() const override;
 
     void upload(gfx::UploadPass&) override;
 
@@ -114,4 +114,10 @@ bool HillshadeBucket::hasData() const {
     return demdata.getImage()->valid();
 }
 
+std::size_t HillshadeBucket::getMemoryUsage() const {
+    return demdata.getImage()->bytes() + (dem ? dem->size.area() * 4 : 0) + (texture ? texture->size.area() * 4 : 0) +
+           vertices.bytes() + indices.bytes() + (vertexBuffer ? vertexBuffer->bytes() : 0) +
+           (indexBuffer ? indexBuffer->bytes() : 0);
+}
+
 } // namespace mbgl
@@ -571,7 +571,7 @@ void LineBucket::addPieSliceVertex(const GeometryCoordinate& currentVertex,
 }
 
 void LineBucket::upload(gfx::UploadPass& uploadPass) {
-    if (!uploaded) {
+    if (!vertexBuffer) {
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertices));
         indexBuffer = uploadPass.createIndexBuffer(std::move(triangles));
     }
@@ -587,6 +587,11 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t LineBucket::getMemoryUsage() const {
+    return vertices.bytes() + triangles.bytes() + (vertexBuffer ? vertexBuffer->bytes() : 0) +
+           (indexBuffer ? indexBuffer->bytes() : 0);
+}
+
 template <class Property>
 static float get(const LinePaintProperties::PossiblyEvaluated& evaluated,
                  const std::string& id,
@@ -612,6 +617,14 @@ float LineBucket::getQueryRadius(const RenderLayer& layer) const {
     return lineWidth / 2.0f + std::abs(offset) + util::length(translate[0], translate[1]);
 }
 
+void LineBucket::prepareFeatures(const GeometryTileLayer& layer,
+                                 const std::vector<std::size_t>& selection,
+                                 const CanonicalTileID& canonical) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.prepareVertexVectors(layer, selection, canonical);
+    }
+}
+
 void LineBucket::update(const FeatureStates& states,
                         const GeometryTileLayer& layer,
                         const std::string& layerID,
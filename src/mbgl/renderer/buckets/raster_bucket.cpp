@@ -109,4 +109,9 @@ bool RasterBucket::hasData() const {
     return !!image;
 }
 
+std::size_t RasterBucket::getMemoryUsage() const {
+    return (image ? image->bytes() : 0) + (texture ? texture->size.area() * 4 : 0) + vertices.bytes() +
+           indices.bytes() + (vertexBuffer ? vertexBuffer->bytes() : 0) + (indexBuffer ? indexBuffer->bytes() : 0);
+}
+
 } // namespace mbgl
@@ -21,6 +21,7 @@ public:
 
     void upload(gfx::UploadPass&) override;
     bool hasData() const override;
+    std::size_t getMemoryUsage() const override;
 
     void clear();
     void setImage(std::shared_ptr<PremultipliedImage>);
@@ -188,6 +188,19 @@ bool SymbolBucket::hasData() const {
            hasTextCollisionBoxData() || hasIconCollisionCircleData() || hasTextCollisionCircleData();
 }
 
+std::size_t SymbolBucket::getMemoryUsage() const {
+    auto bufferBytes = [](const Buffer& buffer) {
+        return buffer.vertices.bytes() + buffer.dynamicVertices.bytes() + buffer.opacityVertices.bytes() +
+               buffer.triangles.bytes() + (buffer.vertexBuffer ? buffer.vertexBuffer->bytes() : 0) +
+               (buffer.dynamicVertexBuffer ? buffer.dynamicVertexBuffer->bytes() : 0) +
+               (buffer.opacityVertexBuffer ? buffer.opacityVertexBuffer->bytes() : 0) +
+               (buffer.indexBuffer ? buffer.indexBuffer->bytes() : 0);
+    };
+    return bufferBytes(text) + bufferBytes(icon) + bufferBytes(sdfIcon) +
+           symbolInstances.size() * sizeof(SymbolInstance) +
+           (text.placedSymbols.size() + icon.placedSymbols.size() + sdfIcon.placedSymbols.size()) * sizeof(PlacedSymbol);
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
@@ -45,7 +45,7 @@ void ImageManager::addImage(Immutable<style::Image::Impl> image_) {
     if (requestedImages.find(image_->id) != requestedImages.end()) {
         requestedImagesCacheSize += image_->image.bytes();
     }
-    availableImages.emplace(image_->id);
+    availableImages.reset();
     images.emplace(image_->id, std::move(image_));
 }
 
@@ -84,7 +84,7 @@ void ImageManager::removeImage(const std::string& id) {
         requestedImages.erase(requestedIt);
     }
     images.erase(it);
-    availableImages.erase(id);
+    availableImages.reset();
     updatedImageVersions.erase(id);
 }
 
@@ -173,8 +173,16 @@ void ImageManager::reduceMemoryUseIfCacheSizeExceedsLimit() {
     }
 }
 
-const std::set<std::string>& ImageManager::getAvailableImages() const {
-    return availableImages;
+Immutable<AvailableImages> ImageManager::getAvailableImages() const {
+    if (!availableImages) {
+        std::unordered_set<std::string> ids;
+        ids.reserve(images.size());
+        for (const auto& entry : images) {
+            ids.emplace(entry.first);
+        }
+        availableImages.emplace(makeMutable<AvailableImages>(std::move(ids)));
+    }
+    return *availableImages;
 }
 
 void ImageManager::clear() {
@@ -182,7 +190,7 @@ void ImageManager::clear() {
     assert(missingImageRequestors.empty());
 
     images.clear();
-    availableImages.clear();
+    availableImages.reset();
     updatedImageVersions.clear();
     requestedImages.clear();
     loaded = false;
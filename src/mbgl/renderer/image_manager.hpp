@@ -1,9 +1,11 @@
 #pragma once
 
+#include <mbgl/style/available_images.hpp>
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/util/immutable.hpp>
 
 #include <map>
+#include <optional>
 #include <string>
 
 namespace mbgl {
@@ -47,7 +49,8 @@ public:
     void notifyIfMissingImageAdded();
     void reduceMemoryUse();
     void reduceMemoryUseIfCacheSizeExceedsLimit();
-    const std::set<std::string>& getAvailableImages() const;
+    // Returns a snapshot of the IDs of the images added so far, shared until the images change.
+    Immutable<AvailableImages> getAvailableImages() const;
 
     ImageVersionMap updatedImageVersions;
 
@@ -65,8 +68,8 @@ private:
     std::map<std::string, std::set<ImageRequestor*>> requestedImages;
     std::size_t requestedImagesCacheSize = 0ul;
     ImageMap images;
-    // Mirror of 'ImageMap images;' keys.
-    std::set<std::string> availableImages;
+    // Snapshot of 'ImageMap images;' keys, taken on demand after images are added or removed.
+    mutable std::optional<Immutable<AvailableImages>> availableImages;
 
     ImageManagerObserver* observer = nullptr;
 };
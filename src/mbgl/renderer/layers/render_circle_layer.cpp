@@ -175,6 +175,13 @@ GeometryCoordinates projectQueryGeometry(const GeometryCoordinates& queryGeometr
     return projectedGeometry;
 }
 
+void RenderCircleLayer::prewarm(PaintParameters& parameters) {
+    if (!parameters.shaders.populate(circleProgram)) return;
+    if (!needsPrewarm({circleProgram.get()})) return;
+
+    circleProgram->prewarm(parameters.context, getEvaluated<CircleLayerProperties>(evaluatedProperties));
+}
+
 bool RenderCircleLayer::queryIntersectsFeature(const GeometryCoordinates& queryGeometry,
                                                const GeometryTileFeature& feature,
                                                const float zoom,
@@ -241,6 +241,30 @@ void RenderFillLayer::render(PaintParameters& parameters) {
     }
 }
 
+void RenderFillLayer::prewarm(PaintParameters& parameters) {
+    if (!parameters.shaders.populate(fillProgram)) return;
+    if (!parameters.shaders.populate(fillPatternProgram)) return;
+    if (!parameters.shaders.populate(fillOutlineProgram)) return;
+    if (!parameters.shaders.populate(fillOutlinePatternProgram)) return;
+    if (!needsPrewarm(
+            {fillProgram.get(), fillPatternProgram.get(), fillOutlineProgram.get(), fillOutlinePatternProgram.get()})) {
+        return;
+    }
+
+    const auto& evaluated = getEvaluated<FillLayerProperties>(evaluatedProperties);
+    if (unevaluated.get<FillPattern>().isUndefined()) {
+        fillProgram->prewarm(parameters.context, evaluated);
+        if (evaluated.get<FillAntialias>()) {
+            fillOutlineProgram->prewarm(parameters.context, evaluated);
+        }
+    } else {
+        fillPatternProgram->prewarm(parameters.context, evaluated);
+        if (evaluated.get<FillAntialias>() && unevaluated.get<FillOutlineColor>().isUndefined()) {
+            fillOutlinePatternProgram->prewarm(parameters.context, evaluated);
+        }
+    }
+}
+
 bool RenderFillLayer::queryIntersectsFeature(const GeometryCoordinates& queryGeometry,
                                              const GeometryTileFeature& feature,
                                              const float,
@@ -24,6 +24,7 @@ private:
     bool hasTransition() const override;
     bool hasCrossfade() const override;
     void render(PaintParameters&) override;
+    void prewarm(PaintParameters&) override;
 
     bool queryIntersectsFeature(const GeometryCoordinates&,
                                 const GeometryTileFeature&,
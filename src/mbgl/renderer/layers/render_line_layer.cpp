@@ -209,6 +209,27 @@ void RenderLineLayer::render(PaintParameters& parameters) {
     }
 }
 
+void RenderLineLayer::prewarm(PaintParameters& parameters) {
+    if (!parameters.shaders.populate(lineProgram)) return;
+    if (!parameters.shaders.populate(lineGradientProgram)) return;
+    if (!parameters.shaders.populate(lineSDFProgram)) return;
+    if (!parameters.shaders.populate(linePatternProgram)) return;
+    if (!needsPrewarm({lineProgram.get(), lineGradientProgram.get(), lineSDFProgram.get(), linePatternProgram.get()})) {
+        return;
+    }
+
+    const auto& evaluated = getEvaluated<LineLayerProperties>(evaluatedProperties);
+    if (!evaluated.get<LineDasharray>().from.empty()) {
+        lineSDFProgram->prewarm(parameters.context, evaluated);
+    } else if (!unevaluated.get<LinePattern>().isUndefined()) {
+        linePatternProgram->prewarm(parameters.context, evaluated);
+    } else if (!unevaluated.get<LineGradient>().getValue().isUndefined()) {
+        lineGradientProgram->prewarm(parameters.context, evaluated);
+    } else {
+        lineProgram->prewarm(parameters.context, evaluated);
+    }
+}
+
 namespace {
 
 GeometryCollection offsetLine(const GeometryCollection& rings, double offset) {
@@ -28,6 +28,7 @@ private:
     void prepare(const LayerPrepareParameters&) override;
     void upload(gfx::UploadPass&) override;
     void render(PaintParameters&) override;
+    void prewarm(PaintParameters&) override;
 
     bool queryIntersectsFeature(const GeometryCoordinates&,
                                 const GeometryTileFeature&,
@@ -210,9 +210,8 @@ void drawText(const RenderSymbolLayer::Programs& programs,
     const bool alongLine = layout.get<SymbolPlacement>() != SymbolPlacementType::Point &&
                            layout.get<TextRotationAlignment>() == AlignmentType::Map;
 
-    const Size& glyphTexSize = tile.getGlyphAtlasTexture().size;
-    const gfx::TextureBinding glyphTextureBinding{tile.getGlyphAtlasTexture().getResource(),
-                                                  gfx::TextureFilterType::Linear};
+    const Size glyphTexSize = parameters.glyphAtlas.getPixelSize();
+    const gfx::TextureBinding glyphTextureBinding = parameters.glyphAtlas.textureBinding();
 
     const auto drawGlyphs = [&](auto& program, const auto& uniforms, const auto& textures, SymbolSDFPart part) {
         draw(program,
@@ -598,6 +597,22 @@ void RenderSymbolLayer::render(PaintParameters& parameters) {
     }
 }
 
+void RenderSymbolLayer::prewarm(PaintParameters& parameters) {
+    if (!parameters.shaders.populate(programs.symbolIconProgram)) return;
+    if (!parameters.shaders.populate(programs.symbolSDFTextProgram)) return;
+    if (!needsPrewarm({programs.symbolIconProgram.get(), programs.symbolSDFTextProgram.get()})) return;
+
+    // Whether icons are SDFs is only known once images are loaded, so only the common case is covered.
+    const auto& layout = impl_cast(baseImpl).layout;
+    const auto& evaluated = getEvaluated<SymbolLayerProperties>(evaluatedProperties);
+    if (!layout.get<IconImage>().isUndefined()) {
+        programs.symbolIconProgram->prewarm(parameters.context, iconPaintProperties(evaluated));
+    }
+    if (!layout.get<TextField>().isUndefined()) {
+        programs.symbolSDFTextProgram->prewarm(parameters.context, textPaintProperties(evaluated));
+    }
+}
+
 // static
 style::IconPaintProperties::PossiblyEvaluated RenderSymbolLayer::iconPaintProperties(
     const style::SymbolPaintProperties::PossiblyEvaluated& evaluated_) {
@@ -87,6 +87,7 @@ private:
     bool hasTransition() const override;
     bool hasCrossfade() const override;
     void render(PaintParameters&) override;
+    void prewarm(PaintParameters&) override;
     void prepare(const LayerPrepareParameters&) override;
 
     // Paint properties
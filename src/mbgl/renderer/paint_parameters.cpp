@@ -36,7 +36,8 @@ PaintParameters::PaintParameters(gfx::Context& context_,
                                  const TransformParameters& transformParams_,
                                  RenderStaticData& staticData_,
                                  LineAtlas& lineAtlas_,
-                                 PatternAtlas& patternAtlas_)
+                                 PatternAtlas& patternAtlas_,
+                                 GlyphAtlas& glyphAtlas_)
     : context(context_),
       backend(backend_),
       encoder(context.createCommandEncoder()),
@@ -46,6 +47,7 @@ PaintParameters::PaintParameters(gfx::Context& context_,
       staticData(staticData_),
       lineAtlas(lineAtlas_),
       patternAtlas(patternAtlas_),
+      glyphAtlas(glyphAtlas_),
       mapMode(mode_),
       debugOptions(debugOptions_),
       timePoint(timePoint_),
@@ -23,6 +23,7 @@ class TransformState;
 class ImageManager;
 class LineAtlas;
 class PatternAtlas;
+class GlyphAtlas;
 class UnwrappedTileID;
 
 namespace gfx {
@@ -54,7 +55,8 @@ public:
                     const TransformParameters&,
                     RenderStaticData&,
                     LineAtlas&,
-                    PatternAtlas&);
+                    PatternAtlas&,
+                    GlyphAtlas&);
     ~PaintParameters();
 
     gfx::Context& context;
@@ -69,6 +71,7 @@ public:
     RenderStaticData& staticData;
     LineAtlas& lineAtlas;
     PatternAtlas& patternAtlas;
+    GlyphAtlas& glyphAtlas;
 
     RenderPass pass = RenderPass::Opaque;
     MapMode mapMode;
@@ -15,6 +15,7 @@
 #include <mbgl/util/indexed_tuple.hpp>
 #include <mbgl/layout/pattern_layout.hpp>
 
+#include <algorithm>
 #include <bitset>
 
 namespace mbgl {
@@ -28,6 +29,66 @@ struct FeatureVertexRange {
 
 using FeatureVertexRangeMap = std::map<std::string, std::vector<FeatureVertexRange>>;
 
+// Vertex ranges of an uploaded paint attribute buffer that were rewritten since, e.g. after a feature-state
+// change. Uploading only sends these ranges, so that the cost scales with the number of changed features.
+class DirtyVertexRanges {
+public:
+    void add(std::size_t start, std::size_t end) {
+        if (start < end) ranges.emplace_back(start, end);
+    }
+
+    void clear() { ranges.clear(); }
+
+    template <class Vertex>
+    void upload(gfx::UploadPass& uploadPass,
+                gfx::VertexBuffer<Vertex>& buffer,
+                const gfx::VertexVector<Vertex>& vertices) {
+        std::sort(ranges.begin(), ranges.end());
+        std::size_t i = 0;
+        while (i < ranges.size()) {
+            // Coalesce adjacent and overlapping ranges, such as the ranges of consecutive features.
+            const std::size_t start = ranges[i].first;
+            std::size_t end = ranges[i].second;
+            for (++i; i < ranges.size() && ranges[i].first <= end; ++i) {
+                end = std::max(end, ranges[i].second);
+            }
+            uploadPass.updateVertexBuffer(buffer, vertices, start, end - start);
+        }
+        ranges.clear();
+    }
+
+private:
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+};
+
+// Values of a data-driven paint property evaluated ahead of time for the features of a source layer that a
+// bucket is built from, so that the attributes are filled without evaluating the expression per feature.
+template <class T>
+class PaintPropertyColumn {
+public:
+    void assign(std::vector<std::size_t> indices_, std::vector<T> values_) {
+        assert(indices_.size() == values_.size());
+        indices = std::move(indices_);
+        values = std::move(values_);
+    }
+
+    // Returns the value of the feature at `index` if it was evaluated, or nullptr.
+    const T* find(std::size_t index) const {
+        const auto it = std::lower_bound(indices.begin(), indices.end(), index);
+        return it != indices.end() && *it == index ? &values[it - indices.begin()] : nullptr;
+    }
+
+    void clear() {
+        indices = {};
+        values = {};
+    }
+
+private:
+    // Sorted feature indices, and the values of these features.
+    std::vector<std::size_t> indices;
+    std::vector<T> values;
+};
+
 /*
    ZoomInterpolatedAttribute<Attr> is a 'compound' attribute, representing two values of the
    the base attribute Attr.  These two values are provided to the shader to allow interpolation
@@ -112,6 +173,12 @@ public:
                                       const CanonicalTileID& canonical,
                                       const style::expression::Value&) = 0;
 
+    // Evaluates the property for the features of `layer` at the sorted indices in `selection` before they are
+    // added, after which populateVertexVector() uses these values for features without a formatted section.
+    virtual void prepareVertexVectors(const GeometryTileLayer&,
+                                      const std::vector<std::size_t>& /* selection */,
+                                      const CanonicalTileID&) {}
+
     virtual void updateVertexVectors(const FeatureStates&, const GeometryTileLayer&, const ImagePositions&) {}
 
     virtual void updateVertexVector(std::size_t, std::size_t, const GeometryTileFeature&, const FeatureState&) = 0;
@@ -233,9 +300,12 @@ public:
                               const CanonicalTileID& canonical,
                               const style::expression::Value& formattedSection) override {
         using style::expression::EvaluationContext;
-        auto evaluated = expression.evaluate(
-            EvaluationContext(&feature).withFormattedSection(&formattedSection).withCanonicalTileID(&canonical),
-            defaultValue);
+        const T* prepared = formattedSection.is<NullValue>() ? column.find(index) : nullptr;
+        auto evaluated = prepared ? *prepared
+                                  : expression.evaluate(EvaluationContext(&feature)
+                                                            .withFormattedSection(&formattedSection)
+                                                            .withCanonicalTileID(&canonical),
+                                                        defaultValue);
         this->statistics.add(evaluated);
         auto value = attributeValue(evaluated);
         auto elements = vertexVector.elements();
@@ -248,6 +318,15 @@ public:
         }
     }
 
+    void prepareVertexVectors(const GeometryTileLayer& layer,
+                              const std::vector<std::size_t>& selection,
+                              const CanonicalTileID& canonical) override {
+        using style::expression::EvaluationContext;
+        column.assign(
+            selection,
+            expression.evaluate(EvaluationContext().withCanonicalTileID(&canonical), layer, selection, defaultValue));
+    }
+
     void updateVertexVectors(const FeatureStates& states,
                              const GeometryTileLayer& layer,
                              const ImagePositions&) override {
@@ -275,13 +354,23 @@ public:
         auto evaluated = expression.evaluate(EvaluationContext(&feature).withFeatureState(&state), defaultValue);
         this->statistics.add(evaluated);
         auto value = attributeValue(evaluated);
+        if (start == end || vertexVector.at(start).a1 == value) {
+            return;
+        }
         for (std::size_t i = start; i < end; ++i) {
             vertexVector.at(i) = BaseVertex{value};
         }
+        dirtyRanges.add(start, end);
     }
 
     void upload(gfx::UploadPass& uploadPass) override {
-        vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+        if (!vertexBuffer) {
+            vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+            dirtyRanges.clear();
+            column.clear();
+        } else {
+            dirtyRanges.upload(uploadPass, *vertexBuffer, vertexVector);
+        }
     }
 
     std::tuple<std::optional<gfx::AttributeBinding>> attributeBinding(
@@ -307,9 +396,11 @@ public:
 private:
     style::PropertyExpression<T> expression;
     T defaultValue;
+    PaintPropertyColumn<T> column;
     gfx::VertexVector<BaseVertex> vertexVector;
     std::optional<gfx::VertexBuffer<BaseVertex>> vertexBuffer;
     FeatureVertexRangeMap featureMap;
+    DirtyVertexRanges dirtyRanges;
 };
 
 template <class T, class A>
@@ -335,16 +426,18 @@ public:
                               const CanonicalTileID& canonical,
                               const style::expression::Value& formattedSection) override {
         using style::expression::EvaluationContext;
-        Range<T> range = {
-            expression.evaluate(EvaluationContext(zoomRange.min, &feature)
-                                    .withFormattedSection(&formattedSection)
-                                    .withCanonicalTileID(&canonical),
-                                defaultValue),
-            expression.evaluate(EvaluationContext(zoomRange.max, &feature)
-                                    .withFormattedSection(&formattedSection)
-                                    .withCanonicalTileID(&canonical),
-                                defaultValue),
-        };
+        const Range<T>* prepared = formattedSection.is<NullValue>() ? column.find(index) : nullptr;
+        Range<T> range = prepared ? *prepared
+                                  : Range<T>{
+                                        expression.evaluate(EvaluationContext(zoomRange.min, &feature)
+                                                                .withFormattedSection(&formattedSection)
+                                                                .withCanonicalTileID(&canonical),
+                                                            defaultValue),
+                                        expression.evaluate(EvaluationContext(zoomRange.max, &feature)
+                                                                .withFormattedSection(&formattedSection)
+                                                                .withCanonicalTileID(&canonical),
+                                                            defaultValue),
+                                    };
         this->statistics.add(range.min);
         this->statistics.add(range.max);
         AttributeValue value = zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max));
@@ -358,6 +451,22 @@ public:
         }
     }
 
+    void prepareVertexVectors(const GeometryTileLayer& layer,
+                              const std::vector<std::size_t>& selection,
+                              const CanonicalTileID& canonical) override {
+        using style::expression::EvaluationContext;
+        std::vector<T> min = expression.evaluate(
+            EvaluationContext(zoomRange.min, nullptr).withCanonicalTileID(&canonical), layer, selection, defaultValue);
+        std::vector<T> max = expression.evaluate(
+            EvaluationContext(zoomRange.max, nullptr).withCanonicalTileID(&canonical), layer, selection, defaultValue);
+        std::vector<Range<T>> ranges;
+        ranges.reserve(selection.size());
+        for (std::size_t i = 0; i < selection.size(); ++i) {
+            ranges.push_back({std::move(min[i]), std::move(max[i])});
+        }
+        column.assign(selection, std::move(ranges));
+    }
+
     void updateVertexVectors(const FeatureStates& states,
                              const GeometryTileLayer& layer,
                              const ImagePositions&) override {
@@ -388,14 +497,23 @@ public:
         this->statistics.add(range.min);
         this->statistics.add(range.max);
         AttributeValue value = zoomInterpolatedAttributeValue(attributeValue(range.min), attributeValue(range.max));
-
+        if (start == end || vertexVector.at(start).a1 == value) {
+            return;
+        }
         for (std::size_t i = start; i < end; ++i) {
             vertexVector.at(i) = Vertex{value};
         }
+        dirtyRanges.add(start, end);
     }
 
     void upload(gfx::UploadPass& uploadPass) override {
-        vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+        if (!vertexBuffer) {
+            vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
+            dirtyRanges.clear();
+            column.clear();
+        } else {
+            dirtyRanges.upload(uploadPass, *vertexBuffer, vertexVector);
+        }
     }
 
     std::tuple<std::optional<gfx::AttributeBinding>> attributeBinding(
@@ -427,9 +545,11 @@ private:
     style::PropertyExpression<T> expression;
     T defaultValue;
     Range<float> zoomRange;
+    PaintPropertyColumn<Range<T>> column;
     gfx::VertexVector<Vertex> vertexVector;
     std::optional<gfx::VertexBuffer<Vertex>> vertexBuffer;
     FeatureVertexRangeMap featureMap;
+    DirtyVertexRanges dirtyRanges;
 };
 
 template <class T, class A1, class A2>
@@ -653,6 +773,12 @@ public:
                        0)...});
     }
 
+    void prepareVertexVectors(const GeometryTileLayer& layer,
+                              const std::vector<std::size_t>& selection,
+                              const CanonicalTileID& canonical) {
+        util::ignore({(binders.template get<Ps>()->prepareVertexVectors(layer, selection, canonical), 0)...});
+    }
+
     void updateVertexVectors(const FeatureStates& states,
                              const GeometryTileLayer& layer,
                              const ImagePositions& imagePositions) {
@@ -681,6 +807,14 @@ public:
             std::tuple_cat(binders.template get<Ps>()->attributeBinding(currentProperties.template get<Ps>())...)};
     }
 
+    // The bindings attributeBindings() will return once vertex buffers are uploaded, except that they don't
+    // refer to any buffer: attributes are bound for the properties that aren't constant.
+    template <class EvaluatedProperties>
+    static AttributeBindings placeholderAttributeBindings(const EvaluatedProperties& currentProperties) {
+        return AttributeBindings{std::tuple_cat(placeholderAttributeBinding(
+            ZoomInterpolatedAttributeList<Ps>(), !currentProperties.template get<Ps>().isConstant())...)};
+    }
+
     using UniformList = TypeListConcat<InterpolationUniformList<Ps>..., typename Ps::UniformList...>;
     using UniformValues = gfx::UniformValues<UniformList>;
 
@@ -700,6 +834,13 @@ public:
     }
 
 private:
+    template <class... As>
+    static std::tuple<ExpandToType<As, std::optional<gfx::AttributeBinding>>...> placeholderAttributeBinding(
+        TypeList<As...>, bool bound) {
+        const auto binding = bound ? std::optional<gfx::AttributeBinding>(gfx::AttributeBinding{}) : std::nullopt;
+        return {ExpandToType<As, std::optional<gfx::AttributeBinding>>(binding)...};
+    }
+
     Binders binders;
 };
 
@@ -89,7 +89,7 @@ public:
     template <class Feature>
     Faded<T> evaluate(const Feature& feature,
                       float zoom,
-                      const std::set<std::string>& availableImages,
+                      const AvailableImages& availableImages,
                       const CanonicalTileID& canonical,
                       T defaultValue) const {
         return this->match([&](const Faded<T>& constant_) { return constant_; },
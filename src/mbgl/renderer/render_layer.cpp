@@ -8,6 +8,8 @@
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 using namespace style;
@@ -58,6 +60,16 @@ void RenderLayer::markContextDestroyed() {
     // no-op
 }
 
+bool RenderLayer::needsPrewarm(std::initializer_list<const void*> programs) {
+    if (prewarmedProperties && *prewarmedProperties == evaluatedProperties &&
+        std::equal(programs.begin(), programs.end(), prewarmedPrograms.begin(), prewarmedPrograms.end())) {
+        return false;
+    }
+    prewarmedProperties = evaluatedProperties;
+    prewarmedPrograms.assign(programs.begin(), programs.end());
+    return true;
+}
+
 void RenderLayer::checkRenderability(const PaintParameters& parameters, const uint32_t activeBindingCount) {
     // Only warn once for every layer.
     if (hasRenderFailures) {
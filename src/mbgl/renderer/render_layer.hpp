@@ -6,8 +6,11 @@
 #include <mbgl/style/layer_properties.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/mat4.hpp>
+#include <initializer_list>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 
@@ -100,6 +103,11 @@ public:
     virtual void upload(gfx::UploadPass&) {}
     virtual void render(PaintParameters&) = 0;
 
+    // Builds the program variants the layer will draw with for its latest evaluated properties, so that
+    // their shaders are ready before the first tiles arrive. Otherwise, variants are built on first draw.
+    // Called every frame, implementations return early unless needsPrewarm().
+    virtual void prewarm(PaintParameters&) {}
+
     // Check wether the given geometry intersects
     // with the feature
     virtual bool queryIntersectsFeature(const GeometryCoordinates&,
@@ -137,6 +145,10 @@ protected:
 
     const LayerRenderData* getRenderDataForPass(const RenderTile&, RenderPass) const;
 
+    // Returns whether the evaluated properties or the given programs changed since the last call that
+    // returned true, i.e. whether prewarm() may select variants that the programs have not built yet.
+    bool needsPrewarm(std::initializer_list<const void*> programs);
+
 protected:
     // Stores current set of tiles to be rendered for this layer.
     RenderTiles renderTiles;
@@ -152,6 +164,10 @@ private:
     // that GPU is exceeded. More attributes are used when adding many data driven paint properties
     // to a layer.
     bool hasRenderFailures = false;
+
+    // The evaluated properties and programs of the last prewarm.
+    std::optional<Immutable<style::LayerProperties>> prewarmedProperties;
+    std::vector<const void*> prewarmedPrograms;
 };
 
 using RenderLayerReferences = std::vector<std::reference_wrapper<RenderLayer>>;
@@ -23,6 +23,7 @@
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/util/async_request.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
@@ -54,6 +55,7 @@ private:
     bool hasRenderPass(RenderPass pass) const override { return layer.get().hasRenderPass(pass); }
     void upload(gfx::UploadPass& pass) const override { layer.get().upload(pass); }
     void render(PaintParameters& parameters) const override { layer.get().render(parameters); }
+    void prewarm(PaintParameters& parameters) const override { layer.get().prewarm(parameters); }
     const std::string& getName() const override { return layer.get().getID(); }
 };
 
@@ -64,6 +66,7 @@ public:
                    std::vector<std::unique_ptr<RenderItem>> sourceRenderItems_,
                    LineAtlas& lineAtlas_,
                    PatternAtlas& patternAtlas_,
+                   GlyphAtlas& glyphAtlas_,
                    RenderLayerReferences layersNeedPlacement_,
                    Immutable<Placement> placement_,
                    bool updateSymbolOpacities_)
@@ -72,6 +75,7 @@ public:
           sourceRenderItems(std::move(sourceRenderItems_)),
           lineAtlas(lineAtlas_),
           patternAtlas(patternAtlas_),
+          glyphAtlas(glyphAtlas_),
           layersNeedPlacement(std::move(layersNeedPlacement_)),
           placement(std::move(placement_)),
           updateSymbolOpacities(updateSymbolOpacities_) {}
@@ -91,11 +95,13 @@ public:
     }
     LineAtlas& getLineAtlas() const override { return lineAtlas; }
     PatternAtlas& getPatternAtlas() const override { return patternAtlas; }
+    GlyphAtlas& getGlyphAtlas() const override { return glyphAtlas; }
 
     std::set<LayerRenderItem> layerRenderItems;
     std::vector<std::unique_ptr<RenderItem>> sourceRenderItems;
     std::reference_wrapper<LineAtlas> lineAtlas;
     std::reference_wrapper<PatternAtlas> patternAtlas;
+    std::reference_wrapper<GlyphAtlas> glyphAtlas;
     RenderLayerReferences layersNeedPlacement;
     Immutable<Placement> placement;
     bool updateSymbolOpacities;
@@ -172,7 +178,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                         updateParameters->annotationManager,
                                         *imageManager,
                                         *glyphManager,
-                                        updateParameters->prefetchZoomDelta};
+                                        updateParameters->prefetchZoomDelta,
+                                        updateParameters->cameraTrajectory};
 
     glyphManager->setURL(updateParameters->glyphURL);
 
@@ -404,15 +411,17 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
             placementUpdatePeriodOverride = std::optional<Duration>(Milliseconds(30));
         }
 
-        renderTreeParameters->placementChanged = !placementController.placementIsRecent(
-            updateParameters->timePoint,
-            static_cast<float>(updateParameters->transformState.getZoom()),
-            placementUpdatePeriodOverride);
+        // A pending placement keeps being resumed until committed; meanwhile frames are rendered
+        // with the current placement and its fade state.
+        const bool placementNeeded = placementController.hasPendingPlacement() ||
+                                     !placementController.placementIsRecent(
+                                         updateParameters->timePoint,
+                                         static_cast<float>(updateParameters->transformState.getZoom()),
+                                         placementUpdatePeriodOverride);
+        renderTreeParameters->placementChanged = placementNeeded &&
+                                                 placementController.placeLayers(updateParameters, layersNeedPlacement);
         symbolBucketsChanged |= renderTreeParameters->placementChanged;
         if (renderTreeParameters->placementChanged) {
-            Mutable<Placement> placement = Placement::create(updateParameters, placementController.getPlacement());
-            placement->placeLayers(layersNeedPlacement);
-            placementController.setPlacement(std::move(placement));
             crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
             for (const auto& entry : renderSources) {
                 entry.second->updateFadingTiles();
@@ -454,6 +463,7 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(
                                             std::move(sourceRenderItems),
                                             *lineAtlas,
                                             *patternAtlas,
+                                            glyphManager->getGlyphAtlas(),
                                             std::move(layersNeedPlacement),
                                             placementController.getPlacement(),
                                             symbolBucketsChanged);
@@ -615,6 +625,20 @@ FeatureExtensionValue RenderOrchestrator::queryFeatureExtensions(
     return {};
 }
 
+std::unique_ptr<AsyncRequest> RenderOrchestrator::queryFeatureExtensions(
+    const std::string& sourceID,
+    const Feature& feature,
+    const std::string& extension,
+    const std::string& extensionField,
+    const std::optional<std::map<std::string, Value>>& args,
+    std::function<void(FeatureExtensionValue)> callback) const {
+    if (RenderSource* renderSource = getRenderSource(sourceID)) {
+        return renderSource->queryFeatureExtensions(feature, extension, extensionField, args, std::move(callback));
+    }
+    callback({});
+    return nullptr;
+}
+
 void RenderOrchestrator::setFeatureState(const std::string& sourceID,
                                          const std::optional<std::string>& sourceLayerID,
                                          const std::string& featureID,
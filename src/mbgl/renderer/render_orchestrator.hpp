@@ -56,6 +56,12 @@ public:
                                                  const std::string& extension,
                                                  const std::string& extensionField,
                                                  const std::optional<std::map<std::string, Value>>& args) const;
+    std::unique_ptr<AsyncRequest> queryFeatureExtensions(const std::string& sourceID,
+                                                         const Feature& feature,
+                                                         const std::string& extension,
+                                                         const std::string& extensionField,
+                                                         const std::optional<std::map<std::string, Value>>& args,
+                                                         std::function<void(FeatureExtensionValue)> callback) const;
 
     void setFeatureState(const std::string& sourceID,
                          const std::optional<std::string>& layerID,
@@ -76,6 +82,7 @@ public:
     void dumpDebugLogs();
     void collectPlacedSymbolData(bool);
     const std::vector<PlacedSymbolData>& getPlacedSymbolsData() const;
+    Duration getPlacementLatency() const { return placementController.getPlacementLatency(); }
     void clearData();
 
 private:
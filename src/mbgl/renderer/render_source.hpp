@@ -10,6 +10,7 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layer_properties.hpp>
 
+#include <functional>
 #include <unordered_map>
 #include <vector>
 #include <map>
@@ -17,6 +18,7 @@
 
 namespace mbgl {
 
+class AsyncRequest;
 class PaintParameters;
 class TransformState;
 class RenderTile;
@@ -91,6 +93,18 @@ public:
         return {};
     }
 
+    // Asynchronous variant of the query above. The default implementation answers synchronously and
+    // returns nullptr.
+    virtual std::unique_ptr<AsyncRequest> queryFeatureExtensions(
+        const Feature& feature,
+        const std::string& extension,
+        const std::string& extensionField,
+        const std::optional<std::map<std::string, Value>>& args,
+        std::function<void(FeatureExtensionValue)> callback) const {
+        callback(queryFeatureExtensions(feature, extension, extensionField, args));
+        return nullptr;
+    }
+
     virtual void setFeatureState(const std::optional<std::string>&, const std::string&, const FeatureState&) {}
 
     virtual void getFeatureState(FeatureState&, const std::optional<std::string>&, const std::string&) const {}
@@ -1,6 +1,7 @@
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/upload_pass.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/programs/program_parameters.hpp>
 
 namespace mbgl {
@@ -49,8 +50,16 @@ static gfx::VertexVector<HeatmapTextureLayoutVertex> heatmapTextureVertices() {
     return result;
 }
 
+static std::optional<std::string> programCacheDir() {
+    auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PROGRAM_CACHE_DIR);
+    if (auto* dir = value.getString()) {
+        if (!dir->empty()) return *dir;
+    }
+    return std::nullopt;
+}
+
 RenderStaticData::RenderStaticData(float pixelRatio, std::unique_ptr<gfx::ShaderRegistry>&& shaders_)
-    : programs(ProgramParameters{pixelRatio, false}),
+    : programs(ProgramParameters{pixelRatio, false, programCacheDir()}),
       shaders(std::move(shaders_)),
       clippingMaskSegments(tileTriangleSegments())
 #ifndef NDEBUG
@@ -87,11 +87,6 @@ std::optional<ImagePosition> RenderTile::getPattern(const std::string& pattern)
     return renderData->getPattern(pattern);
 }
 
-const gfx::Texture& RenderTile::getGlyphAtlasTexture() const {
-    assert(renderData);
-    return renderData->getGlyphAtlasTexture();
-}
-
 const gfx::Texture& RenderTile::getIconAtlasTexture() const {
     assert(renderData);
     return renderData->getIconAtlasTexture();
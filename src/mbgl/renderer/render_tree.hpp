@@ -12,6 +12,7 @@ namespace mbgl {
 
 class PaintParameters;
 class PatternAtlas;
+class GlyphAtlas;
 
 namespace gfx {
 class UploadPass;
@@ -22,6 +23,7 @@ public:
     virtual ~RenderItem() = default;
     virtual void upload(gfx::UploadPass&) const = 0;
     virtual void render(PaintParameters&) const = 0;
+    virtual void prewarm(PaintParameters&) const {}
     virtual bool hasRenderPass(RenderPass) const = 0;
     virtual const std::string& getName() const = 0;
 };
@@ -64,6 +66,7 @@ public:
     // Resources
     virtual LineAtlas& getLineAtlas() const = 0;
     virtual PatternAtlas& getPatternAtlas() const = 0;
+    virtual GlyphAtlas& getGlyphAtlas() const = 0;
     // Parameters
     const RenderTreeParameters& getParameters() const { return *parameters; }
 
@@ -5,6 +5,7 @@
 #include <mbgl/renderer/render_tree.hpp>
 #include <mbgl/gfx/backend_scope.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/util/async_request.hpp>
 
 namespace mbgl {
 
@@ -96,6 +97,17 @@ FeatureExtensionValue Renderer::queryFeatureExtensions(const std::string& source
     return impl->orchestrator.queryFeatureExtensions(sourceID, feature, extension, extensionField, args);
 }
 
+std::unique_ptr<AsyncRequest> Renderer::queryFeatureExtensions(
+    const std::string& sourceID,
+    const Feature& feature,
+    const std::string& extension,
+    const std::string& extensionField,
+    const std::optional<std::map<std::string, Value>>& args,
+    std::function<void(FeatureExtensionValue)> callback) const {
+    return impl->orchestrator.queryFeatureExtensions(
+        sourceID, feature, extension, extensionField, args, std::move(callback));
+}
+
 void Renderer::setFeatureState(const std::string& sourceID,
                                const std::optional<std::string>& sourceLayerID,
                                const std::string& featureID,
@@ -129,6 +141,10 @@ const std::vector<PlacedSymbolData>& Renderer::getPlacedSymbolsData() const {
     return impl->orchestrator.getPlacedSymbolsData();
 }
 
+Duration Renderer::getPlacementLatency() const {
+    return impl->orchestrator.getPlacementLatency();
+}
+
 void Renderer::reduceMemoryUse() {
     gfx::BackendScope guard{impl->backend};
     impl->reduceMemoryUse();
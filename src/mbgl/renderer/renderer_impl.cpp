@@ -13,6 +13,7 @@
 #include <mbgl/renderer/renderer_observer.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tree.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -71,7 +72,8 @@ void Renderer::Impl::render(const RenderTree& renderTree) {
                                renderTreeParameters.transformParams,
                                *staticData,
                                renderTree.getLineAtlas(),
-                               renderTree.getPatternAtlas()};
+                               renderTree.getPatternAtlas(),
+                               renderTree.getGlyphAtlas()};
 
     parameters.symbolFadeChange = renderTreeParameters.symbolFadeChange;
     parameters.opaquePassCutoff = renderTreeParameters.opaquePassCutOff;
@@ -93,6 +95,16 @@ void Renderer::Impl::render(const RenderTree& renderTree) {
         staticData->upload(*uploadPass);
         renderTree.getLineAtlas().upload(*uploadPass);
         renderTree.getPatternAtlas().upload(*uploadPass);
+        renderTree.getGlyphAtlas().setMaximumSize(context.maximumTextureSize);
+        renderTree.getGlyphAtlas().upload(*uploadPass);
+    }
+
+    // - PREWARM -----------------------------------------------------------------------------------
+    // Builds the shader variants that the paint properties of visible layers call for, which lets the
+    // frames drawn while tiles are still loading absorb the cost of compiling them. Layers skip this
+    // until their evaluated properties or programs change.
+    for (const RenderItem& item : layerRenderItems) {
+        item.prewarm(parameters);
     }
 
     // - 3D PASS -------------------------------------------------------------------------------------
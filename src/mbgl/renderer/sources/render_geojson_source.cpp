@@ -3,9 +3,15 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/util/async_request.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <mapbox/eternal.hpp>
 
+#include <cmath>
+#include <unordered_set>
+
 namespace mbgl {
 
 using namespace style;
@@ -32,24 +38,26 @@ FeatureExtensionValue getChildren(std::shared_ptr<style::GeoJSONData> clusterDat
     return clusterData->getChildren(clusterID);
 }
 
-// NOLINTNEXTLINE(performance-unnecessary-value-param)
-FeatureExtensionValue getLeaves(std::shared_ptr<style::GeoJSONData> clusterData,
-                                std::uint32_t clusterID,
-                                const std::optional<std::map<std::string, Value>>& args) {
+// Returns the limit and offset of the leaves query.
+std::pair<std::uint32_t, std::uint32_t> getLeavesRange(const std::optional<std::map<std::string, Value>>& args) {
     if (args) {
         const auto limit = getProperty<uint64_t>(*args, "limit");
         const auto offset = getProperty<uint64_t>(*args, "offset");
         // Offset cannot be set without limit.
         if (limit) {
-            if (offset) {
-                return clusterData->getLeaves(
-                    clusterID, static_cast<std::uint32_t>(*limit), static_cast<std::uint32_t>(*offset));
-            }
-            return clusterData->getLeaves(clusterID, static_cast<std::uint32_t>(*limit), 0u);
+            return {static_cast<std::uint32_t>(*limit), offset ? static_cast<std::uint32_t>(*offset) : 0u};
         }
     }
 
-    return clusterData->getLeaves(clusterID, 10u, 0u);
+    return {10u, 0u};
+}
+
+// NOLINTNEXTLINE(performance-unnecessary-value-param)
+FeatureExtensionValue getLeaves(std::shared_ptr<style::GeoJSONData> clusterData,
+                                std::uint32_t clusterID,
+                                const std::optional<std::map<std::string, Value>>& args) {
+    const auto range = getLeavesRange(args);
+    return clusterData->getLeaves(clusterID, range.first, range.second);
 }
 
 // NOLINTNEXTLINE(performance-unnecessary-value-param)
@@ -59,10 +67,96 @@ FeatureExtensionValue getClusterExpansionZoom(std::shared_ptr<style::GeoJSONData
     return Value{static_cast<uint64_t>(clusterData->getClusterExpansionZoom(clusterID))};
 }
 
+// Returns the tiles, among the given ones, that intersect the given bounds, buffer included.
+std::unordered_set<CanonicalTileID> getChangedTiles(const std::map<OverscaledTileID, std::unique_ptr<Tile>>& tiles,
+                                                    const std::vector<mapbox::geometry::box<double>>& bounds,
+                                                    double buffer) {
+    std::map<uint8_t, std::unordered_set<CanonicalTileID>> tilesByZoom;
+    for (const auto& pair : tiles) {
+        tilesByZoom[pair.first.canonical.z].insert(pair.first.canonical);
+    }
+
+    std::unordered_set<CanonicalTileID> result;
+    for (const auto& zoom : tilesByZoom) {
+        const double scale = std::pow(2.0, zoom.first);
+        const auto toTile = [&](double coordinate) {
+            return static_cast<int64_t>(std::floor(util::clamp(coordinate * scale, 0.0, scale - 1.0)));
+        };
+        const auto addTiles = [&](double minX, double minY, double maxX, double maxY) {
+            const int64_t x0 = toTile(minX), y0 = toTile(minY), x1 = toTile(maxX), y1 = toTile(maxY);
+            if ((x1 - x0 + 1) * (y1 - y0 + 1) > static_cast<int64_t>(zoom.second.size())) {
+                // Cheaper to test the tiles of this zoom level than the ones covered by the bounds.
+                for (const auto& id : zoom.second) {
+                    if (id.x >= x0 && id.x <= x1 && id.y >= y0 && id.y <= y1) result.insert(id);
+                }
+                return;
+            }
+            for (int64_t y = y0; y <= y1; ++y) {
+                for (int64_t x = x0; x <= x1; ++x) {
+                    const CanonicalTileID id(zoom.first, static_cast<uint32_t>(x), static_cast<uint32_t>(y));
+                    if (zoom.second.count(id)) result.insert(id);
+                }
+            }
+        };
+
+        const double margin = buffer / scale;
+        for (const auto& box : bounds) {
+            const double minX = box.min.x - margin, maxX = box.max.x + margin;
+            const double minY = box.min.y - margin, maxY = box.max.y + margin;
+            addTiles(minX, minY, maxX, maxY);
+            // Features close to the antimeridian are also in the buffer of the tiles on the other side.
+            if (minX < 0.0) addTiles(minX + 1.0, minY, 1.0, maxY);
+            if (maxX > 1.0) addTiles(0.0, minY, maxX - 1.0, maxY);
+        }
+    }
+    return result;
+}
+
 MAPBOX_ETERNAL_CONSTEXPR const auto extensionGetters =
     mapbox::eternal::hash_map<mapbox::eternal::string, FeatureExtensionGetterPtr>(
         {{"children", &getChildren}, {"leaves", &getLeaves}, {"expansion-zoom", &getClusterExpansionZoom}});
 
+// Asynchronous variants of the getters above, answered on the scheduler of the data.
+using FeatureExtensionCallback = std::function<void(FeatureExtensionValue)>;
+using FeatureExtensionRequestPtr = std::unique_ptr<AsyncRequest> (*)(
+    style::GeoJSONData&, std::uint32_t, const std::optional<std::map<std::string, Value>>&, FeatureExtensionCallback);
+
+std::unique_ptr<AsyncRequest> requestChildren(style::GeoJSONData& clusterData,
+                                              std::uint32_t clusterID,
+                                              const std::optional<std::map<std::string, Value>>&,
+                                              FeatureExtensionCallback callback) {
+    return clusterData.requestChildren(
+        clusterID, [callback = std::move(callback)](style::GeoJSONData::Features children) {
+            callback(std::move(children));
+        });
+}
+
+std::unique_ptr<AsyncRequest> requestLeaves(style::GeoJSONData& clusterData,
+                                            std::uint32_t clusterID,
+                                            const std::optional<std::map<std::string, Value>>& args,
+                                            FeatureExtensionCallback callback) {
+    const auto range = getLeavesRange(args);
+    return clusterData.requestLeaves(
+        clusterID, range.first, range.second, [callback = std::move(callback)](style::GeoJSONData::Features leaves) {
+            callback(std::move(leaves));
+        });
+}
+
+std::unique_ptr<AsyncRequest> requestClusterExpansionZoom(style::GeoJSONData& clusterData,
+                                                          std::uint32_t clusterID,
+                                                          const std::optional<std::map<std::string, Value>>&,
+                                                          FeatureExtensionCallback callback) {
+    return clusterData.requestClusterExpansionZoom(clusterID, [callback = std::move(callback)](std::uint8_t zoom) {
+        callback(Value{static_cast<uint64_t>(zoom)});
+    });
+}
+
+MAPBOX_ETERNAL_CONSTEXPR const auto extensionRequests =
+    mapbox::eternal::hash_map<mapbox::eternal::string, FeatureExtensionRequestPtr>(
+        {{"children", &requestChildren},
+         {"leaves", &requestLeaves},
+         {"expansion-zoom", &requestClusterExpansionZoom}});
+
 } // namespace
 
 RenderGeoJSONSource::RenderGeoJSONSource(Immutable<style::GeoJSONSource::Impl> impl_)
@@ -84,16 +178,26 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
     enabled = needsRendering;
 
     auto data_ = impl().getData().lock();
-    if (data.lock() != data_) {
+    if (data != data_) {
+        auto previousData = std::move(data);
         data = data_;
         if (parameters.mode != MapMode::Continuous) {
             // Clearing the tile pyramid in order to avoid render tests being flaky.
             tilePyramid.clearAll();
         } else if (data_) {
             tilePyramid.reduceMemoryUse();
+            std::optional<std::unordered_set<CanonicalTileID>> changedTiles;
+            if (previousData && !needsRelayout) {
+                // When only some features were updated by id, only the tiles they touch are reloaded.
+                if (auto changedBounds = data_->getChangedBoundsSince(*previousData)) {
+                    const double buffer = impl().getOptions()->buffer / util::tileSize_D;
+                    changedTiles = getChangedTiles(tilePyramid.getTiles(), *changedBounds, buffer);
+                }
+            }
             const uint8_t maxZ = impl().getZoomRange().max;
             for (const auto& pair : tilePyramid.getTiles()) {
-                if (pair.first.canonical.z <= maxZ) {
+                if (pair.first.canonical.z <= maxZ &&
+                    (!changedTiles || changedTiles->count(pair.first.canonical))) {
                     static_cast<GeoJSONTile*>(pair.second.get())->updateData(data_, needsRelayout);
                 }
             }
@@ -134,12 +238,29 @@ mapbox::util::variant<Value, FeatureCollection> RenderGeoJSONSource::queryFeatur
         return {};
     }
 
-    auto jsonData = data.lock();
-    if (!jsonData) {
+    if (!data) {
         return {};
     }
 
-    return extensionIt->second(std::move(jsonData), static_cast<std::uint32_t>(*clusterID), args);
+    return extensionIt->second(data, static_cast<std::uint32_t>(*clusterID), args);
+}
+
+std::unique_ptr<AsyncRequest> RenderGeoJSONSource::queryFeatureExtensions(
+    const Feature& feature,
+    const std::string& extension,
+    const std::string& extensionField,
+    const std::optional<std::map<std::string, Value>>& args,
+    std::function<void(FeatureExtensionValue)> callback) const {
+    assert(callback);
+    const auto extensionIt = extensionRequests.find(extensionField.c_str());
+    const auto clusterID = getProperty<uint64_t>(feature.properties, "cluster_id");
+    if (extension != "supercluster" || extensionIt == extensionRequests.end() || !clusterID || !data) {
+        callback({});
+        return nullptr;
+    }
+
+    // Pending queries hold on to the cluster index they read, not to this source or its data.
+    return extensionIt->second(*data, static_cast<std::uint32_t>(*clusterID), args, std::move(callback));
 }
 
 } // namespace mbgl
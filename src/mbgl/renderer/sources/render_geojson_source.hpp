@@ -26,10 +26,19 @@ public:
         const std::string& extensionField,
         const std::optional<std::map<std::string, Value>>& args) const override;
 
+    std::unique_ptr<AsyncRequest> queryFeatureExtensions(
+        const Feature& feature,
+        const std::string& extension,
+        const std::string& extensionField,
+        const std::optional<std::map<std::string, Value>>& args,
+        std::function<void(FeatureExtensionValue)> callback) const override;
+
 private:
     const style::GeoJSONSource::Impl& impl() const;
 
-    std::weak_ptr<style::GeoJSONData> data;
+    // Kept alive so that the tiles changed by the next update of the data can be found, even if no
+    // tile uses this version of the data.
+    std::shared_ptr<style::GeoJSONData> data;
 };
 
 } // namespace mbgl
@@ -3,6 +3,7 @@
 #include <mbgl/map/mode.hpp>
 
 #include <memory>
+#include <vector>
 
 #include <mapbox/std/weak.hpp>
 
@@ -25,6 +26,8 @@ public:
     ImageManager& imageManager;
     GlyphManager& glyphManager;
     const uint8_t prefetchZoomDelta;
+    // States along the path of the running camera animation, destination first; may be null.
+    const std::shared_ptr<const std::vector<TransformState>> cameraTrajectory;
 };
 
 } // namespace mbgl
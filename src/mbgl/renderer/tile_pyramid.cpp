@@ -5,6 +5,7 @@
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/math/clamp.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/util/tile_cover.hpp>
 #include <mbgl/util/tile_range.hpp>
 #include <mbgl/util/enum.hpp>
@@ -23,8 +24,20 @@ using namespace style;
 
 static TileObserver nullObserver;
 
+static constexpr std::size_t defaultCameraPrefetchTiles = 32;
+
 TilePyramid::TilePyramid()
-    : observer(&nullObserver) {}
+    : observer(&nullObserver),
+      cameraPrefetchTiles(defaultCameraPrefetchTiles) {
+    auto& settings = platform::Settings::getInstance();
+    if (auto* prefetchTiles = settings.get(platform::EXPERIMENTAL_CAMERA_PREFETCH_TILES).getUint()) {
+        cameraPrefetchTiles = static_cast<std::size_t>(*prefetchTiles);
+    }
+    if (auto* maxBytes = settings.get(platform::EXPERIMENTAL_TILE_CACHE_MAX_BYTES).getUint()) {
+        defaultCacheMaxBytes = static_cast<std::size_t>(*maxBytes);
+    }
+    cache.setMaxBytes(defaultCacheMaxBytes);
+}
 
 TilePyramid::~TilePyramid() = default;
 
@@ -61,6 +74,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     if (needsRelayout) {
         cache.clear();
     }
+    cache.setMaxBytes(sourceImpl.getTileCacheMaxBytes().value_or(defaultCacheMaxBytes));
 
     // If we're not going to render anything, move our existing tiles into
     // the cache (if they're not stale) or abandon them, and return.
@@ -131,6 +145,33 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
         }
     }
 
+    // Tiles along the path of a running camera animation, destination first. They're requested at low
+    // priority so that they're loaded, or at least on their way, by the time the camera gets there.
+    std::vector<OverscaledTileID> trajectoryTiles;
+    if (parameters.mode == MapMode::Continuous && parameters.cameraTrajectory && cameraPrefetchTiles > 0 &&
+        type != SourceType::GeoJSON && type != SourceType::Annotations) {
+        std::set<OverscaledTileID> seen(idealTiles.begin(), idealTiles.end());
+        for (const TransformState& state : *parameters.cameraTrajectory) {
+            if (trajectoryTiles.size() == cameraPrefetchTiles) {
+                break;
+            }
+            const int32_t stateZoom = util::coveringZoomLevel(state.getZoom(), type, tileSize);
+            if (stateZoom < zoomRange.min) {
+                continue;
+            }
+            const int32_t stateIdealZoom = std::min<int32_t>(zoomRange.max, stateZoom);
+            const int32_t stateTileZoom = type == SourceType::Raster ? stateIdealZoom : stateZoom;
+            for (const auto& tileID : util::tileCover(state, stateIdealZoom, stateTileZoom)) {
+                if (trajectoryTiles.size() == cameraPrefetchTiles) {
+                    break;
+                }
+                if (seen.insert(tileID).second) {
+                    trajectoryTiles.push_back(tileID);
+                }
+            }
+        }
+    }
+
     // Stores a list of all the tiles that we're definitely going to retain. There are two
     // kinds of tiles we need: the ideal tiles determined by the tile cover. They may not yet be in
     // use because they're still loading. In addition to that, we also need to retain all tiles that
@@ -199,6 +240,17 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
     algorithm::updateRenderables(
         getTileFn, createTileFn, retainTileFn, renderTileFn, idealTiles, zoomRange, maxParentTileOverscaleFactor);
 
+    // Tiles that are already retained, e.g. as ideal tiles, keep their necessity.
+    for (const auto& tileID : trajectoryTiles) {
+        Tile* tile = getTileFn(tileID);
+        if (!tile) {
+            tile = createTileFn(tileID);
+        }
+        if (tile) {
+            retainTileFn(*tile, TileNecessity::Prefetch);
+        }
+    }
+
     for (auto previouslyRenderedTile : previouslyRenderedTiles) {
         Tile& tile = previouslyRenderedTile.second;
         tile.markRenderedPreviously();
@@ -83,6 +83,11 @@ private:
 
     float prevLng = 0;
 
+    // Maximum number of tiles requested ahead of a camera animation.
+    std::size_t cameraPrefetchTiles;
+    // Byte budget of the cache of a source that doesn't set its own.
+    std::size_t defaultCacheMaxBytes = 0;
+
     bool fadingTiles = false;
 };
 
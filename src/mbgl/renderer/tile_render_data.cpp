@@ -9,12 +9,6 @@ TileRenderData::TileRenderData(std::shared_ptr<TileAtlasTextures> atlasTextures_
 
 TileRenderData::~TileRenderData() = default;
 
-const gfx::Texture& TileRenderData::getGlyphAtlasTexture() const {
-    assert(atlasTextures);
-    assert(atlasTextures->glyph);
-    return *atlasTextures->glyph;
-}
-
 const gfx::Texture& TileRenderData::getIconAtlasTexture() const {
     assert(atlasTextures);
     assert(atlasTextures->icon);
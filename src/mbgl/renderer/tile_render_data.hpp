@@ -19,14 +19,12 @@ class SourcePrepareParameters;
 
 class TileAtlasTextures {
 public:
-    std::optional<gfx::Texture> glyph;
     std::optional<gfx::Texture> icon;
 };
 
 class TileRenderData {
 public:
     virtual ~TileRenderData();
-    const gfx::Texture& getGlyphAtlasTexture() const;
     const gfx::Texture& getIconAtlasTexture() const;
     // To be implemented for concrete tile types.
     virtual std::optional<ImagePosition> getPattern(const std::string&) const;
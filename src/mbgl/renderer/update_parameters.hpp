@@ -9,6 +9,7 @@
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/immutable.hpp>
 
+#include <memory>
 #include <vector>
 
 #include <mapbox/std/weak.hpp>
@@ -39,6 +40,8 @@ public:
     std::shared_ptr<FileSource> fileSource;
 
     const uint8_t prefetchZoomDelta;
+    // States along the path of the running camera animation, destination first.
+    const std::shared_ptr<const std::vector<TransformState>> cameraTrajectory;
 
     // For still image requests, render requested
     const bool stillImageRequest;
@@ -20,8 +20,8 @@ namespace mbgl {
 static SpriteLoaderObserver nullObserver;
 
 struct SpriteLoader::Data {
-    std::shared_ptr<const std::string> image;
-    std::shared_ptr<const std::string> json;
+    SharedBuffer image;
+    SharedBuffer json;
     std::unique_ptr<AsyncRequest> jsonRequest;
     std::unique_ptr<AsyncRequest> spriteRequest;
 };
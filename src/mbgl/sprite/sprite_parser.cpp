@@ -41,7 +41,8 @@ std::unique_ptr<style::Image> createStyleImage(const std::string& id,
     }
 
     const Size size(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
-    PremultipliedImage dstImage(size);
+    // Every pixel is copied from the sheet, so the buffer is left uninitialized instead of being zeroed.
+    PremultipliedImage dstImage(size, std::unique_ptr<uint8_t[]>(new uint8_t[size.width * size.height * 4]));
 
     // Copy from the source image into our individual sprite image
     PremultipliedImage::copy(image, dstImage, {static_cast<uint32_t>(srcX), static_cast<uint32_t>(srcY)}, {0, 0}, size);
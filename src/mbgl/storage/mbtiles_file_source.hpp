@@ -5,9 +5,13 @@
 #include <mbgl/util/client_options.hpp>
 #include <mbgl/util/thread.hpp>
 
+#include <atomic>
+#include <vector>
+
 namespace mbgl {
 // File source for supporting .mbtiles maps.
-// can only load resource URLS that are absolute paths to local files
+// can only load resource URLS that are absolute paths to local files.
+// Tiles are read by a pool of threads, each with its own read-only connection to the archives.
 class MBTilesFileSource : public FileSource {
 public:
     MBTilesFileSource(const ResourceOptions& resourceOptions, const ClientOptions& clientOptions);
@@ -24,7 +28,12 @@ public:
 
 private:
     class Impl;
-    std::unique_ptr<util::Thread<Impl>> thread; // impl
+    struct TileQueue;
+
+    std::shared_ptr<TileQueue> tileQueue;
+    // The first reader also generates the TileJSON and keeps the options.
+    std::vector<std::unique_ptr<util::Thread<Impl>>> readers;
+    std::atomic<std::size_t> nextReader{0};
 };
 
 } // namespace mbgl
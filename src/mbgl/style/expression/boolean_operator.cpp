@@ -41,6 +41,17 @@ EvaluationResult All::evaluate(const EvaluationContext& params) const {
     return EvaluationResult(true);
 }
 
+void All::select(const EvaluationContext& params,
+                 const GeometryTileLayer& layer,
+                 std::vector<std::size_t>& selection) const {
+    // Inputs are boolean, and an input failing to evaluate fails the whole expression, so each input
+    // narrows down the selection left by the previous ones and only tests the features still selected.
+    for (const auto& input : inputs) {
+        if (selection.empty()) return;
+        input->select(params, layer, selection);
+    }
+}
+
 void All::eachChild(const std::function<void(const Expression&)>& visit) const {
     for (const std::unique_ptr<Expression>& input : inputs) {
         visit(*input);
@@ -1,7 +1,11 @@
 #include <mbgl/style/expression/collator.hpp>
 #include <mbgl/style/expression/comparison.hpp>
 #include <mbgl/style/expression/dsl.hpp>
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/style/expression/util.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+
 #include <utility>
 
 namespace mbgl {
@@ -120,9 +124,28 @@ BasicComparison::BasicComparison(std::string op_, std::unique_ptr<Expression> lh
 
     needsRuntimeTypeCheck = (op != "==" && op != "!=") &&
                             (lhs->getType() == type::Value || rhs->getType() == type::Value);
+
+    if (op == "==" || op == "!=") {
+        const auto specialize = [&](const Expression& property, const Expression& operand) {
+            if (operand.getKind() != Kind::Literal) return;
+            propertyKey = getFeaturePropertyKey(property);
+            if (propertyKey) {
+                propertyOperand = static_cast<const Literal&>(operand).getValue();
+            }
+        };
+        specialize(*lhs, *rhs);
+        if (!propertyKey) specialize(*rhs, *lhs);
+    }
 }
 
 EvaluationResult BasicComparison::evaluate(const EvaluationContext& params) const {
+    if (propertyKey) {
+        if (!params.feature) {
+            return EvaluationError{"Feature data is unavailable in the current evaluation context."};
+        }
+        return EvaluationResult(compareProperty(*params.feature));
+    }
+
     EvaluationResult lhsResult = lhs->evaluate(params);
     if (!lhsResult) return lhsResult;
 
@@ -143,6 +166,28 @@ EvaluationResult BasicComparison::evaluate(const EvaluationContext& params) cons
     return compare(*lhsResult, *rhsResult);
 }
 
+void BasicComparison::select(const EvaluationContext& params,
+                             const GeometryTileLayer& layer,
+                             std::vector<std::size_t>& selection) const {
+    if (!propertyKey) {
+        Expression::select(params, layer, selection);
+        return;
+    }
+    std::size_t kept = 0;
+    for (const std::size_t index : selection) {
+        if (compareProperty(*layer.getFeature(index))) {
+            selection[kept++] = index;
+        }
+    }
+    selection.resize(kept);
+}
+
+bool BasicComparison::compareProperty(const GeometryTileFeature& feature) const {
+    const std::optional<mbgl::Value> property = feature.getValue(*propertyKey);
+    const bool equal = property ? featurePropertyEquals(*property, *propertyOperand) : propertyOperand->is<NullValue>();
+    return compare == eq ? equal : !equal;
+}
+
 void BasicComparison::eachChild(const std::function<void(const Expression&)>& visit) const {
     visit(*lhs);
     visit(*rhs);
@@ -1,6 +1,8 @@
 #include <mbgl/style/expression/compound_expression.hpp>
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <cassert>
 #include <utility>
 
 namespace mbgl {
@@ -54,7 +56,7 @@ EvaluationResult Expression::evaluate(std::optional<float> zoom,
 EvaluationResult Expression::evaluate(std::optional<float> zoom,
                                       const Feature& feature,
                                       std::optional<double> colorRampParameter,
-                                      const std::set<std::string>& availableImages) const {
+                                      const AvailableImages& availableImages) const {
     GeoJSONFeature f(feature);
     return this->evaluate(
         EvaluationContext(std::move(zoom), &f, std::move(colorRampParameter)).withAvailableImages(&availableImages));
@@ -63,7 +65,7 @@ EvaluationResult Expression::evaluate(std::optional<float> zoom,
 EvaluationResult Expression::evaluate(std::optional<float> zoom,
                                       const Feature& feature,
                                       std::optional<double> colorRampParameter,
-                                      const std::set<std::string>& availableImages,
+                                      const AvailableImages& availableImages,
                                       const CanonicalTileID& canonical) const {
     GeoJSONFeature f(feature, canonical);
     return this->evaluate(EvaluationContext(std::move(zoom), &f, std::move(colorRampParameter))
@@ -76,6 +78,23 @@ EvaluationResult Expression::evaluate(std::optional<mbgl::Value> accumulated, co
     return this->evaluate(EvaluationContext(std::move(accumulated), &f));
 }
 
+void Expression::select(const EvaluationContext& params,
+                        const GeometryTileLayer& layer,
+                        std::vector<std::size_t>& selection) const {
+    EvaluationContext context = params;
+    std::size_t kept = 0;
+    for (const std::size_t index : selection) {
+        assert(index < layer.featureCount());
+        const std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(index);
+        context.feature = feature.get();
+        const EvaluationResult result = evaluate(context);
+        if (result && result->is<bool>() && result->get<bool>()) {
+            selection[kept++] = index;
+        }
+    }
+    selection.resize(kept);
+}
+
 } // namespace expression
 } // namespace style
 } // namespace mbgl
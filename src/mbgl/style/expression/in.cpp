@@ -1,8 +1,13 @@
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/style/expression/in.hpp>
+#include <mbgl/style/expression/literal.hpp>
 #include <mbgl/style/expression/type.hpp>
+#include <mbgl/style/expression/util.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace mbgl {
@@ -34,9 +39,37 @@ In::In(std::unique_ptr<Expression> needle_, std::unique_ptr<Expression> haystack
       haystack(std::move(haystack_)) {
     assert(isComparableType(needle->getType()));
     assert(isSearchableType(haystack->getType()));
+
+    if (haystack->getKind() != Kind::Literal) return;
+    const Value elements = static_cast<const Literal&>(*haystack).getValue();
+    if (!elements.is<std::vector<Value>>()) return;
+    propertyKey = getFeaturePropertyKey(*needle);
+    if (!propertyKey) return;
+
+    for (const Value& element : elements.get<std::vector<Value>>()) {
+        element.match([&](bool b) { (b ? containsTrue : containsFalse) = true; },
+                      [&](double n) {
+                          if (!std::isnan(n)) numbers.push_back(n);
+                      },
+                      [&](const std::string& s) { strings.push_back(s); },
+                      // Other elements never equal a scalar property.
+                      [&](const auto&) {});
+    }
+    std::sort(numbers.begin(), numbers.end());
+    std::sort(strings.begin(), strings.end());
 }
 
 EvaluationResult In::evaluate(const EvaluationContext& params) const {
+    if (propertyKey) {
+        if (!params.feature) {
+            return EvaluationError{"Feature data is unavailable in the current evaluation context."};
+        }
+        const std::optional<bool> found = searchProperty(*params.feature);
+        if (found) {
+            return EvaluationResult(*found);
+        }
+    }
+
     const EvaluationResult evaluatedHaystack = haystack->evaluate(params);
     if (!evaluatedHaystack) {
         return evaluatedHaystack.error();
@@ -74,6 +107,44 @@ EvaluationResult In::evaluate(const EvaluationContext& params) const {
     }
 }
 
+std::optional<bool> In::searchProperty(const GeometryTileFeature& feature) const {
+    const std::optional<mbgl::Value> property = feature.getValue(*propertyKey);
+    if (!property) {
+        return false;
+    }
+    const auto containsNumber = [&](double n) {
+        return std::binary_search(numbers.begin(), numbers.end(), n);
+    };
+    return property->match(
+        [&](const NullValue&) -> std::optional<bool> { return false; },
+        [&](bool b) -> std::optional<bool> { return b ? containsTrue : containsFalse; },
+        [&](uint64_t n) -> std::optional<bool> { return containsNumber(static_cast<double>(n)); },
+        [&](int64_t n) -> std::optional<bool> { return containsNumber(static_cast<double>(n)); },
+        [&](double n) -> std::optional<bool> { return !std::isnan(n) && containsNumber(n); },
+        [&](const std::string& s) -> std::optional<bool> {
+            return std::binary_search(strings.begin(), strings.end(), s);
+        },
+        // Arrays and objects are left to evaluate(), which reports them.
+        [&](const auto&) -> std::optional<bool> { return std::nullopt; });
+}
+
+void In::select(const EvaluationContext& params,
+                const GeometryTileLayer& layer,
+                std::vector<std::size_t>& selection) const {
+    if (!propertyKey) {
+        Expression::select(params, layer, selection);
+        return;
+    }
+    std::size_t kept = 0;
+    for (const std::size_t index : selection) {
+        // Evaluating fails for properties that aren't scalars.
+        if (searchProperty(*layer.getFeature(index)).value_or(false)) {
+            selection[kept++] = index;
+        }
+    }
+    selection.resize(kept);
+}
+
 void In::eachChild(const std::function<void(const Expression&)>& visit) const {
     visit(*needle);
     visit(*haystack);
@@ -1,7 +1,11 @@
 #include <mbgl/style/expression/interpolate.hpp>
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/style/expression/util.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 namespace style {
 namespace expression {
@@ -16,17 +20,40 @@ public:
                     std::unique_ptr<Expression> input_,
                     // NOLINTNEXTLINE(performance-unnecessary-value-param)
                     std::map<double, std::unique_ptr<Expression>> stops_)
-        : Interpolate(type_, interpolator_, std::move(input_), std::move(stops_)) {
+        : Interpolate(type_, interpolator_, std::move(input_), std::move(stops_)),
+          zoomInput(isZoomExpression(*input)) {
         static_assert(util::Interpolatable<T>::value, "Interpolate expression requires an interpolatable value type.");
+
+        // Stops with literal outputs, the common case once constant subexpressions are folded, are kept
+        // in flat arrays that are searched and interpolated without evaluating the stop expressions.
+        for (const auto& stop : stops) {
+            if (stop.second->getKind() != Kind::Literal) break;
+            const Value output = static_cast<const Literal&>(*stop.second).getValue();
+            if (!output.is<T>()) break;
+            stopInputs.push_back(stop.first);
+            stopOutputs.push_back(output.get<T>());
+        }
+        if (stopOutputs.size() != stops.size()) {
+            stopInputs.clear();
+            stopOutputs.clear();
+        }
     }
 
     EvaluationResult evaluate(const EvaluationContext& params) const override {
-        const EvaluationResult evaluatedInput = input->evaluate(params);
-        if (!evaluatedInput) {
-            return evaluatedInput.error();
+        float x;
+        if (zoomInput) {
+            if (!params.zoom) {
+                return EvaluationError{"The 'zoom' expression is unavailable in the current evaluation context."};
+            }
+            x = static_cast<float>(*params.zoom);
+        } else {
+            const EvaluationResult evaluatedInput = input->evaluate(params);
+            if (!evaluatedInput) {
+                return evaluatedInput.error();
+            }
+            x = *fromExpressionValue<float>(*evaluatedInput);
         }
 
-        float x = *fromExpressionValue<float>(*evaluatedInput);
         if (std::isnan(x)) {
             return EvaluationError{"Input is not a number."};
         }
@@ -35,6 +62,10 @@ public:
             return EvaluationError{"No stops in exponential curve."};
         }
 
+        if (!stopOutputs.empty()) {
+            return interpolateLiteralStops(x);
+        }
+
         auto it = stops.upper_bound(x);
         if (it == stops.end()) {
             return stops.rbegin()->second->evaluate(params);
@@ -71,6 +102,32 @@ public:
             return util::interpolate(lower->get<T>(), upper->get<T>(), t);
         }
     }
+
+private:
+    EvaluationResult interpolateLiteralStops(float x) const {
+        const auto upper = static_cast<std::size_t>(
+            std::upper_bound(stopInputs.begin(), stopInputs.end(), x) - stopInputs.begin());
+        if (upper == stopInputs.size()) {
+            return Value(stopOutputs.back());
+        } else if (upper == 0) {
+            return Value(stopOutputs.front());
+        }
+
+        const std::size_t lower = upper - 1;
+        const double t = interpolationFactor({stopInputs[lower], stopInputs[upper]}, x);
+        if (t == 0.0) {
+            return Value(stopOutputs[lower]);
+        }
+        if (t == 1.0) {
+            return Value(stopOutputs[upper]);
+        }
+        return Value(util::interpolate(stopOutputs[lower], stopOutputs[upper], t));
+    }
+
+    // Whether the input is ["zoom"], which is read from the evaluation context directly.
+    const bool zoomInput;
+    std::vector<double> stopInputs;
+    std::vector<T> stopOutputs;
 };
 
 ParseResult parseInterpolate(const Convertible& value, ParsingContext& ctx) {
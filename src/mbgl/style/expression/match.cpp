@@ -1,13 +1,26 @@
 #include <mbgl/style/expression/match.hpp>
 #include <mbgl/style/expression/check_subtype.hpp>
 #include <mbgl/style/expression/parsing_context.hpp>
+#include <mbgl/style/expression/util.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/string.hpp>
 
 namespace mbgl {
 namespace style {
 namespace expression {
 
+template <typename T>
+Match<T>::Match(const type::Type& type_,
+                std::unique_ptr<Expression> input_,
+                Branches branches_,
+                std::unique_ptr<Expression> otherwise_)
+    : Expression(Kind::Match, type_),
+      input(std::move(input_)),
+      branches(std::move(branches_)),
+      otherwise(std::move(otherwise_)),
+      propertyKey(getFeaturePropertyKey(*input)) {}
+
 template <typename T>
 void Match<T>::eachChild(const std::function<void(const Expression&)>& visit) const {
     visit(*input);
@@ -79,6 +92,20 @@ mbgl::Value Match<T>::serialize() const {
 
 template <>
 EvaluationResult Match<std::string>::evaluate(const EvaluationContext& params) const {
+    if (propertyKey) {
+        if (!params.feature) {
+            return EvaluationError{"Feature data is unavailable in the current evaluation context."};
+        }
+        const std::optional<mbgl::Value> property = params.feature->getValue(*propertyKey);
+        if (property && property->is<std::string>()) {
+            auto it = branches.find(property->get<std::string>());
+            if (it != branches.end()) {
+                return (*it).second->evaluate(params);
+            }
+        }
+        return otherwise->evaluate(params);
+    }
+
     const EvaluationResult inputValue = input->evaluate(params);
     if (!inputValue) {
         return inputValue.error();
@@ -98,16 +125,29 @@ EvaluationResult Match<std::string>::evaluate(const EvaluationContext& params) c
 
 template <>
 EvaluationResult Match<int64_t>::evaluate(const EvaluationContext& params) const {
-    const EvaluationResult inputValue = input->evaluate(params);
-    if (!inputValue) {
-        return inputValue.error();
-    }
+    double numeric;
+    if (propertyKey) {
+        if (!params.feature) {
+            return EvaluationError{"Feature data is unavailable in the current evaluation context."};
+        }
+        const std::optional<mbgl::Value> property = params.feature->getValue(*propertyKey);
+        const std::optional<double> number = property ? featurePropertyNumber(*property) : std::nullopt;
+        if (!number) {
+            return otherwise->evaluate(params);
+        }
+        numeric = *number;
+    } else {
+        const EvaluationResult inputValue = input->evaluate(params);
+        if (!inputValue) {
+            return inputValue.error();
+        }
 
-    if (!inputValue->is<double>()) {
-        return otherwise->evaluate(params);
+        if (!inputValue->is<double>()) {
+            return otherwise->evaluate(params);
+        }
+        numeric = inputValue->get<double>();
     }
 
-    const auto numeric = inputValue->get<double>();
     const auto rounded = static_cast<int64_t>(std::floor(numeric));
     if (numeric == rounded) {
         auto it = branches.find(rounded);
@@ -1,4 +1,6 @@
 #include <mbgl/style/expression/util.hpp>
+#include <mbgl/style/expression/compound_expression.hpp>
+#include <mbgl/style/expression/literal.hpp>
 #include <mbgl/style/expression/value.hpp>
 
 namespace mbgl {
@@ -23,6 +25,48 @@ Result<Color> rgba(double r, double g, double b, double a) {
                  static_cast<float>(a));
 }
 
+std::optional<std::string> getFeaturePropertyKey(const Expression& expression) {
+    if (expression.getKind() != Kind::CompoundExpression) return std::nullopt;
+    const auto& compound = static_cast<const CompoundExpression&>(expression);
+    const std::optional<std::size_t> parameterCount = compound.getParameterCount();
+    if (compound.getOperator() != "get" || !parameterCount || *parameterCount != 1) return std::nullopt;
+
+    std::optional<std::string> key;
+    compound.eachChild([&](const Expression& child) {
+        if (child.getKind() != Kind::Literal) return;
+        const Value value = static_cast<const Literal&>(child).getValue();
+        if (value.is<std::string>()) {
+            key = value.get<std::string>();
+        }
+    });
+    return key;
+}
+
+bool isZoomExpression(const Expression& expression) {
+    if (expression.getKind() != Kind::CompoundExpression) return false;
+    const auto& compound = static_cast<const CompoundExpression&>(expression);
+    const std::optional<std::size_t> parameterCount = compound.getParameterCount();
+    return compound.getOperator() == "zoom" && parameterCount && *parameterCount == 0;
+}
+
+bool featurePropertyEquals(const mbgl::Value& property, const Value& value) {
+    return property.match(
+        [&](const NullValue&) { return value.is<NullValue>(); },
+        [&](bool b) { return value.is<bool>() && value.get<bool>() == b; },
+        [&](uint64_t n) { return value.is<double>() && value.get<double>() == static_cast<double>(n); },
+        [&](int64_t n) { return value.is<double>() && value.get<double>() == static_cast<double>(n); },
+        [&](double n) { return value.is<double>() && value.get<double>() == n; },
+        [&](const std::string& s) { return value.is<std::string>() && value.get<std::string>() == s; },
+        [&](const auto&) { return toExpressionValue(property) == value; });
+}
+
+std::optional<double> featurePropertyNumber(const mbgl::Value& property) {
+    return property.match([](uint64_t n) -> std::optional<double> { return static_cast<double>(n); },
+                          [](int64_t n) -> std::optional<double> { return static_cast<double>(n); },
+                          [](double n) -> std::optional<double> { return n; },
+                          [](const auto&) -> std::optional<double> { return std::nullopt; });
+}
+
 } // namespace expression
 } // namespace style
 } // namespace mbgl
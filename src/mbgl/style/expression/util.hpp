@@ -3,12 +3,29 @@
 #include <mbgl/style/expression/expression.hpp>
 #include <mbgl/util/color.hpp>
 
+#include <optional>
+#include <string>
+
 namespace mbgl {
 namespace style {
 namespace expression {
 
 Result<Color> rgba(double r, double g, double b, double a);
 
+// Returns the key of a ["get", key] expression reading a constant property of the evaluated feature.
+// Expressions testing such a property look it up directly instead of evaluating the child expression.
+std::optional<std::string> getFeaturePropertyKey(const Expression&);
+
+// Whether the expression is ["zoom"].
+bool isZoomExpression(const Expression&);
+
+// Whether a feature property equals the given value once converted with toExpressionValue(), without
+// converting scalars.
+bool featurePropertyEquals(const mbgl::Value& property, const Value& value);
+
+// Returns the number a feature property converts to with toExpressionValue(), if any.
+std::optional<double> featurePropertyNumber(const mbgl::Value& property);
+
 } // namespace expression
 } // namespace style
 } // namespace mbgl
@@ -1,6 +1,8 @@
 #include <mbgl/style/filter.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
+#include <numeric>
+
 namespace mbgl {
 namespace style {
 
@@ -16,5 +18,15 @@ bool Filter::operator()(const expression::EvaluationContext &context) const {
     }
 }
 
+std::vector<std::size_t> Filter::select(const expression::EvaluationContext& context,
+                                        const GeometryTileLayer& layer) const {
+    std::vector<std::size_t> selection(layer.featureCount());
+    std::iota(selection.begin(), selection.end(), std::size_t(0));
+    if (this->expression) {
+        (*this->expression)->select(context, layer, selection);
+    }
+    return selection;
+}
+
 } // namespace style
 } // namespace mbgl
@@ -169,7 +169,7 @@ public:
                           const GeometryTileFeature& feature,
                           const PossiblyEvaluatedPropertyValue<T>& v,
                           const T& defaultValue,
-                          const std::set<std::string>& availableImages) {
+                          const AvailableImages& availableImages) {
             return v.match(
                 [&](const T& t) { return t; },
                 [&](const PropertyExpression<T>& t) { return t.evaluate(z, feature, availableImages, defaultValue); });
@@ -180,7 +180,7 @@ public:
                           const GeometryTileFeature& feature,
                           const PossiblyEvaluatedPropertyValue<T>& v,
                           const T& defaultValue,
-                          const std::set<std::string>& availableImages,
+                          const AvailableImages& availableImages,
                           const CanonicalTileID& canonical) {
             return v.match([&](const T& t) { return t; },
                            [&](const PropertyExpression<T>& t) {
@@ -225,14 +225,14 @@ public:
         }
 
         template <class P>
-        auto evaluate(float z, const GeometryTileFeature& feature, const std::set<std::string>& availableImages) const {
+        auto evaluate(float z, const GeometryTileFeature& feature, const AvailableImages& availableImages) const {
             return evaluate(z, feature, this->template get<P>(), P::defaultValue(), availableImages);
         }
 
         template <class P>
         auto evaluate(float z,
                       const GeometryTileFeature& feature,
-                      const std::set<std::string>& availableImages,
+                      const AvailableImages& availableImages,
                       const CanonicalTileID& canonical) const {
             return evaluate(z, feature, this->template get<P>(), P::defaultValue(), availableImages, canonical);
         }
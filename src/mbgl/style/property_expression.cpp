@@ -1,14 +1,40 @@
 #include <mbgl/style/property_expression.hpp>
+#include <mbgl/style/expression/util.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 
 namespace mbgl {
 namespace style {
 
+namespace {
+
+// Returns the key of a property read as is, or through an assertion of a scalar type. Such assertions
+// fail for the same values that fromExpressionValue() rejects for the properties asserting them.
+std::optional<std::string> propertyReadByExpression(const expression::Expression& e) {
+    if (e.getKind() != expression::Kind::Assertion) {
+        return expression::getFeaturePropertyKey(e);
+    }
+    const expression::type::Type type = e.getType();
+    if (!(type == expression::type::Number || type == expression::type::String || type == expression::type::Boolean)) {
+        return std::nullopt;
+    }
+    std::size_t inputs = 0;
+    std::optional<std::string> key;
+    e.eachChild([&](const expression::Expression& input) {
+        ++inputs;
+        key = expression::getFeaturePropertyKey(input);
+    });
+    return inputs == 1 ? key : std::nullopt;
+}
+
+} // namespace
+
 PropertyExpressionBase::PropertyExpressionBase(std::unique_ptr<expression::Expression> expression_)
     : expression(std::move(expression_)),
       zoomCurve(expression::findZoomCurveChecked(expression.get())) {
     isZoomConstant_ = expression::isZoomConstant(*expression);
     isFeatureConstant_ = expression::isFeatureConstant(*expression);
     isRuntimeConstant_ = expression::isRuntimeConstant(*expression);
+    propertyKey = propertyReadByExpression(*expression);
 }
 
 bool PropertyExpressionBase::isZoomConstant() const noexcept {
@@ -53,5 +79,27 @@ std::shared_ptr<const expression::Expression> PropertyExpressionBase::getSharedE
     return expression;
 }
 
+void PropertyExpressionBase::evaluateFeatures(
+    const expression::EvaluationContext& context,
+    const GeometryTileLayer& layer,
+    const std::vector<std::size_t>& selection,
+    const std::function<void(const expression::EvaluationResult&)>& consume) const {
+    if (propertyKey) {
+        for (const std::size_t index : selection) {
+            const std::optional<mbgl::Value> property = layer.getFeature(index)->getValue(*propertyKey);
+            consume(expression::EvaluationResult(property ? expression::toExpressionValue(*property)
+                                                          : expression::Value(expression::Null)));
+        }
+        return;
+    }
+
+    expression::EvaluationContext featureContext = context;
+    for (const std::size_t index : selection) {
+        const std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(index);
+        featureContext.feature = feature.get();
+        consume(expression->evaluate(featureContext));
+    }
+}
+
 } // namespace style
 } // namespace mbgl
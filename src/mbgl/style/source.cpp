@@ -78,6 +78,18 @@ std::optional<uint8_t> Source::getMaxOverscaleFactorForParentTiles() const noexc
     return baseImpl->getMaxOverscaleFactorForParentTiles();
 }
 
+void Source::setTileCacheMaxBytes(std::optional<std::size_t> maxBytes) noexcept {
+    if (getTileCacheMaxBytes() == maxBytes) return;
+    auto newImpl = createMutable();
+    newImpl->setTileCacheMaxBytes(maxBytes);
+    baseImpl = std::move(newImpl);
+    observer->onSourceChanged(*this);
+}
+
+std::optional<std::size_t> Source::getTileCacheMaxBytes() const noexcept {
+    return baseImpl->getTileCacheMaxBytes();
+}
+
 void Source::dumpDebugLogs() const {
     Log::Info(Event::General, "Source::id: " + getID());
     Log::Info(Event::General, "Source::loaded: " + std::to_string(loaded));
@@ -0,0 +1,300 @@
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/style/sources/geojson_feature_store.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/projection.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4244)
+#endif
+
+#include <mapbox/geojsonvt.hpp>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <mapbox/geometry/envelope.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace mbgl {
+namespace style {
+
+namespace {
+
+using Box = GeoJSONFeatureStore::Box;
+
+// Features are indexed in the cells of a 256x256 grid, i.e. of the tiles at zoom level 8.
+constexpr std::uint32_t gridSize = 256;
+// Features spanning more cells are kept apart and tested against every tile.
+constexpr std::uint32_t maxCellsPerEntry = 16;
+
+struct CellRange {
+    std::uint32_t x0, y0, x1, y1;
+};
+
+bool isEmpty(const Box& box) {
+    return box.min.x > box.max.x || box.min.y > box.max.y;
+}
+
+bool intersects(const Box& a, const Box& b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+}
+
+std::uint32_t toCell(double coordinate) {
+    return static_cast<std::uint32_t>(util::clamp(std::floor(coordinate * gridSize), 0.0, gridSize - 1.0));
+}
+
+CellRange cellRange(const Box& box) {
+    return {toCell(box.min.x), toCell(box.min.y), toCell(box.max.x), toCell(box.max.y)};
+}
+
+std::uint32_t cellCount(const CellRange& range) {
+    return (range.x1 - range.x0 + 1) * (range.y1 - range.y0 + 1);
+}
+
+template <typename Fn>
+void forEachCell(const CellRange& range, Fn&& fn) {
+    for (std::uint32_t y = range.y0; y <= range.y1; ++y) {
+        for (std::uint32_t x = range.x0; x <= range.x1; ++x) {
+            fn(y * gridSize + x);
+        }
+    }
+}
+
+Box projectedBounds(const GeoJSONFeature::geometry_type& geometry) {
+    const auto envelope = mapbox::geometry::envelope(geometry);
+    if (isEmpty(envelope)) {
+        return envelope;
+    }
+    const auto project = [](double longitude, double latitude) {
+        return Projection::project(LatLng(util::clamp(latitude, -util::LATITUDE_MAX, util::LATITUDE_MAX), longitude),
+                                   0);
+    };
+    // The y axis points south.
+    const auto min = project(envelope.min.x, envelope.max.y);
+    const auto max = project(envelope.max.x, envelope.min.y);
+    return {{min.x, min.y}, {max.x, max.y}};
+}
+
+template <typename T>
+void removeValue(std::vector<T>& values, const T& value) {
+    auto it = std::find(values.begin(), values.end(), value);
+    if (it != values.end()) {
+        *it = values.back();
+        values.pop_back();
+    }
+}
+
+} // namespace
+
+GeoJSONFeatureStore::GeoJSONFeatureStore(std::shared_ptr<const GeoJSONData::Features> features)
+    : unindexed(std::move(features)) {
+    assert(unindexed);
+}
+
+GeoJSONFeatureStore::~GeoJSONFeatureStore() = default;
+
+void GeoJSONFeatureStore::index() {
+    if (indexed) return;
+    indexed = true;
+    entries.reserve(unindexed->size());
+    for (const auto& feature : *unindexed) {
+        if (auto key = featureIDtoString(feature.id)) {
+            auto existing = entries.find(*key);
+            if (existing != entries.end()) {
+                std::vector<Box> ignored;
+                erase(existing, ignored);
+            }
+            insert(std::move(*key), feature);
+        }
+    }
+    unindexed.reset();
+}
+
+const GeoJSONFeatureStore::Entry& GeoJSONFeatureStore::insert(std::string key, GeoJSONFeature feature) {
+    Box bounds = projectedBounds(feature.geometry);
+    auto result = entries.emplace(std::move(key), Entry{std::move(feature), bounds, nextOrder++});
+    assert(result.second);
+    const Entry& entry = result.first->second;
+    if (isEmpty(bounds)) return entry;
+
+    const CellRange range = cellRange(bounds);
+    if (cellCount(range) > maxCellsPerEntry) {
+        largeEntries.push_back(&entry);
+    } else {
+        forEachCell(range, [&](std::uint32_t cell) { cells[cell].push_back(&entry); });
+    }
+    return entry;
+}
+
+void GeoJSONFeatureStore::erase(Entries::iterator it, std::vector<Box>& changed) {
+    const Entry* entry = &it->second;
+    const Box& bounds = entry->bounds;
+    if (!isEmpty(bounds)) {
+        changed.push_back(bounds);
+        const CellRange range = cellRange(bounds);
+        if (cellCount(range) > maxCellsPerEntry) {
+            removeValue(largeEntries, entry);
+        } else {
+            forEachCell(range, [&](std::uint32_t cell) {
+                auto cellEntries = cells.find(cell);
+                assert(cellEntries != cells.end());
+                removeValue(cellEntries->second, entry);
+                if (cellEntries->second.empty()) {
+                    cells.erase(cellEntries);
+                }
+            });
+        }
+    }
+    entries.erase(it);
+}
+
+std::uint64_t GeoJSONFeatureStore::apply(const GeoJSONDiff& diff) {
+    index();
+
+    std::vector<Box> changed;
+    if (diff.removeAll) {
+        if (!entries.empty()) {
+            changed.push_back({{0.0, 0.0}, {1.0, 1.0}});
+        }
+        entries.clear();
+        cells.clear();
+        largeEntries.clear();
+    }
+
+    for (const auto& id : diff.remove) {
+        if (auto key = featureIDtoString(id)) {
+            auto it = entries.find(*key);
+            if (it != entries.end()) {
+                erase(it, changed);
+            }
+        }
+    }
+
+    for (const auto& feature : diff.add) {
+        auto key = featureIDtoString(feature.id);
+        if (!key) {
+            Log::Warning(Event::General, "Ignoring GeoJSON feature without id added with a diff");
+            continue;
+        }
+        auto it = entries.find(*key);
+        if (it != entries.end()) {
+            erase(it, changed);
+        }
+        const Box& bounds = insert(std::move(*key), feature).bounds;
+        if (!isEmpty(bounds)) {
+            changed.push_back(bounds);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(changesMutex);
+    changes.push_back(std::move(changed));
+    if (changes.size() > maxLoggedChanges) {
+        changes.pop_front();
+    }
+    return ++version;
+}
+
+GeoJSONData::Features GeoJSONFeatureStore::getFeatures() const {
+    if (!indexed) {
+        return *unindexed;
+    }
+
+    std::vector<const Entry*> ordered;
+    ordered.reserve(entries.size());
+    for (const auto& entry : entries) {
+        ordered.push_back(&entry.second);
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const Entry* a, const Entry* b) { return a->order < b->order; });
+
+    GeoJSONData::Features features;
+    features.reserve(ordered.size());
+    for (const Entry* entry : ordered) {
+        features.push_back(entry->feature);
+    }
+    return features;
+}
+
+void GeoJSONFeatureStore::collect(const Box& box, std::vector<const Entry*>& result) const {
+    const CellRange range = cellRange(box);
+    forEachCell(range, [&](std::uint32_t cell) {
+        auto cellEntries = cells.find(cell);
+        if (cellEntries == cells.end()) return;
+        for (const Entry* entry : cellEntries->second) {
+            if (!intersects(entry->bounds, box)) continue;
+            // An entry spanning several cells is only collected from the first one within the range.
+            const CellRange entryRange = cellRange(entry->bounds);
+            const std::uint32_t x = std::max(entryRange.x0, range.x0);
+            const std::uint32_t y = std::max(entryRange.y0, range.y0);
+            if (y * gridSize + x == cell) {
+                result.push_back(entry);
+            }
+        }
+    });
+}
+
+GeoJSONData::TileFeatures GeoJSONFeatureStore::getTile(const CanonicalTileID& id,
+                                                       const mapbox::geojsonvt::TileOptions& options) const {
+    assert(indexed);
+    const double tiles = std::pow(2.0, id.z);
+    const double buffer = static_cast<double>(options.buffer) / options.extent;
+    const Box tile{{(id.x - buffer) / tiles, (id.y - buffer) / tiles},
+                   {(id.x + 1 + buffer) / tiles, (id.y + 1 + buffer) / tiles}};
+
+    // The buffer of the tiles at the edges of the world includes features wrapped from the other side.
+    std::vector<Box> boxes{{{std::max(tile.min.x, 0.0), tile.min.y}, {std::min(tile.max.x, 1.0), tile.max.y}}};
+    if (tile.min.x < 0.0) {
+        boxes.push_back({{tile.min.x + 1.0, tile.min.y}, {1.0, tile.max.y}});
+    }
+    if (tile.max.x > 1.0) {
+        boxes.push_back({{0.0, tile.min.y}, {tile.max.x - 1.0, tile.max.y}});
+    }
+
+    std::vector<const Entry*> selected;
+    for (const Box& box : boxes) {
+        collect(box, selected);
+    }
+    for (const Entry* entry : largeEntries) {
+        if (std::any_of(boxes.begin(), boxes.end(), [&](const Box& box) { return intersects(entry->bounds, box); })) {
+            selected.push_back(entry);
+        }
+    }
+    if (selected.empty()) {
+        return {};
+    }
+
+    std::sort(selected.begin(), selected.end(), [](const Entry* a, const Entry* b) { return a->order < b->order; });
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+    GeoJSONData::Features features;
+    features.reserve(selected.size());
+    for (const Entry* entry : selected) {
+        features.push_back(entry->feature);
+    }
+    return mapbox::geojsonvt::geoJSONToTile(features, id.z, id.x, id.y, options, true, true).features;
+}
+
+std::optional<std::vector<Box>> GeoJSONFeatureStore::getChangedBounds(std::uint64_t from, std::uint64_t to) const {
+    std::lock_guard<std::mutex> lock(changesMutex);
+    if (from > to || to > version || version - from > changes.size()) {
+        return std::nullopt;
+    }
+
+    std::vector<Box> result;
+    // changes[i] results in version `version - changes.size() + i + 1`.
+    const std::size_t first = changes.size() - static_cast<std::size_t>(version - from);
+    const std::size_t last = changes.size() - static_cast<std::size_t>(version - to);
+    for (std::size_t i = first; i < last; ++i) {
+        result.insert(result.end(), changes[i].begin(), changes[i].end());
+    }
+    return result;
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <mbgl/style/sources/geojson_source.hpp>
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mapbox {
+namespace geojsonvt {
+struct TileOptions;
+} // namespace geojsonvt
+} // namespace mapbox
+
+namespace mbgl {
+namespace style {
+
+// Features of a GeoJSON source, indexed by id so that they can be updated with a GeoJSONDiff, and by
+// location so that the tiles touched by an update can be generated without re-indexing the others.
+//
+// The features are accessed on the sequenced scheduler of the data. Only the log of the changed
+// bounds is thread-safe, as the renderer reads it to find the tiles to reload.
+class GeoJSONFeatureStore {
+public:
+    using Box = mapbox::geometry::box<double>;
+
+    // The features are shared with their owner until the first diff is applied, which copies and
+    // indexes them.
+    explicit GeoJSONFeatureStore(std::shared_ptr<const GeoJSONData::Features>);
+    ~GeoJSONFeatureStore();
+
+    // Applies the diff and returns the version of the features it results in.
+    std::uint64_t apply(const GeoJSONDiff&);
+
+    // Returns the features in the order they were added.
+    GeoJSONData::Features getFeatures() const;
+    GeoJSONData::TileFeatures getTile(const CanonicalTileID&, const mapbox::geojsonvt::TileOptions&) const;
+
+    // Returns the bounds of the features changed between the given versions, or std::nullopt if they
+    // are no longer known.
+    std::optional<std::vector<Box>> getChangedBounds(std::uint64_t from, std::uint64_t to) const;
+
+    // The number of updates whose changed bounds are kept.
+    static constexpr std::size_t maxLoggedChanges = 16;
+
+private:
+    struct Entry {
+        GeoJSONFeature feature;
+        // In world coordinates normalized to [0, 1].
+        Box bounds;
+        // Keeps the features of a tile in the order they were added.
+        std::uint64_t order;
+    };
+    using Entries = std::unordered_map<std::string, Entry>;
+
+    void index();
+    const Entry& insert(std::string key, GeoJSONFeature);
+    void erase(Entries::iterator, std::vector<Box>& changed);
+    void collect(const Box&, std::vector<const Entry*>&) const;
+
+    std::shared_ptr<const GeoJSONData::Features> unindexed;
+    bool indexed = false;
+
+    Entries entries;
+    // Entries by cell of a fixed grid, except for the large ones that span too many cells.
+    std::unordered_map<std::uint32_t, std::vector<const Entry*>> cells;
+    std::vector<const Entry*> largeEntries;
+    std::uint64_t nextOrder = 0;
+
+    mutable std::mutex changesMutex;
+    std::uint64_t version = 0;
+    // The bounds changed by the last updates, the last one resulting in `version`.
+    std::deque<std::vector<Box>> changes;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -42,12 +42,12 @@ void GeoJSONSource::setURL(const std::string& url_) {
 
 namespace {
 
-inline std::shared_ptr<GeoJSONData> createGeoJSONData(const mapbox::geojson::geojson& geoJSON,
-                                                      const GeoJSONSource::Impl& impl) {
+template <typename GeoJSONRef>
+inline std::shared_ptr<GeoJSONData> createGeoJSONData(GeoJSONRef&& geoJSON, const GeoJSONSource::Impl& impl) {
     if (auto data = impl.getData().lock()) {
-        return GeoJSONData::create(geoJSON, impl.getOptions(), data->getScheduler());
+        return GeoJSONData::create(std::forward<GeoJSONRef>(geoJSON), impl.getOptions(), data->getScheduler());
     }
-    return GeoJSONData::create(geoJSON, impl.getOptions());
+    return GeoJSONData::create(std::forward<GeoJSONRef>(geoJSON), impl.getOptions());
 }
 
 } // namespace
@@ -56,12 +56,40 @@ void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
     setGeoJSONData(createGeoJSONData(geoJSON, impl()));
 }
 
+void GeoJSONSource::setGeoJSON(mapbox::geojson::geojson&& geoJSON) {
+    setGeoJSONData(createGeoJSONData(std::move(geoJSON), impl()));
+}
+
 void GeoJSONSource::setGeoJSONData(std::shared_ptr<GeoJSONData> geoJSONData) {
     req.reset();
+    ++dataGeneration;
     baseImpl = makeMutable<Impl>(impl(), std::move(geoJSONData));
     observer->onSourceChanged(*this);
 }
 
+void GeoJSONSource::updateGeoJSON(const GeoJSONDiff& diff) {
+    auto data = impl().getData().lock();
+    if (!data) {
+        // Replacing the data would cancel the pending load of the URL, if any.
+        Log::Error(Event::General, "Cannot update GeoJSON source '" + getID() + "': it has no data yet");
+        return;
+    }
+
+    data->applyDiff(diff,
+                    [this, self = makeWeakPtr(), generation = dataGeneration](std::shared_ptr<GeoJSONData> updated) {
+                        if (!self) return;                        // This source has been deleted.
+                        if (generation != dataGeneration) return; // The data has been replaced since.
+                        if (!updated) {
+                            Log::Error(Event::General,
+                                       "Cannot update GeoJSON source '" + getID() +
+                                           "': features must have an id and be owned by the source");
+                            return;
+                        }
+                        baseImpl = makeMutable<Impl>(impl(), std::move(updated));
+                        observer->onSourceChanged(*this);
+                    });
+}
+
 std::optional<std::string> GeoJSONSource::getURL() const {
     return url;
 }
@@ -94,7 +122,7 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                 conversion::Error error;
                 std::shared_ptr<GeoJSONData> geoJSONData;
                 if (std::optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*data, error)) {
-                    geoJSONData = createGeoJSONData(*geoJSON, current);
+                    geoJSONData = createGeoJSONData(std::move(*geoJSON), current);
                 } else {
                     // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for tiles to load.
                     Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: " + error.message);
@@ -107,6 +135,7 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                 if (capturedReq != req.get()) return; // A new request is being processed, ignore this impl.
 
                 baseImpl = std::move(newImpl);
+                ++dataGeneration;
                 loaded = true;
                 observer->onSourceLoaded(*this);
             };
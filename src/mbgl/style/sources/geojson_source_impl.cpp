@@ -1,7 +1,10 @@
+#include <mbgl/style/sources/geojson_feature_store.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/async_request.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/logging.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/thread_pool.hpp>
 
@@ -17,15 +20,150 @@
 #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <optional>
 
 namespace mbgl {
 namespace style {
 
-class GeoJSONVTData final : public GeoJSONData {
-    void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
+namespace {
+
+// Skips the scheduled task when destroyed before it runs, and drops its result otherwise.
+class GeoJSONDataRequest final : public AsyncRequest {
+public:
+    ~GeoJSONDataRequest() override { *canceled = true; }
+
+    const std::shared_ptr<std::atomic<bool>> canceled = std::make_shared<std::atomic<bool>>(false);
+};
+
+template <typename Result, typename TaskFn>
+std::unique_ptr<AsyncRequest> scheduleRequest(Scheduler& scheduler,
+                                              TaskFn&& task,
+                                              std::function<void(Result)> reply) {
+    assert(reply);
+    auto request = std::make_unique<GeoJSONDataRequest>();
+    scheduler.scheduleAndReplyValue(
+        [canceled = request->canceled, task = std::forward<TaskFn>(task)]() -> std::optional<Result> {
+            if (*canceled) return std::nullopt;
+            try {
+                return task();
+            } catch (const std::exception& e) {
+                // Supercluster throws for unknown cluster ids; answer with an empty result instead.
+                Log::Error(Event::General, std::string("GeoJSON data request failed: ") + e.what());
+                return Result();
+            }
+        },
+        [canceled = request->canceled, reply = std::move(reply)](std::optional<Result> result) {
+            if (*canceled || !result) return;
+            reply(std::move(*result));
+        });
+    return request;
+}
+
+} // namespace
+
+std::unique_ptr<AsyncRequest> GeoJSONData::requestChildren(std::uint32_t clusterID,
+                                                           std::function<void(Features)> fn) {
+    assert(fn);
+    fn(getChildren(clusterID));
+    return nullptr;
+}
+
+std::unique_ptr<AsyncRequest> GeoJSONData::requestLeaves(std::uint32_t clusterID,
+                                                         std::uint32_t limit,
+                                                         std::uint32_t offset,
+                                                         std::function<void(Features)> fn) {
+    assert(fn);
+    fn(getLeaves(clusterID, limit, offset));
+    return nullptr;
+}
+
+std::unique_ptr<AsyncRequest> GeoJSONData::requestClusterExpansionZoom(std::uint32_t clusterID,
+                                                                       std::function<void(std::uint8_t)> fn) {
+    assert(fn);
+    fn(getClusterExpansionZoom(clusterID));
+    return nullptr;
+}
+
+GeoJSONData::GeoJSONData(std::shared_ptr<GeoJSONFeatureStore> featureStore_, std::uint64_t featureVersion_)
+    : featureStore(std::move(featureStore_)),
+      featureVersion(featureVersion_) {}
+
+void GeoJSONData::applyDiff(GeoJSONDiff, std::function<void(std::shared_ptr<GeoJSONData>)> fn) {
+    assert(fn);
+    fn(nullptr);
+}
+
+std::optional<std::vector<mapbox::geometry::box<double>>> GeoJSONData::getChangedBoundsSince(
+    const GeoJSONData& other) const {
+    if (!featureStore || featureStore != other.featureStore) {
+        return std::nullopt;
+    }
+    return featureStore->getChangedBounds(other.featureVersion, featureVersion);
+}
+
+// Data updated by id: tiles are generated on demand from the features of the store that they contain,
+// so that an update only costs the changed features and the tiles they touch.
+class GeoJSONStoreData final : public GeoJSONData {
+    std::unique_ptr<AsyncRequest> getTile(const CanonicalTileID& id,
+                                          const std::function<void(TileFeatures)>& fn) final {
+        return scheduleRequest<TileFeatures>(
+            *scheduler,
+            [id, store = this->featureStore, options = this->options]() -> TileFeatures {
+                return store->getTile(id, options);
+            },
+            fn);
+    }
+
+    Features getChildren(const std::uint32_t) final { return {}; }
+
+    Features getLeaves(const std::uint32_t, const std::uint32_t, const std::uint32_t) final { return {}; }
+
+    std::uint8_t getClusterExpansionZoom(std::uint32_t) final { return 0; }
+
+    void applyDiff(GeoJSONDiff diff, std::function<void(std::shared_ptr<GeoJSONData>)> fn) final {
+        update(featureStore, options, scheduler, std::move(diff), std::move(fn));
+    }
+
+    std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
+
+    // Applies the diff to the store on the scheduler, which also generates the tiles, so that tiles
+    // requested afterwards include the changes.
+    static void update(std::shared_ptr<GeoJSONFeatureStore> store,
+                       const mapbox::geojsonvt::TileOptions& options,
+                       std::shared_ptr<Scheduler> scheduler,
+                       GeoJSONDiff diff,
+                       std::function<void(std::shared_ptr<GeoJSONData>)> fn) {
         assert(fn);
         scheduler->scheduleAndReplyValue(
+            [store, diff = std::move(diff)]() -> std::uint64_t { return store->apply(diff); },
+            [store, options, scheduler, fn = std::move(fn)](std::uint64_t version) {
+                fn(std::shared_ptr<GeoJSONData>(new GeoJSONStoreData(store, version, options, scheduler)));
+            });
+    }
+
+    friend class GeoJSONVTData;
+    GeoJSONStoreData(std::shared_ptr<GeoJSONFeatureStore> store,
+                     std::uint64_t version,
+                     const mapbox::geojsonvt::TileOptions& options_,
+                     std::shared_ptr<Scheduler> scheduler_)
+        : GeoJSONData(std::move(store), version),
+          options(options_),
+          scheduler(std::move(scheduler_)) {
+        assert(scheduler);
+    }
+
+    mapbox::geojsonvt::TileOptions options;
+    std::shared_ptr<Scheduler> scheduler;
+};
+
+class GeoJSONVTData final : public GeoJSONData {
+    std::unique_ptr<AsyncRequest> getTile(const CanonicalTileID& id,
+                                          const std::function<void(TileFeatures)>& fn) final {
+        return scheduleRequest<TileFeatures>(
+            *scheduler,
             [id, geoJSONVT_impl = this->impl]() -> TileFeatures {
                 return geoJSONVT_impl->getTile(id.z, id.x, id.y).features;
             },
@@ -38,43 +176,141 @@ class GeoJSONVTData final : public GeoJSONData {
 
     std::uint8_t getClusterExpansionZoom(std::uint32_t) final { return 0; }
 
+    void applyDiff(GeoJSONDiff diff, std::function<void(std::shared_ptr<GeoJSONData>)> fn) final {
+        if (!featureStore) {
+            GeoJSONData::applyDiff(std::move(diff), std::move(fn));
+            return;
+        }
+        // From now on, tiles are generated from the store.
+        GeoJSONStoreData::update(featureStore, options, scheduler, std::move(diff), std::move(fn));
+    }
+
     std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
 
     friend GeoJSONData;
     GeoJSONVTData(const GeoJSON& geoJSON,
-                  const mapbox::geojsonvt::Options& options,
+                  const mapbox::geojsonvt::Options& options_,
+                  std::shared_ptr<GeoJSONFeatureStore> store,
                   std::shared_ptr<Scheduler> scheduler_)
-        : impl(std::make_shared<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options)),
+        : GeoJSONData(std::move(store), 0),
+          impl(std::make_shared<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options_)),
+          options(options_),
           scheduler(std::move(scheduler_)) {
         assert(scheduler);
     }
 
     std::shared_ptr<mapbox::geojsonvt::GeoJSONVT> impl; // Accessed on worker thread.
+    mapbox::geojsonvt::TileOptions options;
     std::shared_ptr<Scheduler> scheduler;
 };
 
+// Cluster tiles and queries are computed on the scheduler, so that large clustered sources do not
+// stall the calling thread. The index is never modified once built: updates build a new one, so that
+// tiles and queries can read their snapshot concurrently without locking.
 class SuperclusterData final : public GeoJSONData {
-    void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
-        assert(fn);
-        fn(impl.getTile(id.z, id.x, id.y));
+    using Index = mapbox::supercluster::Supercluster;
+
+    std::unique_ptr<AsyncRequest> getTile(const CanonicalTileID& id,
+                                          const std::function<void(TileFeatures)>& fn) final {
+        return scheduleRequest<TileFeatures>(
+            *scheduler,
+            [id, index = this->index]() -> TileFeatures { return index->getTile(id.z, id.x, id.y); },
+            fn);
     }
 
-    Features getChildren(const std::uint32_t cluster_id) final { return impl.getChildren(cluster_id); }
+    Features getChildren(const std::uint32_t cluster_id) final { return index->getChildren(cluster_id); }
 
     Features getLeaves(const std::uint32_t cluster_id, const std::uint32_t limit, const std::uint32_t offset) final {
-        return impl.getLeaves(cluster_id, limit, offset);
+        return index->getLeaves(cluster_id, limit, offset);
     }
 
     std::uint8_t getClusterExpansionZoom(std::uint32_t cluster_id) final {
-        return impl.getClusterExpansionZoom(cluster_id);
+        return index->getClusterExpansionZoom(cluster_id);
+    }
+
+    std::unique_ptr<AsyncRequest> requestChildren(std::uint32_t cluster_id, std::function<void(Features)> fn) final {
+        return scheduleRequest<Features>(
+            *scheduler,
+            [cluster_id, index = this->index]() -> Features { return index->getChildren(cluster_id); },
+            std::move(fn));
+    }
+
+    std::unique_ptr<AsyncRequest> requestLeaves(std::uint32_t cluster_id,
+                                                std::uint32_t limit,
+                                                std::uint32_t offset,
+                                                std::function<void(Features)> fn) final {
+        return scheduleRequest<Features>(
+            *scheduler,
+            [cluster_id, limit, offset, index = this->index]() -> Features {
+                return index->getLeaves(cluster_id, limit, offset);
+            },
+            std::move(fn));
+    }
+
+    std::unique_ptr<AsyncRequest> requestClusterExpansionZoom(std::uint32_t cluster_id,
+                                                              std::function<void(std::uint8_t)> fn) final {
+        return scheduleRequest<std::uint8_t>(
+            *scheduler,
+            [cluster_id, index = this->index]() -> std::uint8_t { return index->getClusterExpansionZoom(cluster_id); },
+            std::move(fn));
     }
 
+    // Clusters depend on all the features, so the index is rebuilt and the changed bounds are unknown.
+    void applyDiff(GeoJSONDiff diff, std::function<void(std::shared_ptr<GeoJSONData>)> fn) final {
+        if (!features) {
+            GeoJSONData::applyDiff(std::move(diff), std::move(fn));
+            return;
+        }
+        assert(fn);
+        scheduler->scheduleAndReplyValue(
+            [features = this->features, options = this->options, diff = std::move(diff)]()
+                -> std::shared_ptr<const Index> {
+                features->apply(diff);
+                return std::make_shared<Index>(features->getFeatures(), options);
+            },
+            [features = this->features, options = this->options, scheduler = this->scheduler, fn = std::move(fn)](
+                std::shared_ptr<const Index> updated) {
+                fn(std::shared_ptr<GeoJSONData>(
+                    new SuperclusterData(std::move(updated), features, options, scheduler)));
+            });
+    }
+
+    std::shared_ptr<Scheduler> getScheduler() final { return scheduler; }
+
     friend GeoJSONData;
-    SuperclusterData(const Features& features, const mapbox::supercluster::Options& options)
-        : impl(features, options) {}
-    mapbox::supercluster::Supercluster impl;
+    SuperclusterData(std::shared_ptr<const Index> index_,
+                     std::shared_ptr<GeoJSONFeatureStore> features_,
+                     const mapbox::supercluster::Options& options_,
+                     std::shared_ptr<Scheduler> scheduler_)
+        : index(std::move(index_)),
+          features(std::move(features_)),
+          options(options_),
+          scheduler(std::move(scheduler_)) {
+        assert(scheduler);
+    }
+
+    std::shared_ptr<const Index> index; // Accessed on worker thread.
+    // The features, for rebuilding the index when they are updated by id. Accessed on worker thread.
+    std::shared_ptr<GeoJSONFeatureStore> features;
+    mapbox::supercluster::Options options;
+    std::shared_ptr<Scheduler> scheduler;
 };
 
+namespace {
+
+// Features can be updated by id if they all have one. The store shares them with their owner, so that
+// they are only copied if they are updated.
+std::shared_ptr<GeoJSONFeatureStore> makeFeatureStore(std::shared_ptr<const GeoJSONData::Features> features) {
+    if (!features || !std::all_of(features->begin(), features->end(), [](const auto& feature) {
+            return !feature.id.template is<NullValue>();
+        })) {
+        return nullptr;
+    }
+    return std::make_shared<GeoJSONFeatureStore>(std::move(features));
+}
+
+} // namespace
+
 template <class T>
 T evaluateFeature(const mapbox::feature::feature<double>& f,
                   const std::shared_ptr<expression::Expression>& expression,
@@ -93,6 +329,22 @@ T evaluateFeature(const mapbox::feature::feature<double>& f,
 std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
                                                  const Immutable<GeoJSONOptions>& options,
                                                  std::shared_ptr<Scheduler> scheduler) {
+    return create(geoJSON, nullptr, options, std::move(scheduler));
+}
+
+// static
+std::shared_ptr<GeoJSONData> GeoJSONData::create(GeoJSON&& geoJSON,
+                                                 const Immutable<GeoJSONOptions>& options,
+                                                 std::shared_ptr<Scheduler> scheduler) {
+    auto owned = std::make_shared<const GeoJSON>(std::move(geoJSON));
+    return create(*owned, owned, options, std::move(scheduler));
+}
+
+// static
+std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
+                                                 std::shared_ptr<const GeoJSON> owned,
+                                                 const Immutable<GeoJSONOptions>& options,
+                                                 std::shared_ptr<Scheduler> scheduler) {
     constexpr double scale = util::EXTENT / util::tileSize_D;
     if (options->cluster && geoJSON.is<Features>() && !geoJSON.get<Features>().empty()) {
         mapbox::supercluster::Options clusterOptions;
@@ -119,7 +371,12 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
                 toReturn[p.first] = evaluateFeature<Value>(*feature, p.second.second, accumulated);
             }
         };
-        return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), clusterOptions));
+        if (!scheduler) scheduler = Scheduler::GetSequenced();
+        auto index = std::make_shared<SuperclusterData::Index>(geoJSON.get<Features>(), clusterOptions);
+        // Supercluster keeps a copy of the features, which the store can share.
+        auto store = makeFeatureStore(std::shared_ptr<const Features>(index, &index->features));
+        return std::shared_ptr<GeoJSONData>(
+            new SuperclusterData(std::move(index), std::move(store), clusterOptions, std::move(scheduler)));
     }
 
     mapbox::geojsonvt::Options vtOptions;
@@ -129,7 +386,12 @@ std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON,
     vtOptions.tolerance = scale * options->tolerance;
     vtOptions.lineMetrics = options->lineMetrics;
     if (!scheduler) scheduler = Scheduler::GetSequenced();
-    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, vtOptions, std::move(scheduler)));
+    // geojson-vt does not keep the features, so only the ones owned by the data can be updated.
+    std::shared_ptr<GeoJSONFeatureStore> store;
+    if (owned && owned->is<Features>()) {
+        store = makeFeatureStore(std::shared_ptr<const Features>(owned, &owned->get<Features>()));
+    }
+    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, vtOptions, std::move(store), std::move(scheduler)));
 }
 
 GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
@@ -0,0 +1,594 @@
+#include <mbgl/text/collision_grid.hpp>
+#include <mbgl/math/minmax.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <mutex>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MBGL_COLLISION_GRID_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MBGL_COLLISION_GRID_NEON
+#endif
+
+namespace mbgl {
+
+namespace {
+
+// A box is stored as [minX, minY, maxX, maxY], a circle as [centerX, centerY, radius, 0].
+using Bounds = std::array<float, 4>;
+
+#if defined(MBGL_COLLISION_GRID_SSE2)
+
+using Lanes = __m128;
+using Mask = __m128;
+
+// One coordinate of four records per register.
+struct Batch {
+    Lanes c[4];
+};
+
+inline Lanes splat(float v) {
+    return _mm_set1_ps(v);
+}
+inline Lanes add(Lanes a, Lanes b) {
+    return _mm_add_ps(a, b);
+}
+inline Lanes sub(Lanes a, Lanes b) {
+    return _mm_sub_ps(a, b);
+}
+inline Lanes mul(Lanes a, Lanes b) {
+    return _mm_mul_ps(a, b);
+}
+inline Lanes absolute(Lanes a) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+inline Mask lessEqual(Lanes a, Lanes b) {
+    return _mm_cmple_ps(a, b);
+}
+inline Mask greaterEqual(Lanes a, Lanes b) {
+    return _mm_cmpge_ps(a, b);
+}
+inline Mask greater(Lanes a, Lanes b) {
+    return _mm_cmpgt_ps(a, b);
+}
+inline Mask notGreater(Lanes a, Lanes b) {
+    return _mm_cmpngt_ps(a, b);
+}
+inline Mask both(Mask a, Mask b) {
+    return _mm_and_ps(a, b);
+}
+inline Mask either(Mask a, Mask b) {
+    return _mm_or_ps(a, b);
+}
+inline unsigned bits(Mask m) {
+    return static_cast<unsigned>(_mm_movemask_ps(m));
+}
+
+// Loads four records and transposes them.
+inline Batch load(const Bounds* records) {
+    __m128 r0 = _mm_loadu_ps(records[0].data());
+    __m128 r1 = _mm_loadu_ps(records[1].data());
+    __m128 r2 = _mm_loadu_ps(records[2].data());
+    __m128 r3 = _mm_loadu_ps(records[3].data());
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    return {{r0, r1, r2, r3}};
+}
+
+#elif defined(MBGL_COLLISION_GRID_NEON)
+
+using Lanes = float32x4_t;
+using Mask = uint32x4_t;
+
+struct Batch {
+    Lanes c[4];
+};
+
+inline Lanes splat(float v) {
+    return vdupq_n_f32(v);
+}
+inline Lanes add(Lanes a, Lanes b) {
+    return vaddq_f32(a, b);
+}
+inline Lanes sub(Lanes a, Lanes b) {
+    return vsubq_f32(a, b);
+}
+inline Lanes mul(Lanes a, Lanes b) {
+    return vmulq_f32(a, b);
+}
+inline Lanes absolute(Lanes a) {
+    return vabsq_f32(a);
+}
+inline Mask lessEqual(Lanes a, Lanes b) {
+    return vcleq_f32(a, b);
+}
+inline Mask greaterEqual(Lanes a, Lanes b) {
+    return vcgeq_f32(a, b);
+}
+inline Mask greater(Lanes a, Lanes b) {
+    return vcgtq_f32(a, b);
+}
+inline Mask notGreater(Lanes a, Lanes b) {
+    return vmvnq_u32(vcgtq_f32(a, b));
+}
+inline Mask both(Mask a, Mask b) {
+    return vandq_u32(a, b);
+}
+inline Mask either(Mask a, Mask b) {
+    return vorrq_u32(a, b);
+}
+inline unsigned bits(Mask m) {
+    static const uint32_t weights[4] = {1, 2, 4, 8};
+    const uint32x4_t weighted = vandq_u32(m, vld1q_u32(weights));
+    const uint32x2_t sum = vadd_u32(vget_low_u32(weighted), vget_high_u32(weighted));
+    return vget_lane_u32(vpadd_u32(sum, sum), 0);
+}
+
+// Loads four records and transposes them.
+inline Batch load(const Bounds* records) {
+    const float32x4x4_t r = vld4q_f32(records[0].data());
+    return {{r.val[0], r.val[1], r.val[2], r.val[3]}};
+}
+
+#else
+
+using Lanes = std::array<float, 4>;
+using Mask = std::array<bool, 4>;
+
+struct Batch {
+    Lanes c[4];
+};
+
+template <class Op>
+inline auto lanewise(const Lanes& a, const Lanes& b, Op op) {
+    std::array<decltype(op(a[0], b[0])), 4> result;
+    for (std::size_t i = 0; i < 4; ++i) result[i] = op(a[i], b[i]);
+    return result;
+}
+
+inline Lanes splat(float v) {
+    return {{v, v, v, v}};
+}
+inline Lanes add(const Lanes& a, const Lanes& b) {
+    return lanewise(a, b, [](float x, float y) { return x + y; });
+}
+inline Lanes sub(const Lanes& a, const Lanes& b) {
+    return lanewise(a, b, [](float x, float y) { return x - y; });
+}
+inline Lanes mul(const Lanes& a, const Lanes& b) {
+    return lanewise(a, b, [](float x, float y) { return x * y; });
+}
+inline Lanes absolute(Lanes a) {
+    for (auto& v : a) v = std::abs(v);
+    return a;
+}
+inline Mask lessEqual(const Lanes& a, const Lanes& b) {
+    return lanewise(a, b, [](float x, float y) { return x <= y; });
+}
+inline Mask greaterEqual(const Lanes& a, const Lanes& b) {
+    return lanewise(a, b, [](float x, float y) { return x >= y; });
+}
+inline Mask greater(const Lanes& a, const Lanes& b) {
+    return lanewise(a, b, [](float x, float y) { return x > y; });
+}
+inline Mask notGreater(const Lanes& a, const Lanes& b) {
+    return lanewise(a, b, [](float x, float y) { return !(x > y); });
+}
+inline Mask both(Mask a, const Mask& b) {
+    for (std::size_t i = 0; i < 4; ++i) a[i] = a[i] && b[i];
+    return a;
+}
+inline Mask either(Mask a, const Mask& b) {
+    for (std::size_t i = 0; i < 4; ++i) a[i] = a[i] || b[i];
+    return a;
+}
+inline unsigned bits(const Mask& m) {
+    return unsigned(m[0]) | unsigned(m[1]) << 1 | unsigned(m[2]) << 2 | unsigned(m[3]) << 3;
+}
+
+inline Batch load(const Bounds* records) {
+    Batch result;
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) result.c[j][i] = records[i][j];
+    }
+    return result;
+}
+
+#endif
+
+// The tests below evaluate the predicates of GridIndex on four candidates at once and return one bit per candidate.
+
+inline unsigned boxesCollide(const Bounds& query, const Batch& boxes) {
+    const Mask min = both(lessEqual(splat(query[0]), boxes.c[2]), lessEqual(splat(query[1]), boxes.c[3]));
+    const Mask max = both(greaterEqual(splat(query[2]), boxes.c[0]), greaterEqual(splat(query[3]), boxes.c[1]));
+    return bits(both(min, max));
+}
+
+inline unsigned circlesCollide(const Bounds& query, const Batch& circles) {
+    const Lanes dx = sub(circles.c[0], splat(query[0]));
+    const Lanes dy = sub(circles.c[1], splat(query[1]));
+    const Lanes bothRadii = add(splat(query[2]), circles.c[2]);
+    return bits(greater(mul(bothRadii, bothRadii), add(mul(dx, dx), mul(dy, dy))));
+}
+
+inline unsigned circleAndBoxCollide(
+    Lanes centerX, Lanes centerY, Lanes radius, Lanes minX, Lanes minY, Lanes maxX, Lanes maxY) {
+    const Lanes halfRectWidth = mul(sub(maxX, minX), splat(0.5f));
+    const Lanes halfRectHeight = mul(sub(maxY, minY), splat(0.5f));
+    const Lanes distX = absolute(sub(centerX, add(minX, halfRectWidth)));
+    const Lanes distY = absolute(sub(centerY, add(minY, halfRectHeight)));
+    const Lanes dx = sub(distX, halfRectWidth);
+    const Lanes dy = sub(distY, halfRectHeight);
+
+    const Mask near = both(notGreater(distX, add(halfRectWidth, radius)),
+                           notGreater(distY, add(halfRectHeight, radius)));
+    const Mask edge = either(lessEqual(distX, halfRectWidth), lessEqual(distY, halfRectHeight));
+    const Mask corner = lessEqual(add(mul(dx, dx), mul(dy, dy)), mul(radius, radius));
+    return bits(both(near, either(edge, corner)));
+}
+
+inline unsigned circleAndBoxesCollide(const Bounds& circle, const Batch& boxes) {
+    return circleAndBoxCollide(
+        splat(circle[0]), splat(circle[1]), splat(circle[2]), boxes.c[0], boxes.c[1], boxes.c[2], boxes.c[3]);
+}
+
+inline unsigned circlesAndBoxCollide(const Bounds& box, const Batch& circles) {
+    return circleAndBoxCollide(
+        circles.c[0], circles.c[1], circles.c[2], splat(box[0]), splat(box[1]), splat(box[2]), splat(box[3]));
+}
+
+inline Bounds toBounds(const CollisionGrid::BBox& box) {
+    return {{box.min.x, box.min.y, box.max.x, box.max.y}};
+}
+
+inline Bounds toBounds(const CollisionGrid::BCircle& circle) {
+    return {{circle.center.x, circle.center.y, circle.radius, 0.0f}};
+}
+
+inline CollisionGrid::BBox circleToBox(const Bounds& circle) {
+    return {{circle[0] - circle[2], circle[1] - circle[2]}, {circle[0] + circle[2], circle[1] + circle[2]}};
+}
+
+struct Cell {
+    std::vector<Bounds> bounds;
+    std::vector<uint32_t> ids;
+
+    void clear() {
+        bounds.clear();
+        ids.clear();
+    }
+};
+
+// Runs `test` on the records of a cell, four at a time, and calls `fn` with the id of every colliding record in
+// insertion order until it returns true.
+template <class Test, class Fn>
+bool forEachCollision(const Cell& cell, const Test& test, Fn&& fn) {
+    const std::size_t count = cell.bounds.size();
+    for (std::size_t i = 0; i < count; i += 4) {
+        unsigned hits;
+        if (count - i >= 4) {
+            hits = test(load(&cell.bounds[i]));
+        } else {
+            std::array<Bounds, 4> tail{};
+            std::copy(cell.bounds.begin() + i, cell.bounds.end(), tail.begin());
+            hits = test(load(tail.data())) & ((1u << (count - i)) - 1);
+        }
+        for (std::size_t lane = 0; hits != 0; ++lane, hits >>= 1) {
+            if ((hits & 1) && fn(cell.ids[i + lane])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <class T>
+struct Pool {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<T>> released;
+};
+
+// Not destroyed at exit, as placements may still be released from other threads.
+template <class T>
+Pool<T>& pool() {
+    static auto* instance = new Pool<T>();
+    return *instance;
+}
+
+// Two placements, with two grids each, are alive at a time.
+constexpr std::size_t maxPooledStorages = 4;
+
+} // namespace
+
+struct CollisionGrid::Storage {
+    // Indexed by FeatureHandle.
+    std::vector<IndexedSubfeature> features;
+
+    // Records in insertion order, and the handle of the feature each belongs to. Cells refer to them by index.
+    std::vector<Bounds> boxes;
+    std::vector<Bounds> circles;
+    std::vector<FeatureHandle> boxFeatures;
+    std::vector<FeatureHandle> circleFeatures;
+
+    std::vector<Cell> boxCells;
+    std::vector<Cell> circleCells;
+
+    // Empties the grid while keeping the allocated capacity.
+    void reset(std::size_t cellCount) {
+        features.clear();
+        boxes.clear();
+        circles.clear();
+        boxFeatures.clear();
+        circleFeatures.clear();
+        boxCells.resize(cellCount);
+        circleCells.resize(cellCount);
+        for (auto& cell : boxCells) cell.clear();
+        for (auto& cell : circleCells) cell.clear();
+    }
+};
+
+std::unique_ptr<CollisionGrid::Storage> CollisionGrid::acquireStorage(std::size_t cellCount) {
+    std::unique_ptr<Storage> result;
+    {
+        auto& recycled = pool<Storage>();
+        std::lock_guard<std::mutex> lock(recycled.mutex);
+        if (!recycled.released.empty()) {
+            result = std::move(recycled.released.back());
+            recycled.released.pop_back();
+        }
+    }
+    if (!result) {
+        result = std::make_unique<Storage>();
+    }
+    result->reset(cellCount);
+    return result;
+}
+
+void CollisionGrid::releaseStorage(std::unique_ptr<Storage> released) {
+    if (!released) return;
+    auto& recycled = pool<Storage>();
+    std::lock_guard<std::mutex> lock(recycled.mutex);
+    if (recycled.released.size() < maxPooledStorages) {
+        recycled.released.push_back(std::move(released));
+    }
+}
+
+CollisionGrid::CollisionGrid(const float width_, const float height_, const uint32_t cellSize_)
+    : width(width_),
+      height(height_),
+      xCellCount(static_cast<size_t>(std::ceil(width / cellSize_))),
+      yCellCount(static_cast<size_t>(std::ceil(height / cellSize_))),
+      xScale(xCellCount / width),
+      yScale(yCellCount / height),
+      storage(acquireStorage(xCellCount * yCellCount)) {
+    assert(width > 0.0f);
+    assert(height > 0.0f);
+}
+
+CollisionGrid::~CollisionGrid() {
+    releaseStorage(std::move(storage));
+}
+
+CollisionGrid::FeatureHandle CollisionGrid::addFeature(const IndexedSubfeature& feature,
+                                                       uint32_t bucketInstanceId,
+                                                       uint16_t collisionGroupId) {
+    auto handle = static_cast<FeatureHandle>(storage->features.size());
+    storage->features.emplace_back(feature, bucketInstanceId, collisionGroupId);
+    return handle;
+}
+
+const IndexedSubfeature& CollisionGrid::getFeature(FeatureHandle handle) const {
+    return storage->features[handle];
+}
+
+void CollisionGrid::insert(FeatureHandle handle, const BBox& bbox) {
+    assert(handle < storage->features.size());
+    const auto uid = static_cast<uint32_t>(storage->boxes.size());
+    const Bounds bounds = toBounds(bbox);
+
+    auto cx1 = convertToXCellCoord(bbox.min.x);
+    auto cy1 = convertToYCellCoord(bbox.min.y);
+    auto cx2 = convertToXCellCoord(bbox.max.x);
+    auto cy2 = convertToYCellCoord(bbox.max.y);
+
+    for (std::size_t x = cx1; x <= cx2; ++x) {
+        for (std::size_t y = cy1; y <= cy2; ++y) {
+            auto& cell = storage->boxCells[xCellCount * y + x];
+            cell.bounds.push_back(bounds);
+            cell.ids.push_back(uid);
+        }
+    }
+
+    storage->boxes.push_back(bounds);
+    storage->boxFeatures.push_back(handle);
+}
+
+void CollisionGrid::insert(FeatureHandle handle, const BCircle& bcircle) {
+    assert(handle < storage->features.size());
+    const auto uid = static_cast<uint32_t>(storage->circles.size());
+    const Bounds bounds = toBounds(bcircle);
+
+    auto cx1 = convertToXCellCoord(bcircle.center.x - bcircle.radius);
+    auto cy1 = convertToYCellCoord(bcircle.center.y - bcircle.radius);
+    auto cx2 = convertToXCellCoord(bcircle.center.x + bcircle.radius);
+    auto cy2 = convertToYCellCoord(bcircle.center.y + bcircle.radius);
+
+    for (std::size_t x = cx1; x <= cx2; ++x) {
+        for (std::size_t y = cy1; y <= cy2; ++y) {
+            auto& cell = storage->circleCells[xCellCount * y + x];
+            cell.bounds.push_back(bounds);
+            cell.ids.push_back(uid);
+        }
+    }
+
+    storage->circles.push_back(bounds);
+    storage->circleFeatures.push_back(handle);
+}
+
+std::vector<std::pair<CollisionGrid::FeatureHandle, CollisionGrid::BBox>> CollisionGrid::queryWithBoxes(
+    const BBox& queryBBox) const {
+    std::vector<std::pair<FeatureHandle, BBox>> result;
+    const Storage& s = *storage;
+
+    if (noIntersection(queryBBox)) {
+        return result;
+    } else if (completeIntersection(queryBBox)) {
+        for (std::size_t uid = 0; uid < s.boxes.size(); ++uid) {
+            const auto& box = s.boxes[uid];
+            result.emplace_back(s.boxFeatures[uid], BBox{{box[0], box[1]}, {box[2], box[3]}});
+        }
+        for (std::size_t uid = 0; uid < s.circles.size(); ++uid) {
+            result.emplace_back(s.circleFeatures[uid], circleToBox(s.circles[uid]));
+        }
+        return result;
+    }
+
+    const Bounds query = toBounds(queryBBox);
+    const auto testBoxes = [&](const Batch& boxes) { return boxesCollide(query, boxes); };
+    const auto testCircles = [&](const Batch& circles) { return circlesAndBoxCollide(query, circles); };
+
+    // Records spanning several cells are reported from the first cell only.
+    std::vector<bool> seenBoxes(s.boxes.size());
+    std::vector<bool> seenCircles(s.circles.size());
+
+    auto cx1 = convertToXCellCoord(queryBBox.min.x);
+    auto cy1 = convertToYCellCoord(queryBBox.min.y);
+    auto cx2 = convertToXCellCoord(queryBBox.max.x);
+    auto cy2 = convertToYCellCoord(queryBBox.max.y);
+
+    for (std::size_t x = cx1; x <= cx2; ++x) {
+        for (std::size_t y = cy1; y <= cy2; ++y) {
+            const std::size_t cellIndex = xCellCount * y + x;
+            forEachCollision(s.boxCells[cellIndex], testBoxes, [&](uint32_t uid) {
+                if (!seenBoxes[uid]) {
+                    seenBoxes[uid] = true;
+                    const auto& box = s.boxes[uid];
+                    result.emplace_back(s.boxFeatures[uid], BBox{{box[0], box[1]}, {box[2], box[3]}});
+                }
+                return false;
+            });
+            forEachCollision(s.circleCells[cellIndex], testCircles, [&](uint32_t uid) {
+                if (!seenCircles[uid]) {
+                    seenCircles[uid] = true;
+                    result.emplace_back(s.circleFeatures[uid], circleToBox(s.circles[uid]));
+                }
+                return false;
+            });
+        }
+    }
+
+    return result;
+}
+
+bool CollisionGrid::hitTest(const BBox& queryBBox, std::optional<uint16_t> collisionGroup) const {
+    const Storage& s = *storage;
+
+    if (noIntersection(queryBBox)) {
+        return false;
+    } else if (completeIntersection(queryBBox)) {
+        for (auto handle : s.boxFeatures) {
+            if (inGroup(handle, collisionGroup)) return true;
+        }
+        for (auto handle : s.circleFeatures) {
+            if (inGroup(handle, collisionGroup)) return true;
+        }
+        return false;
+    }
+
+    // Unlike queryWithBoxes(), records spanning several cells are not deduplicated: testing one again is cheaper
+    // than tracking which ones were seen, and yields the same answer.
+    const Bounds query = toBounds(queryBBox);
+    const auto testBoxes = [&](const Batch& boxes) { return boxesCollide(query, boxes); };
+    const auto testCircles = [&](const Batch& circles) { return circlesAndBoxCollide(query, circles); };
+    const auto boxHit = [&](uint32_t uid) { return inGroup(s.boxFeatures[uid], collisionGroup); };
+    const auto circleHit = [&](uint32_t uid) { return inGroup(s.circleFeatures[uid], collisionGroup); };
+
+    auto cx1 = convertToXCellCoord(queryBBox.min.x);
+    auto cy1 = convertToYCellCoord(queryBBox.min.y);
+    auto cx2 = convertToXCellCoord(queryBBox.max.x);
+    auto cy2 = convertToYCellCoord(queryBBox.max.y);
+
+    for (std::size_t x = cx1; x <= cx2; ++x) {
+        for (std::size_t y = cy1; y <= cy2; ++y) {
+            const std::size_t cellIndex = xCellCount * y + x;
+            if (forEachCollision(s.boxCells[cellIndex], testBoxes, boxHit) ||
+                forEachCollision(s.circleCells[cellIndex], testCircles, circleHit)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool CollisionGrid::hitTest(const BCircle& queryBCircle, std::optional<uint16_t> collisionGroup) const {
+    const Storage& s = *storage;
+
+    const BBox queryBBox = circleToBox(toBounds(queryBCircle));
+    if (noIntersection(queryBBox)) {
+        return false;
+    } else if (completeIntersection(queryBBox)) {
+        for (auto handle : s.boxFeatures) {
+            if (inGroup(handle, collisionGroup)) return true;
+        }
+        for (auto handle : s.circleFeatures) {
+            if (inGroup(handle, collisionGroup)) return true;
+        }
+        return false;
+    }
+
+    const Bounds query = toBounds(queryBCircle);
+    const auto testBoxes = [&](const Batch& boxes) { return circleAndBoxesCollide(query, boxes); };
+    const auto testCircles = [&](const Batch& circles) { return circlesCollide(query, circles); };
+    const auto boxHit = [&](uint32_t uid) { return inGroup(s.boxFeatures[uid], collisionGroup); };
+    const auto circleHit = [&](uint32_t uid) { return inGroup(s.circleFeatures[uid], collisionGroup); };
+
+    auto cx1 = convertToXCellCoord(queryBBox.min.x);
+    auto cy1 = convertToYCellCoord(queryBBox.min.y);
+    auto cx2 = convertToXCellCoord(queryBBox.max.x);
+    auto cy2 = convertToYCellCoord(queryBBox.max.y);
+
+    for (std::size_t x = cx1; x <= cx2; ++x) {
+        for (std::size_t y = cy1; y <= cy2; ++y) {
+            const std::size_t cellIndex = xCellCount * y + x;
+            if (forEachCollision(s.boxCells[cellIndex], testBoxes, boxHit) ||
+                forEachCollision(s.circleCells[cellIndex], testCircles, circleHit)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool CollisionGrid::empty() const {
+    return storage->boxes.empty() && storage->circles.empty();
+}
+
+std::size_t CollisionGrid::size() const {
+    return storage->boxes.size() + storage->circles.size();
+}
+
+bool CollisionGrid::noIntersection(const BBox& queryBBox) const {
+    return queryBBox.max.x < 0 || queryBBox.min.x >= width || queryBBox.max.y < 0 || queryBBox.min.y >= height;
+}
+
+bool CollisionGrid::completeIntersection(const BBox& queryBBox) const {
+    return queryBBox.min.x <= 0 && queryBBox.min.y <= 0 && width <= queryBBox.max.x && height <= queryBBox.max.y;
+}
+
+bool CollisionGrid::inGroup(FeatureHandle handle, std::optional<uint16_t> collisionGroup) const {
+    return !collisionGroup || storage->features[handle].collisionGroupId == *collisionGroup;
+}
+
+std::size_t CollisionGrid::convertToXCellCoord(const float x) const {
+    return static_cast<size_t>(util::max(0.0, util::min(xCellCount - 1.0, std::floor(x * xScale))));
+}
+
+std::size_t CollisionGrid::convertToYCellCoord(const float y) const {
+    return static_cast<size_t>(util::max(0.0, util::min(yCellCount - 1.0, std::floor(y * yScale))));
+}
+
+} // namespace mbgl
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/util/grid_index.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+/*
+ CollisionGrid is the grid used by CollisionIndex for symbol placement.
+ It splits the plane into cells the same way GridIndex does, but cells
+ only hold plain records: the coordinates of a box or circle and a 32-bit
+ id, with the indexed features kept once in a side table. Candidates of
+ a cell are tested four at a time with SIMD where available, collision
+ groups are compared by id, and the storage of grids released by earlier
+ placements is reused.
+*/
+class CollisionGrid {
+public:
+    using BBox = GridIndex<IndexedSubfeature>::BBox;
+    using BCircle = GridIndex<IndexedSubfeature>::BCircle;
+    using FeatureHandle = uint32_t;
+
+    CollisionGrid(float width, float height, uint32_t cellSize);
+    ~CollisionGrid();
+
+    CollisionGrid(const CollisionGrid&) = delete;
+    CollisionGrid& operator=(const CollisionGrid&) = delete;
+
+    // Adds a feature to the side table. All geometries of the feature are inserted with the returned handle.
+    FeatureHandle addFeature(const IndexedSubfeature&, uint32_t bucketInstanceId, uint16_t collisionGroupId);
+    const IndexedSubfeature& getFeature(FeatureHandle) const;
+
+    void insert(FeatureHandle, const BBox&);
+    void insert(FeatureHandle, const BCircle&);
+
+    // Returns the handles of the features that have a geometry intersecting the given box, in the same order as
+    // GridIndex::queryWithBoxes(). Circles are reported with their bounding boxes.
+    std::vector<std::pair<FeatureHandle, BBox>> queryWithBoxes(const BBox&) const;
+
+    // When a collision group is given, only geometries of features in that group are considered.
+    bool hitTest(const BBox&, std::optional<uint16_t> collisionGroup = std::nullopt) const;
+    bool hitTest(const BCircle&, std::optional<uint16_t> collisionGroup = std::nullopt) const;
+
+    bool empty() const;
+    std::size_t size() const;
+
+private:
+    struct Storage;
+
+    static std::unique_ptr<Storage> acquireStorage(std::size_t cellCount);
+    static void releaseStorage(std::unique_ptr<Storage>);
+
+    bool noIntersection(const BBox&) const;
+    bool completeIntersection(const BBox&) const;
+    bool inGroup(FeatureHandle, std::optional<uint16_t> collisionGroup) const;
+
+    std::size_t convertToXCellCoord(float x) const;
+    std::size_t convertToYCellCoord(float y) const;
+
+    const float width;
+    const float height;
+
+    const std::size_t xCellCount;
+    const std::size_t yCellCount;
+    const double xScale;
+    const double yScale;
+
+    std::unique_ptr<Storage> storage;
+};
+
+} // namespace mbgl
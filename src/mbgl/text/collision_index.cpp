@@ -156,7 +156,7 @@ std::pair<bool, bool> CollisionIndex::placeFeature(
     const bool pitchWithMap,
     const bool collisionDebug,
     const std::optional<CollisionBoundaries>& avoidEdges,
-    const std::optional<std::function<bool(const IndexedSubfeature&)>>& collisionGroupPredicate,
+    std::optional<uint16_t> collisionGroup,
     std::vector<ProjectedCollisionBox>& projectedBoxes) {
     assert(projectedBoxes.empty());
     if (!feature.alongLine) {
@@ -165,7 +165,7 @@ std::pair<bool, bool> CollisionIndex::placeFeature(
         projectedBoxes.emplace_back(
             collisionBoundaries[0], collisionBoundaries[1], collisionBoundaries[2], collisionBoundaries[3]);
         if ((avoidEdges && !isInsideTile(collisionBoundaries, *avoidEdges)) || !isInsideGrid(collisionBoundaries) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes.back().box(), collisionGroupPredicate))) {
+            (!allowOverlap && collisionGrid.hitTest(projectedBoxes.back().box(), collisionGroup))) {
             return {false, false};
         }
 
@@ -182,7 +182,7 @@ std::pair<bool, bool> CollisionIndex::placeFeature(
                                 pitchWithMap,
                                 collisionDebug,
                                 avoidEdges,
-                                collisionGroupPredicate,
+                                collisionGroup,
                                 projectedBoxes);
     }
 }
@@ -199,7 +199,7 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
     const bool pitchWithMap,
     const bool collisionDebug,
     const std::optional<CollisionBoundaries>& avoidEdges,
-    const std::optional<std::function<bool(const IndexedSubfeature&)>>& collisionGroupPredicate,
+    std::optional<uint16_t> collisionGroup,
     std::vector<ProjectedCollisionBox>& projectedBoxes) {
     assert(feature.alongLine);
     assert(projectedBoxes.empty());
@@ -247,6 +247,16 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
                                                    pitchWithMap);
     }
 
+    if (firstAndLastGlyph) {
+        circleAnchors.clear();
+        circleAnchors.reserve(feature.boxes.size());
+        for (const CollisionBox& circle : feature.boxes) {
+            circleAnchors.push_back(circle.anchor);
+        }
+        util::projectPoints(circleAnchors, posMatrix, projectedCircleAnchors);
+    }
+    const auto size = transformState.getSize();
+
     bool previousCirclePlaced = false;
     projectedBoxes.resize(feature.boxes.size());
     for (size_t i = 0; i < feature.boxes.size(); i++) {
@@ -261,7 +271,10 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
             continue;
         }
 
-        const auto projectedPoint = projectPoint(posMatrix, circle.anchor);
+        // Same as projectPoint(), for the anchor projected above.
+        const Point<float> projectedPoint{
+            (projectedCircleAnchors.x[i] + 1) / 2 * size.width + viewportPadding,
+            (-projectedCircleAnchors.y[i] + 1) / 2 * size.height + viewportPadding};
         const float tileUnitRadius = (circle.x2 - circle.x1) / 2;
         const float radius = tileUnitRadius * tileToViewport;
 
@@ -308,7 +321,7 @@ std::pair<bool, bool> CollisionIndex::placeLineFeature(
         inGrid |= isInsideGrid(collisionBoundaries);
 
         if ((avoidEdges && !isInsideTile(collisionBoundaries, *avoidEdges)) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes[i].circle(), collisionGroupPredicate))) {
+            (!allowOverlap && collisionGrid.hitTest(projectedBoxes[i].circle(), collisionGroup))) {
             if (!collisionDebug) {
                 return {false, false};
             } else {
@@ -327,35 +340,27 @@ void CollisionIndex::insertFeature(const CollisionFeature& feature,
                                    bool ignorePlacement,
                                    uint32_t bucketInstanceId,
                                    uint16_t collisionGroupId) {
+    CollisionGrid& grid = ignorePlacement ? ignoredGrid : collisionGrid;
     if (feature.alongLine) {
+        std::optional<CollisionGrid::FeatureHandle> handle;
         for (auto& circle : projectedBoxes) {
             if (!circle.isCircle()) {
                 continue;
             }
-
-            if (ignorePlacement) {
-                ignoredGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
-                                   circle.circle());
-            } else {
-                collisionGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
-                                     circle.circle());
+            if (!handle) {
+                handle = grid.addFeature(feature.indexedFeature, bucketInstanceId, collisionGroupId);
             }
+            grid.insert(*handle, circle.circle());
         }
     } else if (!projectedBoxes.empty()) {
         assert(projectedBoxes.size() == 1);
         auto& box = projectedBoxes[0];
         assert(box.isBox());
-        if (ignorePlacement) {
-            ignoredGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
-                               box.box());
-        } else {
-            collisionGrid.insert(IndexedSubfeature(feature.indexedFeature, bucketInstanceId, collisionGroupId),
-                                 box.box());
-        }
+        grid.insert(grid.addFeature(feature.indexedFeature, bucketInstanceId, collisionGroupId), box.box());
     }
 }
 
-bool polygonIntersectsBox(const LineString<float>& polygon, const GridIndex<IndexedSubfeature>::BBox& bbox) {
+bool polygonIntersectsBox(const LineString<float>& polygon, const CollisionGrid::BBox& bbox) {
     // This is just a wrapper that allows us to use the integer-based util::polygonIntersectsPolygon
     // Conversion limits our query accuracy to single-pixel resolution
     GeometryCoordinates integerPolygon;
@@ -387,28 +392,26 @@ std::unordered_map<uint32_t, std::vector<IndexedSubfeature>> CollisionIndex::que
 
     auto envelope = mapbox::geometry::envelope(gridQuery);
 
-    using QueryResult = std::pair<IndexedSubfeature, GridIndex<IndexedSubfeature>::BBox>;
-
-    std::vector<QueryResult> features = collisionGrid.queryWithBoxes(envelope);
-    std::vector<QueryResult> ignoredFeatures = ignoredGrid.queryWithBoxes(envelope);
-    features.insert(features.end(), ignoredFeatures.begin(), ignoredFeatures.end());
-
     std::unordered_map<uint32_t, std::unordered_set<size_t>> seenBuckets;
-    for (auto& queryResult : features) {
-        auto& feature = queryResult.first;
-        auto& bbox = queryResult.second;
+    auto collectFeatures = [&](const CollisionGrid& grid) {
+        for (auto& queryResult : grid.queryWithBoxes(envelope)) {
+            auto& feature = grid.getFeature(queryResult.first);
+            auto& bbox = queryResult.second;
 
-        // Skip already seen features.
-        auto& seenFeatures = seenBuckets[feature.bucketInstanceId];
-        if (seenFeatures.find(feature.index) != seenFeatures.end()) continue;
+            // Skip already seen features.
+            auto& seenFeatures = seenBuckets[feature.bucketInstanceId];
+            if (seenFeatures.find(feature.index) != seenFeatures.end()) continue;
 
-        if (!polygonIntersectsBox(gridQuery, bbox)) {
-            continue;
-        }
+            if (!polygonIntersectsBox(gridQuery, bbox)) {
+                continue;
+            }
 
-        seenFeatures.insert(feature.index);
-        result[feature.bucketInstanceId].push_back(feature);
-    }
+            seenFeatures.insert(feature.index);
+            result[feature.bucketInstanceId].push_back(feature);
+        }
+    };
+    collectFeatures(collisionGrid);
+    collectFeatures(ignoredGrid);
 
     return result;
 }
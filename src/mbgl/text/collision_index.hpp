@@ -3,8 +3,9 @@
 #include <mbgl/geometry/feature_index.hpp>
 
 #include <mbgl/text/collision_feature.hpp>
-#include <mbgl/util/grid_index.hpp>
+#include <mbgl/text/collision_grid.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/util/projection_batch.hpp>
 
 #include <array>
 
@@ -27,8 +28,6 @@ struct IntersectStatus {
 };
 class CollisionIndex {
 public:
-    using CollisionGrid = GridIndex<IndexedSubfeature>;
-
     explicit CollisionIndex(const TransformState&, MapMode);
     IntersectStatus intersectsTileEdges(const CollisionBox&,
                                         Point<float> shift,
@@ -48,7 +47,7 @@ public:
         bool pitchWithMap,
         bool collisionDebug,
         const std::optional<CollisionBoundaries>& avoidEdges,
-        const std::optional<std::function<bool(const IndexedSubfeature&)>>& collisionGroupPredicate,
+        std::optional<uint16_t> collisionGroup,
         std::vector<ProjectedCollisionBox>& /*out*/);
 
     void insertFeature(const CollisionFeature& feature,
@@ -83,7 +82,7 @@ private:
         bool pitchWithMap,
         bool collisionDebug,
         const std::optional<CollisionBoundaries>& avoidEdges,
-        const std::optional<std::function<bool(const IndexedSubfeature&)>>& collisionGroupPredicate,
+        std::optional<uint16_t> collisionGroup,
         std::vector<ProjectedCollisionBox>& /*out*/);
 
     float approximateTileDistance(const TileDistance& tileDistance,
@@ -113,6 +112,10 @@ private:
     const float gridBottomBoundary;
 
     const float pitchFactor;
+
+    // Scratch buffers for projecting the collision circles of a line label.
+    PointBatch circleAnchors;
+    ProjectedPointBatch projectedCircleAnchors;
 };
 
 } // namespace mbgl
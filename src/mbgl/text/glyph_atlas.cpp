@@ -1,48 +1,200 @@
 #include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/gfx/upload_pass.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
 
-#include <mapbox/shelf-pack.hpp>
+#include <algorithm>
+#include <cassert>
 
 namespace mbgl {
 
-static constexpr uint32_t padding = 1;
+namespace {
 
-GlyphAtlas makeGlyphAtlas(const GlyphMap& glyphs) {
-    GlyphAtlas result;
+// When copied into the atlas texture, glyph bitmaps are padded by one pixel on each side.
+constexpr uint16_t padding = 1;
 
-    mapbox::ShelfPack::ShelfPackOptions options;
-    options.autoResize = true;
-    mapbox::ShelfPack pack(0, 0, options);
+// Used until the graphics context reports its own limit; every OpenGL ES 3 context supports it.
+constexpr uint32_t defaultMaximumSize = 2048;
+// Glyph rects are stored with 16 bit coordinates.
+constexpr uint32_t largestMaximumSize = 32768;
 
-    for (const auto& glyphMapEntry : glyphs) {
-        FontStackHash fontStack = glyphMapEntry.first;
-        GlyphPositionMap& positions = result.positions[fontStack];
+} // namespace
 
-        for (const auto& entry : glyphMapEntry.second) {
-            if (entry.second && (*entry.second)->bitmap.valid()) {
-                const Glyph& glyph = **entry.second;
+GlyphAtlas::GlyphAtlas()
+    : shelfPack(128, 128),
+      maximumSize(defaultMaximumSize),
+      atlasImage(getPixelSize()) {}
 
-                const mapbox::Bin& bin = *pack.packOne(
-                    -1, glyph.bitmap.size.width + 2 * padding, glyph.bitmap.size.height + 2 * padding);
+GlyphAtlas::~GlyphAtlas() = default;
 
-                result.image.resize({static_cast<uint32_t>(pack.width()), static_cast<uint32_t>(pack.height())});
+void GlyphAtlas::setMaximumSize(uint32_t size) {
+    maximumSize = std::min(size, largestMaximumSize);
+}
+
+std::optional<GlyphPosition> GlyphAtlas::addGlyph(FontStackHash fontStack, const Immutable<Glyph>& glyph) {
+    auto fontGlyphs = glyphs.find(fontStack);
+    if (fontGlyphs != glyphs.end()) {
+        auto it = fontGlyphs->second.find(glyph->id);
+        if (it != fontGlyphs->second.end()) {
+            if (it->second.glyph == glyph) {
+                ++it->second.refCount;
+                return it->second.position;
+            }
+            // The glyph was reloaded: keep the old one for its references and pack the new one.
+            supersededGlyphs.emplace_back(fontStack, std::move(it->second));
+            fontGlyphs->second.erase(it);
+            if (fontGlyphs->second.empty()) {
+                glyphs.erase(fontGlyphs);
+            }
+        }
+    }
+
+    if (!glyph->bitmap.valid()) {
+        return std::nullopt;
+    }
+
+    const auto width = static_cast<uint16_t>(glyph->bitmap.size.width + 2 * padding);
+    const auto height = static_cast<uint16_t>(glyph->bitmap.size.height + 2 * padding);
+    mapbox::Bin* bin = pack(width, height);
+    if (!bin) {
+        Log::Warning(Event::Glyph,
+                     "Glyph atlas reached its maximum size of " + util::toString(maximumSize) +
+                         " pixels; glyph " + util::toString(static_cast<uint32_t>(glyph->id)) + " is not drawn");
+        return std::nullopt;
+    }
+
+    const Size pixelSize = getPixelSize();
+    if (pixelSize != atlasImage.size) {
+        atlasImage.resize(pixelSize);
+        resized = true;
+    }
+
+    AlphaImage::copy(glyph->bitmap,
+                     atlasImage,
+                     {0, 0},
+                     {static_cast<uint32_t>(bin->x + padding), static_cast<uint32_t>(bin->y + padding)},
+                     glyph->bitmap.size);
+
+    const Rect<uint16_t> rect{static_cast<uint16_t>(bin->x), static_cast<uint16_t>(bin->y), width, height};
+    dirtyRects.push_back(rect);
+
+    return glyphs[fontStack]
+        .emplace(glyph->id, Entry{glyph, bin, GlyphPosition{rect, glyph->metrics}, 1})
+        .first->second.position;
+}
+
+mapbox::Bin* GlyphAtlas::pack(uint16_t width, uint16_t height) {
+    while (true) {
+        if (mapbox::Bin* bin = shelfPack.packOne(-1, width, height)) {
+            return bin;
+        }
+
+        // Grow by doubling the shorter side, so that resizes stay amortized, until both sides
+        // reach the maximum size.
+        auto packWidth = static_cast<uint32_t>(shelfPack.width());
+        auto packHeight = static_cast<uint32_t>(shelfPack.height());
+        if (packWidth <= packHeight && packWidth * 2 <= maximumSize) {
+            packWidth *= 2;
+        } else if (packHeight * 2 <= maximumSize) {
+            packHeight *= 2;
+        } else if (packWidth * 2 <= maximumSize) {
+            packWidth *= 2;
+        } else {
+            return nullptr;
+        }
+        shelfPack.resize(static_cast<int32_t>(packWidth), static_cast<int32_t>(packHeight));
+    }
+}
 
-                AlphaImage::copy(
-                    glyph.bitmap, result.image, {0, 0}, {bin.x + padding, bin.y + padding}, glyph.bitmap.size);
+bool GlyphAtlas::release(Entry& entry) {
+    assert(entry.refCount > 0);
+    if (--entry.refCount > 0) return false;
 
-                positions.emplace(glyph.id,
-                                  GlyphPosition{Rect<uint16_t>{static_cast<uint16_t>(bin.x),
-                                                               static_cast<uint16_t>(bin.y),
-                                                               static_cast<uint16_t>(bin.w),
-                                                               static_cast<uint16_t>(bin.h)},
-                                                glyph.metrics});
+    // Clear the glyph, so that a smaller glyph reusing its space does not sample stale pixels.
+    const Rect<uint16_t>& rect = entry.position.rect;
+    AlphaImage::clear(atlasImage, {rect.x, rect.y}, {rect.w, rect.h});
+    dirtyRects.push_back(rect);
+
+    shelfPack.unref(*entry.bin);
+    return true;
+}
+
+void GlyphAtlas::removeGlyph(FontStackHash fontStack, const Glyph& glyph) {
+    auto fontGlyphs = glyphs.find(fontStack);
+    if (fontGlyphs != glyphs.end()) {
+        auto it = fontGlyphs->second.find(glyph.id);
+        if (it != fontGlyphs->second.end() && it->second.glyph.get() == &glyph) {
+            if (release(it->second)) {
+                fontGlyphs->second.erase(it);
+                if (fontGlyphs->second.empty()) {
+                    glyphs.erase(fontGlyphs);
+                }
             }
         }
     }
 
-    pack.shrink();
-    result.image.resize({static_cast<uint32_t>(pack.width()), static_cast<uint32_t>(pack.height())});
+    auto superseded = std::find_if(supersededGlyphs.begin(), supersededGlyphs.end(), [&](const auto& pair) {
+        return pair.first == fontStack && pair.second.glyph.get() == &glyph;
+    });
+    if (superseded != supersededGlyphs.end() && release(superseded->second)) {
+        supersededGlyphs.erase(superseded);
+    }
+
+    if (isEmpty()) {
+        // Nothing is referenced anymore: drop the shelves too, so that glyphs of other sizes can
+        // use all of the space again.
+        shelfPack.clear();
+    }
+}
+
+std::optional<GlyphPosition> GlyphAtlas::getGlyphPosition(FontStackHash fontStack, GlyphID glyphID) const {
+    auto fontGlyphs = glyphs.find(fontStack);
+    if (fontGlyphs == glyphs.end()) return std::nullopt;
+
+    auto it = fontGlyphs->second.find(glyphID);
+    if (it == fontGlyphs->second.end()) return std::nullopt;
+
+    return it->second.position;
+}
 
+Size GlyphAtlas::getPixelSize() const {
+    return {static_cast<uint32_t>(shelfPack.width()), static_cast<uint32_t>(shelfPack.height())};
+}
+
+std::size_t GlyphAtlas::size() const {
+    std::size_t result = supersededGlyphs.size();
+    for (const auto& fontGlyphs : glyphs) {
+        result += fontGlyphs.second.size();
+    }
     return result;
 }
 
+void GlyphAtlas::upload(gfx::UploadPass& uploadPass) {
+    if (!atlasTexture) {
+        atlasTexture = uploadPass.createTexture(atlasImage);
+    } else if (resized) {
+        uploadPass.updateTexture(*atlasTexture, atlasImage);
+    } else if (!dirtyRects.empty()) {
+        // Only re-upload the rows holding the glyphs added or removed since the last upload, as a
+        // single band.
+        uint32_t top = atlasImage.size.height;
+        uint32_t bottom = 0;
+        for (const auto& rect : dirtyRects) {
+            top = std::min<uint32_t>(top, rect.y);
+            bottom = std::max<uint32_t>(bottom, rect.y + rect.h);
+        }
+        AlphaImage band({atlasImage.size.width, bottom - top});
+        AlphaImage::copy(atlasImage, band, {0, top}, {0, 0}, band.size);
+        uploadPass.updateTextureSub(*atlasTexture, band, 0, static_cast<uint16_t>(top));
+    }
+
+    dirtyRects.clear();
+    resized = false;
+}
+
+gfx::TextureBinding GlyphAtlas::textureBinding() const {
+    assert(atlasTexture);
+    return {atlasTexture->getResource(), gfx::TextureFilterType::Linear};
+}
+
 } // namespace mbgl
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <mbgl/gfx/texture.hpp>
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/util/immutable.hpp>
 
 #include <mapbox/shelf-pack.hpp>
 
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace mbgl {
 
+namespace gfx {
+class UploadPass;
+} // namespace gfx
+
 struct GlyphPosition {
     Rect<uint16_t> rect;
     GlyphMetrics metrics;
@@ -14,12 +25,65 @@ struct GlyphPosition {
 using GlyphPositionMap = std::map<GlyphID, GlyphPosition>;
 using GlyphPositions = std::map<FontStackHash, GlyphPositionMap>;
 
+// Renderer-wide atlas of SDF glyphs, shared by the symbol buckets of all tiles.
+//
+// Glyphs are packed incrementally and reference counted: a glyph keeps its position for as long
+// as it is referenced, and its space is released for reuse once the last reference is removed.
+// The atlas only grows, up to the maximum texture size, so positions handed out earlier stay valid
+// when new glyphs are added. Entries are keyed by the glyph they were packed from: a glyph that is
+// reloaded, e.g. after the glyph URL changed, is packed again while the old one stays referenced.
 class GlyphAtlas {
 public:
-    AlphaImage image;
-    GlyphPositions positions;
-};
+    GlyphAtlas();
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+    ~GlyphAtlas();
+
+    // Adds a reference to the glyph, packing it into the atlas first if needed. Returns
+    // std::nullopt for glyphs without a bitmap, and for glyphs that don't fit in an atlas of the
+    // maximum size; neither are drawn.
+    std::optional<GlyphPosition> addGlyph(FontStackHash, const Immutable<Glyph>&);
+    // Removes a reference added by addGlyph() for this glyph.
+    void removeGlyph(FontStackHash, const Glyph&);
+
+    // Returns the position of the glyph most recently added for this id.
+    std::optional<GlyphPosition> getGlyphPosition(FontStackHash, GlyphID) const;
+
+    // Limits the size of the atlas to the maximum texture size of the graphics context.
+    void setMaximumSize(uint32_t);
 
-GlyphAtlas makeGlyphAtlas(const GlyphMap&);
+    void upload(gfx::UploadPass&);
+    gfx::TextureBinding textureBinding() const;
+    Size getPixelSize() const;
+
+    const AlphaImage& getAtlasImageForTests() const { return atlasImage; }
+
+    bool isEmpty() const { return glyphs.empty() && supersededGlyphs.empty(); }
+    std::size_t size() const;
+
+private:
+    struct Entry {
+        Immutable<Glyph> glyph;
+        mapbox::Bin* bin;
+        GlyphPosition position;
+        uint32_t refCount;
+    };
+
+    mapbox::Bin* pack(uint16_t width, uint16_t height);
+    // Releases the reference, and the entry's space once it's no longer referenced. Returns
+    // whether the entry is gone.
+    bool release(Entry&);
+
+    mapbox::ShelfPack shelfPack;
+    uint32_t maximumSize;
+    std::unordered_map<FontStackHash, std::unordered_map<GlyphID, Entry>> glyphs;
+    // Entries replaced by a reloaded glyph that are still referenced.
+    std::vector<std::pair<FontStackHash, Entry>> supersededGlyphs;
+    AlphaImage atlasImage;
+    std::optional<gfx::Texture> atlasTexture;
+    // Regions of the atlas image changed since the last upload.
+    std::vector<Rect<uint16_t>> dirtyRects;
+    bool resized = true;
+};
 
 } // namespace mbgl
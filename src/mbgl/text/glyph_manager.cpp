@@ -124,31 +124,69 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
     observer->onGlyphsLoaded(fontStack, range);
 }
 
+void GlyphManager::setURL(const std::string& url) {
+    if (url == glyphURL) {
+        return;
+    }
+    glyphURL = url;
+
+    // Ranges that are still loading keep their requestors, and answer them when they arrive.
+    for (auto& entry : entries) {
+        util::erase_if(entry.second.ranges, [](const auto& range) { return range.second.parsed; });
+        util::erase_if(entry.second.glyphs, [&](const auto& glyph) {
+            return !localGlyphRasterizer->canRasterizeGlyph(entry.first, glyph.first) &&
+                   entry.second.ranges.count(getGlyphRange(glyph.first)) == 0;
+        });
+    }
+}
+
 void GlyphManager::setObserver(GlyphManagerObserver* observer_) {
     observer = observer_ ? observer_ : &nullObserver;
 }
 
 void GlyphManager::notify(GlyphRequestor& requestor, const GlyphDependencies& glyphDependencies) {
     GlyphMap response;
+    GlyphPositions positions;
+    auto& retained = atlasGlyphs[&requestor];
 
     for (const auto& dependency : glyphDependencies) {
         const FontStack& fontStack = dependency.first;
         const GlyphIDs& glyphIDs = dependency.second;
 
-        Glyphs& glyphs = response[FontStackHasher()(fontStack)];
+        const FontStackHash fontStackHash = FontStackHasher()(fontStack);
+        Glyphs& glyphs = response[fontStackHash];
+        GlyphPositionMap& glyphPositions = positions[fontStackHash];
         Entry& entry = entries[fontStack];
 
         for (const auto& glyphID : glyphIDs) {
             auto it = entry.glyphs.find(glyphID);
-            if (it != entry.glyphs.end()) {
-                glyphs.emplace(*it);
-            } else {
+            if (it == entry.glyphs.end()) {
                 glyphs.emplace(glyphID, std::nullopt);
+                continue;
+            }
+            glyphs.emplace(*it);
+
+            // A requestor holds a single reference to each of its glyphs. When the glyph was reloaded
+            // since, the reference moves to the new glyph.
+            std::optional<GlyphPosition> position;
+            auto held = retained.find({fontStackHash, glyphID});
+            if (held == retained.end()) {
+                retained.emplace(std::make_pair(fontStackHash, glyphID), it->second);
+                position = glyphAtlas.addGlyph(fontStackHash, it->second);
+            } else if (held->second != it->second) {
+                position = glyphAtlas.addGlyph(fontStackHash, it->second);
+                glyphAtlas.removeGlyph(fontStackHash, *held->second);
+                held->second = it->second;
+            } else {
+                position = glyphAtlas.getGlyphPosition(fontStackHash, glyphID);
+            }
+            if (position) {
+                glyphPositions.emplace(glyphID, *position);
             }
         }
     }
 
-    requestor.onGlyphsAvailable(response);
+    requestor.onGlyphsAvailable(std::move(response), std::move(positions));
 }
 
 void GlyphManager::removeRequestor(GlyphRequestor& requestor) {
@@ -157,6 +195,14 @@ void GlyphManager::removeRequestor(GlyphRequestor& requestor) {
             range.second.requestors.erase(&requestor);
         }
     }
+
+    auto retained = atlasGlyphs.find(&requestor);
+    if (retained != atlasGlyphs.end()) {
+        for (const auto& glyph : retained->second) {
+            glyphAtlas.removeGlyph(glyph.first.first, *glyph.second);
+        }
+        atlasGlyphs.erase(retained);
+    }
 }
 
 void GlyphManager::evict(const std::set<FontStack>& keep) {
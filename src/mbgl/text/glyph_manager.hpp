@@ -1,14 +1,18 @@
 #pragma once
 
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/text/local_glyph_rasterizer.hpp>
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/immutable.hpp>
 
+#include <map>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace mbgl {
 
@@ -18,7 +22,8 @@ class Response;
 
 class GlyphRequestor {
 public:
-    virtual void onGlyphsAvailable(GlyphMap) = 0;
+    // Provides the requested glyphs, together with their positions in the renderer-wide glyph atlas.
+    virtual void onGlyphsAvailable(GlyphMap, GlyphPositions) = 0;
 
 protected:
     virtual ~GlyphRequestor() = default;
@@ -38,15 +43,21 @@ public:
     // FileSource is made for each range needed, and notifies the observer when all are
     // complete.
     void getGlyphs(GlyphRequestor&, GlyphDependencies, FileSource&);
+    // Cancels pending requests of the requestor and releases the atlas glyphs provided to it.
     void removeRequestor(GlyphRequestor&);
 
-    void setURL(const std::string& url) { glyphURL = url; }
+    // Changing the URL drops the glyphs loaded from the previous one, so that they are loaded again.
+    void setURL(const std::string& url);
 
     void setObserver(GlyphManagerObserver*);
 
     // Remove glyphs for all but the supplied font stacks.
     void evict(const std::set<FontStack>&);
 
+    // Atlas holding the glyphs provided to the current requestors. Glyphs are referenced by
+    // every requestor they were provided to, until it is removed.
+    GlyphAtlas& getGlyphAtlas() { return glyphAtlas; }
+
 private:
     Glyph generateLocalSDF(const FontStack& fontStack, GlyphID glyphID);
     std::string glyphURL;
@@ -64,6 +75,10 @@ private:
 
     std::unordered_map<FontStack, Entry, FontStackHasher> entries;
 
+    GlyphAtlas glyphAtlas;
+    // The glyphs each requestor references in the atlas.
+    std::unordered_map<GlyphRequestor*, std::map<std::pair<FontStackHash, GlyphID>, Immutable<Glyph>>> atlasGlyphs;
+
     void requestRange(GlyphRequest&, const FontStack&, const GlyphRange&, FileSource& fileSource);
     void processResponse(const Response&, const FontStack&, const GlyphRange&);
     void notify(GlyphRequestor&, const GlyphDependencies&);
@@ -1,5 +1,6 @@
 #include <list>
 #include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/render_layer.hpp>
@@ -7,6 +8,7 @@
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/text/placement.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/util/mat4.hpp>
 #include <mbgl/util/math.hpp>
 #include <utility>
 
@@ -40,18 +42,13 @@ bool JointOpacityState::isHidden() const {
 }
 
 const CollisionGroups::CollisionGroup& CollisionGroups::get(const std::string& sourceID) {
-    // The predicate/groupID mechanism allows for arbitrary grouping,
+    // The groupID mechanism allows for arbitrary grouping,
     // but the current interface defines one source == one group when
     // crossSourceCollisions == true.
     if (!crossSourceCollisions) {
         if (collisionGroups.find(sourceID) == collisionGroups.end()) {
             uint16_t nextGroupID = ++maxGroupID;
-            collisionGroups.emplace(
-                sourceID,
-                CollisionGroup(nextGroupID,
-                               std::optional<Predicate>([nextGroupID](const IndexedSubfeature& feature) -> bool {
-                                   return feature.collisionGroupId == nextGroupID;
-                               })));
+            collisionGroups.emplace(sourceID, CollisionGroup(nextGroupID, nextGroupID));
         }
         return collisionGroups[sourceID];
     } else {
@@ -72,6 +69,7 @@ public:
     PlacementContext(const SymbolBucket& bucket_,
                      const RenderTile& renderTile_,
                      const TransformState& state_,
+                     const mat4& posMatrix_,
                      float placementZoom,
                      CollisionGroups::CollisionGroup collisionGroup_,
                      std::optional<CollisionBoundaries> avoidEdges_ = std::nullopt)
@@ -81,6 +79,7 @@ public:
           pixelsToTileUnits(renderTile_.id.pixelsToTileUnits(1, placementZoom)),
           scale(static_cast<float>(std::pow(2, placementZoom - getOverscaledID().overscaledZ))),
           pixelRatio(static_cast<float>(util::tileSize_D * getOverscaledID().overscaleFactor() / util::EXTENT)),
+          posMatrix(posMatrix_),
           collisionGroup(std::move(collisionGroup_)),
           partiallyEvaluatedTextSize(bucket_.textSizeBinder->evaluateForZoom(placementZoom)),
           partiallyEvaluatedIconSize(bucket_.iconSizeBinder->evaluateForZoom(placementZoom)),
@@ -101,6 +100,7 @@ public:
     float pixelsToTileUnits;
     float scale;
     float pixelRatio;
+    mat4 posMatrix;
 
     bool rotateTextWithMap = getLayout().get<TextRotationAlignment>() == AlignmentType::Map;
     bool pitchTextWithMap = getLayout().get<TextPitchAlignment>() == AlignmentType::Map;
@@ -109,12 +109,11 @@ public:
     SymbolPlacementType placementType = getLayout().get<SymbolPlacement>();
 
     mat4 textLabelPlaneMatrix = getLabelPlaneMatrix(
-        renderTile.get().matrix, pitchTextWithMap, rotateTextWithMap, state, pixelsToTileUnits);
+        posMatrix, pitchTextWithMap, rotateTextWithMap, state, pixelsToTileUnits);
     mat4 iconLabelPlaneMatrix =
         (rotateTextWithMap == rotateIconWithMap && pitchTextWithMap == pitchIconWithMap)
             ? textLabelPlaneMatrix
-            : getLabelPlaneMatrix(
-                  renderTile.get().matrix, pitchIconWithMap, rotateIconWithMap, state, pixelsToTileUnits);
+            : getLabelPlaneMatrix(posMatrix, pitchIconWithMap, rotateIconWithMap, state, pixelsToTileUnits);
 
     CollisionGroups::CollisionGroup collisionGroup;
     ZoomEvaluatedSize partiallyEvaluatedTextSize;
@@ -150,13 +149,47 @@ public:
 // PlacementController implemenation
 
 PlacementController::PlacementController()
-    : placement(makeMutable<Placement>()) {}
+    : placement(makeMutable<Placement>()) {
+    auto budget = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PLACEMENT_TIME_BUDGET);
+    std::optional<double> milliseconds;
+    if (auto* value = budget.getDouble()) {
+        milliseconds = *value;
+    } else if (auto* uintValue = budget.getUint()) {
+        milliseconds = static_cast<double>(*uintValue);
+    }
+    if (milliseconds && *milliseconds >= 0.0) {
+        placementTimeBudget = std::chrono::duration_cast<Duration>(
+            std::chrono::duration<double, std::milli>(*milliseconds));
+    }
+}
 
 void PlacementController::setPlacement(Immutable<Placement> placement_) {
     placement = std::move(placement_);
+    pending = std::nullopt;
     stale = false;
 }
 
+bool PlacementController::placeLayers(std::shared_ptr<const UpdateParameters> updateParameters,
+                                      const RenderLayerReferences& layers) {
+    assert(updateParameters->mode == MapMode::Continuous);
+    const TimePoint now = updateParameters->timePoint;
+    if (!pending) {
+        pending = Placement::create(std::move(updateParameters), placement);
+    }
+
+    if (placementTimeBudget) {
+        if (!(*pending)->continuePlacement(layers, now, *placementTimeBudget)) {
+            return false;
+        }
+    } else {
+        (*pending)->placeLayers(layers);
+    }
+
+    placementLatency = (*pending)->getLatency();
+    setPlacement(std::move(*pending));
+    return true;
+}
+
 bool PlacementController::placementIsRecent(TimePoint now,
                                             const float zoom,
                                             std::optional<Duration> periodOverride) const {
@@ -170,7 +203,7 @@ bool PlacementController::placementIsRecent(TimePoint now,
 bool PlacementController::hasTransitions(TimePoint now) const {
     if (!placement->transitionsEnabled()) return false;
 
-    if (stale) return true;
+    if (stale || pending) return true;
 
     return placement->hasTransitions(now);
 }
@@ -190,6 +223,7 @@ Placement::Placement(std::shared_ptr<const UpdateParameters> updateParameters_,
     if (prevPlacement) {
         prevPlacement->get()->prevPlacement = std::nullopt; // Only hold on to one placement back
     }
+    collisionIndex.getTransformState().getProjMatrix(projMatrix);
 }
 
 Placement::Placement()
@@ -206,6 +240,44 @@ void Placement::placeLayers(const RenderLayerReferences& layers) {
     commit();
 }
 
+bool Placement::continuePlacement(const RenderLayerReferences& layers, TimePoint now, Duration budget) {
+    assert(updateParameters && updateParameters->mode == MapMode::Continuous);
+    const TimePoint deadline = Clock::now() + budget;
+    bool placedAny = false;
+    // Layers and placement data are re-read on every call, as render tiles only live for a frame.
+    for (auto it = layers.crbegin(); it != layers.crend(); ++it) {
+        const RenderLayer& layer = *it;
+        if (placedLayerIDs.count(layer.getID()) != 0u) continue;
+        if (layer.getID() != inProgressLayerID) {
+            inProgressLayerID = layer.getID();
+            inProgressBuckets.clear();
+            inProgressCrossTileIDs.clear();
+        }
+
+        for (const BucketPlacementData& data : layer.getPlacementData()) {
+            const auto& bucket = static_cast<const SymbolBucket&>(data.bucket.get());
+            auto key = std::make_pair(bucket.bucketInstanceId, data.sortKeyRange ? data.sortKeyRange->start : 0u);
+            if (inProgressBuckets.count(key) != 0u) continue;
+            if (placedAny && Clock::now() >= deadline) return false;
+
+            inProgressBuckets.insert(key);
+            data.bucket.get().place(*this, data, inProgressCrossTileIDs);
+            placedAny = true;
+        }
+        placedLayerIDs.insert(layer.getID());
+    }
+
+    placedLayerIDs.clear();
+    inProgressLayerID.clear();
+    inProgressBuckets.clear();
+    inProgressCrossTileIDs.clear();
+
+    // Fading starts from the moment the placement gets committed, not from when it was started.
+    commitTime = now;
+    commit();
+    return true;
+}
+
 void Placement::placeLayer(const RenderLayer& layer, std::set<uint32_t>& seenCrossTileIDs) {
     for (const BucketPlacementData& data : layer.getPlacementData()) {
         Bucket& bucket = data.bucket;
@@ -237,13 +309,14 @@ Point<float> calculateVariableLayoutOffset(style::SymbolAnchorType anchor,
 void Placement::placeSymbolBucket(const BucketPlacementData& params, std::set<uint32_t>& seenCrossTileIDs) {
     assert(updateParameters);
     const auto& symbolBucket = static_cast<const SymbolBucket&>(params.bucket.get());
-    const RenderTile& renderTile = params.tile;
+    const mat4 posMatrix = getPosMatrix(params.tile.get().id);
     PlacementContext ctx{symbolBucket,
                          params.tile,
                          collisionIndex.getTransformState(),
+                         posMatrix,
                          placementZoom,
                          collisionGroups.get(params.sourceId),
-                         getAvoidEdges(symbolBucket, renderTile.matrix)};
+                         getAvoidEdges(symbolBucket, posMatrix)};
     for (const SymbolInstance& symbol : getSortedSymbols(params, ctx.pixelRatio)) {
         if (seenCrossTileIDs.count(symbol.crossTileID) != 0u) continue;
         placeSymbol(symbol, ctx);
@@ -275,7 +348,7 @@ JointPlacement Placement::placeSymbol(const SymbolInstance& symbolInstance, cons
         return kUnplaced;
     }
     const SymbolBucket& bucket = ctx.getBucket();
-    const mat4& posMatrix = ctx.getRenderTile().matrix;
+    const mat4& posMatrix = ctx.posMatrix;
     const auto& collisionGroup = ctx.collisionGroup;
     auto variableTextAnchors = ctx.getVariableTextAnchors();
     textBoxes.clear();
@@ -723,6 +796,14 @@ void Placement::commit() {
     }
 
     fadeStartTime = placementChanged ? commitTime : getPrevPlacement()->fadeStartTime;
+    latency = Clock::now() - creationTime;
+}
+
+mat4 Placement::getPosMatrix(const UnwrappedTileID& tileID) const {
+    mat4 posMatrix;
+    collisionIndex.getTransformState().matrixFor(posMatrix, tileID);
+    matrix::multiply(posMatrix, projMatrix, posMatrix);
+    return posMatrix;
 }
 
 void Placement::updateLayerBuckets(const RenderLayer& layer, const TransformState& state, bool updateOpacities) const {
@@ -775,7 +856,10 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
                                     keepUpright,
                                     tile,
                                     *bucket.iconSizeBinder,
-                                    state);
+                                    state,
+                                    anchorBatch,
+                                    projectedAnchors,
+                                    labelPlaneAnchors);
                 result = true;
             }
             if (bucket.hasIconData()) {
@@ -787,7 +871,10 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
                                     keepUpright,
                                     tile,
                                     *bucket.iconSizeBinder,
-                                    state);
+                                    state,
+                                    anchorBatch,
+                                    projectedAnchors,
+                                    labelPlaneAnchors);
                 result = true;
             }
         }
@@ -803,7 +890,10 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
                                 keepUpright,
                                 tile,
                                 *bucket.textSizeBinder,
-                                state);
+                                state,
+                                anchorBatch,
+                                projectedAnchors,
+                                labelPlaneAnchors);
             result = true;
         }
     } else if (hasVariableAnchors) {
@@ -820,6 +910,13 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
             tile.matrix, pitchWithMap, rotateWithMap, state, pixelsToTileUnits);
         std::unordered_map<std::size_t, std::pair<std::size_t, Point<float>>> placedTextShifts;
 
+        anchorBatch.clear();
+        anchorBatch.reserve(bucket.text.placedSymbols.size());
+        for (const PlacedSymbol& symbol : bucket.text.placedSymbols) {
+            anchorBatch.push_back(symbol.anchorPoint);
+        }
+        util::projectPoints(anchorBatch, pitchWithMap ? tile.matrix : labelPlaneMatrix, projectedAnchors);
+
         for (std::size_t i = 0; i < bucket.text.placedSymbols.size(); ++i) {
             const PlacedSymbol& symbol = bucket.text.placedSymbols[i];
             std::optional<VariableOffset> variableOffset;
@@ -838,9 +935,9 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
                 hideGlyphs(symbol.glyphOffsets.size(), bucket.text.dynamicVertices);
             } else {
                 const Point<float> tileAnchor = symbol.anchorPoint;
-                const auto projectedAnchor = project(tileAnchor, pitchWithMap ? tile.matrix : labelPlaneMatrix);
+                const Point<float> projectedAnchor = projectedAnchors.point(i);
                 const float perspectiveRatio = 0.5f +
-                                               0.5f * (state.getCameraToCenterDistance() / projectedAnchor.second);
+                                               0.5f * (state.getCameraToCenterDistance() / projectedAnchors.w[i]);
                 float renderTextSize = evaluateSizeForFeature(partiallyEvaluatedSize, symbol) * perspectiveRatio /
                                        util::ONE_EM;
                 if (pitchWithMap) {
@@ -864,10 +961,9 @@ bool Placement::updateBucketDynamicVertices(SymbolBucket& bucket,
                         project(Point<float>(tileAnchor.x + shift.x, tileAnchor.y + shift.y), labelPlaneMatrix).first;
                 } else if (rotateWithMap) {
                     auto rotated = util::rotate(shift, -state.getPitch());
-                    shiftedAnchor = Point<float>(projectedAnchor.first.x + rotated.x,
-                                                 projectedAnchor.first.y + rotated.y);
+                    shiftedAnchor = Point<float>(projectedAnchor.x + rotated.x, projectedAnchor.y + rotated.y);
                 } else {
-                    shiftedAnchor = Point<float>(projectedAnchor.first.x + shift.x, projectedAnchor.first.y + shift.y);
+                    shiftedAnchor = Point<float>(projectedAnchor.x + shift.x, projectedAnchor.y + shift.y);
                 }
 
                 if (updateTextFitIcon && symbol.placedIconIndex) {
@@ -1433,6 +1529,7 @@ void TilePlacement::placeSymbolBucket(const BucketPlacementData& params, std::se
     PlacementContext ctx{bucket,
                          params.tile,
                          collisionIndex.getTransformState(),
+                         renderTile.matrix,
                          placementZoom,
                          collisionGroups.get(params.sourceId),
                          getAvoidEdges(bucket, renderTile.matrix)};
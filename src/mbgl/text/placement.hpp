@@ -5,12 +5,15 @@
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/text/collision_index.hpp>
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/projection_batch.hpp>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace mbgl {
 
+class Bucket;
 class SymbolBucket;
 class SymbolInstance;
 using SymbolInstanceReferences = std::vector<std::reference_wrapper<const SymbolInstance>>;
@@ -77,8 +80,8 @@ struct RetainedQueryData {
 
 class CollisionGroups {
 public:
-    using Predicate = std::function<bool(const IndexedSubfeature&)>;
-    using CollisionGroup = std::pair<uint16_t, std::optional<Predicate>>;
+    // The id of the group, and the group whose features it collides with (all features if unset).
+    using CollisionGroup = std::pair<uint16_t, std::optional<uint16_t>>;
 
     CollisionGroups(const bool crossSourceCollisions_)
         : maxGroupID(0),
@@ -103,8 +106,29 @@ public:
     bool placementIsRecent(TimePoint now, float zoom, std::optional<Duration> periodOverride = std::nullopt) const;
     bool hasTransitions(TimePoint now) const;
 
+    /**
+     * @brief places `layers` into a new continuous placement, which replaces the current one once complete.
+     *
+     * When a placement time budget is set, the placement is spread over several frames: every call
+     * resumes the pending placement (starting a new one from `updateParameters` if none is pending)
+     * and the current placement keeps being used for rendering, fading and queries meanwhile.
+     *
+     * @return `true` if the new placement was committed and became the current one.
+     */
+    bool placeLayers(std::shared_ptr<const UpdateParameters>, const RenderLayerReferences& layers);
+    bool hasPendingPlacement() const { return bool(pending); }
+
+    void setPlacementTimeBudget(std::optional<Duration> budget) { placementTimeBudget = budget; }
+    std::optional<Duration> getPlacementTimeBudget() const { return placementTimeBudget; }
+
+    // Wall-clock time between the start and the commit of the latest committed placement.
+    Duration getPlacementLatency() const { return placementLatency; }
+
 private:
     Immutable<Placement> placement;
+    std::optional<Mutable<Placement>> pending;
+    std::optional<Duration> placementTimeBudget;
+    Duration placementLatency = Duration::zero();
     bool stale = false;
 };
 
@@ -121,6 +145,14 @@ public:
 
     virtual ~Placement();
     virtual void placeLayers(const RenderLayerReferences&);
+    /**
+     * @brief places `layers`, resuming from where the previous call stopped, until either all of them
+     * are placed or `budget` elapses.
+     *
+     * At least one bucket is placed on every call. Once all the layers are placed, the placement is
+     * committed at `now` and `true` is returned. Only supported in Continuous map mode.
+     */
+    bool continuePlacement(const RenderLayerReferences& layers, TimePoint now, Duration budget);
     void updateLayerBuckets(const RenderLayer&, const TransformState&, bool updateOpacities) const;
     virtual float symbolFadeChange(TimePoint now) const;
     virtual bool hasTransitions(TimePoint now) const;
@@ -130,6 +162,8 @@ public:
 
     const CollisionIndex& getCollisionIndex() const;
     TimePoint getCommitTime() const { return commitTime; }
+    // Wall-clock time spent between the creation of this placement and its commit.
+    Duration getLatency() const { return latency; }
     Duration getUpdatePeriod(float zoom) const;
 
     float zoomAdjustment(float zoom) const;
@@ -177,14 +211,20 @@ protected:
     void markUsedOrientation(SymbolBucket&, style::TextWritingModeType, const SymbolInstance&) const;
     const Placement* getPrevPlacement() const { return prevPlacement ? prevPlacement->get() : nullptr; }
     bool isTiltedView() const;
+    // Tile matrix computed from this placement's own transform state, so that incremental placement
+    // is not affected by the camera moving between frames.
+    mat4 getPosMatrix(const UnwrappedTileID&) const;
 
     std::shared_ptr<const UpdateParameters> updateParameters;
     CollisionIndex collisionIndex;
+    mat4 projMatrix{};
 
     style::TransitionOptions transitionOptions;
 
     TimePoint fadeStartTime;
     TimePoint commitTime;
+    TimePoint creationTime = Clock::now();
+    Duration latency = Duration::zero();
     float placementZoom = 0.0f;
     float prevZoomAdjustment = 0.0f;
 
@@ -201,8 +241,20 @@ protected:
     // Cache being used by placeSymbol()
     std::vector<ProjectedCollisionBox> textBoxes;
     std::vector<ProjectedCollisionBox> iconBoxes;
+    // Cache being used by updateBucketDynamicVertices() for projecting symbol anchors
+    mutable PointBatch anchorBatch;
+    mutable ProjectedPointBatch projectedAnchors;
+    mutable ProjectedPointBatch labelPlaneAnchors;
     // Used for debug purposes.
     std::unordered_map<const CollisionFeature*, std::vector<ProjectedCollisionBox>> collisionCircles;
+
+    // Progress of an incremental placement, see continuePlacement(). Buckets are identified by their
+    // instance id, which outlives the frame unlike the bucket pointer, together with their sort key
+    // range, as a bucket can be placed in several ranges.
+    std::unordered_set<std::string> placedLayerIDs;
+    std::string inProgressLayerID;
+    std::set<std::pair<uint32_t, std::size_t>> inProgressBuckets;
+    std::set<uint32_t> inProgressCrossTileIDs;
 };
 
 } // namespace mbgl
@@ -0,0 +1,191 @@
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/platform/settings.hpp>
+#include <mbgl/util/hash.hpp>
+
+#include <iterator>
+
+namespace mbgl {
+
+namespace {
+
+constexpr std::size_t defaultCapacity = 4096;
+
+std::size_t capacitySetting() {
+    auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_SHAPING_CACHE_SIZE);
+    if (auto* size = value.getUint()) {
+        return static_cast<std::size_t>(*size);
+    } else if (auto* signedSize = value.getInt()) {
+        return *signedSize > 0 ? static_cast<std::size_t>(*signedSize) : 0;
+    }
+    return defaultCapacity;
+}
+
+// Copies the atlas rects of the glyphs into the shaping. Returns false if a glyph is missing or its
+// metrics differ, e.g. after the glyphs of the font stack were reloaded from another URL.
+bool updateGlyphRects(Shaping& shaping, const GlyphPositions& glyphPositions) {
+    for (auto& line : shaping.positionedLines) {
+        for (auto& glyph : line.positionedGlyphs) {
+            const auto font = glyphPositions.find(glyph.font);
+            if (font == glyphPositions.end()) return false;
+            const auto position = font->second.find(glyph.glyph);
+            if (position == font->second.end() || !(position->second.metrics == glyph.metrics)) return false;
+            glyph.rect = position->second.rect;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool ShapingCache::Key::operator==(const Key& other) const {
+    return hashValue == other.hashValue && text == other.text && sectionIndices == other.sectionIndices &&
+           sections == other.sections && maxWidth == other.maxWidth && lineHeight == other.lineHeight &&
+           spacing == other.spacing && translate == other.translate && textAnchor == other.textAnchor &&
+           textJustify == other.textJustify && writingMode == other.writingMode &&
+           allowVerticalPlacement == other.allowVerticalPlacement && glyphs == other.glyphs;
+}
+
+ShapingCache::ShapingCache(std::size_t capacity_)
+    : capacity(capacity_) {}
+
+ShapingCache& ShapingCache::getInstance() {
+    static ShapingCache instance(capacitySetting());
+    return instance;
+}
+
+std::optional<ShapingCache::Key> ShapingCache::makeKey(const TaggedString& string,
+                                                       const GlyphMap& glyphMap,
+                                                       float maxWidth,
+                                                       float lineHeight,
+                                                       style::SymbolAnchorType textAnchor,
+                                                       style::TextJustifyType textJustify,
+                                                       float spacing,
+                                                       const std::array<float, 2>& translate,
+                                                       WritingModeType writingMode,
+                                                       bool allowVerticalPlacement) {
+    Key key;
+    key.sections.reserve(string.sectionCount());
+    for (const auto& section : string.getSections()) {
+        if (section.imageID) {
+            return std::nullopt;
+        }
+        key.sections.emplace_back(section.scale, section.fontStackHash);
+    }
+    key.text = string.rawText();
+    key.sectionIndices = string.getStyledText().second;
+    key.maxWidth = maxWidth;
+    key.lineHeight = lineHeight;
+    key.spacing = spacing;
+    key.translate = translate;
+    key.textAnchor = textAnchor;
+    key.textJustify = textJustify;
+    key.writingMode = writingMode;
+    key.allowVerticalPlacement = allowVerticalPlacement;
+
+    std::size_t seed = util::hash(key.text,
+                                  maxWidth,
+                                  lineHeight,
+                                  spacing,
+                                  translate[0],
+                                  translate[1],
+                                  static_cast<uint8_t>(textAnchor),
+                                  static_cast<uint8_t>(textJustify),
+                                  static_cast<uint8_t>(writingMode),
+                                  allowVerticalPlacement);
+    for (const auto& section : key.sections) {
+        util::hash_combine(seed, section.first);
+        util::hash_combine(seed, section.second);
+    }
+    if (key.sections.size() > 1) {
+        for (uint8_t sectionIndex : key.sectionIndices) {
+            util::hash_combine(seed, sectionIndex);
+        }
+    }
+
+    key.glyphs.reserve(key.text.size());
+    for (std::size_t i = 0; i < key.text.size(); ++i) {
+        std::optional<Immutable<Glyph>> glyph;
+        const auto font = glyphMap.find(key.sections[key.sectionIndices[i]].second);
+        if (font != glyphMap.end()) {
+            const auto it = font->second.find(key.text[i]);
+            if (it != font->second.end()) {
+                glyph = it->second;
+            }
+        }
+        util::hash_combine(seed, glyph ? static_cast<const void*>(glyph->get()) : nullptr);
+        key.glyphs.push_back(std::move(glyph));
+    }
+    key.hashValue = seed;
+    return key;
+}
+
+std::optional<Shaping> ShapingCache::get(const Key& key, const GlyphPositions& glyphPositions) {
+    std::shared_ptr<const Shaping> cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            entries.splice(entries.end(), entries, it->second);
+            cached = it->second->second;
+        }
+    }
+
+    if (cached) {
+        Shaping shaping = *cached;
+        if (updateGlyphRects(shaping, glyphPositions)) {
+            ++hits;
+            return shaping;
+        }
+    }
+    ++misses;
+    return std::nullopt;
+}
+
+void ShapingCache::put(const Key& key, Shaping shaping) {
+    auto shared = std::make_shared<const Shaping>(std::move(shaping));
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) return;
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->second = std::move(shared);
+        entries.splice(entries.end(), entries, it->second);
+        return;
+    }
+    entries.emplace_back(key, std::move(shared));
+    index.emplace(key, std::prev(entries.end()));
+    evict();
+}
+
+void ShapingCache::setCapacity(std::size_t capacity_) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacity = capacity_;
+    evict();
+}
+
+void ShapingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+    hits = 0;
+    misses = 0;
+}
+
+ShapingCache::Stats ShapingCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.size = entries.size();
+    stats.capacity = capacity;
+    return stats;
+}
+
+void ShapingCache::evict() {
+    while (entries.size() > capacity) {
+        index.erase(entries.front().first);
+        entries.pop_front();
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <mbgl/text/shaping.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+
+/**
+ * @brief Least-recently-used cache of text shapings, shared by the symbol layouts of all tiles.
+ *
+ * Labels such as road and place names repeat across neighbouring tiles and zoom levels, and are
+ * shaped once per justification tried for variable anchors. Line breaking, bidi and justification
+ * only depend on the text, its sections, the glyphs of its characters and the layout parameters in
+ * the key, so the result of one layout can be reused by another. The key refers to the glyphs
+ * themselves, so glyphs loaded from another URL, or loaded after the text was shaped without them,
+ * give another key. Texts containing images are not cached, as their shaping depends on the image
+ * positions of the tile.
+ *
+ * The cache is thread-safe. Shapings are stored immutable and copied out, with the atlas rects of
+ * their glyphs refreshed from the positions of the requesting tile.
+ */
+class ShapingCache {
+public:
+    class Key {
+    public:
+        bool operator==(const Key&) const;
+
+        std::size_t hash() const { return hashValue; }
+
+    private:
+        friend class ShapingCache;
+
+        std::u16string text;
+        std::vector<uint8_t> sectionIndices;
+        std::vector<std::pair<double, FontStackHash>> sections;
+        // The glyph of each character, or std::nullopt if it's missing. Holding the glyphs keeps
+        // their addresses from being reused while the key exists.
+        std::vector<std::optional<Immutable<Glyph>>> glyphs;
+        float maxWidth;
+        float lineHeight;
+        float spacing;
+        std::array<float, 2> translate;
+        style::SymbolAnchorType textAnchor;
+        style::TextJustifyType textJustify;
+        WritingModeType writingMode;
+        bool allowVerticalPlacement;
+        std::size_t hashValue;
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        std::size_t size = 0;
+        std::size_t capacity = 0;
+    };
+
+    explicit ShapingCache(std::size_t capacity);
+
+    ShapingCache(const ShapingCache&) = delete;
+    ShapingCache& operator=(const ShapingCache&) = delete;
+
+    // The cache shared by all symbol layouts, holding as many shapings as the
+    // EXPERIMENTAL_SHAPING_CACHE_SIZE setting allows.
+    static ShapingCache& getInstance();
+
+    // Returns the key of the shaping of the text with the given parameters, or std::nullopt if the
+    // shaping can't be cached.
+    static std::optional<Key> makeKey(const TaggedString&,
+                                      const GlyphMap&,
+                                      float maxWidth,
+                                      float lineHeight,
+                                      style::SymbolAnchorType,
+                                      style::TextJustifyType,
+                                      float spacing,
+                                      const std::array<float, 2>& translate,
+                                      WritingModeType,
+                                      bool allowVerticalPlacement);
+
+    // Returns a copy of the cached shaping with the glyph rects of `glyphPositions`, or std::nullopt if
+    // it isn't cached or uses glyphs missing from `glyphPositions` or with different metrics.
+    std::optional<Shaping> get(const Key&, const GlyphPositions& glyphPositions);
+    void put(const Key&, Shaping);
+
+    void setCapacity(std::size_t);
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    struct KeyHasher {
+        std::size_t operator()(const Key& key) const { return key.hash(); }
+    };
+    using Entries = std::list<std::pair<Key, std::shared_ptr<const Shaping>>>;
+
+    void evict();
+
+    mutable std::mutex mutex;
+    // Ordered from oldest to newest.
+    Entries entries;
+    std::unordered_map<Key, Entries::iterator, KeyHasher> index;
+    std::size_t capacity;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
+} // namespace mbgl
@@ -18,7 +18,9 @@ void GeoJSONTile::updateData(std::shared_ptr<style::GeoJSONData> data_, bool nee
     assert(data_);
     data = std::move(data_);
     if (needsRelayout) reset();
-    data->getTile(
+    // Replacing the request cancels the generation of the tile from the previous data, and destroying
+    // the tile cancels the pending one.
+    dataRequest = data->getTile(
         id.canonical,
         [this, self = weakFactory.makeWeakPtr(), capturedData = data.get()](style::GeoJSONData::TileFeatures features) {
             if (!self) return;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/util/async_request.hpp>
 #include <mbgl/util/feature.hpp>
 
 namespace mbgl {
@@ -23,6 +24,7 @@ public:
 
 private:
     std::shared_ptr<style::GeoJSONData> data;
+    std::unique_ptr<AsyncRequest> dataRequest;
     mapbox::base::WeakPtrFactory<GeoJSONTile> weakFactory{this};
 };
 
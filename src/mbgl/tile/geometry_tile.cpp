@@ -22,6 +22,7 @@
 #include <mbgl/util/logging.hpp>
 
 #include <mbgl/gfx/upload_pass.hpp>
+#include <unordered_set>
 #include <utility>
 
 namespace mbgl {
@@ -86,11 +87,6 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
 
     assert(atlasTextures);
 
-    if (layoutResult->glyphAtlasImage) {
-        atlasTextures->glyph = uploadPass.createTexture(*layoutResult->glyphAtlasImage);
-        layoutResult->glyphAtlasImage = {};
-    }
-
     if (layoutResult->iconAtlas.image.valid()) {
         atlasTextures->icon = uploadPass.createTexture(layoutResult->iconAtlas.image);
         layoutResult->iconAtlas.image = {};
@@ -165,6 +161,10 @@ void GeometryTile::cancel() {
     markObsolete();
 }
 
+void GeometryTile::setNecessity(TileNecessity necessity) {
+    worker.setPriority(necessity == TileNecessity::Required ? TaskPriority::Normal : TaskPriority::Low);
+}
+
 void GeometryTile::markObsolete() {
     obsolete = true;
 }
@@ -254,8 +254,8 @@ void GeometryTile::onError(std::exception_ptr err, const uint64_t resultCorrelat
     observer->onTileError(*this, std::move(err));
 }
 
-void GeometryTile::onGlyphsAvailable(GlyphMap glyphs) {
-    worker.self().invoke(&GeometryTileWorker::onGlyphsAvailable, std::move(glyphs));
+void GeometryTile::onGlyphsAvailable(GlyphMap glyphs, GlyphPositions positions) {
+    worker.self().invoke(&GeometryTileWorker::onGlyphsAvailable, std::move(glyphs), std::move(positions));
 }
 
 void GeometryTile::getGlyphs(GlyphDependencies glyphDependencies) {
@@ -283,6 +283,25 @@ std::shared_ptr<FeatureIndex> GeometryTile::getFeatureIndex() const {
     return layoutResult ? layoutResult->featureIndex : nullptr;
 }
 
+std::size_t GeometryTile::getMemoryUsage() const {
+    if (!layoutResult) return 0;
+
+    std::size_t result = layoutResult->featureIndex ? layoutResult->featureIndex->getMemoryUsage() : 0;
+    // Layers sharing a layout share the same bucket, count it once.
+    std::unordered_set<const Bucket*> buckets;
+    for (const auto& pair : layoutResult->layerRenderData) {
+        const Bucket* bucket = pair.second.bucket.get();
+        if (bucket && buckets.insert(bucket).second) {
+            result += bucket->getMemoryUsage();
+        }
+    }
+    result += layoutResult->iconAtlas.image.bytes();
+    if (atlasTextures && atlasTextures->icon) {
+        result += atlasTextures->icon->size.area() * 4;
+    }
+    return result;
+}
+
 bool GeometryTile::layerPropertiesUpdated(const Immutable<style::LayerProperties>& layerProperties) {
     LayerRenderData* renderData = getLayerRenderData(*layerProperties->baseImpl);
     if (!renderData) {
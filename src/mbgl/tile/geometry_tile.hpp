@@ -41,13 +41,14 @@ public:
     void setLayers(const std::vector<Immutable<style::LayerProperties>>&) override;
     void setShowCollisionBoxes(bool showCollisionBoxes) override;
 
-    void onGlyphsAvailable(GlyphMap) override;
+    void onGlyphsAvailable(GlyphMap, GlyphPositions) override;
     void onImagesAvailable(ImageMap, ImageMap, ImageVersionMap versionMap, uint64_t imageCorrelationID) override;
 
     void getGlyphs(GlyphDependencies);
     void getImages(ImageRequestPair);
 
     bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override;
+    std::size_t getMemoryUsage() const override;
 
     void queryRenderedFeatures(std::unordered_map<std::string, std::vector<Feature>>& result,
                                const GeometryCoordinates& queryGeometry,
@@ -63,22 +64,23 @@ public:
 
     void cancel() override;
 
+    // Parsing of tiles that are not required for rendering is moved to a lower
+    // priority lane of the background scheduler.
+    void setNecessity(TileNecessity) override;
+
     class LayoutResult {
     public:
         std::unordered_map<std::string, LayerRenderData> layerRenderData;
         std::shared_ptr<FeatureIndex> featureIndex;
-        std::optional<AlphaImage> glyphAtlasImage;
         ImageAtlas iconAtlas;
 
         LayerRenderData* getLayerRenderData(const style::Layer::Impl&);
 
         LayoutResult(std::unordered_map<std::string, LayerRenderData> renderData_,
                      std::unique_ptr<FeatureIndex> featureIndex_,
-                     std::optional<AlphaImage> glyphAtlasImage_,
                      ImageAtlas iconAtlas_)
             : layerRenderData(std::move(renderData_)),
               featureIndex(std::move(featureIndex_)),
-              glyphAtlasImage(std::move(glyphAtlasImage_)),
               iconAtlas(std::move(iconAtlas_)) {}
     };
     void onLayout(std::shared_ptr<LayoutResult>, uint64_t correlationID);
@@ -78,6 +78,9 @@ public:
     // Returns the layer with the given name. The returned layer object *may* outlive the data
     // object.
     virtual std::unique_ptr<GeometryTileLayer> getLayer(const std::string&) const = 0;
+
+    // Returns the bytes held by decoded data that lives as long as this object.
+    virtual std::size_t getMemoryUsage() const { return 0; }
 };
 
 // classifies an array of rings into polygons with outer rings and holes
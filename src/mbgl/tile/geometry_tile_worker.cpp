@@ -1,10 +1,12 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/layermanager/layer_manager.hpp>
 #include <mbgl/layout/layout.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/layout/pattern_layout.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/group_by_layout.hpp>
 #include <mbgl/style/filter.hpp>
@@ -20,6 +22,8 @@
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/stopwatch.hpp>
 
+#include <condition_variable>
+#include <mutex>
 #include <unordered_set>
 #include <utility>
 
@@ -42,7 +46,13 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
       obsolete(obsolete_),
       mode(mode_),
       pixelRatio(pixelRatio_),
-      showCollisionBoxes(showCollisionBoxes_) {}
+      availableImages(makeMutable<AvailableImages>()),
+      showCollisionBoxes(showCollisionBoxes_) {
+    auto parallel = platform::Settings::getInstance().get(platform::EXPERIMENTAL_PARALLEL_TILE_PARSING);
+    if (auto* enabled = parallel.getBool()) {
+        parallelParsing = *enabled;
+    }
+}
 
 GeometryTileWorker::~GeometryTileWorker() = default;
 
@@ -117,7 +127,7 @@ GeometryTileWorker::~GeometryTileWorker() = default;
 */
 
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
-                                 std::set<std::string> availableImages_,
+                                 Immutable<AvailableImages> availableImages_,
                                  uint64_t correlationID_) {
     try {
         data = std::move(data_);
@@ -142,7 +152,7 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
 }
 
 void GeometryTileWorker::setLayers(std::vector<Immutable<LayerProperties>> layers_,
-                                   std::set<std::string> availableImages_,
+                                   Immutable<AvailableImages> availableImages_,
                                    uint64_t correlationID_) {
     try {
         layers = std::move(layers_);
@@ -274,7 +284,14 @@ void GeometryTileWorker::coalesce() {
     self.invoke(&GeometryTileWorker::coalesced);
 }
 
-void GeometryTileWorker::onGlyphsAvailable(GlyphMap newGlyphMap) {
+void GeometryTileWorker::onGlyphsAvailable(GlyphMap newGlyphMap, GlyphPositions newGlyphPositions) {
+    for (auto& newFontPositions : newGlyphPositions) {
+        GlyphPositionMap& positions = glyphPositions[newFontPositions.first];
+        for (auto& newPosition : newFontPositions.second) {
+            positions.insert_or_assign(newPosition.first, newPosition.second);
+        }
+    }
+
     for (auto& newFontGlyphs : newGlyphMap) {
         FontStackHash fontStack = newFontGlyphs.first;
         Glyphs& newGlyphs = newFontGlyphs.second;
@@ -336,6 +353,114 @@ void GeometryTileWorker::requestNewImages(const ImageDependencies& imageDependen
     }
 }
 
+namespace {
+
+// Features of one source layer, decoded once and shared by every layer group reading it.
+using DecodedFeatures = std::vector<std::unique_ptr<GeometryTileFeature>>;
+
+// A layer group that doesn't need the intermediate Layout step. Its bucket can be built
+// independently of the other groups. When built in parallel, the features are decoded up front
+// and the feature index inserts are recorded rather than applied, so that they can be merged in
+// group order regardless of where the bucket was built.
+struct BucketJob {
+    BucketParameters parameters;
+    const std::vector<Immutable<style::LayerProperties>>* group;
+    const GeometryTileLayer* layer;
+    std::shared_ptr<const DecodedFeatures> features;
+
+    std::shared_ptr<Bucket> bucket;
+    std::vector<std::size_t> indexedFeatures;
+};
+
+// Builds the bucket of `job`, inserting its features into `featureIndex` if given, or recording them otherwise.
+// The filter and the data-driven paint properties are evaluated for the whole source layer first, reading only
+// the properties they test. Without pre-decoded features, each selected feature is then decoded and released
+// once added, so that rejected features are never decoded and the source layer is never kept decoded.
+void buildBucket(BucketJob& job, const std::atomic<bool>& obsolete, FeatureIndex* featureIndex = nullptr) {
+    const style::Layer::Impl& leaderImpl = *(job.group->at(0)->baseImpl);
+    const CanonicalTileID& canonical = job.parameters.tileID.canonical;
+    const auto zoom = static_cast<float>(job.parameters.tileID.overscaledZ);
+
+    job.bucket = LayerManager::get()->createBucket(job.parameters, *job.group);
+
+    const std::vector<std::size_t> selection = leaderImpl.filter.select(
+        expression::EvaluationContext(zoom, nullptr).withCanonicalTileID(&canonical), *job.layer);
+    if (obsolete) {
+        return;
+    }
+    job.bucket->prepareFeatures(*job.layer, selection, canonical);
+
+    for (const std::size_t i : selection) {
+        if (obsolete) {
+            return;
+        }
+        std::unique_ptr<GeometryTileFeature> decoded = job.features ? nullptr : job.layer->getFeature(i);
+        const GeometryTileFeature& feature = job.features ? *(*job.features)[i] : *decoded;
+
+        const GeometryCollection& geometries = feature.getGeometries();
+        job.bucket->addFeature(feature, geometries, {}, PatternLayerMap(), i, canonical);
+        if (featureIndex) {
+            featureIndex->insert(geometries, i, leaderImpl.sourceLayer, leaderImpl.id);
+        } else {
+            job.indexedFeatures.push_back(i);
+        }
+    }
+}
+
+// Builds the buckets of all jobs, fanning them out to the background scheduler. The calling
+// thread takes part in the work, so progress doesn't depend on the availability of other
+// background threads, and returns once every job is either complete or was never started
+// because the tile became obsolete.
+void buildBuckets(std::vector<BucketJob>& jobs, const std::atomic<bool>& obsolete) {
+    struct State {
+        std::vector<BucketJob>* jobs;
+        std::size_t total;
+        const std::atomic<bool>* obsolete;
+        std::atomic<std::size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t finished = 0;
+
+        // Runs jobs until none are left; returns the number of jobs run.
+        std::size_t drain() {
+            std::size_t count = 0;
+            for (std::size_t i = next++; i < total; i = next++) {
+                if (!*obsolete) {
+                    buildBucket((*jobs)[i], *obsolete);
+                }
+                ++count;
+            }
+            return count;
+        }
+    };
+
+    auto state = std::make_shared<State>();
+    state->jobs = &jobs;
+    state->total = jobs.size();
+    state->obsolete = &obsolete;
+
+    if (jobs.size() > 1) {
+        auto scheduler = Scheduler::GetBackground();
+        for (std::size_t i = 1; i < jobs.size(); ++i) {
+            // Helpers that start after all jobs were claimed return without touching `jobs`.
+            scheduler->schedule([state] {
+                if (const std::size_t count = state->drain()) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->finished += count;
+                    state->cv.notify_one();
+                }
+            });
+        }
+    }
+
+    const std::size_t count = state->drain();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished += count;
+    state->cv.wait(lock, [&] { return state->finished == state->total; });
+}
+
+} // namespace
+
 void GeometryTileWorker::parse() {
     if (!data || !layers) {
         return;
@@ -359,6 +484,16 @@ void GeometryTileWorker::parse() {
         groupMap[layoutKey(*layer->baseImpl)].push_back(std::move(layer));
     }
 
+    // Groups that need a Layout keep it in `layout`; the others are built through `bucketJobs`.
+    struct GroupEntry {
+        const style::Layer::Impl* leaderImpl;
+        std::unique_ptr<Layout> layout;
+        std::size_t bucketJob;
+    };
+    std::vector<GroupEntry> entries;
+    std::vector<BucketJob> bucketJobs;
+    std::unordered_map<std::string, std::pair<std::unique_ptr<GeometryTileLayer>, std::size_t>> sourceLayers;
+
     for (auto& pair : groupMap) {
         const auto& group = pair.second;
         if (obsolete) {
@@ -372,54 +507,106 @@ void GeometryTileWorker::parse() {
         const style::Layer::Impl& leaderImpl = *(group.at(0)->baseImpl);
         BucketParameters parameters{id, mode, pixelRatio, leaderImpl.getTypeInfo()};
 
-        auto geometryLayer = (*data)->getLayer(leaderImpl.sourceLayer);
-        if (!geometryLayer) {
-            continue;
-        }
-
         std::vector<std::string> layerIDs(group.size());
         for (const auto& layer : group) {
             layerIDs.push_back(layer->baseImpl->id);
         }
 
-        featureIndex->setBucketLayerIDs(leaderImpl.id, layerIDs);
-
         // Symbol layers and layers that support pattern properties have an extra step at layout time to figure out what
         // images/glyphs are needed to render the layer. They use the intermediate Layout data structure to accomplish
         // this, and either immediately create a bucket if no images/glyphs are used, or the Layout is stored until the
         // images/glyphs are available to add the features to the buckets.
         if (leaderImpl.getTypeInfo()->layout == LayerTypeInfo::Layout::Required) {
-            std::unique_ptr<Layout> layout = LayerManager::get()->createLayout(
-                {parameters, glyphDependencies, imageDependencies, availableImages}, std::move(geometryLayer), group);
-            if (layout->hasDependencies()) {
-                layouts.push_back(std::move(layout));
-            } else {
-                layout->createBucket({}, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
+            auto geometryLayer = (*data)->getLayer(leaderImpl.sourceLayer);
+            if (!geometryLayer) {
+                continue;
             }
+            featureIndex->setBucketLayerIDs(leaderImpl.id, layerIDs);
+            std::unique_ptr<Layout> layout = LayerManager::get()->createLayout(
+                {parameters, glyphDependencies, imageDependencies, *availableImages}, std::move(geometryLayer), group);
+            entries.push_back({&leaderImpl, std::move(layout), 0});
         } else {
-            const Filter& filter = leaderImpl.filter;
-            const std::string& sourceLayerID = leaderImpl.sourceLayer;
-            std::shared_ptr<Bucket> bucket = LayerManager::get()->createBucket(parameters, group);
+            auto it = sourceLayers.find(leaderImpl.sourceLayer);
+            if (it == sourceLayers.end()) {
+                auto geometryLayer = (*data)->getLayer(leaderImpl.sourceLayer);
+                it = sourceLayers.emplace(leaderImpl.sourceLayer, std::make_pair(std::move(geometryLayer), 0)).first;
+            }
+            if (!it->second.first) {
+                continue;
+            }
+            ++it->second.second;
+            featureIndex->setBucketLayerIDs(leaderImpl.id, layerIDs);
+            entries.push_back({&leaderImpl, nullptr, bucketJobs.size()});
+            bucketJobs.push_back({parameters, &group, it->second.first.get(), nullptr, nullptr, {}});
+        }
+    }
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+    // When buckets are built in parallel, the features of every source layer are decoded once up front
+    // and shared by the groups reading it. Features read by several groups are fully decoded, as their
+    // lazily decoded members must not be populated concurrently; filters and paint properties read the
+    // source layer through feature handles of their own. A serial parse builds every bucket while merging
+    // instead, so that no source layer is kept decoded.
+    if (parallelParsing && bucketJobs.size() > 1) {
+        std::unordered_map<std::string, std::shared_ptr<const DecodedFeatures>> decodedLayers;
+        for (auto& job : bucketJobs) {
+            const std::string& sourceLayer = job.group->at(0)->baseImpl->sourceLayer;
+            auto& decoded = decodedLayers[sourceLayer];
+            if (!decoded) {
+                const bool shared = sourceLayers.at(sourceLayer).second > 1;
+
+                auto features = std::make_shared<DecodedFeatures>();
+                features->reserve(job.layer->featureCount());
+                for (std::size_t i = 0; !obsolete && i < job.layer->featureCount(); i++) {
+                    features->push_back(job.layer->getFeature(i));
+                    if (shared) {
+                        features->back()->getGeometries();
+                        features->back()->getProperties();
+                    }
+                }
+                decoded = std::move(features);
+            }
+            job.features = decoded;
+        }
 
-                if (!filter(expression::EvaluationContext(static_cast<float>(this->id.overscaledZ), feature.get())
-                                .withCanonicalTileID(&id.canonical)))
-                    continue;
+        if (obsolete) {
+            return;
+        }
 
-                const GeometryCollection& geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i, id.canonical);
-                featureIndex->insert(geometries, i, sourceLayerID, leaderImpl.id);
-            }
+        buildBuckets(bucketJobs, obsolete);
+    }
 
-            if (!bucket->hasData()) {
-                continue;
+    // Merge the results of a parallel parse, or build the buckets of a serial one, in group order,
+    // so that the feature index is the same either way.
+    for (auto& entry : entries) {
+        if (obsolete) {
+            return;
+        }
+
+        const style::Layer::Impl& leaderImpl = *entry.leaderImpl;
+        if (entry.layout) {
+            if (entry.layout->hasDependencies()) {
+                layouts.push_back(std::move(entry.layout));
+            } else {
+                entry.layout->createBucket({}, featureIndex, renderData, firstLoad, showCollisionBoxes, id.canonical);
             }
+            continue;
+        }
 
-            for (const auto& layer : group) {
-                renderData.emplace(layer->baseImpl->id, LayerRenderData{bucket, layer});
+        BucketJob& job = bucketJobs[entry.bucketJob];
+        if (job.features) {
+            for (std::size_t i : job.indexedFeatures) {
+                featureIndex->insert((*job.features)[i]->getGeometries(), i, leaderImpl.sourceLayer, leaderImpl.id);
             }
+        } else {
+            buildBucket(job, obsolete, featureIndex.get());
+        }
+
+        if (!job.bucket || !job.bucket->hasData()) {
+            continue;
+        }
+
+        for (const auto& layer : *job.group) {
+            renderData.emplace(layer->baseImpl->id, LayerRenderData{job.bucket, layer});
         }
     }
 
@@ -453,18 +640,15 @@ void GeometryTileWorker::finalizeLayout() {
     }
 
     MBGL_TIMING_START(watch)
-    std::optional<AlphaImage> glyphAtlasImage;
     ImageAtlas iconAtlas = makeImageAtlas(imageMap, patternMap, versionMap);
     if (!layouts.empty()) {
-        GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
-        glyphAtlasImage = std::move(glyphAtlas.image);
-
         for (auto& layout : layouts) {
             if (obsolete) {
                 return;
             }
 
-            layout->prepareSymbols(glyphMap, glyphAtlas.positions, imageMap, iconAtlas.iconPositions);
+            // Glyph positions refer to the renderer-wide glyph atlas, there is no per-tile glyph texture.
+            layout->prepareSymbols(glyphMap, glyphPositions, imageMap, iconAtlas.iconPositions);
 
             if (!layout->hasSymbolInstances()) {
                 continue;
@@ -488,7 +672,7 @@ void GeometryTileWorker::finalizeLayout() {
 
     parent.invoke(&GeometryTile::onLayout,
                   std::make_shared<GeometryTile::LayoutResult>(
-                      std::move(renderData), std::move(featureIndex), std::move(glyphAtlasImage), std::move(iconAtlas)),
+                      std::move(renderData), std::move(featureIndex), std::move(iconAtlas)),
                   correlationID);
 }
 
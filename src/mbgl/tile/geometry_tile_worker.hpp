@@ -2,8 +2,10 @@
 
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/style/available_images.hpp>
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/util/immutable.hpp>
 #include <mbgl/style/layer_properties.hpp>
@@ -38,15 +40,15 @@ public:
     ~GeometryTileWorker();
 
     void setLayers(std::vector<Immutable<style::LayerProperties>>,
-                   std::set<std::string> availableImages,
+                   Immutable<AvailableImages> availableImages,
                    uint64_t correlationID);
     void setData(std::unique_ptr<const GeometryTileData>,
-                 std::set<std::string> availableImages,
+                 Immutable<AvailableImages> availableImages,
                  uint64_t correlationID);
     void reset(uint64_t correlationID_);
     void setShowCollisionBoxes(bool showCollisionBoxes_, uint64_t correlationID_);
 
-    void onGlyphsAvailable(GlyphMap newGlyphMap);
+    void onGlyphsAvailable(GlyphMap newGlyphMap, GlyphPositions newGlyphPositions);
     void onImagesAvailable(ImageMap newIconMap,
                            ImageMap newPatternMap,
                            ImageVersionMap versionMap,
@@ -100,13 +102,16 @@ private:
     GlyphDependencies pendingGlyphDependencies;
     ImageDependencies pendingImageDependencies;
     GlyphMap glyphMap;
+    GlyphPositions glyphPositions;
     ImageMap imageMap;
     ImageMap patternMap;
     ImageVersionMap versionMap;
-    std::set<std::string> availableImages;
+    Immutable<AvailableImages> availableImages;
 
     bool showCollisionBoxes;
     bool firstLoad = true;
+    // Builds independent layer groups of a tile concurrently on the background scheduler.
+    bool parallelParsing = false;
 };
 
 } // namespace mbgl
@@ -47,7 +47,7 @@ void RasterDEMTile::setMetadata(std::optional<Timestamp> modified_, std::optiona
     expires = std::move(expires_);
 }
 
-void RasterDEMTile::setData(const std::shared_ptr<const std::string>& data) {
+void RasterDEMTile::setData(const SharedBuffer& data) {
     pending = true;
     ++correlationID;
     worker.self().invoke(&RasterDEMTileWorker::parse, data, correlationID, encoding);
@@ -75,6 +75,10 @@ bool RasterDEMTile::layerPropertiesUpdated(const Immutable<style::LayerPropertie
     return bool(bucket);
 }
 
+std::size_t RasterDEMTile::getMemoryUsage() const {
+    return bucket ? bucket->getMemoryUsage() : 0;
+}
+
 HillshadeBucket* RasterDEMTile::getBucket() const {
     return bucket.get();
 }
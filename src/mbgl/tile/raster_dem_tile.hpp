@@ -70,9 +70,10 @@ public:
 
     void setError(std::exception_ptr);
     void setMetadata(std::optional<Timestamp> modified, std::optional<Timestamp> expires);
-    void setData(const std::shared_ptr<const std::string>& data);
+    void setData(const SharedBuffer& data);
 
     bool layerPropertiesUpdated(const Immutable<style::LayerProperties>& layerProperties) override;
+    std::size_t getMemoryUsage() const override;
 
     HillshadeBucket* getBucket() const;
     void backfillBorder(const RasterDEMTile& borderTile, DEMTileNeighbors mask);
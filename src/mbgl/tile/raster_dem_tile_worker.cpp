@@ -9,7 +9,7 @@ namespace mbgl {
 RasterDEMTileWorker::RasterDEMTileWorker(const ActorRef<RasterDEMTileWorker>&, ActorRef<RasterDEMTile> parent_)
     : parent(std::move(parent_)) {}
 
-void RasterDEMTileWorker::parse(const std::shared_ptr<const std::string>& data,
+void RasterDEMTileWorker::parse(const SharedBuffer& data,
                                 uint64_t correlationID,
                                 Tileset::DEMEncoding encoding) {
     if (!data) {
@@ -1,10 +1,10 @@
 #pragma once
 
 #include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 #include <mbgl/util/tileset.hpp>
 
 #include <memory>
-#include <string>
 
 namespace mbgl {
 
@@ -14,7 +14,7 @@ class RasterDEMTileWorker {
 public:
     RasterDEMTileWorker(const ActorRef<RasterDEMTileWorker>&, ActorRef<RasterDEMTile>);
 
-    void parse(const std::shared_ptr<const std::string>& data, uint64_t correlationID, Tileset::DEMEncoding encoding);
+    void parse(const SharedBuffer& data, uint64_t correlationID, Tileset::DEMEncoding encoding);
 
 private:
     ActorRef<RasterDEMTile> parent;
@@ -36,7 +36,7 @@ void RasterTile::setMetadata(std::optional<Timestamp> modified_, std::optional<T
     expires = std::move(expires_);
 }
 
-void RasterTile::setData(const std::shared_ptr<const std::string>& data) {
+void RasterTile::setData(const SharedBuffer& data) {
     pending = true;
     ++correlationID;
     worker.self().invoke(&RasterTileWorker::parse, data, correlationID);
@@ -64,6 +64,10 @@ bool RasterTile::layerPropertiesUpdated(const Immutable<style::LayerProperties>&
     return bool(bucket);
 }
 
+std::size_t RasterTile::getMemoryUsage() const {
+    return bucket ? bucket->getMemoryUsage() : 0;
+}
+
 void RasterTile::setMask(TileMask&& mask) {
     if (bucket) {
         bucket->setMask(std::move(mask));
@@ -131,6 +131,10 @@ public:
 
     virtual void setFeatureState(const LayerFeatureStates&) {}
 
+    // Returns an estimate of the memory held by this tile in bytes, covering its
+    // buckets, feature index and images. Used to budget the tile cache.
+    virtual std::size_t getMemoryUsage() const { return 0; }
+
     void dumpDebugLogs() const;
 
     const Kind kind;
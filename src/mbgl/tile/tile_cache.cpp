@@ -1,18 +1,96 @@
 #include <mbgl/tile/tile_cache.hpp>
+#include <mbgl/platform/settings.hpp>
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <mutex>
 
 namespace mbgl {
 
+namespace {
+
+std::atomic<size_t> globalMaxBytes{0};
+std::atomic<size_t> globalBytes{0};
+// The number of caches holding tiles, which share the global cap equally.
+std::atomic<size_t> activeCaches{0};
+
+// The global cap is read from the platform settings once, when the first cache is created or the cap is
+// first set explicitly, so that creating the caches of later sources doesn't reset it.
+std::once_flag globalMaxBytesFlag;
+
+void initializeGlobalMaxBytes() {
+    std::call_once(globalMaxBytesFlag, [] {
+        auto& settings = platform::Settings::getInstance();
+        if (auto* maxBytes = settings.get(platform::EXPERIMENTAL_TILE_CACHE_TOTAL_MAX_BYTES).getUint()) {
+            globalMaxBytes = static_cast<size_t>(*maxBytes);
+        }
+    });
+}
+
+} // namespace
+
+TileCache::TileCache(size_t size_)
+    : size(size_) {
+    initializeGlobalMaxBytes();
+}
+
+TileCache::~TileCache() {
+    clear();
+}
+
+// static
+void TileCache::setGlobalMaxBytes(size_t maxBytes_) {
+    initializeGlobalMaxBytes();
+    globalMaxBytes = maxBytes_;
+}
+
+// static
+size_t TileCache::getGlobalMaxBytes() {
+    initializeGlobalMaxBytes();
+    return globalMaxBytes;
+}
+
+// static
+size_t TileCache::getGlobalBytes() {
+    return globalBytes;
+}
+
+bool TileCache::exceedsLimits() const {
+    if (entries.size() > size) return true;
+    if (maxBytes && bytes > maxBytes) return true;
+    const size_t globalMax = globalMaxBytes;
+    if (!globalMax || globalBytes <= globalMax) return false;
+    // Only the caches holding more than their share of the cap evict tiles, so that the caches of
+    // a new source are not starved by the ones of the sources loaded before.
+    return bytes > globalMax / std::max<size_t>(activeCaches, 1);
+}
+
+TileCache::Entries::iterator TileCache::erase(Entries::iterator it) {
+    assert(bytes >= it->bytes);
+    bytes -= it->bytes;
+    globalBytes -= it->bytes;
+    if (it->bytes && !bytes) --activeCaches;
+    index.erase(it->key);
+    return entries.erase(it);
+}
+
 void TileCache::setSize(size_t size_) {
     size = size_;
 
-    while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.remove(key);
-        tiles.erase(key);
+    while (!entries.empty() && exceedsLimits()) {
+        erase(entries.begin());
     }
 
-    assert(orderedKeys.size() <= size);
+    assert(entries.size() <= size);
+}
+
+void TileCache::setMaxBytes(size_t maxBytes_) {
+    maxBytes = maxBytes_;
+
+    while (!entries.empty() && exceedsLimits()) {
+        erase(entries.begin());
+    }
 }
 
 void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
@@ -20,27 +98,31 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
         return;
     }
 
-    // insert new or query existing tile
-    if (!tiles.emplace(key, std::move(tile)).second) {
-        // remove existing tile key
-        orderedKeys.remove(key);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        // keep the existing tile and mark it as newest
+        entries.splice(entries.end(), entries, it->second);
+    } else {
+        const size_t tileBytes = tile->getMemoryUsage();
+        entries.push_back({key, std::move(tile), tileBytes});
+        index.emplace(key, std::prev(entries.end()));
+        if (tileBytes && !bytes) ++activeCaches;
+        bytes += tileBytes;
+        globalBytes += tileBytes;
     }
 
-    // (re-)insert tile key as newest
-    orderedKeys.push_back(key);
-
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        pop(orderedKeys.front());
+    // purge oldest tiles if necessary
+    while (!entries.empty() && exceedsLimits()) {
+        erase(entries.begin());
     }
 
-    assert(orderedKeys.size() <= size);
+    assert(entries.size() <= size);
 }
 
 Tile* TileCache::get(const OverscaledTileID& key) {
-    auto it = tiles.find(key);
-    if (it != tiles.end()) {
-        return it->second.get();
+    auto it = index.find(key);
+    if (it != index.end()) {
+        return it->second->tile.get();
     } else {
         return nullptr;
     }
@@ -49,11 +131,10 @@ Tile* TileCache::get(const OverscaledTileID& key) {
 std::unique_ptr<Tile> TileCache::pop(const OverscaledTileID& key) {
     std::unique_ptr<Tile> tile;
 
-    auto it = tiles.find(key);
-    if (it != tiles.end()) {
-        tile = std::move(it->second);
-        tiles.erase(it);
-        orderedKeys.remove(key);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        tile = std::move(it->second->tile);
+        erase(it->second);
         assert(tile->isRenderable());
     }
 
@@ -61,12 +142,15 @@ std::unique_ptr<Tile> TileCache::pop(const OverscaledTileID& key) {
 }
 
 bool TileCache::has(const OverscaledTileID& key) {
-    return tiles.find(key) != tiles.end();
+    return index.find(key) != index.end();
 }
 
 void TileCache::clear() {
-    orderedKeys.clear();
-    tiles.clear();
+    if (bytes) --activeCaches;
+    globalBytes -= bytes;
+    bytes = 0;
+    index.clear();
+    entries.clear();
 }
 
 } // namespace mbgl
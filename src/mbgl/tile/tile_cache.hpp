@@ -5,17 +5,44 @@
 
 #include <list>
 #include <memory>
-#include <map>
+#include <unordered_map>
 
 namespace mbgl {
 
+/**
+ * @brief Least-recently-used cache of tiles that are no longer rendered.
+ *
+ * The cache is bounded by a tile count (`setSize`) and, optionally, by the
+ * estimated memory of its tiles (`setMaxBytes`). All caches additionally share
+ * a process-wide byte cap equally. It is read from the platform settings once,
+ * and changed with `setGlobalMaxBytes`. While the global total exceeds the cap,
+ * the caches holding more than their share evict their oldest tiles when they
+ * are next updated, down to their share or until the total fits.
+ * Adding, retrieving and evicting a tile are all O(1).
+ */
 class TileCache {
 public:
-    TileCache(size_t size_ = 0)
-        : size(size_) {}
+    TileCache(size_t size_ = 0);
+    ~TileCache();
+
+    TileCache(const TileCache&) = delete;
+    TileCache& operator=(const TileCache&) = delete;
 
     void setSize(size_t);
     size_t getSize() const { return size; };
+
+    /// Sets the maximum estimated memory of the cached tiles, 0 meaning unbounded.
+    void setMaxBytes(size_t);
+    size_t getMaxBytes() const { return maxBytes; }
+    /// Returns the estimated memory of the cached tiles, as reported by
+    /// `Tile::getMemoryUsage()` when each tile was added.
+    size_t getBytes() const { return bytes; }
+
+    /// Sets the maximum estimated memory of all tile caches together, 0 meaning unbounded.
+    static void setGlobalMaxBytes(size_t);
+    static size_t getGlobalMaxBytes();
+    static size_t getGlobalBytes();
+
     void add(const OverscaledTileID& key, std::unique_ptr<Tile> tile);
     std::unique_ptr<Tile> pop(const OverscaledTileID& key);
     Tile* get(const OverscaledTileID& key);
@@ -23,10 +50,23 @@ public:
     void clear();
 
 private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
-    std::list<OverscaledTileID> orderedKeys;
+    struct Entry {
+        OverscaledTileID key;
+        std::unique_ptr<Tile> tile;
+        size_t bytes;
+    };
+    using Entries = std::list<Entry>;
+
+    bool exceedsLimits() const;
+    Entries::iterator erase(Entries::iterator);
+
+    // Ordered from oldest to newest.
+    Entries entries;
+    std::unordered_map<OverscaledTileID, Entries::iterator> index;
 
     size_t size;
+    size_t maxBytes = 0;
+    size_t bytes = 0;
 };
 
 } // namespace mbgl
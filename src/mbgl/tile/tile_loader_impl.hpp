@@ -42,7 +42,7 @@ TileLoader<T>::TileLoader(T& tile_,
         // started out with a required request, we'd have to cancel everything, including the
         // initial std::optional part of the request.
         loadFromCache();
-    } else if (necessity == TileNecessity::Required) {
+    } else if (necessity != TileNecessity::Optional) {
         // When the file source doesn't support cache-only requests, and we definiitely need this
         // data, we can start out with a network request immediately.
         loadFromNetwork();
@@ -58,11 +58,16 @@ TileLoader<T>::~TileLoader() = default;
 template <typename T>
 void TileLoader<T>::setNecessity(TileNecessity newNecessity) {
     if (newNecessity != necessity) {
+        const bool wasPrefetch = necessity == TileNecessity::Prefetch;
         necessity = newNecessity;
-        if (necessity == TileNecessity::Required) {
-            makeRequired();
-        } else {
+        if (necessity == TileNecessity::Optional) {
             makeOptional();
+        } else if (wasPrefetch && necessity == TileNecessity::Required && hasPendingNetworkRequest()) {
+            // Reissue the low priority request of a prefetched tile that is now needed.
+            request.reset();
+            loadFromNetwork();
+        } else {
+            makeRequired();
         }
     }
 }
@@ -107,7 +112,7 @@ void TileLoader<T>::loadFromCache() {
             loadedData(res);
         }
 
-        if (necessity == TileNecessity::Required) {
+        if (necessity != TileNecessity::Optional) {
             loadFromNetwork();
         }
     });
@@ -158,6 +163,7 @@ void TileLoader<T>::loadFromNetwork() {
     // Instead of using Resource::LoadingMethod::All, we're first doing a CacheOnly, and then a
     // NetworkOnly request.
     resource.loadingMethod = Resource::LoadingMethod::NetworkOnly;
+    resource.setPriority(necessity == TileNecessity::Prefetch ? Resource::Priority::Low : Resource::Priority::Regular);
     resource.minimumUpdateInterval = updateParameters.minimumUpdateInterval;
     resource.storagePolicy = updateParameters.isVolatile ? Resource::StoragePolicy::Volatile
                                                          : Resource::StoragePolicy::Permanent;
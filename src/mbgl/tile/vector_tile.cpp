@@ -14,6 +14,7 @@ VectorTile::VectorTile(const OverscaledTileID& id_,
       loader(*this, id_, parameters, tileset) {}
 
 void VectorTile::setNecessity(TileNecessity necessity) {
+    GeometryTile::setNecessity(necessity);
     loader.setNecessity(necessity);
 }
 
@@ -26,7 +27,7 @@ void VectorTile::setMetadata(std::optional<Timestamp> modified_, std::optional<T
     expires = std::move(expires_);
 }
 
-void VectorTile::setData(const std::shared_ptr<const std::string>& data_) {
+void VectorTile::setData(const SharedBuffer& data_) {
     GeometryTile::setData(data_ ? std::make_unique<VectorTileData>(data_) : nullptr);
 }
 
@@ -2,6 +2,7 @@
 
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/tile/tile_loader.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 
 namespace mbgl {
 
@@ -15,7 +16,7 @@ public:
     void setNecessity(TileNecessity) final;
     void setUpdateParameters(const TileUpdateParameters&) final;
     void setMetadata(std::optional<Timestamp> modified, std::optional<Timestamp> expires);
-    void setData(const std::shared_ptr<const std::string>& data);
+    void setData(const SharedBuffer& data);
 
 private:
     TileLoader<VectorTile> loader;
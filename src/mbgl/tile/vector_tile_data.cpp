@@ -2,13 +2,17 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
 namespace mbgl {
 
-VectorTileFeature::VectorTileFeature(const mapbox::vector_tile::layer& layer, const protozero::data_view& view)
-    : feature(view, layer) {}
+namespace {
 
-FeatureType VectorTileFeature::getType() const {
-    switch (feature.getType()) {
+FeatureType convertType(mapbox::vector_tile::GeomType type) {
+    switch (type) {
         case mapbox::vector_tile::GeomType::POINT:
             return FeatureType::Point;
         case mapbox::vector_tile::GeomType::LINESTRING:
@@ -20,80 +24,254 @@ FeatureType VectorTileFeature::getType() const {
     }
 }
 
+// Equivalent to mapbox::vector_tile::buffer::getLayers(), which only accepts a std::string.
+std::map<std::string, const protozero::data_view> decodeLayers(std::string_view data) {
+    std::map<std::string, const protozero::data_view> layers;
+    protozero::pbf_reader tileReader(data.data(), data.size());
+    while (tileReader.next(mapbox::vector_tile::TileType::LAYERS)) {
+        const protozero::data_view layerView = tileReader.get_view();
+        protozero::pbf_reader layerReader(layerView);
+        std::optional<std::string> name;
+        while (layerReader.next(mapbox::vector_tile::LayerType::NAME)) {
+            name = layerReader.get_string();
+        }
+        if (!name) {
+            throw std::runtime_error("Layer missing name");
+        }
+        layers.emplace(std::move(*name), layerView);
+    }
+    return layers;
+}
+
+// Vector tile property values are scalars, so only strings hold memory of their own.
+std::size_t valueBytes(const Value& value) {
+    return sizeof(Value) + (value.is<std::string>() ? value.get<std::string>().capacity() : 0);
+}
+
+} // namespace
+
+VectorTileLayerData::VectorTileLayerData(SharedBuffer data_, const protozero::data_view& view)
+    : data(std::move(data_)),
+      layer(view),
+      name(layer.getName()) {
+    const std::size_t count = layer.featureCount();
+    types.reserve(count);
+    ids.reserve(count);
+    propertyOffsets.reserve(count + 1);
+    propertyOffsets.push_back(0);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const mapbox::vector_tile::feature feature(layer.getFeature(i), layer);
+        types.push_back(convertType(feature.getType()));
+        ids.push_back(feature.getID());
+
+        for (auto& property : feature.getProperties()) {
+            auto key = keyIndices.emplace(property.first, static_cast<uint32_t>(keys.size()));
+            if (key.second) {
+                keys.push_back(property.first);
+            }
+            propertyKeys.push_back(key.first->second);
+            propertyValues.push_back(std::move(property.second));
+        }
+        propertyOffsets.push_back(static_cast<uint32_t>(propertyKeys.size()));
+    }
+
+    columnBytes = types.capacity() * sizeof(FeatureType) + ids.capacity() * sizeof(FeatureIdentifier) +
+                  propertyOffsets.capacity() * sizeof(uint32_t) + propertyKeys.capacity() * sizeof(uint32_t) +
+                  (propertyValues.capacity() - propertyValues.size()) * sizeof(Value);
+    for (const auto& key : keys) {
+        // The key is stored in `keys` and in `keyIndices`.
+        columnBytes += 2 * (sizeof(std::string) + key.capacity()) + sizeof(uint32_t) + sizeof(void*);
+    }
+    for (const auto& value : propertyValues) {
+        columnBytes += valueBytes(value);
+    }
+}
+
+const Value* VectorTileLayerData::getValue(std::size_t index, const std::string& key) const {
+    auto it = keyIndices.find(key);
+    if (it == keyIndices.end()) {
+        return nullptr;
+    }
+    for (uint32_t i = propertyOffsets[index]; i < propertyOffsets[index + 1]; ++i) {
+        if (propertyKeys[i] == it->second) {
+            return &propertyValues[i];
+        }
+    }
+    return nullptr;
+}
+
+void VectorTileLayerData::buildPropertyMaps() const {
+    std::call_once(propertyMapsFlag, [&] {
+        std::size_t bytes = 0;
+        propertyMaps.resize(featureCount());
+        for (std::size_t index = 0; index < propertyMaps.size(); ++index) {
+            PropertyMap& properties = propertyMaps[index];
+            properties.reserve(propertyOffsets[index + 1] - propertyOffsets[index]);
+            for (uint32_t i = propertyOffsets[index]; i < propertyOffsets[index + 1]; ++i) {
+                const std::string& key = keys[propertyKeys[i]];
+                properties.emplace(key, propertyValues[i]);
+                bytes += sizeof(std::string) + key.capacity() + valueBytes(propertyValues[i]) + 2 * sizeof(void*);
+            }
+            bytes += sizeof(PropertyMap) + properties.bucket_count() * sizeof(void*);
+        }
+        propertyMapBytes = bytes;
+    });
+}
+
+const PropertyMap& VectorTileLayerData::getProperties(std::size_t index) const {
+    buildPropertyMaps();
+    return propertyMaps[index];
+}
+
+void VectorTileLayerData::decodeGeometries() const {
+    std::call_once(geometryFlag, [&] {
+        const std::size_t count = featureCount();
+        featureRings.reserve(count + 1);
+        featureRings.push_back(0);
+        ringOffsets.push_back(0);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const mapbox::vector_tile::feature feature(layer.getFeature(i), layer);
+            const auto scale = static_cast<float>(util::EXTENT) / feature.getExtent();
+            GeometryCollection lines;
+
+            try {
+                lines = feature.getGeometries<GeometryCollection>(scale);
+            } catch (const std::runtime_error& ex) {
+                Log::Error(Event::ParseTile, "Could not get geometries: " + std::string(ex.what()));
+                lines = GeometryCollection();
+            }
+
+            if (feature.getVersion() < 2 && feature.getType() == mapbox::vector_tile::GeomType::POLYGON) {
+                lines = fixupPolygons(lines);
+            }
+
+            for (const auto& ring : lines) {
+                points.insert(points.end(), ring.begin(), ring.end());
+                ringOffsets.push_back(static_cast<uint32_t>(points.size()));
+            }
+            featureRings.push_back(static_cast<uint32_t>(ringOffsets.size() - 1));
+        }
+
+        ringOffsets.shrink_to_fit();
+        points.shrink_to_fit();
+        geometryBytes = featureRings.capacity() * sizeof(uint32_t) + ringOffsets.capacity() * sizeof(uint32_t) +
+                        points.capacity() * sizeof(GeometryCoordinate);
+    });
+}
+
+GeometryCollection VectorTileLayerData::getGeometries(std::size_t index) const {
+    decodeGeometries();
+    GeometryCollection lines;
+    lines.reserve(featureRings[index + 1] - featureRings[index]);
+    for (uint32_t ring = featureRings[index]; ring < featureRings[index + 1]; ++ring) {
+        lines.emplace_back(points.begin() + ringOffsets[ring], points.begin() + ringOffsets[ring + 1]);
+    }
+    return lines;
+}
+
+std::size_t VectorTileLayerData::getMemoryUsage() const {
+    return columnBytes + geometryBytes + propertyMapBytes;
+}
+
+VectorTileFeature::VectorTileFeature(std::shared_ptr<const VectorTileLayerData> layer_, std::size_t index_)
+    : layer(std::move(layer_)),
+      index(index_) {}
+
+FeatureType VectorTileFeature::getType() const {
+    return layer->getType(index);
+}
+
 std::optional<Value> VectorTileFeature::getValue(const std::string& key) const {
-    const std::optional<Value> value(feature.getValue(key));
-    return value->is<NullValue>() ? std::nullopt : value;
+    const Value* value = layer->getValue(index, key);
+    if (!value || value->is<NullValue>()) {
+        return std::nullopt;
+    }
+    return *value;
 }
 
 const PropertyMap& VectorTileFeature::getProperties() const {
-    if (!properties) {
-        properties = feature.getProperties();
-    }
-    return *properties;
+    return layer->getProperties(index);
 }
 
 FeatureIdentifier VectorTileFeature::getID() const {
-    return feature.getID();
+    return layer->getID(index);
 }
 
 const GeometryCollection& VectorTileFeature::getGeometries() const {
     if (!lines) {
-        const auto scale = static_cast<float>(util::EXTENT) / feature.getExtent();
-
-        try {
-            lines = feature.getGeometries<GeometryCollection>(scale);
-        } catch (const std::runtime_error& ex) {
-            Log::Error(Event::ParseTile, "Could not get geometries: " + std::string(ex.what()));
-            lines = GeometryCollection();
-        }
-
-        if (feature.getVersion() < 2 && feature.getType() == mapbox::vector_tile::GeomType::POLYGON) {
-            lines = fixupPolygons(*lines);
-        }
+        lines = layer->getGeometries(index);
     }
     return *lines;
 }
 
-VectorTileLayer::VectorTileLayer(std::shared_ptr<const std::string> data_, const protozero::data_view& view)
-    : data(std::move(data_)),
-      layer(view) {}
+VectorTileLayer::VectorTileLayer(std::shared_ptr<const VectorTileLayerData> layer_)
+    : layer(std::move(layer_)) {}
 
 std::size_t VectorTileLayer::featureCount() const {
-    return layer.featureCount();
+    return layer->featureCount();
 }
 
 std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
-    return std::make_unique<VectorTileFeature>(layer, layer.getFeature(i));
+    if (i >= layer->featureCount()) {
+        throw std::out_of_range("feature index out of range");
+    }
+    return std::make_unique<VectorTileFeature>(layer, i);
 }
 
 std::string VectorTileLayer::getName() const {
-    return layer.getName();
+    return layer->getName();
 }
 
-VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
-    : data(std::move(data_)) {}
+VectorTileData::VectorTileData(SharedBuffer data_)
+    : VectorTileData(std::move(data_), std::make_shared<Layers>()) {}
+
+VectorTileData::VectorTileData(SharedBuffer data_, std::shared_ptr<Layers> layers_)
+    : data(std::move(data_)),
+      layers(std::move(layers_)) {}
 
 std::unique_ptr<GeometryTileData> VectorTileData::clone() const {
-    return std::make_unique<VectorTileData>(data);
+    return std::unique_ptr<GeometryTileData>(new VectorTileData(data, layers));
 }
 
 std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& name) const {
-    if (!parsed) {
+    std::lock_guard<std::mutex> lock(layers->mutex);
+
+    if (!layers->parsed) {
         // We're parsing this lazily so that we can construct VectorTileData objects on the main
         // thread without incurring the overhead of parsing immediately.
-        layers = mapbox::vector_tile::buffer(*data).getLayers();
-        parsed = true;
+        layers->views = decodeLayers(data.view());
+        layers->parsed = true;
     }
 
-    auto it = layers.find(name);
-    if (it != layers.end()) {
-        return std::make_unique<VectorTileLayer>(data, it->second);
+    auto& decoded = layers->decoded[name];
+    if (!decoded) {
+        auto it = layers->views.find(name);
+        if (it == layers->views.end()) {
+            layers->decoded.erase(name);
+            return nullptr;
+        }
+        decoded = std::make_shared<const VectorTileLayerData>(data, it->second);
     }
-    return nullptr;
+    return std::make_unique<VectorTileLayer>(decoded);
+}
+
+std::size_t VectorTileData::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(layers->mutex);
+    std::size_t result = 0;
+    for (const auto& layer : layers->decoded) {
+        result += layer.second->getMemoryUsage();
+    }
+    return result;
 }
 
 std::vector<std::string> VectorTileData::layerNames() const {
-    return mapbox::vector_tile::buffer(*data).layerNames();
+    std::vector<std::string> names;
+    for (auto& layer : decodeLayers(data.view())) {
+        names.push_back(layer.first);
+    }
+    return names;
 }
 
 } // namespace mbgl
@@ -1,5 +1,6 @@
 #pragma once
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/shared_buffer.hpp>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -14,15 +15,80 @@
 
 #include <protozero/pbf_reader.hpp>
 
+#include <atomic>
 #include <unordered_map>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 namespace mbgl {
 
+/**
+ * @brief Decoded form of a vector tile layer.
+ *
+ * Types, identifiers and properties of all features are decoded once, in columns:
+ * property keys are interned per layer and every feature refers to a range of
+ * (key, value) pairs in a flat array. Geometries are decoded for the whole layer on
+ * first use into a single point arena, where every feature refers to a range of rings.
+ * Instances are shared by every `VectorTileLayer`/`VectorTileFeature` created for
+ * the layer, including those of cloned `VectorTileData`, so that the protobuf is
+ * decoded once no matter how many style layers, filters and queries read it.
+ * All const methods are thread-safe.
+ */
+class VectorTileLayerData {
+public:
+    VectorTileLayerData(SharedBuffer data, const protozero::data_view&);
+
+    std::size_t featureCount() const { return types.size(); }
+    const std::string& getName() const { return name; }
+
+    FeatureType getType(std::size_t index) const { return types[index]; }
+    const FeatureIdentifier& getID(std::size_t index) const { return ids[index]; }
+    const Value* getValue(std::size_t index, const std::string& key) const;
+    const PropertyMap& getProperties(std::size_t index) const;
+    GeometryCollection getGeometries(std::size_t index) const;
+
+    // Bytes held by the decoded columns, and by the geometries and property maps once built.
+    std::size_t getMemoryUsage() const;
+
+private:
+    void decodeGeometries() const;
+    void buildPropertyMaps() const;
+
+    SharedBuffer data;
+    mapbox::vector_tile::layer layer;
+    std::string name;
+
+    std::vector<FeatureType> types;
+    std::vector<FeatureIdentifier> ids;
+
+    // Interned property keys; `propertyKeys` refers to indices of `keys`.
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, uint32_t> keyIndices;
+    // The properties of feature `i` are in [propertyOffsets[i], propertyOffsets[i + 1]).
+    std::vector<uint32_t> propertyOffsets;
+    std::vector<uint32_t> propertyKeys;
+    std::vector<Value> propertyValues;
+    std::size_t columnBytes = 0;
+
+    // The rings of feature `i` are [featureRings[i], featureRings[i + 1]), and the points of
+    // ring `r` are [ringOffsets[r], ringOffsets[r + 1]) in `points`.
+    mutable std::once_flag geometryFlag;
+    mutable std::vector<uint32_t> featureRings;
+    mutable std::vector<uint32_t> ringOffsets;
+    mutable std::vector<GeometryCoordinate> points;
+    mutable std::atomic<std::size_t> geometryBytes{0};
+
+    // Built on the first getProperties() call, for the callers that need a PropertyMap.
+    mutable std::once_flag propertyMapsFlag;
+    mutable std::vector<PropertyMap> propertyMaps;
+    mutable std::atomic<std::size_t> propertyMapBytes{0};
+};
+
 class VectorTileFeature : public GeometryTileFeature {
 public:
-    VectorTileFeature(const mapbox::vector_tile::layer&, const protozero::data_view&);
+    VectorTileFeature(std::shared_ptr<const VectorTileLayerData>, std::size_t index);
 
     FeatureType getType() const override;
     std::optional<Value> getValue(const std::string& key) const override;
@@ -31,37 +97,48 @@ public:
     const GeometryCollection& getGeometries() const override;
 
 private:
-    mapbox::vector_tile::feature feature;
+    std::shared_ptr<const VectorTileLayerData> layer;
+    std::size_t index;
     mutable std::optional<GeometryCollection> lines;
-    mutable std::optional<PropertyMap> properties;
 };
 
 class VectorTileLayer : public GeometryTileLayer {
 public:
-    VectorTileLayer(std::shared_ptr<const std::string> data, const protozero::data_view&);
+    VectorTileLayer(std::shared_ptr<const VectorTileLayerData>);
 
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
     std::string getName() const override;
 
 private:
-    std::shared_ptr<const std::string> data;
-    mapbox::vector_tile::layer layer;
+    std::shared_ptr<const VectorTileLayerData> layer;
 };
 
 class VectorTileData : public GeometryTileData {
 public:
-    VectorTileData(std::shared_ptr<const std::string> data);
+    VectorTileData(SharedBuffer data);
 
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
 
     std::vector<std::string> layerNames() const;
 
+    // Bytes held by the layers decoded so far, which are shared with the clones of this object.
+    std::size_t getMemoryUsage() const override;
+
 private:
-    std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
-    mutable std::map<std::string, const protozero::data_view> layers;
+    // Decoded layers, shared between clones.
+    struct Layers {
+        std::mutex mutex;
+        bool parsed = false;
+        std::map<std::string, const protozero::data_view> views;
+        std::map<std::string, std::shared_ptr<const VectorTileLayerData>> decoded;
+    };
+
+    VectorTileData(SharedBuffer data, std::shared_ptr<Layers>);
+
+    SharedBuffer data;
+    std::shared_ptr<Layers> layers;
 };
 
 } // namespace mbgl
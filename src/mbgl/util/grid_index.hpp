@@ -68,6 +68,8 @@ public:
 
     bool empty() const;
 
+    std::size_t size() const { return boxElements.size() + circleElements.size(); }
+
 private:
     bool noIntersection(const BBox& queryBBox) const;
     bool completeIntersection(const BBox& queryBBox) const;
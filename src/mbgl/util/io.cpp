@@ -7,6 +7,13 @@
 #include <sstream>
 #include <fstream>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifdef __GNUC__
 #define MBGL_FOPEN_MODE_WBE "wbe"
 #else
@@ -51,6 +58,33 @@ std::optional<std::string> readFile(const std::string &filename) {
     return {};
 }
 
+std::optional<SharedBuffer> mapFile(const std::string &filename) {
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return {};
+    }
+    struct stat info;
+    void *address = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (address != MAP_FAILED) {
+        const auto size = static_cast<std::size_t>(info.st_size);
+        std::shared_ptr<const void> mapping(address,
+                                            [size](const void *ptr) { munmap(const_cast<void *>(ptr), size); });
+        return SharedBuffer(static_cast<const char *>(address), size, std::move(mapping));
+    }
+#endif
+    // Empty files and special files can't be mapped.
+    auto data = readFile(filename);
+    if (!data) {
+        return {};
+    }
+    return SharedBuffer(std::make_shared<const std::string>(std::move(*data)));
+}
+
 void deleteFile(const std::string &filename) {
     const int ret = std::remove(filename.c_str());
     if (ret != 0 && errno != ENOENT) {
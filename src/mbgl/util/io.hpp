@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mbgl/util/shared_buffer.hpp>
+
 #include <string>
 #include <stdexcept>
 #include <optional>
@@ -16,6 +18,11 @@ void write_file(const std::string& filename, const std::string& data);
 std::string read_file(const std::string& filename);
 
 std::optional<std::string> readFile(const std::string& filename);
+// Maps the file into memory where supported and reads it otherwise. The mapping is private, but pages
+// are only read from the file when first touched: if the file is truncated or replaced in place while
+// the buffer is alive, touching the missing pages raises SIGBUS instead of reporting a read error. Only
+// use it for large files that are not modified while in use, such as bundled tiles.
+std::optional<SharedBuffer> mapFile(const std::string& filename);
 void deleteFile(const std::string& filename);
 void copyFile(const std::string& destination, const std::string& source);
 
@@ -1,10 +1,93 @@
 #include <mbgl/util/premultiply.hpp>
 
-#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MBGL_PREMULTIPLY_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MBGL_PREMULTIPLY_NEON
+#endif
 
 namespace mbgl {
 namespace util {
 
+namespace {
+
+// Computes (x * a + 127) / 255 without a division; exact for all 8-bit x and a.
+inline uint8_t premultiplyChannel(uint32_t x, uint32_t a) {
+    const uint32_t t = x * a + 128;
+    return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+void premultiplyScalar(uint8_t* data, std::size_t pixels) {
+    for (std::size_t i = 0; i < pixels * 4; i += 4) {
+        const uint8_t a = data[i + 3];
+        data[i + 0] = premultiplyChannel(data[i + 0], a);
+        data[i + 1] = premultiplyChannel(data[i + 1], a);
+        data[i + 2] = premultiplyChannel(data[i + 2], a);
+    }
+}
+
+#if defined(MBGL_PREMULTIPLY_SSE2)
+
+// Premultiplies two pixels widened to 16-bit lanes. The alpha lanes are multiplied by 255, which
+// leaves them unchanged.
+inline __m128i premultiplyLanes(__m128i pixels) {
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(_mm_andnot_si128(alphaMask, alpha), _mm_and_si128(alphaMask, _mm_set1_epi16(255)));
+
+    const __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+void premultiplyVector(uint8_t* data, std::size_t pixels) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        auto* block = reinterpret_cast<__m128i*>(data + i * 4);
+        const __m128i pixels16 = _mm_loadu_si128(block);
+        const __m128i low = premultiplyLanes(_mm_unpacklo_epi8(pixels16, zero));
+        const __m128i high = premultiplyLanes(_mm_unpackhi_epi8(pixels16, zero));
+        _mm_storeu_si128(block, _mm_packus_epi16(low, high));
+    }
+    premultiplyScalar(data + i * 4, pixels - i);
+}
+
+#elif defined(MBGL_PREMULTIPLY_NEON)
+
+inline uint8x8_t premultiplyLanes(uint8x8_t channel, uint8x8_t alpha) {
+    const uint16x8_t t = vaddq_u16(vmull_u8(channel, alpha), vdupq_n_u16(128));
+    return vshrn_n_u16(vsraq_n_u16(t, t, 8), 8);
+}
+
+void premultiplyVector(uint8_t* data, std::size_t pixels) {
+    std::size_t i = 0;
+    for (; i + 8 <= pixels; i += 8) {
+        uint8x8x4_t rgba = vld4_u8(data + i * 4);
+        rgba.val[0] = premultiplyLanes(rgba.val[0], rgba.val[3]);
+        rgba.val[1] = premultiplyLanes(rgba.val[1], rgba.val[3]);
+        rgba.val[2] = premultiplyLanes(rgba.val[2], rgba.val[3]);
+        vst4_u8(data + i * 4, rgba);
+    }
+    premultiplyScalar(data + i * 4, pixels - i);
+}
+
+#else
+
+void premultiplyVector(uint8_t* data, std::size_t pixels) {
+    premultiplyScalar(data, pixels);
+}
+
+#endif
+
+} // namespace
+
+void premultiply(uint8_t* data, std::size_t pixels) {
+    premultiplyVector(data, pixels);
+}
+
 PremultipliedImage premultiply(UnassociatedImage&& src) {
     PremultipliedImage dst;
 
@@ -12,16 +95,7 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
     src.size = {0, 0};
     dst.data = std::move(src.data);
 
-    uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
-        uint8_t& r = data[i + 0];
-        uint8_t& g = data[i + 1];
-        uint8_t& b = data[i + 2];
-        uint8_t& a = data[i + 3];
-        r = (r * a + 127) / 255;
-        g = (g * a + 127) / 255;
-        b = (b * a + 127) / 255;
-    }
+    premultiply(dst.data.get(), dst.bytes() / 4);
 
     return dst;
 }
@@ -39,7 +113,8 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
         uint8_t& a = data[i + 3];
-        if (a) {
+        // Opaque pixels are left as they are.
+        if (a && a != 255) {
             r = static_cast<uint8_t>((255 * r + (a / 2)) / a);
             g = static_cast<uint8_t>((255 * g + (a / 2)) / a);
             b = static_cast<uint8_t>((255 * b + (a / 2)) / a);
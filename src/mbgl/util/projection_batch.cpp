@@ -0,0 +1,131 @@
+#include <mbgl/util/projection_batch.hpp>
+
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MBGL_PROJECTION_BATCH_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MBGL_PROJECTION_BATCH_NEON
+#endif
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// The entries of a matrix that contribute to x, y and w when z = 0 and w = 1.
+struct PlanarMatrix {
+    explicit PlanarMatrix(const mat4& m)
+        : x{static_cast<float>(m[0]), static_cast<float>(m[4]), static_cast<float>(m[12])},
+          y{static_cast<float>(m[1]), static_cast<float>(m[5]), static_cast<float>(m[13])},
+          w{static_cast<float>(m[3]), static_cast<float>(m[7]), static_cast<float>(m[15])} {}
+
+    float x[3];
+    float y[3];
+    float w[3];
+};
+
+void projectScalar(const PlanarMatrix& m,
+                   const float* xs,
+                   const float* ys,
+                   std::size_t count,
+                   float* outX,
+                   float* outY,
+                   float* outW) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const float px = m.x[0] * xs[i] + m.x[1] * ys[i] + m.x[2];
+        const float py = m.y[0] * xs[i] + m.y[1] * ys[i] + m.y[2];
+        const float pw = m.w[0] * xs[i] + m.w[1] * ys[i] + m.w[2];
+        outX[i] = px / pw;
+        outY[i] = py / pw;
+        outW[i] = pw;
+    }
+}
+
+#if defined(MBGL_PROJECTION_BATCH_SSE2)
+
+void projectVector(const PlanarMatrix& m,
+                   const float* xs,
+                   const float* ys,
+                   std::size_t count,
+                   float* outX,
+                   float* outY,
+                   float* outW) {
+    const __m128 mx0 = _mm_set1_ps(m.x[0]), mx1 = _mm_set1_ps(m.x[1]), mx2 = _mm_set1_ps(m.x[2]);
+    const __m128 my0 = _mm_set1_ps(m.y[0]), my1 = _mm_set1_ps(m.y[1]), my2 = _mm_set1_ps(m.y[2]);
+    const __m128 mw0 = _mm_set1_ps(m.w[0]), mw1 = _mm_set1_ps(m.w[1]), mw2 = _mm_set1_ps(m.w[2]);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(xs + i);
+        const __m128 y = _mm_loadu_ps(ys + i);
+        const __m128 px = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mx0, x), _mm_mul_ps(mx1, y)), mx2);
+        const __m128 py = _mm_add_ps(_mm_add_ps(_mm_mul_ps(my0, x), _mm_mul_ps(my1, y)), my2);
+        const __m128 pw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mw0, x), _mm_mul_ps(mw1, y)), mw2);
+        _mm_storeu_ps(outX + i, _mm_div_ps(px, pw));
+        _mm_storeu_ps(outY + i, _mm_div_ps(py, pw));
+        _mm_storeu_ps(outW + i, pw);
+    }
+    projectScalar(m, xs + i, ys + i, count - i, outX + i, outY + i, outW + i);
+}
+
+#elif defined(MBGL_PROJECTION_BATCH_NEON)
+
+void projectVector(const PlanarMatrix& m,
+                   const float* xs,
+                   const float* ys,
+                   std::size_t count,
+                   float* outX,
+                   float* outY,
+                   float* outW) {
+    const float32x4_t mx0 = vdupq_n_f32(m.x[0]), mx1 = vdupq_n_f32(m.x[1]), mx2 = vdupq_n_f32(m.x[2]);
+    const float32x4_t my0 = vdupq_n_f32(m.y[0]), my1 = vdupq_n_f32(m.y[1]), my2 = vdupq_n_f32(m.y[2]);
+    const float32x4_t mw0 = vdupq_n_f32(m.w[0]), mw1 = vdupq_n_f32(m.w[1]), mw2 = vdupq_n_f32(m.w[2]);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t x = vld1q_f32(xs + i);
+        const float32x4_t y = vld1q_f32(ys + i);
+        const float32x4_t px = vaddq_f32(vaddq_f32(vmulq_f32(mx0, x), vmulq_f32(mx1, y)), mx2);
+        const float32x4_t py = vaddq_f32(vaddq_f32(vmulq_f32(my0, x), vmulq_f32(my1, y)), my2);
+        const float32x4_t pw = vaddq_f32(vaddq_f32(vmulq_f32(mw0, x), vmulq_f32(mw1, y)), mw2);
+        vst1q_f32(outX + i, vdivq_f32(px, pw));
+        vst1q_f32(outY + i, vdivq_f32(py, pw));
+        vst1q_f32(outW + i, pw);
+    }
+    projectScalar(m, xs + i, ys + i, count - i, outX + i, outY + i, outW + i);
+}
+
+#else
+
+void projectVector(const PlanarMatrix& m,
+                   const float* xs,
+                   const float* ys,
+                   std::size_t count,
+                   float* outX,
+                   float* outY,
+                   float* outW) {
+    projectScalar(m, xs, ys, count, outX, outY, outW);
+}
+
+#endif
+
+} // namespace
+
+void projectPoints(const PointBatch& points, const mat4& matrix, ProjectedPointBatch& out) {
+    assert(points.x.size() == points.y.size());
+    const std::size_t count = points.size();
+    out.x.resize(count);
+    out.y.resize(count);
+    out.w.resize(count);
+    if (count == 0) {
+        return;
+    }
+    projectVector(
+        PlanarMatrix(matrix), points.x.data(), points.y.data(), count, out.x.data(), out.y.data(), out.w.data());
+}
+
+} // namespace util
+} // namespace mbgl
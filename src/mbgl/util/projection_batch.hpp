@@ -0,0 +1,53 @@
+#pragma once
+
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/mat4.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace mbgl {
+
+// Tile-unit points kept as separate x and y arrays, so that they can be projected several at a time.
+class PointBatch {
+public:
+    void clear() {
+        x.clear();
+        y.clear();
+    }
+    void reserve(std::size_t count) {
+        x.reserve(count);
+        y.reserve(count);
+    }
+    void push_back(const Point<float>& point) {
+        x.push_back(point.x);
+        y.push_back(point.y);
+    }
+    std::size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+
+    std::vector<float> x;
+    std::vector<float> y;
+};
+
+// Points of a PointBatch transformed by a matrix: the position after the perspective divide, and the w component,
+// which is the distance to the camera for the matrices used to draw tiles.
+class ProjectedPointBatch {
+public:
+    Point<float> point(std::size_t i) const { return {x[i], y[i]}; }
+    std::size_t size() const { return w.size(); }
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> w;
+};
+
+namespace util {
+
+// Transforms the points (x, y, 0, 1) by `matrix` in single precision, four points at a time with SSE2 or NEON
+// where available. For the points of a tile in view, results are within a thousandth of a pixel of the double
+// precision math of matrix::transformMat4().
+void projectPoints(const PointBatch&, const mat4& matrix, ProjectedPointBatch&);
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,43 @@
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+namespace mbgl {
+
+struct SharedBuffer::Materialized {
+    std::once_flag flag;
+    std::shared_ptr<const std::string> string;
+};
+
+SharedBuffer::SharedBuffer(std::shared_ptr<const std::string> string_)
+    : owner(string_),
+      begin(string_ ? string_->data() : nullptr),
+      length(string_ ? string_->size() : 0),
+      whole(std::move(string_)) {}
+
+SharedBuffer::SharedBuffer(const char* data_, std::size_t size_, std::shared_ptr<const void> owner_)
+    : owner(std::move(owner_)),
+      begin(data_),
+      length(size_),
+      materialized(std::make_shared<Materialized>()) {}
+
+SharedBuffer SharedBuffer::slice(std::size_t offset, std::size_t count) const {
+    offset = std::min(offset, length);
+    count = std::min(count, length - offset);
+    if (offset == 0 && count == length) {
+        return *this;
+    }
+    return {begin + offset, count, owner};
+}
+
+std::shared_ptr<const std::string> SharedBuffer::string() const {
+    if (whole || !materialized) {
+        return whole;
+    }
+    std::call_once(materialized->flag,
+                   [&] { materialized->string = std::make_shared<const std::string>(begin, length); });
+    return materialized->string;
+}
+
+} // namespace mbgl
@@ -5,18 +5,64 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
+namespace {
+
+// The scheduler and worker index of the current thread, if it is a worker thread.
+thread_local const ThreadedSchedulerBase* currentScheduler = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+// Work running on the pool may block on other work on the pool (e.g. an actor waiting for another
+// actor's reply), so the default never goes below the four threads the pool used to have.
+constexpr std::size_t kMinimumThreadCount = 4;
+
+} // namespace
+
+ThreadedSchedulerBase::ThreadedSchedulerBase(std::size_t threadCount) {
+    workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+}
+
 ThreadedSchedulerBase::~ThreadedSchedulerBase() = default;
 
 void ThreadedSchedulerBase::terminate() {
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> lock(idleMutex);
         terminated = true;
     }
     cv.notify_all();
 }
 
+bool ThreadedSchedulerBase::popFrom(Worker& worker, std::size_t lane, std::function<void()>& function) {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    auto& queue = worker.lanes[lane];
+    if (queue.empty()) {
+        return false;
+    }
+    function = std::move(queue.front());
+    queue.pop_front();
+    return true;
+}
+
+bool ThreadedSchedulerBase::pop(std::size_t index, std::function<void()>& function) {
+    const std::size_t count = workers.size();
+    for (std::size_t lane = 0; lane < TaskPriorityCount; ++lane) {
+        // Own queue first, then steal from the other workers.
+        for (std::size_t i = 0; i < count; ++i) {
+            if (popFrom(*workers[(index + i) % count], lane, function)) {
+                pending.fetch_sub(1);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
     return std::thread([this, index] {
         auto& settings = platform::Settings::getInstance();
@@ -28,32 +74,68 @@ std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
         platform::setCurrentThreadName(std::string{"Worker "} + util::toString(index + 1));
         platform::attachThread();
 
+        currentScheduler = this;
+        currentWorker = index;
+
         while (true) {
-            std::unique_lock<std::mutex> lock(mutex);
+            std::function<void()> function;
+            if (!terminated && pop(index, function)) {
+                if (function) function();
+                continue;
+            }
 
-            cv.wait(lock, [this] { return !queue.empty() || terminated; });
+            std::unique_lock<std::mutex> lock(idleMutex);
+            ++sleeping;
+            cv.wait(lock, [this] { return pending > 0 || terminated; });
+            --sleeping;
 
             if (terminated) {
+                currentScheduler = nullptr;
                 platform::detachThread();
                 return;
             }
-
-            auto function = std::move(queue.front());
-            queue.pop();
-            lock.unlock();
-            if (function) function();
         }
     });
 }
 
 void ThreadedSchedulerBase::schedule(std::function<void()> fn) {
+    scheduleWithPriority(TaskPriority::Normal, std::move(fn));
+}
+
+void ThreadedSchedulerBase::scheduleWithPriority(TaskPriority priority, std::function<void()> fn) {
     assert(fn);
+    const std::size_t index = currentScheduler == this ? currentWorker : nextWorker++ % workers.size();
+
+    // Counted before it is published, so that a worker popping it right away never
+    // decrements `pending` below zero.
+    ++pending;
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(std::move(fn));
+        auto& worker = *workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.lanes[static_cast<std::size_t>(priority)].push_back(std::move(fn));
+    }
+
+    // A worker going to sleep increments `sleeping` before re-checking `pending`
+    // under `idleMutex`, so either it sees this task or we see it sleeping.
+    if (sleeping > 0) {
+        { std::lock_guard<std::mutex> lock(idleMutex); }
+        cv.notify_one();
+    }
+}
+
+ThreadPool::ThreadPool()
+    : ThreadedScheduler(defaultThreadCount()) {}
+
+// static
+std::size_t ThreadPool::defaultThreadCount() {
+    auto value = platform::Settings::getInstance().get(platform::EXPERIMENTAL_THREAD_POOL_SIZE);
+    if (auto* size = value.getUint()) {
+        if (*size > 0) return static_cast<std::size_t>(*size);
+    } else if (auto* signedSize = value.getInt()) {
+        if (*signedSize > 0) return static_cast<std::size_t>(*signedSize);
     }
 
-    cv.notify_one();
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), kMinimumThreadCount);
 }
 
 } // namespace mbgl
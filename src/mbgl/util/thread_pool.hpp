@@ -4,44 +4,81 @@
 #include <mbgl/actor/scheduler.hpp>
 
 #include <array>
+#include <atomic>
+#include <cassert>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace mbgl {
 
+/**
+ * @brief ThreadedSchedulerBase implements the Scheduler interface on top of
+ * a fixed set of worker threads.
+ *
+ * Every worker owns a queue with one lane per `TaskPriority`. Tasks scheduled
+ * from a worker thread go to that worker's queue, other tasks are distributed
+ * round-robin. An idle worker first drains its own queue and then steals from
+ * the others, always taking the highest priority task it can find.
+ *
+ * Ordering between tasks is only guaranteed when there is a single thread and
+ * all tasks share a priority. Per-mailbox ordering doesn't depend on it, as a
+ * `Mailbox` never has more than one `receive()` task scheduled at a time.
+ */
 class ThreadedSchedulerBase : public Scheduler {
 public:
     void schedule(std::function<void()>) override;
+    void scheduleWithPriority(TaskPriority, std::function<void()>) override;
+
+    std::size_t getThreadCount() const { return workers.size(); }
 
 protected:
-    ThreadedSchedulerBase() = default;
+    explicit ThreadedSchedulerBase(std::size_t threadCount);
     ~ThreadedSchedulerBase() override;
 
     void terminate();
     std::thread makeSchedulerThread(size_t index);
 
-    std::queue<std::function<void()>> queue;
-    std::mutex mutex;
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::array<std::deque<std::function<void()>>, TaskPriorityCount> lanes;
+    };
+
+    bool pop(std::size_t index, std::function<void()>& function);
+    bool popFrom(Worker&, std::size_t lane, std::function<void()>& function);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> nextWorker{0};
+    // Tasks scheduled and not yet popped. Incremented before a task is queued, so it may briefly
+    // count a task that workers can't pop yet, but never drops below the number of queued tasks.
+    std::atomic<std::size_t> pending{0};
+
+    // Only used for putting idle workers to sleep and waking them up.
+    std::mutex idleMutex;
     std::condition_variable cv;
-    bool terminated{false};
+    std::atomic<std::size_t> sleeping{0};
+    std::atomic<bool> terminated{false};
 };
 
 /**
  * @brief ThreadScheduler implements Scheduler interface using a lightweight event loop
  *
- * @tparam N number of threads
- *
- * Note: If N == 1 all scheduled tasks are guaranteed to execute consequently;
- * otherwise, some of the scheduled tasks might be executed in parallel.
+ * Note: If the thread count is 1, all scheduled tasks of the same priority are
+ * guaranteed to execute consequently; otherwise, some of the scheduled tasks might
+ * be executed in parallel.
  */
-template <std::size_t N>
 class ThreadedScheduler : public ThreadedSchedulerBase {
 public:
-    ThreadedScheduler() {
-        for (std::size_t i = 0u; i < N; ++i) {
-            threads[i] = makeSchedulerThread(i);
+    explicit ThreadedScheduler(std::size_t threadCount)
+        : ThreadedSchedulerBase(threadCount) {
+        assert(threadCount > 0);
+        threads.reserve(threadCount);
+        for (std::size_t i = 0u; i < threadCount; ++i) {
+            threads.push_back(makeSchedulerThread(i));
         }
     }
 
@@ -56,16 +93,37 @@ public:
     mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
 
 private:
-    std::array<std::thread, N> threads;
+    std::vector<std::thread> threads;
     mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
-    static_assert(N > 0, "Thread count must be more than zero.");
 };
 
-class SequencedScheduler : public ThreadedScheduler<1> {};
+class SequencedScheduler : public ThreadedScheduler {
+public:
+    SequencedScheduler()
+        : ThreadedScheduler(1) {}
+};
 
 template <std::size_t extra>
-using ParallelScheduler = ThreadedScheduler<1 + extra>;
+class ParallelScheduler : public ThreadedScheduler {
+public:
+    ParallelScheduler()
+        : ThreadedScheduler(1 + extra) {}
+};
+
+/**
+ * @brief ThreadPool is the shared background scheduler.
+ *
+ * The default constructor sizes the pool from the `EXPERIMENTAL_THREAD_POOL_SIZE`
+ * platform setting if present, or from `std::thread::hardware_concurrency()`
+ * with a minimum of four threads.
+ */
+class ThreadPool : public ThreadedScheduler {
+public:
+    ThreadPool();
+    explicit ThreadPool(std::size_t threadCount)
+        : ThreadedScheduler(threadCount) {}
 
-class ThreadPool : public ParallelScheduler<3> {};
+    static std::size_t defaultThreadCount();
+};
 
 } // namespace mbgl
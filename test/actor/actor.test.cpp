@@ -3,12 +3,14 @@
 #include <mbgl/actor/scheduler.hpp>
 #include <mbgl/test/util.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_pool.hpp>
 
 #include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
 #include <thread>
+#include <vector>
 
 using namespace mbgl;
 using namespace std::chrono_literals;
@@ -256,6 +258,87 @@ TEST(Actor, NonConcurrentMailbox) {
     endedFuture.wait();
 }
 
+TEST(Actor, ConcurrentSenders) {
+    // Messages sent from several threads at once are all received, in order per sender.
+
+    constexpr int senders = 4;
+    constexpr int messages = 10000;
+
+    struct TestActor {
+        std::vector<int> last = std::vector<int>(senders, -1);
+        int received = 0;
+        std::promise<void> promise;
+
+        TestActor(ActorRef<TestActor>, std::promise<void> promise_)
+            : promise(std::move(promise_)) {}
+
+        void receive(int sender, int i) {
+            EXPECT_EQ(i, last[sender] + 1);
+            last[sender] = i;
+            if (++received == senders * messages) {
+                promise.set_value();
+            }
+        }
+    };
+
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+    Actor<TestActor> test(Scheduler::GetBackground(), std::move(endedPromise));
+
+    std::vector<std::thread> threads;
+    for (int sender = 0; sender < senders; ++sender) {
+        threads.emplace_back([sender, ref = test.self()]() mutable {
+            for (int i = 0; i < messages; ++i) {
+                ref.invoke(&TestActor::receive, sender, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(std::future_status::ready, endedFuture.wait_for(10s));
+}
+
+TEST(Actor, BatchedReceive) {
+    // A mailbox processes a bounded batch of messages before letting other mailboxes run.
+
+    struct TestActor {
+        std::vector<int>& log;
+        int id;
+
+        TestActor(ActorRef<TestActor>, std::vector<int>& log_, int id_)
+            : log(log_),
+              id(id_) {}
+
+        void receive() { log.push_back(id); }
+        void end(std::promise<void>* promise) { promise->set_value(); }
+    };
+
+    ThreadPool pool(1);
+    std::vector<int> log;
+    Actor<TestActor> first(pool, log, 1);
+    Actor<TestActor> second(pool, log, 2);
+
+    // Keep the only worker busy until all messages are queued.
+    std::promise<void> queuedPromise;
+    pool.schedule([queued = queuedPromise.get_future().share()] { queued.wait(); });
+
+    const auto count = static_cast<int>(2 * Mailbox::maxBatchSize);
+    for (int i = 0; i < count; ++i) {
+        first.self().invoke(&TestActor::receive);
+    }
+    second.self().invoke(&TestActor::receive);
+
+    std::promise<void> endedPromise;
+    first.self().invoke(&TestActor::end, &endedPromise);
+    queuedPromise.set_value();
+    endedPromise.get_future().wait();
+
+    ASSERT_EQ(static_cast<std::size_t>(count + 1), log.size());
+    EXPECT_EQ(2, log[Mailbox::maxBatchSize]);
+}
+
 TEST(Actor, Ask) {
     // Asking for a result
 
@@ -5,9 +5,11 @@
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
+#include <mbgl/style/layer.hpp>
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/color.hpp>
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/gfx/headless_frontend.hpp>
@@ -281,6 +283,75 @@ TEST(Annotations, UpdateFillAnnotationStyle) {
     test.checkRendering("update_fill_style");
 }
 
+TEST(Annotations, UpdateSharedLineAnnotationStyle) {
+    AnnotationTest test;
+
+    LineAnnotation annotation{LineString<double>{{{0, 0}, {45, 45}, {30, 0}}}};
+    annotation.color = Color::red();
+    annotation.width = {5};
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    AnnotationID line = test.map.addAnnotation(annotation);
+    // An empty line with the same style, sharing the layer and drawn above the first.
+    LineAnnotation empty = annotation;
+    empty.geometry = LineString<double>();
+    test.map.addAnnotation(empty);
+
+    test.frontend.render(test.map);
+
+    annotation.color = Color::green();
+    annotation.width = {2};
+    test.map.updateAnnotation(line, annotation);
+    test.checkRendering("update_line_style");
+}
+
+TEST(Annotations, ShapeLayers) {
+    AnnotationTest test;
+
+    auto layerIDs = [&] {
+        std::vector<std::string> ids;
+        for (const auto* layer : test.map.getStyle().getLayers()) {
+            ids.push_back(layer->getID());
+        }
+        return ids;
+    };
+    auto shapeLayerID = [](AnnotationID id) { return "com.mapbox.annotations.shape." + util::toString(id); };
+    const std::string pointLayerID = "com.mapbox.annotations.points";
+
+    LineAnnotation line{LineString<double>{{{0, 0}, {45, 45}}}};
+    line.color = Color::red();
+    FillAnnotation fill{Polygon<double>{{{{0, 0}, {0, 45}, {45, 45}, {45, 0}}}}};
+
+    test.map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+    AnnotationID first = test.map.addAnnotation(line);
+    AnnotationID second = test.map.addAnnotation(line);
+    AnnotationID third = test.map.addAnnotation(fill);
+    AnnotationID fourth = test.map.addAnnotation(line);
+
+    // Consecutive shapes with the same style share a layer.
+    EXPECT_EQ(std::vector<std::string>({shapeLayerID(first), shapeLayerID(third), shapeLayerID(fourth), pointLayerID}),
+              layerIDs());
+
+    // A restyled shape leaves the shared layer, keeping its place in the drawing order.
+    line.color = Color::green();
+    test.map.updateAnnotation(second, line);
+    EXPECT_EQ(std::vector<std::string>(
+                  {shapeLayerID(first), shapeLayerID(second), shapeLayerID(third), shapeLayerID(fourth), pointLayerID}),
+              layerIDs());
+
+    // A shape alone in its layer is restyled in place.
+    test.map.updateAnnotation(first, line);
+    EXPECT_EQ(std::vector<std::string>(
+                  {shapeLayerID(first), shapeLayerID(second), shapeLayerID(third), shapeLayerID(fourth), pointLayerID}),
+              layerIDs());
+
+    test.map.removeAnnotation(third);
+    EXPECT_EQ(std::vector<std::string>({shapeLayerID(first), shapeLayerID(second), shapeLayerID(fourth), pointLayerID}),
+              layerIDs());
+
+    test.frontend.render(test.map);
+}
+
 TEST(Annotations, RemovePoint) {
     AnnotationTest test;
 
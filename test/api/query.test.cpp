@@ -3,6 +3,7 @@
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/test/stub_file_source.hpp>
 #include <mbgl/test/util.hpp>
+#include <mbgl/util/async_request.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
@@ -248,6 +249,45 @@ TEST(Query, QueryFeatureExtensionsSuperclusterExpansionZoom) {
     EXPECT_EQ(zoomValue2.get<uint64_t>(), 3u);
 }
 
+TEST(Query, QueryFeatureExtensionsSuperclusterAsync) {
+    QueryTest test;
+    auto topClusterFeature = getTopClusterFeature(test);
+    ASSERT_EQ(topClusterFeature.size(), 1u);
+
+    // Cluster queries are answered on the scheduler of the source and delivered on the calling thread.
+    std::optional<FeatureExtensionValue> expansionZoom;
+    auto request = test.frontend.getRenderer()->queryFeatureExtensions(
+        "cluster_source"s,
+        topClusterFeature[0],
+        "supercluster"s,
+        "expansion-zoom"s,
+        std::nullopt,
+        [&](FeatureExtensionValue value) {
+            expansionZoom = std::move(value);
+            test.loop.stop();
+        });
+    ASSERT_TRUE(request);
+    EXPECT_FALSE(expansionZoom);
+    test.loop.run();
+    ASSERT_TRUE(expansionZoom);
+    EXPECT_EQ(expansionZoom->get<mbgl::Value>().get<uint64_t>(), 1u);
+
+    // Unknown extensions are answered right away.
+    bool unknownAnswered = false;
+    auto unknownRequest = test.frontend.getRenderer()->queryFeatureExtensions(
+        "cluster_source"s,
+        topClusterFeature[0],
+        "unknown"s,
+        "children"s,
+        std::nullopt,
+        [&](FeatureExtensionValue value) {
+            unknownAnswered = true;
+            EXPECT_TRUE(value.get<mbgl::Value>().is<NullValue>());
+        });
+    EXPECT_FALSE(unknownRequest);
+    EXPECT_TRUE(unknownAnswered);
+}
+
 TEST(Query, QueryFeatureExtensionsSuperclusterLeaves) {
     QueryTest test;
     auto topClusterFeature = getTopClusterFeature(test);
@@ -0,0 +1,109 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend_scope.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/defines.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/program.hpp>
+#include <mbgl/platform/gl_functions.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace mbgl;
+using namespace mbgl::platform;
+
+namespace {
+
+const char* vertexShaderSource = R"MBGL_SHADER(
+#ifdef GL_ES
+precision mediump float;
+#endif
+attribute vec2 a_pos;
+void main() {
+    gl_Position = vec4(a_pos, 0, 1);
+}
+)MBGL_SHADER";
+
+const char* fragmentShaderSource = R"MBGL_SHADER(
+#ifdef GL_ES
+precision mediump float;
+#endif
+void main() {
+    gl_FragColor = vec4(0, 1, 0, 1);
+}
+)MBGL_SHADER";
+
+const std::string cachePath = "test/fixtures/program_binary.cache";
+
+gl::UniqueProgram compileProgram(gl::Context& context) {
+    return context.createProgram(context.createShader(gl::ShaderType::Vertex, {vertexShaderSource}),
+                                 context.createShader(gl::ShaderType::Fragment, {fragmentShaderSource}),
+                                 "a_pos",
+                                 true);
+}
+
+bool isLinked(gl::ProgramID program) {
+    GLint status = GL_FALSE;
+    MBGL_CHECK_ERROR(glGetProgramiv(program, GL_LINK_STATUS, &status));
+    return status == GL_TRUE;
+}
+
+} // namespace
+
+TEST(GLProgram, BinaryCache) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    gl::HeadlessBackend backend{{256, 256}};
+    gfx::BackendScope scope{backend};
+    auto& context = backend.getContext<gl::Context>();
+    if (!context.supportsProgramBinaries()) {
+        // Programs are always compiled without the extension.
+        return;
+    }
+    std::remove(cachePath.c_str());
+
+    // Save.
+    gl::cacheProgram(context, compileProgram(context), cachePath);
+    const auto saved = util::readFile(cachePath);
+    ASSERT_TRUE(saved);
+    ASSERT_GT(saved->size(), sizeof(gl::BinaryProgramFormat));
+
+    // Load, keeping the attribute location bound before linking.
+    {
+        auto loaded = gl::loadCachedProgram(context, cachePath);
+        ASSERT_TRUE(loaded);
+        EXPECT_TRUE(isLinked(*loaded));
+        EXPECT_EQ(0, MBGL_CHECK_ERROR(glGetAttribLocation(*loaded, "a_pos")));
+    }
+
+    // A binary of a format the driver does not support.
+    gl::BinaryProgramFormat format;
+    std::memcpy(&format, saved->data(), sizeof(format));
+    std::string mismatched = *saved;
+    format = ~format;
+    std::memcpy(mismatched.data(), &format, sizeof(format));
+    util::write_file(cachePath, mismatched);
+    EXPECT_FALSE(gl::loadCachedProgram(context, cachePath));
+
+    // A corrupt binary, and a truncated one.
+    std::string corrupt = *saved;
+    std::fill(corrupt.begin() + sizeof(format), corrupt.end(), '\0');
+    util::write_file(cachePath, corrupt);
+    EXPECT_FALSE(gl::loadCachedProgram(context, cachePath));
+    util::write_file(cachePath, saved->substr(0, sizeof(format)));
+    EXPECT_FALSE(gl::loadCachedProgram(context, cachePath));
+
+    // Programs compiled after a rejected binary replace it.
+    gl::cacheProgram(context, compileProgram(context), cachePath);
+    {
+        auto loaded = gl::loadCachedProgram(context, cachePath);
+        ASSERT_TRUE(loaded);
+        EXPECT_TRUE(isLinked(*loaded));
+    }
+
+    std::remove(cachePath.c_str());
+}
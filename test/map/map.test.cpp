@@ -11,6 +11,7 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/math/log2.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/storage/file_source_manager.hpp>
@@ -36,6 +37,7 @@
 #include <mbgl/util/run_loop.hpp>
 
 #include <atomic>
+#include <cstring>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -983,6 +985,81 @@ TEST(Map, Issue12432) {
     test.runLoop.run();
 }
 
+// Building the buckets of a tile in parallel must give the same render data and feature index as a serial parse.
+TEST(Map, ParallelTileParsing) {
+    struct Result {
+        PremultipliedImage image;
+        std::vector<std::vector<Feature>> features;
+    };
+
+    const std::vector<std::string> layerIDs{"water-fill", "water-line", "admin", "admin-lines", "admin-round"};
+    auto parse = [&](bool parallel) {
+        auto& settings = platform::Settings::getInstance();
+        settings.set(platform::EXPERIMENTAL_PARALLEL_TILE_PARSING, parallel);
+        MapTest<> test;
+
+        test.fileSource->tileResponse = [&](const Resource&) {
+            Response result;
+            result.data = std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt"));
+            return result;
+        };
+
+        // Groups of plain buckets sharing source layers, next to each other and with different filters.
+        test.map.getStyle().loadJSON(R"STYLE({
+          "version": 8,
+          "sources": {
+            "mapbox": {
+              "type": "vector",
+              "tiles": ["http://example.com/{z}-{x}-{y}.vector.pbf"]
+            }
+          },
+          "layers": [
+            { "id": "water-fill", "type": "fill", "source": "mapbox", "source-layer": "water" },
+            { "id": "water-line", "type": "line", "source": "mapbox", "source-layer": "water" },
+            { "id": "admin", "type": "line", "source": "mapbox", "source-layer": "admin" },
+            {
+              "id": "admin-lines",
+              "type": "line",
+              "source": "mapbox",
+              "source-layer": "admin",
+              "filter": ["==", ["geometry-type"], "LineString"],
+              "paint": { "line-width": 2 }
+            },
+            {
+              "id": "admin-round",
+              "type": "line",
+              "source": "mapbox",
+              "source-layer": "admin",
+              "filter": ["has", "disputed"],
+              "layout": { "line-join": "round" }
+            }
+          ]
+        })STYLE");
+
+        Result result;
+        result.image = test.frontend.render(test.map).image;
+        settings.set(platform::EXPERIMENTAL_PARALLEL_TILE_PARSING, mapbox::base::Value());
+
+        const Size size = test.frontend.getSize();
+        const ScreenBox box{{0, 0}, {static_cast<double>(size.width), static_cast<double>(size.height)}};
+        for (const auto& layerID : layerIDs) {
+            result.features.push_back(test.frontend.getRenderer()->queryRenderedFeatures(box, {{{layerID}}, {}}));
+        }
+        return result;
+    };
+
+    const Result serial = parse(false);
+    const Result parallel = parse(true);
+
+    ASSERT_EQ(layerIDs.size(), parallel.features.size());
+    for (std::size_t i = 0; i < layerIDs.size(); ++i) {
+        EXPECT_FALSE(serial.features[i].empty()) << layerIDs[i];
+        EXPECT_EQ(serial.features[i], parallel.features[i]) << layerIDs[i];
+    }
+    ASSERT_EQ(serial.image.bytes(), parallel.image.bytes());
+    EXPECT_EQ(0, std::memcmp(serial.image.data.get(), parallel.image.data.get(), serial.image.bytes()));
+}
+
 // https://github.com/mapbox/mapbox-gl-native/issues/15216
 TEST(Map, Issue15216) {
     MapTest<> test{1.0f, MapMode::Continuous};
@@ -1041,6 +1118,80 @@ TEST(Map, Issue15342) {
     test.runLoop.run();
 }
 
+// Placement spread over several frames must eventually be committed, let the map settle and end up with
+// the same symbols placed as a placement done in a single frame.
+TEST(Map, IncrementalPlacement) {
+    struct Result {
+        PremultipliedImage image;
+        std::vector<std::size_t> placedFeatures;
+        bool placementChanged = false;
+        Duration latency = Duration::zero();
+    };
+
+    auto place = [](std::optional<double> budget) {
+        auto& settings = platform::Settings::getInstance();
+        settings.set(platform::EXPERIMENTAL_PLACEMENT_TIME_BUDGET,
+                     budget ? mapbox::base::Value(*budget) : mapbox::base::Value());
+        MapTest<> test{1, MapMode::Continuous};
+        settings.set(platform::EXPERIMENTAL_PLACEMENT_TIME_BUDGET, mapbox::base::Value());
+
+        // The three layers share their points, so that the later ones are hidden by collisions.
+        test.map.getStyle().loadJSON(R"STYLE({
+          "version": 8,
+          "sources": {
+            "points": {
+              "type": "geojson",
+              "data": {
+                "type": "FeatureCollection",
+                "features": [
+                  { "type": "Feature", "properties": {}, "geometry": { "type": "Point", "coordinates": [0, 0] } },
+                  { "type": "Feature", "properties": {}, "geometry": { "type": "Point", "coordinates": [10, 10] } },
+                  { "type": "Feature", "properties": {}, "geometry": { "type": "Point", "coordinates": [-10, -10] } }
+                ]
+              }
+            }
+          },
+          "layers": [
+            { "id": "a", "type": "symbol", "source": "points", "layout": { "icon-image": "marker" } },
+            { "id": "b", "type": "symbol", "source": "points", "layout": { "icon-image": "marker" } },
+            { "id": "c", "type": "symbol", "source": "points", "layout": { "icon-image": "marker" } }
+          ]
+        })STYLE");
+        test.map.getStyle().addImage(std::make_unique<style::Image>(
+            "marker", decodeImage(util::read_file("test/fixtures/sprites/default_marker.png")), 1.0f));
+
+        Result result;
+        test.observer.didFinishRenderingFrameCallback = [&](MapObserver::RenderFrameStatus status) {
+            result.placementChanged |= status.placementChanged;
+            if (status.mode == MapObserver::RenderMode::Full && !status.needsRepaint) {
+                test.runLoop.stop();
+            }
+        };
+        test.runLoop.run();
+
+        Renderer& renderer = *test.frontend.getRenderer();
+        const Size size = test.frontend.getSize();
+        const ScreenBox box{{0, 0}, {static_cast<double>(size.width), static_cast<double>(size.height)}};
+        for (const auto& layerID : {"a", "b", "c"}) {
+            result.placedFeatures.push_back(renderer.queryRenderedFeatures(box, {{{layerID}}, {}}).size());
+        }
+        result.latency = renderer.getPlacementLatency();
+        result.image = test.frontend.readStillImage();
+        return result;
+    };
+
+    // A zero budget places a single bucket per frame.
+    const Result incremental = place(0.0);
+    const Result reference = place(std::nullopt);
+
+    EXPECT_TRUE(incremental.placementChanged);
+    EXPECT_GT(incremental.latency, Duration::zero());
+    EXPECT_NE(std::vector<std::size_t>({0u, 0u, 0u}), reference.placedFeatures);
+    EXPECT_EQ(reference.placedFeatures, incremental.placedFeatures);
+    ASSERT_EQ(reference.image.bytes(), incremental.image.bytes());
+    EXPECT_EQ(0, std::memcmp(reference.image.data.get(), incremental.image.data.get(), reference.image.bytes()));
+}
+
 TEST(Map, UniversalStyleGetter) {
     MapTest<> test;
 
@@ -1,6 +1,7 @@
 #include <mbgl/test/util.hpp>
 
 #include <gmock/gmock.h>
+#include <algorithm>
 #include <cmath>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/util/geo.hpp>
@@ -509,6 +510,44 @@ TEST(Transform, Camera) {
     ASSERT_DOUBLE_EQ(transform.getLatLng().longitude(), 0);
 }
 
+TEST(Transform, CameraTrajectory) {
+    Transform transform;
+    transform.resize({1000, 1000});
+    transform.jumpTo(CameraOptions().withCenter(LatLng{0, 0}).withZoom(10.0));
+    EXPECT_FALSE(transform.getCameraTrajectory());
+
+    transform.flyTo(CameraOptions().withCenter(LatLng{10, 20}).withZoom(12.0), AnimationOptions(Seconds(1)));
+    auto trajectory = transform.getCameraTrajectory();
+    ASSERT_TRUE(trajectory);
+    ASSERT_FALSE(trajectory->empty());
+
+    // The destination comes first.
+    EXPECT_NEAR(10.0, trajectory->front().getLatLng().latitude(), 1e-6);
+    EXPECT_NEAR(20.0, trajectory->front().getLatLng().longitude(), 1e-6);
+    EXPECT_NEAR(12.0, trajectory->front().getZoom(), 1e-6);
+
+    // Sampling doesn't move the camera.
+    EXPECT_DOUBLE_EQ(0.0, transform.getLatLng().latitude());
+    EXPECT_DOUBLE_EQ(10.0, transform.getZoom());
+
+    transform.updateTransitions(transform.getTransitionStart() + Milliseconds(500));
+    // A flight zooms out on its way.
+    EXPECT_TRUE(std::any_of(trajectory->begin() + 1, trajectory->end(), [](const TransformState& state) {
+        return state.getZoom() < 10.0;
+    }));
+    EXPECT_EQ(trajectory, transform.getCameraTrajectory());
+
+    transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
+    EXPECT_FALSE(transform.inTransition());
+    EXPECT_FALSE(transform.getCameraTrajectory());
+    EXPECT_NEAR(10.0, transform.getLatLng().latitude(), 1e-6);
+
+    transform.easeTo(CameraOptions().withZoom(14.0), AnimationOptions(Seconds(1)));
+    ASSERT_TRUE(transform.getCameraTrajectory());
+    transform.cancelTransitions();
+    EXPECT_FALSE(transform.getCameraTrajectory());
+}
+
 TEST(Transform, ProjectionMode) {
     Transform transform;
 
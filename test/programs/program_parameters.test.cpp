@@ -0,0 +1,27 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/programs/program_parameters.hpp>
+
+using namespace mbgl;
+
+TEST(ProgramParameters, CachePathDisabled) {
+    const ProgramParameters parameters(1.0f, false);
+    EXPECT_FALSE(parameters.cachePath("FillProgram", {"vertex", "fragment"}));
+}
+
+TEST(ProgramParameters, CachePath) {
+    const ProgramParameters parameters(1.0f, false, std::string("/tmp/programs"));
+
+    const auto path = parameters.cachePath("FillProgram", {"driver", "vertex", "fragment"});
+    ASSERT_TRUE(path);
+    EXPECT_EQ(0u, path->find("/tmp/programs/FillProgram."));
+    EXPECT_EQ(path->size() - 4, path->rfind(".bin"));
+
+    // The path only depends on the key.
+    EXPECT_EQ(*path, *parameters.cachePath("FillProgram", {"driver", "vertex", "fragment"}));
+    EXPECT_NE(*path, *parameters.cachePath("FillProgram", {"other driver", "vertex", "fragment"}));
+    EXPECT_NE(*path, *parameters.cachePath("LineProgram", {"driver", "vertex", "fragment"}));
+
+    // Moving text between parts of the key changes the path.
+    EXPECT_NE(*parameters.cachePath("FillProgram", {"ab", "c"}), *parameters.cachePath("FillProgram", {"a", "bc"}));
+}
@@ -51,6 +51,32 @@ TEST(ImageManager, AddRemove) {
     EXPECT_EQ(nullptr, imageManager.getImage("four"));
 }
 
+TEST(ImageManager, AvailableImages) {
+    FixtureLog log;
+    ImageManager imageManager;
+
+    imageManager.addImage(makeMutable<style::Image::Impl>("one", PremultipliedImage({16, 16}), 2.0f));
+    imageManager.addImage(makeMutable<style::Image::Impl>("two", PremultipliedImage({16, 16}), 2.0f));
+
+    auto snapshot = imageManager.getAvailableImages();
+    EXPECT_EQ(2u, snapshot->size());
+    EXPECT_TRUE(snapshot->contains("one"));
+    EXPECT_TRUE(snapshot->contains("two"));
+    // The snapshot is shared until the images change.
+    EXPECT_EQ(snapshot, imageManager.getAvailableImages());
+
+    imageManager.updateImage(makeMutable<style::Image::Impl>("one", PremultipliedImage({16, 16}), 2.0f));
+    EXPECT_EQ(snapshot, imageManager.getAvailableImages());
+
+    imageManager.removeImage("one");
+    auto updated = imageManager.getAvailableImages();
+    EXPECT_NE(snapshot, updated);
+    EXPECT_FALSE(updated->contains("one"));
+    EXPECT_TRUE(updated->contains("two"));
+    // Earlier snapshots are left untouched.
+    EXPECT_TRUE(snapshot->contains("one"));
+}
+
 TEST(ImageManager, Update) {
     FixtureLog log;
     ImageManager imageManager;
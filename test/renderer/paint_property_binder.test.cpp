@@ -0,0 +1,179 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/gfx/upload_pass.hpp>
+#include <mbgl/renderer/paint_property_binder.hpp>
+#include <mbgl/style/expression/dsl.hpp>
+
+#include <utility>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// Records the buffer uploads instead of issuing them to a graphics API.
+class StubUploadPass final : public gfx::UploadPass {
+public:
+    class StubVertexBufferResource final : public gfx::VertexBufferResource {};
+
+    struct Update {
+        std::size_t offset;
+        std::size_t size;
+        bool operator==(const Update& other) const { return offset == other.offset && size == other.size; }
+    };
+
+    std::vector<std::size_t> createdVertexBuffers;
+    std::vector<Update> vertexBufferUpdates;
+
+private:
+    void pushDebugGroup(const char*) override {}
+    void popDebugGroup() override {}
+
+    std::unique_ptr<gfx::VertexBufferResource> createVertexBufferResource(const void*,
+                                                                          std::size_t size,
+                                                                          gfx::BufferUsageType) override {
+        createdVertexBuffers.push_back(size);
+        return std::make_unique<StubVertexBufferResource>();
+    }
+    void updateVertexBufferResource(gfx::VertexBufferResource&,
+                                    const void*,
+                                    std::size_t size,
+                                    std::size_t offset) override {
+        vertexBufferUpdates.push_back({offset, size});
+    }
+
+    std::unique_ptr<gfx::IndexBufferResource> createIndexBufferResource(const void*,
+                                                                        std::size_t,
+                                                                        gfx::BufferUsageType) override {
+        return nullptr;
+    }
+    void updateIndexBufferResource(gfx::IndexBufferResource&, const void*, std::size_t) override {}
+
+    std::unique_ptr<gfx::TextureResource> createTextureResource(Size,
+                                                                const void*,
+                                                                gfx::TexturePixelType,
+                                                                gfx::TextureChannelDataType) override {
+        return nullptr;
+    }
+    void updateTextureResource(
+        gfx::TextureResource&, Size, const void*, gfx::TexturePixelType, gfx::TextureChannelDataType) override {}
+    void updateTextureResourceSub(gfx::TextureResource&,
+                                  uint16_t,
+                                  uint16_t,
+                                  Size,
+                                  const void*,
+                                  gfx::TexturePixelType,
+                                  gfx::TextureChannelDataType) override {}
+};
+
+using Vertex = gfx::VertexType<attributes::radius>;
+using Binder = SourceFunctionPaintPropertyBinder<float, attributes::radius>;
+
+constexpr std::size_t verticesPerFeature = 2;
+
+// Four features with two vertices each, whose radius is the "radius" feature state, or 1 by default.
+struct BinderTest {
+    BinderTest()
+        : binder(style::PropertyExpression<float>(style::expression::dsl::createExpression(
+                                                      R"(["number", ["coalesce", ["feature-state", "radius"], 1]])")),
+                 0.0f) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            features.emplace_back(static_cast<uint64_t>(i), FeatureType::Point, GeometryCollection{}, PropertyMap{});
+        }
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            binder.populateVertexVector(
+                features[i], (i + 1) * verticesPerFeature, i, {}, std::nullopt, CanonicalTileID(0, 0, 0), {});
+        }
+    }
+
+    void setRadius(std::size_t i, double radius) {
+        binder.updateVertexVector(
+            i * verticesPerFeature, (i + 1) * verticesPerFeature, features[i], FeatureState{{"radius", radius}});
+    }
+
+    std::vector<StubGeometryTileFeature> features;
+    Binder binder;
+};
+
+StubUploadPass::Update vertices(std::size_t first, std::size_t count) {
+    return {first * sizeof(Vertex), count * sizeof(Vertex)};
+}
+
+} // namespace
+
+TEST(DirtyVertexRanges, Coalesce) {
+    StubUploadPass uploadPass;
+    gfx::VertexVector<Vertex> vertexVector;
+    vertexVector.extend(16, Vertex{{{0.0f}}});
+    auto buffer = uploadPass.createVertexBuffer(gfx::VertexVector<Vertex>(vertexVector));
+
+    DirtyVertexRanges ranges;
+    ranges.add(8, 10);
+    // Adjacent, overlapping and empty ranges, added out of order.
+    ranges.add(2, 4);
+    ranges.add(0, 2);
+    ranges.add(3, 6);
+    ranges.add(12, 12);
+    // A range contained in the previous one.
+    ranges.add(11, 16);
+    ranges.add(12, 14);
+    ranges.upload(uploadPass, buffer, vertexVector);
+
+    EXPECT_EQ(std::vector<StubUploadPass::Update>({vertices(0, 6), vertices(8, 2), vertices(11, 5)}),
+              uploadPass.vertexBufferUpdates);
+
+    // Uploaded ranges are forgotten.
+    uploadPass.vertexBufferUpdates.clear();
+    ranges.upload(uploadPass, buffer, vertexVector);
+    EXPECT_TRUE(uploadPass.vertexBufferUpdates.empty());
+}
+
+TEST(PaintPropertyBinder, FirstUploadCreatesBuffer) {
+    StubUploadPass uploadPass;
+    BinderTest test;
+
+    // Changes made before the buffer exists are part of the full upload.
+    test.setRadius(1, 2.0);
+    test.binder.upload(uploadPass);
+    EXPECT_EQ(std::vector<std::size_t>({4 * verticesPerFeature * sizeof(Vertex)}), uploadPass.createdVertexBuffers);
+    EXPECT_TRUE(uploadPass.vertexBufferUpdates.empty());
+
+    test.binder.upload(uploadPass);
+    EXPECT_EQ(1u, uploadPass.createdVertexBuffers.size());
+    EXPECT_TRUE(uploadPass.vertexBufferUpdates.empty());
+}
+
+TEST(PaintPropertyBinder, UploadChangedFeatures) {
+    StubUploadPass uploadPass;
+    BinderTest test;
+    test.binder.upload(uploadPass);
+
+    // Consecutive features are uploaded as a single range.
+    test.setRadius(0, 2.0);
+    test.setRadius(1, 3.0);
+    test.setRadius(3, 4.0);
+    test.binder.upload(uploadPass);
+    EXPECT_EQ(1u, uploadPass.createdVertexBuffers.size());
+    EXPECT_EQ(std::vector<StubUploadPass::Update>({vertices(0, 2 * verticesPerFeature),
+                                                   vertices(3 * verticesPerFeature, verticesPerFeature)}),
+              uploadPass.vertexBufferUpdates);
+}
+
+TEST(PaintPropertyBinder, SkipUnchangedFeatures) {
+    StubUploadPass uploadPass;
+    BinderTest test;
+    test.setRadius(2, 2.0);
+    test.binder.upload(uploadPass);
+
+    // Feature 0 evaluates to its default, feature 2 to its current value.
+    test.setRadius(0, 1.0);
+    test.setRadius(2, 2.0);
+    test.binder.upload(uploadPass);
+    EXPECT_TRUE(uploadPass.vertexBufferUpdates.empty());
+
+    test.setRadius(2, 1.0);
+    test.binder.upload(uploadPass);
+    EXPECT_EQ(std::vector<StubUploadPass::Update>({vertices(2 * verticesPerFeature, verticesPerFeature)}),
+              uploadPass.vertexBufferUpdates);
+}
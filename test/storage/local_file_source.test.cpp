@@ -1,3 +1,4 @@
+#include <mbgl/storage/local_file_request.hpp>
 #include <mbgl/storage/local_file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/resource_options.hpp>
@@ -76,6 +77,48 @@ TEST(LocalFileSource, NonEmptyFile) {
     loop.run();
 }
 
+TEST(LocalFileSource, MappedTiles) {
+    util::RunLoop loop;
+
+    LocalFileSource fs(ResourceOptions::Default(), ClientOptions());
+    const std::string url = toAbsoluteURL("../../map/issue12432/0-0-0.mvt");
+    std::size_t responses = 0;
+
+    // Large tiles are mapped, so the buffer isn't backed by a string.
+    std::unique_ptr<AsyncRequest> tileReq = fs.request({Resource::Tile, url}, [&](Response res) {
+        tileReq.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data);
+        EXPECT_LE(MIN_MAPPED_TILE_SIZE, res.data.size());
+#ifndef _WIN32
+        EXPECT_NE(res.data.data(), res.data->data());
+#endif
+        if (++responses == 3) loop.stop();
+    });
+
+    // Small tiles and other resources are read.
+    std::unique_ptr<AsyncRequest> smallTileReq =
+        fs.request({Resource::Tile, toAbsoluteURL("nonempty")}, [&](Response res) {
+            smallTileReq.reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data);
+            EXPECT_EQ("content is here\n", *res.data);
+            EXPECT_EQ(res.data.data(), res.data->data());
+            if (++responses == 3) loop.stop();
+        });
+
+    std::unique_ptr<AsyncRequest> otherReq = fs.request({Resource::Unknown, url}, [&](Response res) {
+        otherReq.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data);
+        EXPECT_LE(MIN_MAPPED_TILE_SIZE, res.data.size());
+        EXPECT_EQ(res.data.data(), res.data->data());
+        if (++responses == 3) loop.stop();
+    });
+
+    loop.run();
+}
+
 TEST(LocalFileSource, NonExistentFile) {
     util::RunLoop loop;
 
@@ -1,10 +1,12 @@
 #include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/resource_options.hpp>
+#include <mbgl/storage/sqlite3.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/run_loop.hpp>
 
 #include <climits>
+#include <cstdio>
 #include <gtest/gtest.h>
 
 #if defined(WIN32)
@@ -138,3 +140,76 @@ TEST(MBTilesFileSource, NonExistentTile) {
 
     loop.run();
 }
+
+// Concurrent tile requests are all answered, whichever reader and batch serves them
+TEST(MBTilesFileSource, Tiles) {
+    util::RunLoop loop;
+
+    MBTilesFileSource mbtiles(ResourceOptions::Default(), ClientOptions());
+
+    const std::string url = toAbsoluteURL("geography-class-png.mbtiles?file={z}/{x}/{y}.png");
+    std::vector<std::unique_ptr<AsyncRequest>> requests;
+    std::size_t pending = 0;
+    std::size_t found = 0;
+    for (int32_t x = 0; x < 2; ++x) {
+        for (int32_t y = 0; y < 2; ++y) {
+            ++pending;
+            requests.push_back(
+                mbtiles.request(Resource::tile(url, 1.0, x, y, 1, Tileset::Scheme::XYZ), [&](Response res) {
+                    EXPECT_EQ(nullptr, res.error);
+                    EXPECT_EQ(res.noContent, !res.data);
+                    if (res.data) ++found;
+                    if (--pending == 0) loop.stop();
+                }));
+        }
+    }
+    // A tile outside of the archive.
+    ++pending;
+    requests.push_back(mbtiles.request(Resource::tile(url, 1.0, 0, 0, 30, Tileset::Scheme::XYZ), [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        EXPECT_TRUE(res.noContent);
+        if (--pending == 0) loop.stop();
+    }));
+
+    loop.run();
+    EXPECT_EQ(4u, found);
+}
+
+// A tile that fails to load is answered with an error, without failing the other tiles
+TEST(MBTilesFileSource, CorruptTile) {
+    util::RunLoop loop;
+
+    const std::string path = "test/fixtures/storage/mbtiles/corrupt_tile.mbtiles";
+    std::remove(path.c_str());
+    {
+        auto db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate);
+        db.exec("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB)");
+        mapbox::sqlite::Statement insert{db, "INSERT INTO tiles VALUES (1, ?1, 0, ?2)"};
+        const std::vector<std::vector<uint8_t>> tiles{{'t', 'i', 'l', 'e'}, {0x1f, 0x8b, 0x00, 0x00}};
+        for (std::size_t x = 0; x < tiles.size(); ++x) {
+            mapbox::sqlite::Query query{insert};
+            query.bind(1, static_cast<int64_t>(x));
+            query.bindBlob(2, tiles[x]);
+            query.run();
+        }
+    }
+
+    MBTilesFileSource mbtiles(ResourceOptions::Default(), ClientOptions());
+
+    const std::string url = toAbsoluteURL("corrupt_tile.mbtiles?file={z}/{x}/{y}.pbf");
+    std::size_t pending = 2;
+    auto valid = mbtiles.request(Resource::tile(url, 1.0, 0, 1, 1, Tileset::Scheme::XYZ), [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        EXPECT_TRUE(res.data && *res.data == "tile");
+        if (--pending == 0) loop.stop();
+    });
+    // Not a valid gzip stream.
+    auto corrupt = mbtiles.request(Resource::tile(url, 1.0, 1, 1, 1, Tileset::Scheme::XYZ), [&](Response res) {
+        EXPECT_TRUE(res.error && res.error->reason == Response::Error::Reason::Other);
+        EXPECT_FALSE(res.data);
+        if (--pending == 0) loop.stop();
+    });
+
+    loop.run();
+    std::remove(path.c_str());
+}
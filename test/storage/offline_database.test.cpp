@@ -1218,6 +1218,62 @@ TEST(OfflineDatabase, GetRegionCompletedStatus) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, RegionTileCursor) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    OfflineTilePyramidRegionDefinition definition{
+        "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, false};
+    OfflineRegionMetadata metadata;
+    auto region = db.createRegion(definition, metadata);
+    ASSERT_TRUE(region);
+
+    const std::string urlTemplate = "http://example.com/{z}/{x}/{y}.pbf";
+    EXPECT_FALSE(db.getRegionTileCursor(region->getID(), urlTemplate));
+
+    OfflineRegionTileCursor cursor;
+    cursor.z = 5;
+    cursor.index = 3;
+    cursor.completedTileCount = 2;
+    cursor.completedTileSize = 1024;
+    db.putRegionTileCursor(region->getID(), urlTemplate, cursor);
+
+    cursor.index = 4;
+    db.putRegionTileCursor(region->getID(), urlTemplate, cursor);
+
+    auto saved = db.getRegionTileCursor(region->getID(), urlTemplate);
+    ASSERT_TRUE(saved);
+    EXPECT_EQ(5u, saved->z);
+    EXPECT_EQ(4u, saved->index);
+    EXPECT_EQ(2u, saved->completedTileCount);
+    EXPECT_EQ(1024u, saved->completedTileSize);
+    EXPECT_FALSE(db.getRegionTileCursor(region->getID(), "http://example.com/other/{z}/{x}/{y}.pbf"));
+
+    // Invalidating the region makes its next download go through all tiles again.
+    EXPECT_FALSE(db.invalidateRegion(region->getID()));
+    EXPECT_FALSE(db.getRegionTileCursor(region->getID(), urlTemplate));
+
+    db.putRegionTileCursor(region->getID(), urlTemplate, cursor);
+    db.deleteRegionTileCursors(region->getID());
+    EXPECT_FALSE(db.getRegionTileCursor(region->getID(), urlTemplate));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
+TEST(OfflineDatabase, RegionTileCursorReadOnlyMode) {
+    FixtureLog log;
+    OfflineDatabase db(":memory:", fixture::tileServerOptions);
+    OfflineTilePyramidRegionDefinition definition{
+        "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 2.0, false};
+    auto region = db.createRegion(definition, OfflineRegionMetadata());
+    ASSERT_TRUE(region);
+
+    // A database without tile cursors has none to read, even when it can't be written to.
+    db.reopenDatabaseReadOnly(true /*readOnly*/);
+    EXPECT_FALSE(db.getRegionTileCursor(region->getID(), "http://example.com/{z}/{x}/{y}.pbf"));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, HasRegionResource) {
     FixtureLog log;
     OfflineDatabase db(":memory:", fixture::tileServerOptions);
@@ -1352,7 +1408,9 @@ TEST(OfflineDatabase, BatchInsertion) {
     }
 
     OfflineRegionStatus status;
-    db.putRegionResources(region->getID(), resources, status);
+    auto sizes = db.putRegionResources(region->getID(), resources, status);
+    ASSERT_TRUE(sizes);
+    EXPECT_EQ(100u, sizes->size());
 
     for (uint32_t i = 1; i <= 100; i++) {
         EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/"s + util::toString(i)))));
@@ -1383,8 +1441,9 @@ TEST(OfflineDatabase, BatchInsertionMapboxTileCountExceeded) {
     try {
         db.putRegionResources(region->getID(), resources, status);
         EXPECT_FALSE(true);
-    } catch (const MapboxTileLimitExceededException&) {
-        // Expected
+    } catch (const MapboxTileLimitExceededException& ex) {
+        // The resources stored before the limit was reached.
+        EXPECT_EQ(2u, ex.storedSizes.size());
     }
 
     EXPECT_EQ(0u, status.completedTileCount);
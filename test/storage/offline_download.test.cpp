@@ -866,15 +866,24 @@ TEST(OfflineDownload, DiskFull) {
     };
 
     auto observer = std::make_unique<MockObserver>();
+    bool hasStoreError = false;
+
+    observer->responseErrorFn = [&](Response::Error error) {
+        EXPECT_EQ(Response::Error::Reason::Other, error.reason);
+        EXPECT_EQ("Can't store region resources: database or disk is full", error.message);
+        hasStoreError = true;
+    };
 
     observer->statusChangedFn = [&](OfflineRegionStatus status) {
-        EXPECT_EQ(OfflineRegionDownloadState::Active, status.downloadState);
         EXPECT_EQ(0u, status.completedResourceCount);
         EXPECT_EQ(0u, status.completedResourceSize);
         EXPECT_EQ(hasRequestedStyle, status.requiredResourceCountIsPrecise);
         EXPECT_FALSE(status.complete());
 
-        if (hasRequestedStyle) {
+        // The resources that can't be stored stop the download instead of leaving it pending.
+        if (status.downloadState == OfflineRegionDownloadState::Inactive) {
+            EXPECT_TRUE(hasRequestedStyle);
+            EXPECT_TRUE(hasStoreError);
             EXPECT_EQ(1u,
                       log.count(warning(ResultCode::Full, "Can't write region resources: database or disk is full")));
             EXPECT_EQ(0u, log.uncheckedCount());
@@ -1046,6 +1055,61 @@ TEST(OfflineDownload, InterruptAndResume) {
     test.loop.run();
 }
 
+TEST(OfflineDownload, ResumeFromTileCursor) {
+    OfflineTest test;
+    auto region = test.createRegion();
+    ASSERT_TRUE(region);
+    OfflineDownload download(region->getID(),
+                             OfflineTilePyramidRegionDefinition(
+                                 "http://127.0.0.1:3000/style.json", LatLngBounds::world(), 0.0, 2.0, 1.0, true),
+                             test.db,
+                             test.fileSource);
+
+    // A previous download went through zoom levels 0 and 1, and one of their five tiles was not found.
+    const std::string urlTemplate = "http://127.0.0.1:3000/{z}-{x}-{y}.vector.pbf";
+    OfflineRegionTileCursor cursor;
+    cursor.z = 2;
+    cursor.index = 0;
+    cursor.completedTileCount = 4;
+    cursor.completedTileSize = 400;
+    test.db.putRegionTileCursor(region->getID(), urlTemplate, cursor);
+
+    test.fileSource.styleResponse = [&](const Resource&) {
+        return test.response("inline_source.style.json");
+    };
+
+    std::size_t tileRequests = 0;
+    test.fileSource.tileResponse = [&](const Resource& resource) {
+        const Resource::TileData& tile = *resource.tileData;
+        EXPECT_EQ(urlTemplate, tile.urlTemplate);
+        EXPECT_EQ(2, tile.z);
+        tileRequests++;
+        return test.response("0-0-0.vector.pbf");
+    };
+
+    auto observer = std::make_unique<MockObserver>();
+
+    observer->statusChangedFn = [&](OfflineRegionStatus status) {
+        if (status.complete()) {
+            EXPECT_EQ(16u, tileRequests);
+            EXPECT_EQ(21u, status.requiredTileCount);
+            EXPECT_EQ(21u, status.requiredResourceCount);
+            EXPECT_EQ(20u, status.completedTileCount);
+            EXPECT_EQ(21u, status.completedResourceCount);
+            EXPECT_EQ(test.size + 400, status.completedResourceSize);
+            test.loop.stop();
+        }
+    };
+
+    download.setObserver(std::move(observer));
+    download.setState(OfflineRegionDownloadState::Active);
+
+    test.loop.run();
+
+    // The cursor is removed once the download completes, so that activating it again checks all tiles.
+    EXPECT_FALSE(test.db.getRegionTileCursor(region->getID(), urlTemplate));
+}
+
 TEST(OfflineDownload, NoFreezingOnCachedTilesAndNewStyle) {
     OfflineTest test;
     auto region = test.createRegion();
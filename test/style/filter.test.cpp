@@ -11,6 +11,7 @@
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion/filter.hpp>
+#include <mbgl/tile/geojson_tile_data.hpp>
 #include <mbgl/util/rapidjson.hpp>
 
 #include <rapidjson/writer.h>
@@ -209,6 +210,65 @@ TEST(Filter, PropertyExpression) {
     ASSERT_FALSE(filter("[\"==\", [\"get\", \"two\"], 4]", {{"two", int64_t(2)}}));
 }
 
+TEST(Filter, PropertyLookup) {
+    // Comparisons with a literal look the property up directly, with the semantics of ["get", key].
+    ASSERT_TRUE(filter(R"(["==", 2, ["get", "two"]])", {{"two", uint64_t(2)}}));
+    ASSERT_TRUE(filter(R"(["==", ["get", "two"], 2])", {{"two", 2.0}}));
+    ASSERT_FALSE(filter(R"(["==", ["get", "two"], "2"])", {{"two", int64_t(2)}}));
+    ASSERT_TRUE(filter(R"(["!=", ["get", "two"], "2"])", {{"two", int64_t(2)}}));
+    ASSERT_TRUE(filter(R"(["==", ["get", "missing"], null])", {{"two", int64_t(2)}}));
+    ASSERT_FALSE(filter(R"(["!=", ["get", "missing"], null])", {{"two", int64_t(2)}}));
+    ASSERT_FALSE(filter(R"(["==", ["get", "bool"], 1])", {{"bool", true}}));
+
+    ASSERT_TRUE(filter(R"(["in", ["get", "two"], ["literal", [1, 2, "three"]]])", {{"two", int64_t(2)}}));
+    ASSERT_TRUE(filter(R"(["in", ["get", "two"], ["literal", [1, 2, "three"]]])", {{"two", std::string("three")}}));
+    ASSERT_FALSE(filter(R"(["in", ["get", "two"], ["literal", [1, "2", true]]])", {{"two", int64_t(2)}}));
+    ASSERT_TRUE(filter(R"(["in", ["get", "bool"], ["literal", [1, true]]])", {{"bool", true}}));
+    ASSERT_FALSE(filter(R"(["in", ["get", "bool"], ["literal", [1, true]]])", {{"bool", false}}));
+    ASSERT_FALSE(filter(R"(["in", ["get", "missing"], ["literal", [1, 2]]])", {{"two", int64_t(2)}}));
+
+    ASSERT_TRUE(filter(R"(["match", ["get", "two"], 2, true, false])", {{"two", uint64_t(2)}}));
+    ASSERT_FALSE(filter(R"(["match", ["get", "two"], 2, true, false])", {{"two", 2.5}}));
+    ASSERT_FALSE(filter(R"(["match", ["get", "two"], 2, true, false])", {{"two", std::string("2")}}));
+    ASSERT_TRUE(filter(R"(["match", ["get", "name"], ["a", "b"], true, false])", {{"name", std::string("b")}}));
+    ASSERT_FALSE(filter(R"(["match", ["get", "name"], ["a", "b"], true, false])", {{"two", int64_t(2)}}));
+}
+
+TEST(Filter, Select) {
+    const mapbox::geometry::point<int16_t> point{0, 0};
+    const mapbox::geometry::line_string<int16_t> line{{0, 0}, {1, 1}};
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back({point, PropertyMap{{"class", std::string("primary")}, {"rank", int64_t(1)}}});
+    features.push_back({point, PropertyMap{{"class", std::string("primary")}, {"rank", int64_t(3)}}});
+    features.push_back({line, PropertyMap{{"class", std::string("service")}, {"rank", 1.0}}});
+    features.push_back({point, PropertyMap{{"rank", std::vector<mbgl::Value>{int64_t(1)}}}});
+    features.push_back({point, PropertyMap{}});
+    const GeoJSONTileLayer layer(std::make_shared<const mapbox::feature::feature_collection<int16_t>>(features));
+
+    for (const char* json : {R"(["==", ["get", "rank"], 1])",
+                             R"(["in", ["get", "rank"], ["literal", [1, 2]]])",
+                             R"(["all", ["==", ["get", "class"], "primary"], ["<", ["get", "rank"], 2]])",
+                             R"(["all", ["==", ["geometry-type"], "Point"], ["!=", ["get", "class"], "service"]])",
+                             R"(["all", ["==", ["get", "class"], "none"], ["==", ["get", "rank"], 1]])",
+                             R"(["any", ["==", ["get", "rank"], 3], ["==", ["get", "class"], "service"]])",
+                             R"(["==", "class", "primary"])"}) {
+        conversion::Error error;
+        std::optional<Filter> filter = conversion::convertJSON<Filter>(json, error);
+        ASSERT_TRUE(bool(filter)) << json;
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < layer.featureCount(); ++i) {
+            const std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(i);
+            if ((*filter)(expression::EvaluationContext(0.0f, feature.get()))) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(expected, filter->select(expression::EvaluationContext(0.0f, nullptr), layer)) << json;
+    }
+
+    EXPECT_EQ(std::vector<std::size_t>({0, 1, 2, 3, 4}), Filter().select(expression::EvaluationContext(), layer));
+}
+
 TEST(Filter, LegacyProperty) {
     ASSERT_TRUE(filter("[\"<=\", \"two\", 2]", {{"two", int64_t(2)}}));
     ASSERT_FALSE(filter("[\"==\", \"two\", 4]", {{"two", int64_t(2)}}));
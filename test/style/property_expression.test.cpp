@@ -6,6 +6,7 @@
 #include <mbgl/renderer/property_evaluation_parameters.hpp>
 #include <mbgl/style/expression/dsl.hpp>
 #include <mbgl/style/expression/format_section_override.hpp>
+#include <mbgl/tile/geojson_tile_data.hpp>
 
 #include <mbgl/util/geojson.hpp>
 #include <mbgl/util/io.hpp>
@@ -67,6 +68,35 @@ TEST(PropertyExpression, Defaults) {
     EXPECT_EQ(2.0f, PropertyExpression<float>(number(get("property"))).evaluate(oneString, 2.0f));
 }
 
+TEST(PropertyExpression, EvaluateLayer) {
+    const mapbox::geometry::point<int16_t> point{0, 0};
+    mapbox::feature::feature_collection<int16_t> features;
+    features.push_back({point, PropertyMap{{"property", uint64_t(1)}}});
+    features.push_back({point, PropertyMap{{"property", 4.5}}});
+    features.push_back({point, PropertyMap{{"property", "1"s}}});
+    features.push_back({point, PropertyMap{}});
+    features.push_back({point, PropertyMap{{"property", int64_t(-2)}}});
+    const GeoJSONTileLayer layer(std::make_shared<const mapbox::feature::feature_collection<int16_t>>(features));
+    const std::vector<std::size_t> selection{0, 1, 2, 4};
+
+    std::vector<PropertyExpression<float>> expressions;
+    // Property reads, which are looked up directly.
+    expressions.emplace_back(get("property"));
+    expressions.emplace_back(number(get("property")));
+    expressions.emplace_back(number(get("property")), 3.0f);
+    // Expressions that are evaluated for each feature.
+    expressions.emplace_back(number(get("property"), literal(5.0)));
+    expressions.emplace_back(interpolate(linear(), number(get("property")), 0.0, literal(0.0), 10.0, literal(10.0)));
+
+    for (const auto& expression : expressions) {
+        std::vector<float> expected;
+        for (const std::size_t i : selection) {
+            expected.push_back(expression.evaluate(*layer.getFeature(i), 2.0f));
+        }
+        EXPECT_EQ(expected, expression.evaluate(EvaluationContext(), layer, selection, 2.0f));
+    }
+}
+
 TEST(PropertyExpression, ZoomInterpolation) {
     EXPECT_EQ(40.0f,
               PropertyExpression<float>(interpolate(linear(),
@@ -193,8 +223,8 @@ TEST(PropertyExpression, FormatSectionOverride) {
 }
 
 TEST(PropertyExpression, ImageExpression) {
-    const std::set<std::string> emptySet;
-    const std::set<std::string> availableImages = {"maki-11", "airport-11", "bicycle-15"};
+    const AvailableImages emptySet;
+    const AvailableImages availableImages = {"maki-11", "airport-11", "bicycle-15"};
 
     // evaluation test without available images
     {
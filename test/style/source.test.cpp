@@ -45,6 +45,7 @@
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <optional>
 #include <gmock/gmock.h>
@@ -74,7 +75,8 @@ public:
                 annotationManager.makeWeakPtr(),
                 imageManager,
                 glyphManager,
-                0};
+                0,
+                nullptr};
     };
 
     SourceTest() {
@@ -830,6 +832,23 @@ TEST(Source, InvisibleSourcesTileNecessity) {
     renderSource->update(initialized.baseImpl, layers, true, false, test.tileParameters());
 }
 
+TEST(Source, SourceTileCacheMaxBytes) {
+    VectorSource source("source", Tileset{{"tiles"}});
+    EXPECT_EQ(std::nullopt, source.getTileCacheMaxBytes());
+
+    auto baseImpl = source.baseImpl;
+    source.setTileCacheMaxBytes(1024u);
+    EXPECT_NE(baseImpl, source.baseImpl) << "Source impl was updated";
+    EXPECT_EQ(1024u, *source.getTileCacheMaxBytes());
+
+    baseImpl = source.baseImpl;
+    source.setTileCacheMaxBytes(1024u); // Set the same budget again.
+    EXPECT_EQ(baseImpl, source.baseImpl) << "Source impl was not updated";
+
+    source.setTileCacheMaxBytes(std::nullopt);
+    EXPECT_EQ(std::nullopt, source.getTileCacheMaxBytes());
+}
+
 TEST(Source, SourceMinimumUpdateInterval) {
     SourceTest test;
     VectorSource initialized("source", Tileset{{"tiles"}});
@@ -945,6 +964,146 @@ TEST(Source, GeoJSONSourceTilesAfterDataReset) {
     EXPECT_TRUE(renderSource.isLoaded()); // Tiles are reset in static mode.
 }
 
+TEST(Source, GeoJSONSourceUpdateById) {
+    SourceTest test;
+
+    const auto point = [](uint64_t id, double lon, double lat) {
+        GeoJSONFeature feature{mapbox::geometry::point<double>(lon, lat)};
+        feature.id = id;
+        return feature;
+    };
+
+    GeoJSONSource source("source");
+    source.setObserver(&test.styleObserver);
+    source.setGeoJSON(mapbox::feature::feature_collection<double>{point(1, -90.0, 45.0), point(2, 90.0, -45.0)});
+    auto initial = source.impl().getData().lock();
+    ASSERT_TRUE(initial);
+
+    // Remove the south-eastern feature, move the north-western one and add another next to it.
+    GeoJSONDiff diff;
+    diff.remove = {FeatureIdentifier(uint64_t(2))};
+    diff.add = {point(1, -90.0, 46.0), point(3, -91.0, 45.0)};
+    test.styleObserver.sourceChanged = [&](Source&) { test.end(); };
+    source.updateGeoJSON(diff);
+    test.run();
+
+    auto updated = source.impl().getData().lock();
+    ASSERT_TRUE(updated);
+    ASSERT_NE(initial, updated);
+    EXPECT_FALSE(initial->getChangedBoundsSince(*updated));
+
+    // The removed feature, the old and new positions of the moved one, and the added one.
+    auto changed = updated->getChangedBoundsSince(*initial);
+    ASSERT_TRUE(changed);
+    EXPECT_EQ(4u, changed->size());
+    for (const auto& box : *changed) {
+        // Nothing changed in the north-eastern quarter of the world.
+        EXPECT_FALSE(box.min.x >= 0.5 && box.max.y <= 0.5);
+    }
+
+    // Tiles are generated from the updated features.
+    std::size_t received = 0;
+    auto northWest = updated->getTile({1, 0, 0}, [&](GeoJSONData::TileFeatures features) {
+        EXPECT_EQ(2u, features.size());
+        if (++received == 2) test.end();
+    });
+    auto southEast = updated->getTile({1, 1, 1}, [&](GeoJSONData::TileFeatures features) {
+        EXPECT_TRUE(features.empty());
+        if (++received == 2) test.end();
+    });
+    test.run();
+
+    // Features without an id cannot be updated.
+    GeoJSONSource anonymous("anonymous");
+    anonymous.setObserver(&test.styleObserver);
+    anonymous.setGeoJSON(
+        mapbox::feature::feature_collection<double>{GeoJSONFeature{mapbox::geometry::point<double>(0.0, 0.0)}});
+    auto anonymousData = anonymous.impl().getData().lock();
+    test.styleObserver.sourceChanged = [&](Source&) { FAIL() << "Unexpected update"; };
+    anonymous.updateGeoJSON(diff);
+    EXPECT_EQ(anonymousData, anonymous.impl().getData().lock());
+    EXPECT_FALSE(anonymousData->getChangedBoundsSince(*updated));
+}
+
+TEST(Source, GeoJSONSourceUpdateReloadsTouchedTiles) {
+    SourceTest test;
+    test.transform.jumpTo(CameraOptions().withCenter(LatLng()).withZoom(1.0));
+    test.transformState = test.transform.getState();
+
+    // Counts the tasks of the data: the diffs and the generation of the tiles.
+    class CountingScheduler final : public Scheduler {
+    public:
+        void schedule(std::function<void()> fn) override {
+            ++scheduled;
+            sequenced->schedule(std::move(fn));
+        }
+        mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
+
+        std::atomic<std::size_t> scheduled{0};
+
+    private:
+        std::shared_ptr<Scheduler> sequenced = Scheduler::GetSequenced();
+        mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
+    };
+    auto scheduler = std::make_shared<CountingScheduler>();
+
+    const auto point = [](uint64_t id, double lon, double lat) {
+        GeoJSONFeature feature{mapbox::geometry::point<double>(lon, lat)};
+        feature.id = id;
+        return feature;
+    };
+
+    GeoJSONSource source("source");
+    source.setObserver(&test.styleObserver);
+    source.setGeoJSONData(GeoJSONData::create(
+        mapbox::feature::feature_collection<double>{point(1, -90.0, 45.0), point(2, 90.0, -45.0)},
+        GeoJSONOptions::defaultOptions(),
+        scheduler));
+    RenderGeoJSONSource renderSource{staticImmutableCast<GeoJSONSource::Impl>(source.baseImpl)};
+
+    CircleLayer layer("id", "source");
+    Immutable<LayerProperties> layerProperties = makeMutable<CircleLayerProperties>(
+        staticImmutableCast<CircleLayer::Impl>(layer.baseImpl));
+    std::vector<Immutable<LayerProperties>> layers{layerProperties};
+
+    // The four tiles of zoom level 1 are loaded.
+    static_cast<RenderSource&>(renderSource).update(source.baseImpl, layers, true, true, test.tileParameters());
+    EXPECT_EQ(4u, scheduler->scheduled.load());
+
+    // Moving a feature of the north-western tile only reloads that tile.
+    GeoJSONDiff diff;
+    diff.add = {point(1, -91.0, 46.0)};
+    test.styleObserver.sourceChanged = [&](Source&) { test.end(); };
+    source.updateGeoJSON(diff);
+    test.run();
+    scheduler->scheduled = 0;
+    static_cast<RenderSource&>(renderSource).update(source.baseImpl, layers, true, false, test.tileParameters());
+    EXPECT_EQ(1u, scheduler->scheduled.load());
+
+    // Removing all the features reloads every tile.
+    diff = {};
+    diff.removeAll = true;
+    source.updateGeoJSON(diff);
+    test.run();
+    scheduler->scheduled = 0;
+    static_cast<RenderSource&>(renderSource).update(source.baseImpl, layers, true, false, test.tileParameters());
+    EXPECT_EQ(4u, scheduler->scheduled.load());
+
+    // Features that are not owned by the data cannot be updated, as geojson-vt does not keep them.
+    const GeoJSON borrowed{mapbox::feature::feature_collection<double>{point(1, 0.0, 0.0)}};
+    source.setGeoJSON(borrowed);
+    auto borrowedData = source.impl().getData().lock();
+    test.styleObserver.sourceChanged = [&](Source&) { FAIL() << "Unexpected update"; };
+    source.updateGeoJSON(diff);
+    EXPECT_EQ(borrowedData, source.impl().getData().lock());
+
+    // A source without data ignores diffs rather than replacing its data.
+    GeoJSONSource empty("empty");
+    empty.setObserver(&test.styleObserver);
+    empty.updateGeoJSON(diff);
+    EXPECT_FALSE(empty.impl().getData().lock());
+}
+
 TEST(Source, SetMaxParentOverscaleFactor) {
     SourceTest test;
     test.transform.jumpTo(CameraOptions().withCenter(LatLng()).withZoom(8.0));
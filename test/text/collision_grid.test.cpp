@@ -0,0 +1,129 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/collision_grid.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+IndexedSubfeature makeFeature(std::size_t index) {
+    return {index, "layer", "bucket", index};
+}
+
+} // namespace
+
+TEST(CollisionGrid, QueryWithBoxes) {
+    CollisionGrid grid(100, 100, 10);
+    grid.insert(grid.addFeature(makeFeature(0), 1, 0), CollisionGrid::BBox{{4, 10}, {6, 30}});
+    grid.insert(grid.addFeature(makeFeature(1), 1, 0), CollisionGrid::BBox{{4, 10}, {30, 12}});
+    const auto circle = grid.addFeature(makeFeature(2), 2, 0);
+    grid.insert(circle, CollisionGrid::BCircle{{50, 50}, 10});
+    grid.insert(circle, CollisionGrid::BCircle{{60, 60}, 15});
+
+    EXPECT_EQ(4u, grid.size());
+    EXPECT_EQ(2u, grid.getFeature(circle).bucketInstanceId);
+
+    auto result = grid.queryWithBoxes({{4, 10}, {5, 11}});
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(0u, grid.getFeature(result[0].first).index);
+    EXPECT_EQ(1u, grid.getFeature(result[1].first).index);
+
+    result = grid.queryWithBoxes({{45, 45}, {55, 55}});
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(circle, result[0].first);
+    EXPECT_EQ(circle, result[1].first);
+    EXPECT_EQ((CollisionGrid::BBox{{40, 40}, {60, 60}}), result[0].second);
+
+    EXPECT_TRUE(grid.queryWithBoxes({{70, 10}, {90, 20}}).empty());
+}
+
+TEST(CollisionGrid, HitTestCollisionGroups) {
+    CollisionGrid grid(100, 100, 10);
+    grid.insert(grid.addFeature(makeFeature(0), 0, 1), CollisionGrid::BBox{{10, 10}, {20, 20}});
+    grid.insert(grid.addFeature(makeFeature(1), 0, 2), CollisionGrid::BCircle{{60, 60}, 10});
+
+    EXPECT_TRUE(grid.hitTest(CollisionGrid::BBox{{15, 15}, {25, 25}}));
+    EXPECT_TRUE(grid.hitTest(CollisionGrid::BBox{{15, 15}, {25, 25}}, uint16_t(1)));
+    EXPECT_FALSE(grid.hitTest(CollisionGrid::BBox{{15, 15}, {25, 25}}, uint16_t(2)));
+
+    EXPECT_TRUE(grid.hitTest(CollisionGrid::BCircle{{75, 60}, 6}));
+    EXPECT_FALSE(grid.hitTest(CollisionGrid::BCircle{{75, 60}, 6}, uint16_t(1)));
+    EXPECT_FALSE(grid.hitTest(CollisionGrid::BCircle{{80, 60}, 6}));
+
+    // Queries covering the whole grid hit everything in the group.
+    EXPECT_TRUE(grid.hitTest(CollisionGrid::BBox{{-10, -10}, {110, 110}}, uint16_t(2)));
+    EXPECT_FALSE(grid.hitTest(CollisionGrid::BBox{{-10, -10}, {110, 110}}, uint16_t(3)));
+}
+
+TEST(CollisionGrid, ReusesReleasedStorage) {
+    {
+        CollisionGrid grid(100, 100, 10);
+        for (std::size_t i = 0; i < 20; ++i) {
+            grid.insert(grid.addFeature(makeFeature(i), 0, 0), CollisionGrid::BBox{{0, 0}, {90, 90}});
+        }
+    }
+
+    CollisionGrid grid(200, 50, 25);
+    EXPECT_TRUE(grid.empty());
+    EXPECT_FALSE(grid.hitTest(CollisionGrid::BBox{{10, 10}, {20, 20}}));
+    EXPECT_TRUE(grid.queryWithBoxes({{-10, -10}, {300, 300}}).empty());
+
+    grid.insert(grid.addFeature(makeFeature(0), 0, 0), CollisionGrid::BBox{{150, 10}, {160, 20}});
+    EXPECT_TRUE(grid.hitTest(CollisionGrid::BBox{{155, 15}, {170, 30}}));
+}
+
+TEST(CollisionGrid, MatchesGridIndex) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-50.0f, 650.0f);
+    std::uniform_real_distribution<float> extent(1.0f, 80.0f);
+
+    GridIndex<IndexedSubfeature> reference(600, 400, 25);
+    CollisionGrid grid(600, 400, 25);
+
+    auto randomBox = [&] {
+        const float x = position(generator);
+        const float y = position(generator) * 2 / 3;
+        return CollisionGrid::BBox{{x, y}, {x + extent(generator), y + extent(generator) / 2}};
+    };
+    auto randomCircle = [&] {
+        return CollisionGrid::BCircle{{position(generator), position(generator) * 2 / 3}, extent(generator) / 4};
+    };
+
+    for (std::size_t i = 0; i < 500; ++i) {
+        const auto group = static_cast<uint16_t>(i % 3);
+        const auto handle = grid.addFeature(makeFeature(i), 0, group);
+        IndexedSubfeature feature(makeFeature(i), 0, group);
+        if (i % 2) {
+            const auto box = randomBox();
+            reference.insert(std::move(feature), box);
+            grid.insert(handle, box);
+        } else {
+            const auto circle = randomCircle();
+            reference.insert(std::move(feature), circle);
+            grid.insert(handle, circle);
+        }
+    }
+
+    const std::function<bool(const IndexedSubfeature&)> inGroup = [](const IndexedSubfeature& feature) {
+        return feature.collisionGroupId == 1;
+    };
+
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const auto box = randomBox();
+        const auto circle = randomCircle();
+        EXPECT_EQ(reference.hitTest(box), grid.hitTest(box));
+        EXPECT_EQ(reference.hitTest(box, inGroup), grid.hitTest(box, uint16_t(1)));
+        EXPECT_EQ(reference.hitTest(circle), grid.hitTest(circle));
+        EXPECT_EQ(reference.hitTest(circle, inGroup), grid.hitTest(circle, uint16_t(1)));
+
+        const auto expected = reference.queryWithBoxes(box);
+        const auto actual = grid.queryWithBoxes(box);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (std::size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_EQ(expected[j].first.index, grid.getFeature(actual[j].first).index);
+            EXPECT_EQ(expected[j].second, actual[j].second);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/glyph_atlas.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+Immutable<Glyph> makeGlyph(GlyphID id, uint32_t width, uint32_t height, uint8_t value = 255) {
+    auto glyph = makeMutable<Glyph>();
+    glyph->id = id;
+    glyph->bitmap = AlphaImage({width, height});
+    glyph->bitmap.fill(value);
+    glyph->metrics.width = width;
+    glyph->metrics.height = height;
+    return glyph;
+}
+
+} // namespace
+
+TEST(GlyphAtlas, AddGlyph) {
+    GlyphAtlas atlas;
+    EXPECT_TRUE(atlas.isEmpty());
+
+    auto position = atlas.addGlyph(1, makeGlyph(u'a', 10, 12));
+    ASSERT_TRUE(position);
+    // Glyphs are padded by one pixel on each side.
+    EXPECT_EQ(12, position->rect.w);
+    EXPECT_EQ(14, position->rect.h);
+    EXPECT_EQ(10u, position->metrics.width);
+    EXPECT_EQ(1u, atlas.size());
+    EXPECT_EQ(atlas.getPixelSize(), atlas.getAtlasImageForTests().size);
+
+    // The glyph bitmap is copied inside the padding.
+    const AlphaImage& image = atlas.getAtlasImageForTests();
+    const auto pixel = [&](uint32_t x, uint32_t y) {
+        return image.data[y * image.size.width + x];
+    };
+    EXPECT_EQ(0, pixel(position->rect.x, position->rect.y));
+    EXPECT_EQ(255, pixel(position->rect.x + 1, position->rect.y + 1));
+
+    // The same glyph in another font stack is packed separately.
+    auto other = atlas.addGlyph(2, makeGlyph(u'a', 10, 12));
+    ASSERT_TRUE(other);
+    EXPECT_FALSE(other->rect == position->rect);
+    EXPECT_EQ(2u, atlas.size());
+
+    // Glyphs without a bitmap are not packed.
+    EXPECT_FALSE(atlas.addGlyph(1, makeMutable<Glyph>()));
+    EXPECT_EQ(2u, atlas.size());
+}
+
+TEST(GlyphAtlas, ReferenceCounting) {
+    GlyphAtlas atlas;
+
+    const auto glyph = makeGlyph(u'a', 10, 12);
+    auto first = atlas.addGlyph(1, glyph);
+    auto second = atlas.addGlyph(1, glyph);
+    ASSERT_TRUE(first && second);
+    EXPECT_TRUE(first->rect == second->rect);
+    EXPECT_EQ(1u, atlas.size());
+
+    atlas.removeGlyph(1, *glyph);
+    EXPECT_TRUE(atlas.getGlyphPosition(1, u'a'));
+
+    atlas.removeGlyph(1, *glyph);
+    EXPECT_FALSE(atlas.getGlyphPosition(1, u'a'));
+    EXPECT_TRUE(atlas.isEmpty());
+
+    // Released space is cleared and reused.
+    const AlphaImage& image = atlas.getAtlasImageForTests();
+    EXPECT_EQ(0, image.data[(first->rect.y + 1) * image.size.width + first->rect.x + 1]);
+    auto reused = atlas.addGlyph(1, makeGlyph(u'b', 10, 12));
+    ASSERT_TRUE(reused);
+    EXPECT_EQ(first->rect.x, reused->rect.x);
+    EXPECT_EQ(first->rect.y, reused->rect.y);
+}
+
+TEST(GlyphAtlas, ReloadedGlyph) {
+    GlyphAtlas atlas;
+    const AlphaImage& image = atlas.getAtlasImageForTests();
+    const auto pixel = [&](const GlyphPosition& position) {
+        return image.data[(position.rect.y + 1) * image.size.width + position.rect.x + 1];
+    };
+
+    const auto glyph = makeGlyph(u'a', 10, 12, 100);
+    auto position = atlas.addGlyph(1, glyph);
+    ASSERT_TRUE(position);
+
+    // The same glyph id loaded again, e.g. from another glyph URL, is packed with its own pixels,
+    // while the old glyph keeps its position for the references it still has.
+    const auto reloaded = makeGlyph(u'a', 10, 12, 200);
+    auto reloadedPosition = atlas.addGlyph(1, reloaded);
+    ASSERT_TRUE(reloadedPosition);
+    EXPECT_FALSE(reloadedPosition->rect == position->rect);
+    EXPECT_TRUE(atlas.getGlyphPosition(1, u'a')->rect == reloadedPosition->rect);
+    EXPECT_EQ(100, pixel(*position));
+    EXPECT_EQ(200, pixel(*reloadedPosition));
+    EXPECT_EQ(2u, atlas.size());
+
+    atlas.removeGlyph(1, *glyph);
+    EXPECT_EQ(0, pixel(*position));
+    EXPECT_EQ(1u, atlas.size());
+    EXPECT_TRUE(atlas.getGlyphPosition(1, u'a'));
+
+    atlas.removeGlyph(1, *reloaded);
+    EXPECT_TRUE(atlas.isEmpty());
+}
+
+TEST(GlyphAtlas, MaximumSize) {
+    GlyphAtlas atlas;
+    atlas.setMaximumSize(256);
+
+    // 256x256 pixels fit 64 glyphs of 30x30 pixels once padded.
+    std::vector<Immutable<Glyph>> glyphs;
+    std::size_t packed = 0;
+    for (GlyphID id = 0; id < 80; ++id) {
+        glyphs.push_back(makeGlyph(id, 30, 30));
+        if (atlas.addGlyph(1, glyphs.back())) {
+            ++packed;
+        }
+    }
+    EXPECT_EQ(64u, packed);
+    EXPECT_EQ(Size(256, 256), atlas.getPixelSize());
+    EXPECT_FALSE(atlas.getGlyphPosition(1, 79));
+
+    // Once every glyph is released, the whole atlas can be used again.
+    for (const auto& glyph : glyphs) {
+        atlas.removeGlyph(1, *glyph);
+    }
+    EXPECT_TRUE(atlas.isEmpty());
+    EXPECT_TRUE(atlas.addGlyph(1, makeGlyph(0, 250, 250)));
+}
+
+TEST(GlyphAtlas, Grows) {
+    GlyphAtlas atlas;
+    const Size initialSize = atlas.getPixelSize();
+
+    std::vector<GlyphPosition> positions;
+    for (GlyphID id = 0; id < 256; ++id) {
+        auto position = atlas.addGlyph(1, makeGlyph(id, 24, 24));
+        ASSERT_TRUE(position);
+        positions.push_back(*position);
+    }
+
+    EXPECT_GT(atlas.getPixelSize().area(), initialSize.area());
+    EXPECT_EQ(atlas.getPixelSize(), atlas.getAtlasImageForTests().size);
+
+    // Growing the atlas does not move the glyphs packed before.
+    for (GlyphID id = 0; id < 256; ++id) {
+        auto position = atlas.getGlyphPosition(1, id);
+        ASSERT_TRUE(position);
+        EXPECT_TRUE(position->rect == positions[id].rect);
+    }
+}
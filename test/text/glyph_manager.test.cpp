@@ -135,11 +135,13 @@ public:
 
 class StubGlyphRequestor : public GlyphRequestor {
 public:
-    void onGlyphsAvailable(GlyphMap glyphs) override {
+    void onGlyphsAvailable(GlyphMap glyphs, GlyphPositions positions_) override {
+        positions = std::move(positions_);
         if (glyphsAvailable) glyphsAvailable(std::move(glyphs));
     }
 
     std::function<void(GlyphMap)> glyphsAvailable;
+    GlyphPositions positions;
 };
 
 class GlyphManagerTest {
@@ -199,6 +201,73 @@ TEST(GlyphManager, LoadingSuccess) {
     test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a', u'å', u' '}}});
 }
 
+TEST(GlyphManager, AtlasReferences) {
+    GlyphManagerTest test;
+
+    test.fileSource.glyphsResponse = [&](const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.requestor.glyphsAvailable = [&](GlyphMap) { test.end(); };
+
+    test.run("test/fixtures/resources/glyphs.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a', u'å'}}});
+
+    const FontStackHash fontStack = FontStackHasher()({{"Test Stack"}});
+    const auto& positions = test.requestor.positions.at(fontStack);
+    ASSERT_EQ(positions.size(), 2u);
+
+    GlyphAtlas& atlas = test.glyphManager.getGlyphAtlas();
+    auto position = atlas.getGlyphPosition(fontStack, u'a');
+    ASSERT_TRUE(position);
+    EXPECT_TRUE(position->rect == positions.at(u'a').rect);
+
+    // A second requestor shares the glyphs packed for the first one.
+    StubGlyphRequestor other;
+    test.glyphManager.getGlyphs(other, GlyphDependencies{{{{"Test Stack"}}, {u'a'}}}, test.fileSource);
+    EXPECT_TRUE(other.positions.at(fontStack).at(u'a').rect == position->rect);
+    EXPECT_EQ(2u, atlas.size());
+
+    test.glyphManager.removeRequestor(test.requestor);
+    EXPECT_TRUE(atlas.getGlyphPosition(fontStack, u'a'));
+    EXPECT_FALSE(atlas.getGlyphPosition(fontStack, u'å'));
+
+    test.glyphManager.removeRequestor(other);
+    EXPECT_TRUE(atlas.isEmpty());
+}
+
+TEST(GlyphManager, ReloadAfterURLChange) {
+    GlyphManagerTest test;
+
+    std::vector<std::string> urls;
+    test.fileSource.glyphsResponse = [&](const Resource& resource) {
+        urls.push_back(resource.url);
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    test.requestor.glyphsAvailable = [&](GlyphMap) { test.end(); };
+
+    const FontStackHash fontStack = FontStackHasher()({{"Test Stack"}});
+    test.run("https://example.com/first/{fontstack}/{range}.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a'}}});
+    ASSERT_EQ(1u, urls.size());
+    const auto first = test.requestor.positions.at(fontStack).at(u'a');
+
+    // Glyphs loaded from the previous URL are loaded again, and the requestor's reference moves to
+    // the new glyph.
+    test.run("https://example.com/second/{fontstack}/{range}.pbf", GlyphDependencies{{{{"Test Stack"}}, {u'a'}}});
+    ASSERT_EQ(2u, urls.size());
+    EXPECT_NE(urls[0], urls[1]);
+    const auto second = test.requestor.positions.at(fontStack).at(u'a');
+    EXPECT_FALSE(first.rect == second.rect);
+
+    GlyphAtlas& atlas = test.glyphManager.getGlyphAtlas();
+    EXPECT_EQ(1u, atlas.size());
+    EXPECT_TRUE(atlas.getGlyphPosition(fontStack, u'a')->rect == second.rect);
+}
+
 TEST(GlyphManager, LoadingFail) {
     GlyphManagerTest test;
 
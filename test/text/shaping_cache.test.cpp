@@ -0,0 +1,194 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/tagged_string.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+using namespace util;
+
+namespace {
+
+class ShapingCacheTest {
+public:
+    ShapingCacheTest() {
+        GlyphPosition glyphPosition;
+        glyphPosition.rect = {0, 0, 24, 24};
+        glyphPosition.metrics.width = 18;
+        glyphPosition.metrics.height = 18;
+        glyphPosition.metrics.left = 2;
+        glyphPosition.metrics.top = -8;
+        glyphPosition.metrics.advance = 21;
+
+        Glyph glyph;
+        glyph.id = u'中';
+        glyph.metrics = glyphPosition.metrics;
+
+        glyphs = {{FontStackHasher()(fontStack), {{u'中', Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph)))}}}};
+        glyphPositions = {{FontStackHasher()(fontStack), {{u'中', glyphPosition}}}};
+    }
+
+    std::optional<ShapingCache::Key> makeKey(const TaggedString& string, float maxWidth) const {
+        return makeKey(string, maxWidth, glyphs);
+    }
+
+    std::optional<ShapingCache::Key> makeKey(const TaggedString& string,
+                                             float maxWidth,
+                                             const GlyphMap& glyphMap) const {
+        return ShapingCache::makeKey(string,
+                                     glyphMap,
+                                     maxWidth,
+                                     ONE_EM,
+                                     style::SymbolAnchorType::Center,
+                                     style::TextJustifyType::Center,
+                                     0.0f,
+                                     {{0.0f, 0.0f}},
+                                     WritingModeType::Horizontal,
+                                     false);
+    }
+
+    Shaping shape(const TaggedString& string, float maxWidth) {
+        return getShaping(string,
+                          maxWidth,
+                          ONE_EM,
+                          style::SymbolAnchorType::Center,
+                          style::TextJustifyType::Center,
+                          0.0f,
+                          {{0.0f, 0.0f}},
+                          WritingModeType::Horizontal,
+                          bidi,
+                          glyphs,
+                          glyphPositions,
+                          imagePositions,
+                          16.0f,
+                          16.0f,
+                          false);
+    }
+
+    const std::vector<std::string> fontStack{{"font-stack"}};
+    const SectionOptions sectionOptions{1.0f, fontStack};
+    BiDi bidi;
+    GlyphMap glyphs;
+    GlyphPositions glyphPositions;
+    ImagePositions imagePositions;
+};
+
+} // namespace
+
+TEST(ShapingCache, HitAndMiss) {
+    ShapingCacheTest test;
+    ShapingCache cache(16);
+
+    const TaggedString string(u"中中中", test.sectionOptions);
+    const auto key = test.makeKey(string, 5 * ONE_EM);
+    ASSERT_TRUE(key);
+    EXPECT_FALSE(cache.get(*key, test.glyphPositions));
+
+    const Shaping shaping = test.shape(string, 5 * ONE_EM);
+    cache.put(*key, shaping);
+
+    auto cached = cache.get(*key, test.glyphPositions);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(shaping.positionedLines.size(), cached->positionedLines.size());
+    EXPECT_EQ(shaping.positionedLines[0].positionedGlyphs.size(), cached->positionedLines[0].positionedGlyphs.size());
+    EXPECT_EQ(shaping.left, cached->left);
+    EXPECT_EQ(shaping.right, cached->right);
+    EXPECT_EQ(shaping.top, cached->top);
+    EXPECT_EQ(shaping.bottom, cached->bottom);
+
+    // Another max width breaks the text differently.
+    EXPECT_FALSE(cache.get(*test.makeKey(string, 1 * ONE_EM), test.glyphPositions));
+    // So does another text.
+    EXPECT_FALSE(cache.get(*test.makeKey(TaggedString(u"中中", test.sectionOptions), 5 * ONE_EM), test.glyphPositions));
+
+    const auto stats = cache.getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(3u, stats.misses);
+    EXPECT_EQ(1u, stats.size);
+    EXPECT_EQ(16u, stats.capacity);
+}
+
+TEST(ShapingCache, GlyphPositions) {
+    ShapingCacheTest test;
+    ShapingCache cache(16);
+
+    const TaggedString string(u"中中", test.sectionOptions);
+    const auto key = test.makeKey(string, 5 * ONE_EM);
+    cache.put(*key, test.shape(string, 5 * ONE_EM));
+
+    // The glyph rects follow the atlas of the requesting tile.
+    GlyphPositions moved = test.glyphPositions;
+    moved.begin()->second.begin()->second.rect = {48, 24, 24, 24};
+    auto cached = cache.get(*key, moved);
+    ASSERT_TRUE(cached);
+    for (const auto& glyph : cached->positionedLines[0].positionedGlyphs) {
+        EXPECT_EQ(48, glyph.rect.x);
+        EXPECT_EQ(24, glyph.rect.y);
+    }
+
+    // Shapings of glyphs that are missing or have other metrics are not reused.
+    GlyphPositions changed = test.glyphPositions;
+    changed.begin()->second.begin()->second.metrics.advance = 24;
+    EXPECT_FALSE(cache.get(*key, changed));
+    EXPECT_FALSE(cache.get(*key, GlyphPositions()));
+}
+
+TEST(ShapingCache, Glyphs) {
+    ShapingCacheTest test;
+    ShapingCache cache(16);
+
+    const TaggedString string(u"中中", test.sectionOptions);
+    cache.put(*test.makeKey(string, 5 * ONE_EM), test.shape(string, 5 * ONE_EM));
+    EXPECT_TRUE(cache.get(*test.makeKey(string, 5 * ONE_EM), test.glyphPositions));
+
+    // A glyph with the same id and metrics loaded again, e.g. from another glyph URL, isn't the
+    // glyph the text was shaped with.
+    GlyphMap reloaded = test.glyphs;
+    Glyph glyph;
+    glyph.id = u'中';
+    glyph.metrics = test.glyphPositions.begin()->second.begin()->second.metrics;
+    reloaded.begin()->second.begin()->second = Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph)));
+    EXPECT_FALSE(cache.get(*test.makeKey(string, 5 * ONE_EM, reloaded), test.glyphPositions));
+
+    // Nor is a glyph that was missing when the text was shaped.
+    GlyphMap missing = test.glyphs;
+    missing.begin()->second.begin()->second = std::nullopt;
+    const auto missingKey = test.makeKey(string, 5 * ONE_EM, missing);
+    cache.put(*missingKey, test.shape(string, 5 * ONE_EM));
+    EXPECT_FALSE(*missingKey == *test.makeKey(string, 5 * ONE_EM));
+    EXPECT_TRUE(cache.get(*missingKey, test.glyphPositions));
+}
+
+TEST(ShapingCache, Images) {
+    ShapingCacheTest test;
+
+    TaggedString string(u"中", test.sectionOptions);
+    string.addImageSection("image");
+    EXPECT_FALSE(test.makeKey(string, 5 * ONE_EM));
+}
+
+TEST(ShapingCache, Eviction) {
+    ShapingCacheTest test;
+    ShapingCache cache(2);
+
+    const TaggedString one(u"中", test.sectionOptions);
+    const TaggedString two(u"中中", test.sectionOptions);
+    const TaggedString three(u"中中中", test.sectionOptions);
+
+    cache.put(*test.makeKey(one, 0.0f), test.shape(one, 0.0f));
+    cache.put(*test.makeKey(two, 0.0f), test.shape(two, 0.0f));
+    // Using the first shaping makes the second one the least recently used.
+    EXPECT_TRUE(cache.get(*test.makeKey(one, 0.0f), test.glyphPositions));
+    cache.put(*test.makeKey(three, 0.0f), test.shape(three, 0.0f));
+
+    EXPECT_TRUE(cache.get(*test.makeKey(one, 0.0f), test.glyphPositions));
+    EXPECT_FALSE(cache.get(*test.makeKey(two, 0.0f), test.glyphPositions));
+    EXPECT_TRUE(cache.get(*test.makeKey(three, 0.0f), test.glyphPositions));
+    EXPECT_EQ(2u, cache.getStats().size);
+
+    cache.setCapacity(0);
+    EXPECT_EQ(0u, cache.getStats().size);
+    cache.put(*test.makeKey(one, 0.0f), test.shape(one, 0.0f));
+    EXPECT_FALSE(cache.get(*test.makeKey(one, 0.0f), test.glyphPositions));
+}
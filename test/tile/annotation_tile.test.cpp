@@ -0,0 +1,153 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/fake_file_source.hpp>
+
+#include <mbgl/annotation/annotation_manager.hpp>
+#include <mbgl/annotation/annotation_tile.hpp>
+#include <mbgl/map/transform.hpp>
+#include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+class AnnotationTileTest {
+public:
+    AnnotationTileTest() {
+        style.loadJSON(util::read_file("test/fixtures/api/empty.json"));
+        annotationManager.onStyleLoaded();
+    }
+
+    // Creates the live tiles of zoom level `z`, indexed by x + y * 2^z.
+    void createTiles(uint8_t z) {
+        const uint32_t count = 1u << z;
+        for (uint32_t y = 0; y < count; ++y) {
+            for (uint32_t x = 0; x < count; ++x) {
+                tiles.push_back(std::make_unique<AnnotationTile>(OverscaledTileID(z, x, y), tileParameters));
+                tiles.back()->setLayers({});
+            }
+        }
+        waitForTiles();
+    }
+
+    void waitForTiles() {
+        for (const auto& tile : tiles) {
+            while (!tile->isComplete()) {
+                loop.runOnce();
+            }
+        }
+    }
+
+    // Tiles that were given new data since they were last complete.
+    std::vector<bool> reloadedTiles() const {
+        std::vector<bool> result;
+        for (const auto& tile : tiles) {
+            result.push_back(!tile->isComplete());
+        }
+        return result;
+    }
+
+    std::size_t featureCount(std::size_t tile, AnnotationID layerKey) {
+        const std::string sourceLayer = AnnotationManager::ShapeLayerID + util::toString(layerKey);
+        std::vector<Feature> result;
+        tiles.at(tile)->querySourceFeatures(result, {{{sourceLayer}}, {}});
+        return result.size();
+    }
+
+    std::shared_ptr<FileSource> fileSource = std::make_shared<FakeFileSource>();
+    TransformState transformState;
+    util::RunLoop loop;
+    style::Style style{fileSource, 1};
+    AnnotationManager annotationManager{style};
+    ImageManager imageManager;
+    GlyphManager glyphManager;
+
+    TileParameters tileParameters{1.0,
+                                  MapDebugOptions(),
+                                  transformState,
+                                  fileSource,
+                                  MapMode::Continuous,
+                                  annotationManager.makeWeakPtr(),
+                                  imageManager,
+                                  glyphManager,
+                                  0,
+                                  nullptr};
+
+    std::vector<std::unique_ptr<AnnotationTile>> tiles;
+};
+
+} // namespace
+
+// Changing an annotation only gives new data to the tiles the annotation covered or covers.
+TEST(AnnotationTile, UpdateChangedTiles) {
+    AnnotationTileTest test;
+
+    LineAnnotation northWest{LineString<double>{{{-120, 40}, {-60, 60}}}};
+    LineAnnotation southEast{LineString<double>{{{60, -40}, {120, -60}}}};
+    const AnnotationID first = test.annotationManager.addAnnotation(northWest);
+    test.annotationManager.addAnnotation(southEast);
+    test.annotationManager.updateData();
+
+    test.createTiles(1);
+    EXPECT_EQ(1u, test.featureCount(0, first));
+    EXPECT_EQ(0u, test.featureCount(1, first));
+    EXPECT_EQ(0u, test.featureCount(2, first));
+    EXPECT_EQ(1u, test.featureCount(3, first));
+
+    northWest.geometry = LineString<double>{{{-120, 30}, {-30, 30}}};
+    test.annotationManager.updateAnnotation(first, northWest);
+    test.annotationManager.updateData();
+    EXPECT_EQ(std::vector<bool>({true, false, false, false}), test.reloadedTiles());
+    test.waitForTiles();
+    EXPECT_EQ(1u, test.featureCount(0, first));
+
+    // Moving the line to another tile reloads both the tile it leaves and the one it enters.
+    northWest.geometry = LineString<double>{{{30, 30}, {120, 30}}};
+    test.annotationManager.updateAnnotation(first, northWest);
+    test.annotationManager.updateData();
+    EXPECT_EQ(std::vector<bool>({true, true, false, false}), test.reloadedTiles());
+    test.waitForTiles();
+    EXPECT_EQ(0u, test.featureCount(0, first));
+    EXPECT_EQ(1u, test.featureCount(1, first));
+    EXPECT_EQ(1u, test.featureCount(3, first));
+
+    test.annotationManager.removeAnnotation(first);
+    test.annotationManager.updateData();
+    EXPECT_EQ(std::vector<bool>({false, true, false, false}), test.reloadedTiles());
+    test.waitForTiles();
+}
+
+// A shape crossing the antimeridian is wrapped into the tiles on the other side of it.
+TEST(AnnotationTile, UpdateAntimeridianShape) {
+    AnnotationTileTest test;
+    test.createTiles(1);
+
+    LineAnnotation line{LineString<double>{{{170, 10}, {190, 10}}}};
+    const AnnotationID id = test.annotationManager.addAnnotation(line);
+    test.annotationManager.updateData();
+    EXPECT_EQ(std::vector<bool>({true, true, false, false}), test.reloadedTiles());
+    test.waitForTiles();
+    EXPECT_EQ(1u, test.featureCount(0, id));
+    EXPECT_EQ(1u, test.featureCount(1, id));
+
+    // Moving the line south and away from the antimeridian reloads the tiles on both sides of it.
+    line.geometry = LineString<double>{{{150, -10}, {170, -10}}};
+    test.annotationManager.updateAnnotation(id, line);
+    test.annotationManager.updateData();
+    EXPECT_EQ(std::vector<bool>({true, true, false, true}), test.reloadedTiles());
+    test.waitForTiles();
+    EXPECT_EQ(0u, test.featureCount(0, id));
+    EXPECT_EQ(0u, test.featureCount(1, id));
+    EXPECT_EQ(0u, test.featureCount(2, id));
+    EXPECT_EQ(1u, test.featureCount(3, id));
+}
@@ -38,7 +38,8 @@ public:
                                   annotationManager.makeWeakPtr(),
                                   imageManager,
                                   glyphManager,
-                                  0};
+                                  0,
+                                  nullptr};
 };
 
 TEST(CustomGeometryTile, InvokeFetchTile) {
@@ -13,9 +13,11 @@
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/async_request.hpp>
 #include <mbgl/util/run_loop.hpp>
 
 #include <memory>
+#include <optional>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -39,7 +41,8 @@ public:
                                   annotationManager.makeWeakPtr(),
                                   imageManager,
                                   glyphManager,
-                                  0};
+                                  0,
+                                  nullptr};
 };
 
 namespace {
@@ -49,9 +52,10 @@ public:
     FakeGeoJSONData(TileFeatures features_)
         : features(std::move(features_)) {}
 
-    void getTile(const CanonicalTileID&, const std::function<void(TileFeatures)>& fn) final {
+    std::unique_ptr<AsyncRequest> getTile(const CanonicalTileID&, const std::function<void(TileFeatures)>& fn) final {
         assert(fn);
         fn(features);
+        return nullptr;
     }
 
     Features getChildren(const std::uint32_t) final { return {}; }
@@ -135,3 +139,55 @@ TEST(GeoJSONTile, Issue9927) {
     ASSERT_TRUE(tile.isRenderable());
     ASSERT_TRUE(tile.layerPropertiesUpdated(layerProperties));
 }
+
+TEST(GeoJSONTile, ClusteredDataAsync) {
+    util::RunLoop loop;
+
+    mapbox::feature::feature_collection<double> features;
+    for (int i = 0; i < 100; ++i) {
+        features.push_back(
+            mapbox::feature::feature<double>{mapbox::geometry::point<double>(i * 0.01, i * 0.01), {}, {}});
+    }
+    Mutable<GeoJSONOptions> options = makeMutable<GeoJSONOptions>();
+    options->cluster = true;
+    auto data = GeoJSONData::create(features, std::move(options));
+    ASSERT_TRUE(data->getScheduler());
+
+    // Cluster tiles are generated on the scheduler and delivered on the calling thread.
+    bool received = false;
+    std::uint32_t clusterID = 0;
+    auto request = data->getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures tileFeatures) {
+        received = true;
+        ASSERT_EQ(1u, tileFeatures.size());
+        clusterID = static_cast<std::uint32_t>(tileFeatures[0].properties["cluster_id"].get<uint64_t>());
+        loop.stop();
+    });
+    EXPECT_TRUE(request);
+    EXPECT_FALSE(received);
+    loop.run();
+    EXPECT_TRUE(received);
+
+    // Cluster queries can be answered asynchronously as well.
+    std::optional<std::uint8_t> expansionZoom;
+    auto zoomRequest = data->requestClusterExpansionZoom(clusterID, [&](std::uint8_t zoom) {
+        expansionZoom = zoom;
+        loop.stop();
+    });
+    loop.run();
+    ASSERT_TRUE(expansionZoom);
+    EXPECT_EQ(data->getClusterExpansionZoom(clusterID), *expansionZoom);
+
+    // Destroying the request cancels it.
+    bool canceledCalled = false;
+    data->getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures) { canceledCalled = true; });
+    data->requestChildren(clusterID, [&](GeoJSONData::Features) { canceledCalled = true; });
+    bool lastCalled = false;
+    auto last = data->getTile({0, 0, 0}, [&](GeoJSONData::TileFeatures) {
+        lastCalled = true;
+        loop.stop();
+    });
+    // Replies arrive in order, so the canceled ones would have been delivered by now.
+    loop.run();
+    EXPECT_TRUE(lastCalled);
+    EXPECT_FALSE(canceledCalled);
+}
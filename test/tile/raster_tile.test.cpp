@@ -33,7 +33,8 @@ public:
                                   annotationManager.makeWeakPtr(),
                                   imageManager,
                                   glyphManager,
-                                  0};
+                                  0,
+                                  nullptr};
 };
 
 TEST(RasterTile, setError) {
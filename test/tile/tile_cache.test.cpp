@@ -42,7 +42,8 @@ public:
                                   annotationManager.makeWeakPtr(),
                                   imageManager,
                                   glyphManager,
-                                  0};
+                                  0,
+                                  nullptr};
 };
 
 class VectorTileMock : public VectorTile {
@@ -85,3 +86,92 @@ TEST(TileCache, Issue15926) {
     EXPECT_FALSE(cache.has(id0));
     EXPECT_TRUE(cache.has(id1));
 }
+
+class SizedTileMock : public VectorTileMock {
+public:
+    SizedTileMock(const OverscaledTileID& id_, const VectorTileTest& test, size_t bytes_)
+        : VectorTileMock(id_, "source", test.tileParameters, test.tileset),
+          bytes(bytes_) {}
+
+    size_t getMemoryUsage() const override { return bytes; }
+
+private:
+    const size_t bytes;
+};
+
+TEST(TileCache, MaxBytes) {
+    VectorTileTest test;
+    TileCache cache(10);
+    cache.setMaxBytes(250);
+    OverscaledTileID id0(1, 0, 0);
+    OverscaledTileID id1(1, 1, 0);
+    OverscaledTileID id2(1, 0, 1);
+
+    cache.add(id0, std::make_unique<SizedTileMock>(id0, test, 100));
+    cache.add(id1, std::make_unique<SizedTileMock>(id1, test, 100));
+    EXPECT_EQ(cache.getBytes(), 200u);
+
+    // Re-adding an existing tile marks it as the newest one.
+    cache.add(id0, std::make_unique<SizedTileMock>(id0, test, 100));
+    EXPECT_EQ(cache.getBytes(), 200u);
+
+    cache.add(id2, std::make_unique<SizedTileMock>(id2, test, 100));
+    EXPECT_TRUE(cache.has(id0));
+    EXPECT_FALSE(cache.has(id1));
+    EXPECT_TRUE(cache.has(id2));
+    EXPECT_EQ(cache.getBytes(), 200u);
+
+    cache.setMaxBytes(150);
+    EXPECT_FALSE(cache.has(id0));
+    EXPECT_TRUE(cache.has(id2));
+    EXPECT_EQ(cache.getBytes(), 100u);
+
+    EXPECT_NE(cache.pop(id2), nullptr);
+    EXPECT_EQ(cache.getBytes(), 0u);
+}
+
+TEST(TileCache, GlobalMaxBytes) {
+    VectorTileTest test;
+    const size_t initialBytes = TileCache::getGlobalBytes();
+    TileCache::setGlobalMaxBytes(initialBytes + 250);
+
+    {
+        TileCache cache1(10);
+        TileCache cache2(10);
+        OverscaledTileID id0(1, 0, 0);
+        OverscaledTileID id1(1, 1, 0);
+
+        cache1.add(id0, std::make_unique<SizedTileMock>(id0, test, 100));
+        cache1.add(id1, std::make_unique<SizedTileMock>(id1, test, 100));
+        EXPECT_EQ(TileCache::getGlobalBytes(), initialBytes + 200);
+
+        // A new cache within its share of the cap keeps its tiles, even though the cap is exceeded.
+        cache2.add(id0, std::make_unique<SizedTileMock>(id0, test, 100));
+        EXPECT_TRUE(cache2.has(id0));
+        EXPECT_EQ(TileCache::getGlobalBytes(), initialBytes + 300);
+
+        // The cache holding more than its share evicts its oldest tiles when it is next updated.
+        cache1.setSize(10);
+        EXPECT_FALSE(cache1.has(id0));
+        EXPECT_TRUE(cache1.has(id1));
+        EXPECT_EQ(TileCache::getGlobalBytes(), initialBytes + 200);
+
+        // Growing past its share, the new cache evicts its own oldest tiles.
+        cache2.add(id1, std::make_unique<SizedTileMock>(id1, test, 100));
+        cache2.add(id0, std::make_unique<SizedTileMock>(id0, test, 100));
+        EXPECT_TRUE(cache2.has(id0));
+        EXPECT_FALSE(cache2.has(id1));
+        EXPECT_TRUE(cache1.has(id1));
+        EXPECT_EQ(TileCache::getGlobalBytes(), initialBytes + 200);
+
+        // Alone, a cache may use the whole cap.
+        cache1.clear();
+        cache2.add(id1, std::make_unique<SizedTileMock>(id1, test, 100));
+        EXPECT_TRUE(cache2.has(id0));
+        EXPECT_TRUE(cache2.has(id1));
+        EXPECT_EQ(TileCache::getGlobalBytes(), initialBytes + 200);
+    }
+
+    EXPECT_EQ(TileCache::getGlobalBytes(), initialBytes);
+    TileCache::setGlobalMaxBytes(0);
+}
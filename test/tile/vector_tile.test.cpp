@@ -5,6 +5,7 @@
 #include <mbgl/tile/tile_loader_impl.hpp>
 #include <mbgl/storage/resource_options.hpp>
 
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
@@ -41,7 +42,8 @@ public:
                                   annotationManager.makeWeakPtr(),
                                   imageManager,
                                   glyphManager,
-                                  0};
+                                  0,
+                                  nullptr};
 };
 
 TEST(VectorTile, setError) {
@@ -106,3 +108,48 @@ TEST(VectorTileData, ParseResults) {
 
     ASSERT_EQ(feature->getValue("invalid"), std::nullopt);
 }
+
+TEST(VectorTileData, SharedDecodedLayers) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt")));
+    std::unique_ptr<GeometryTileData> clone = data.clone();
+
+    std::unique_ptr<GeometryTileLayer> layer = data.getLayer("admin");
+    std::unique_ptr<GeometryTileLayer> cloneLayer = clone->getLayer("admin");
+    ASSERT_EQ(layer->featureCount(), cloneLayer->featureCount());
+
+    // Features of the same layer read from the original and from a clone share the decoded data.
+    const std::size_t columnBytes = data.getMemoryUsage();
+    EXPECT_GT(columnBytes, 0u);
+    std::unique_ptr<GeometryTileFeature> feature = layer->getFeature(1u);
+    std::unique_ptr<GeometryTileFeature> cloneFeature = cloneLayer->getFeature(1u);
+    EXPECT_EQ(feature->getGeometries(), cloneFeature->getGeometries());
+    EXPECT_FALSE(feature->getGeometries().empty());
+    EXPECT_EQ(feature->getID(), cloneFeature->getID());
+    EXPECT_EQ(&feature->getProperties(), &cloneFeature->getProperties());
+
+    // The geometries and property maps are decoded for the whole layer at once, and counted.
+    const std::size_t decodedBytes = data.getMemoryUsage();
+    EXPECT_GT(decodedBytes, columnBytes);
+    EXPECT_EQ(decodedBytes, clone->getMemoryUsage());
+    EXPECT_EQ(layer->getFeature(2u)->getGeometries(), cloneLayer->getFeature(2u)->getGeometries());
+    EXPECT_EQ(decodedBytes, data.getMemoryUsage());
+    for (const auto& property : feature->getProperties()) {
+        EXPECT_EQ(property.second, *cloneFeature->getValue(property.first));
+    }
+}
+
+TEST(VectorTileData, MappedFile) {
+    std::optional<SharedBuffer> buffer = util::mapFile("test/fixtures/map/issue12432/0-0-0.mvt");
+    ASSERT_TRUE(buffer);
+    VectorTileData data(*buffer);
+
+    std::vector<std::string> layerNames = data.layerNames();
+    ASSERT_EQ(layerNames.size(), 2u);
+    ASSERT_EQ(layerNames.at(0), "admin");
+    ASSERT_EQ(layerNames.at(1), "water");
+
+    std::unique_ptr<GeometryTileLayer> layer = data.getLayer("water");
+    ASSERT_TRUE(layer);
+    EXPECT_EQ(layer->getName(), "water");
+    EXPECT_GT(layer->featureCount(), 0u);
+}
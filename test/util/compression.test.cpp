@@ -0,0 +1,68 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace mbgl;
+
+TEST(Compression, RoundTrip) {
+    const std::string tile = util::read_file("test/fixtures/map/issue12432/0-0-0.mvt");
+    for (int windowBits : {util::CompressionFormat::ZLIB, util::CompressionFormat::GZIP}) {
+        const std::string compressed = util::compress(tile, windowBits);
+        EXPECT_LT(compressed.size(), tile.size());
+        EXPECT_EQ(tile, util::decompress(compressed));
+        EXPECT_EQ(tile, util::decompress(compressed, windowBits));
+    }
+
+    const std::string deflated = util::compress(tile, util::CompressionFormat::DEFLATE);
+    EXPECT_EQ(tile, util::decompress(deflated, util::CompressionFormat::DEFLATE));
+
+    EXPECT_EQ("", util::decompress(util::compress("")));
+}
+
+TEST(Compression, OutputLargerThanEstimate) {
+    // Highly compressible zlib data has no size hint, so the output has to grow several times.
+    const std::string data(8 * 1024 * 1024, 'x');
+    EXPECT_EQ(data, util::decompress(util::compress(data)));
+
+    // The gzip size hint is only used for the initial allocation.
+    std::string gzip = util::compress(data, util::CompressionFormat::GZIP);
+    EXPECT_EQ(data, util::decompress(gzip));
+    gzip[gzip.size() - 1] ^= 0x7f;
+    EXPECT_THROW(util::decompress(gzip), std::runtime_error);
+}
+
+TEST(Compression, ForgedSizeHint) {
+    // A trailer claiming 4 GB must neither be trusted for the allocation nor accepted.
+    const std::string data(64 * 1024, 'z');
+    std::string gzip = util::compress(data, util::CompressionFormat::GZIP);
+    gzip.replace(gzip.size() - 4, 4, 4, '\xff');
+    EXPECT_THROW(util::decompress(gzip), std::runtime_error);
+
+    // An understated trailer only costs reallocations.
+    gzip = util::compress(data, util::CompressionFormat::GZIP);
+    gzip.replace(gzip.size() - 4, 4, 4, '\0');
+    EXPECT_THROW(util::decompress(gzip), std::runtime_error);
+}
+
+TEST(Compression, Errors) {
+    const std::string compressed = util::compress("a string that is compressed and then truncated");
+    EXPECT_THROW(util::decompress(compressed.substr(0, compressed.size() / 2)), std::runtime_error);
+    EXPECT_THROW(util::decompress("not compressed"), std::runtime_error);
+    EXPECT_THROW(util::decompress(""), std::runtime_error);
+
+    // The reused stream is reset after a failure.
+    EXPECT_EQ("after", util::decompress(util::compress("after")));
+}
+
+TEST(Compression, Threads) {
+    const std::string data(100000, 'y');
+    const std::string compressed = util::compress(data, util::CompressionFormat::GZIP);
+    std::thread thread([&] { EXPECT_EQ(data, util::decompress(compressed)); });
+    EXPECT_EQ(data, util::decompress(compressed));
+    thread.join();
+}
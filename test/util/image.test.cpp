@@ -163,3 +163,24 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(0u, rgba.size.width);
     EXPECT_EQ(0u, rgba.size.height);
 }
+
+TEST(Image, PremultiplyAllValues) {
+    // Every combination of channel and alpha value, plus a trailing pixel that isn't part of a full vector.
+    UnassociatedImage rgba({256 * 256 + 1, 1});
+    for (uint32_t i = 0; i < rgba.size.width; ++i) {
+        rgba.data[i * 4 + 0] = static_cast<uint8_t>(i / 256);
+        rgba.data[i * 4 + 1] = static_cast<uint8_t>(255 - i / 256);
+        rgba.data[i * 4 + 2] = static_cast<uint8_t>(i * 7);
+        rgba.data[i * 4 + 3] = static_cast<uint8_t>(i);
+    }
+    const UnassociatedImage original = rgba.clone();
+
+    PremultipliedImage image = util::premultiply(std::move(rgba));
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        const uint8_t a = original.data[i + 3];
+        ASSERT_EQ((original.data[i + 0] * a + 127) / 255, image.data[i + 0]);
+        ASSERT_EQ((original.data[i + 1] * a + 127) / 255, image.data[i + 1]);
+        ASSERT_EQ((original.data[i + 2] * a + 127) / 255, image.data[i + 2]);
+        ASSERT_EQ(a, image.data[i + 3]);
+    }
+}
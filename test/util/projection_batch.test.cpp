@@ -0,0 +1,71 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection_batch.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+// The matrix of a tile near the center of a pitched and rotated 1024x768 viewport at zoom 18, set up the way
+// TransformState::getProjMatrix() and RenderTile do.
+mat4 tileMatrix() {
+    const double worldSize = util::tileSize_D * std::pow(2.0, 18);
+    const double cameraToCenterDistance = 0.5 / std::tan(0.6435011087932844 / 2.0) * 768;
+    mat4 m;
+    matrix::perspective(m, 0.6435011087932844, 1024.0 / 768.0, 1, cameraToCenterDistance * 4);
+    matrix::scale(m, m, 1, -1, 1);
+    matrix::translate(m, m, 0, 0, -cameraToCenterDistance);
+    matrix::rotate_x(m, m, 1.0);
+    matrix::rotate_z(m, m, 0.3);
+    matrix::translate(m, m, -worldSize * 0.3141, -worldSize * 0.5926, 0);
+
+    const double tileX = std::floor(std::pow(2.0, 18) * 0.3141);
+    const double tileY = std::floor(std::pow(2.0, 18) * 0.5926);
+    matrix::translate(m, m, tileX * util::tileSize_D, tileY * util::tileSize_D, 0);
+    matrix::scale(m, m, util::tileSize_D / util::EXTENT, util::tileSize_D / util::EXTENT, 1);
+    return m;
+}
+
+} // namespace
+
+TEST(ProjectionBatch, Empty) {
+    ProjectedPointBatch projected;
+    util::projectPoints(PointBatch(), tileMatrix(), projected);
+    EXPECT_EQ(0u, projected.size());
+}
+
+TEST(ProjectionBatch, MatchesDoublePrecision) {
+    const mat4 matrix = tileMatrix();
+
+    PointBatch points;
+    for (float y = -util::EXTENT / 2; y <= util::EXTENT * 1.5f; y += 101.0f) {
+        for (float x = -util::EXTENT / 2; x <= util::EXTENT * 1.5f; x += 67.0f) {
+            points.push_back({x, y});
+        }
+    }
+    // Leave a remainder for the scalar tail.
+    while (points.size() % 4 != 3) {
+        points.push_back({1.0f, 2.0f});
+    }
+
+    ProjectedPointBatch projected;
+    util::projectPoints(points, matrix, projected);
+    ASSERT_EQ(points.size(), projected.size());
+
+    std::size_t inFront = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        vec4 p = {{points.x[i], points.y[i], 0, 1}};
+        matrix::transformMat4(p, p, matrix);
+        if (p[3] <= 0) continue;
+        ++inFront;
+
+        // Within a thousandth of a pixel of a 1024x768 viewport, and a millionth of the camera distance.
+        EXPECT_NEAR(p[0] / p[3], projected.x[i], 2e-6 * std::max(1.0, std::abs(p[0] / p[3])));
+        EXPECT_NEAR(p[1] / p[3], projected.y[i], 2e-6 * std::max(1.0, std::abs(p[1] / p[3])));
+        EXPECT_NEAR(p[3], projected.w[i], 1e-6 * p[3]);
+    }
+    EXPECT_GT(inFront, points.size() / 2);
+}
@@ -0,0 +1,55 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/layout/repeated_label_index.hpp>
+#include <mbgl/util/math.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+TEST(RepeatedLabelIndex, RepeatDistance) {
+    RepeatedLabelIndex index;
+
+    EXPECT_FALSE(index.isTooClose(u"Main Street", 100.0f, {0.0f, 0.0f}));
+    // Anchors closer than the repeat distance are rejected and not added.
+    EXPECT_TRUE(index.isTooClose(u"Main Street", 100.0f, {99.0f, 0.0f}));
+    EXPECT_TRUE(index.isTooClose(u"Main Street", 100.0f, {-60.0f, -60.0f}));
+    // The distance must be strictly smaller.
+    EXPECT_FALSE(index.isTooClose(u"Main Street", 100.0f, {100.0f, 0.0f}));
+    EXPECT_TRUE(index.isTooClose(u"Main Street", 100.0f, {150.0f, 0.0f}));
+    // Other texts don't interfere.
+    EXPECT_FALSE(index.isTooClose(u"High Street", 100.0f, {50.0f, 0.0f}));
+    // Anchors outside of the tile are indexed too.
+    EXPECT_FALSE(index.isTooClose(u"Main Street", 100.0f, {-500.0f, 9000.0f}));
+    EXPECT_TRUE(index.isTooClose(u"Main Street", 100.0f, {-450.0f, 9050.0f}));
+
+    index.clear();
+    EXPECT_FALSE(index.isTooClose(u"Main Street", 100.0f, {99.0f, 0.0f}));
+}
+
+TEST(RepeatedLabelIndex, MatchesLinearScan) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> coordinate(-256.0f, 8448.0f);
+    const std::vector<std::u16string> texts{u"A", u"B", u"C"};
+    const float repeatDistance = 125.0f;
+
+    RepeatedLabelIndex index;
+    std::vector<std::vector<Point<float>>> added(texts.size());
+    for (std::size_t i = 0; i < 10000; ++i) {
+        const std::size_t text = i % texts.size();
+        const Point<float> anchor{coordinate(generator), coordinate(generator)};
+
+        bool tooClose = false;
+        for (const auto& other : added[text]) {
+            if (util::dist<float>(anchor, other) < repeatDistance) {
+                tooClose = true;
+                break;
+            }
+        }
+        if (!tooClose) {
+            added[text].push_back(anchor);
+        }
+
+        ASSERT_EQ(tooClose, index.isTooClose(texts[text], repeatDistance, anchor));
+    }
+}
@@ -0,0 +1,62 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/shared_buffer.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+
+using namespace mbgl;
+
+TEST(SharedBuffer, Empty) {
+    SharedBuffer none;
+    EXPECT_FALSE(none);
+    EXPECT_EQ(nullptr, none.get());
+    EXPECT_TRUE(none.empty());
+
+    SharedBuffer empty = std::make_shared<std::string>();
+    EXPECT_TRUE(empty);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ("", *empty);
+}
+
+TEST(SharedBuffer, WrapsStringWithoutCopying) {
+    auto string = std::make_shared<const std::string>("vector tile");
+    SharedBuffer buffer = string;
+    EXPECT_EQ(string->data(), buffer.data());
+    EXPECT_EQ(string.get(), buffer.get());
+    EXPECT_EQ(string, buffer.string());
+    EXPECT_EQ(buffer, SharedBuffer(buffer));
+}
+
+TEST(SharedBuffer, ExternalOwner) {
+    bool released = false;
+    {
+        auto bytes = std::make_shared<std::array<char, 4>>(std::array<char, 4>{{'a', 'b', 'c', 'd'}});
+        std::shared_ptr<const void> owner(bytes.get(), [bytes, &released](const void*) mutable {
+            bytes.reset();
+            released = true;
+        });
+        SharedBuffer buffer(bytes->data(), bytes->size(), std::move(owner));
+        SharedBuffer slice = buffer.slice(1, 2);
+        buffer = {};
+        EXPECT_FALSE(released);
+
+        EXPECT_EQ("bc", slice.view());
+        // Materializing a string copies once; every copy of the buffer shares the result.
+        const std::string* string = slice.get();
+        EXPECT_EQ("bc", *string);
+        EXPECT_EQ(string, SharedBuffer(slice).get());
+        EXPECT_NE(static_cast<const void*>(string->data()), static_cast<const void*>(slice.data()));
+    }
+    EXPECT_TRUE(released);
+}
+
+TEST(SharedBuffer, Slice) {
+    SharedBuffer buffer = std::make_shared<std::string>("0123456789");
+    EXPECT_EQ("3456789", buffer.slice(3).view());
+    EXPECT_EQ("34", buffer.slice(3, 2).view());
+    EXPECT_EQ("89", buffer.slice(8, 100).view());
+    EXPECT_TRUE(buffer.slice(20).empty());
+    EXPECT_EQ(buffer, buffer.slice(0));
+}
@@ -2,12 +2,17 @@
 
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/platform/settings.hpp>
 #include <mbgl/test/util.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/thread_pool.hpp>
 #include <mbgl/util/timer.hpp>
 
 #include <atomic>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 using namespace mbgl;
 using namespace mbgl::util;
@@ -327,3 +332,76 @@ TEST(Thread, DeleteBeforeChildStarts) {
     // Should process the queue before destruction.
     ASSERT_TRUE(flag);
 }
+
+TEST(Thread, ThreadPoolSize) {
+    auto& settings = platform::Settings::getInstance();
+
+    settings.set(platform::EXPERIMENTAL_THREAD_POOL_SIZE, uint64_t(2));
+    EXPECT_EQ(ThreadPool::defaultThreadCount(), 2u);
+    EXPECT_EQ(ThreadPool().getThreadCount(), 2u);
+
+    settings.set(platform::EXPERIMENTAL_THREAD_POOL_SIZE, mapbox::base::Value());
+    EXPECT_GE(ThreadPool::defaultThreadCount(), 4u);
+}
+
+TEST(Thread, ThreadPoolPriorities) {
+    ThreadPool pool(1);
+
+    std::promise<void> blocked;
+    std::promise<void> unblock;
+    auto unblockFuture = unblock.get_future().share();
+
+    // Keep the only worker busy while the other tasks are queued.
+    pool.schedule([&blocked, unblockFuture] {
+        blocked.set_value();
+        unblockFuture.wait();
+    });
+    blocked.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<TaskPriority> order;
+    std::promise<void> done;
+    std::atomic<int> remaining{3};
+    auto record = [&](TaskPriority priority) {
+        return [&, priority] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(priority);
+            }
+            if (!--remaining) done.set_value();
+        };
+    };
+
+    pool.scheduleWithPriority(TaskPriority::Low, record(TaskPriority::Low));
+    pool.scheduleWithPriority(TaskPriority::Normal, record(TaskPriority::Normal));
+    pool.scheduleWithPriority(TaskPriority::High, record(TaskPriority::High));
+
+    unblock.set_value();
+    done.get_future().wait();
+
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], TaskPriority::High);
+    EXPECT_EQ(order[1], TaskPriority::Normal);
+    EXPECT_EQ(order[2], TaskPriority::Low);
+}
+
+TEST(Thread, ThreadPoolWorkStealing) {
+    ThreadPool pool(4);
+
+    constexpr int numTasks = 10000;
+    std::atomic<int> remaining{numTasks};
+    std::promise<void> done;
+
+    // Tasks scheduled from a worker land in that worker's queue, so the
+    // other workers have to steal them to finish.
+    pool.schedule([&] {
+        for (int i = 0; i < numTasks; ++i) {
+            pool.schedule([&] {
+                if (!--remaining) done.set_value();
+            });
+        }
+    });
+
+    done.get_future().wait();
+    EXPECT_EQ(remaining, 0);
+}